@@ -0,0 +1,5 @@
+SET(FILES
+    benchmarks_main.cc
+    serialization/serialization_benchmarks.cc
+    std/string_hash_benchmarks.cc
+)
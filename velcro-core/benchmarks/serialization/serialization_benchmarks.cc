@@ -0,0 +1,197 @@
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/memory/system_allocator.h>
+#include <vcore/serialization/json_serialization.h>
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/smart_ptr/unique_ptr.h>
+#include <vcore/std/string/conversions.h>
+#include <vcore/std/string/string.h>
+
+#include <benchmark/benchmark.h>
+
+namespace Benchmark
+{
+    namespace SerializationBenchmarkInternal
+    {
+        struct BenchmarkItem
+        {
+            VOBJECT(BenchmarkItem, "{3f0e6a52-4b1d-4d8e-9c3a-0a52d6f1c7e4}");
+            V_CLASS_ALLOCATOR(BenchmarkItem, V::SystemAllocator, 0);
+
+            int Id = 0;
+            float Weight = 0.0f;
+            VStd::string Label;
+        };
+
+        //! Payload shaped like a component: a few scalars, a string, a primitive vector and a vector of reflected items.
+        struct BenchmarkObject
+        {
+            VOBJECT(BenchmarkObject, "{c8d1f0b7-2e64-4a39-8f5d-6b7e90a3d215}");
+            V_CLASS_ALLOCATOR(BenchmarkObject, V::SystemAllocator, 0);
+
+            int Count = 0;
+            bool Enabled = false;
+            VStd::string Name;
+            VStd::vector<float> Values;
+            VStd::vector<BenchmarkItem> Items;
+
+            static void Reflect(V::SerializeContext& sc)
+            {
+                sc.Class<BenchmarkItem>()
+                    ->Version(1)
+                    ->Field("Id", &BenchmarkItem::Id)
+                    ->Field("Weight", &BenchmarkItem::Weight)
+                    ->Field("Label", &BenchmarkItem::Label);
+
+                sc.Class<BenchmarkObject>()
+                    ->Version(1)
+                    ->Field("Count", &BenchmarkObject::Count)
+                    ->Field("Enabled", &BenchmarkObject::Enabled)
+                    ->Field("Name", &BenchmarkObject::Name)
+                    ->Field("Values", &BenchmarkObject::Values)
+                    ->Field("Items", &BenchmarkObject::Items);
+            }
+        };
+
+        //! Saver/loader pairs so every benchmark runs the same loop for both formats.
+        struct BinaryFormat
+        {
+            static bool Save(V::IO::GenericStream& stream, const V::SerializeContext& sc, const BenchmarkObject& object)
+            {
+                return V::ObjectStream::SaveObject(stream, sc, &object);
+            }
+
+            static bool Load(V::IO::GenericStream& stream, V::SerializeContext& sc, BenchmarkObject& object)
+            {
+                return V::ObjectStream::LoadObjectInPlace(stream, sc, object);
+            }
+        };
+
+        struct JsonFormat
+        {
+            static bool Save(V::IO::GenericStream& stream, const V::SerializeContext& sc, const BenchmarkObject& object)
+            {
+                return V::JsonSerialization::SaveObject(stream, sc, &object);
+            }
+
+            static bool Load(V::IO::GenericStream& stream, V::SerializeContext& sc, BenchmarkObject& object)
+            {
+                return V::JsonSerialization::LoadObjectInPlace(stream, sc, object);
+            }
+        };
+    } // namespace SerializationBenchmarkInternal
+
+    //! The range argument is the number of items in the payload.
+    class SerializationBenchmarkFixture
+        : public ::benchmark::Fixture
+    {
+    public:
+        void SetUp(const ::benchmark::State& state) override
+        {
+            using namespace SerializationBenchmarkInternal;
+
+            V::AllocatorInstance<V::SystemAllocator>::Create();
+            m_serializeContext = VStd::make_unique<V::SerializeContext>();
+            BenchmarkObject::Reflect(*m_serializeContext);
+
+            const int itemCount = static_cast<int>(state.range(0));
+            m_object.Count = itemCount;
+            m_object.Enabled = true;
+            m_object.Name = "serialization benchmark";
+            m_object.Values.reserve(itemCount);
+            m_object.Items.reserve(itemCount);
+            for (int i = 0; i < itemCount; ++i)
+            {
+                m_object.Values.push_back(static_cast<float>(i) * 0.5f);
+
+                BenchmarkItem item;
+                item.Id = i;
+                item.Weight = static_cast<float>(i) / static_cast<float>(itemCount);
+                item.Label = VStd::string("item_") + VStd::to_string(i);
+                m_object.Items.push_back(VStd::move(item));
+            }
+        }
+
+        void TearDown(const ::benchmark::State&) override
+        {
+            m_buffer = {};
+            m_object = SerializationBenchmarkInternal::BenchmarkObject();
+            m_serializeContext.reset();
+            V::AllocatorInstance<V::SystemAllocator>::Destroy();
+        }
+
+    protected:
+        template<class Format>
+        void SaveLoop(benchmark::State& state)
+        {
+            for ([[maybe_unused]] auto _ : state)
+            {
+                m_buffer.clear();
+                V::IO::ByteContainerStream<VStd::vector<char>> stream(&m_buffer);
+                if (!Format::Save(stream, *m_serializeContext, m_object))
+                {
+                    state.SkipWithError("Save failed");
+                    break;
+                }
+            }
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * m_buffer.size()));
+            state.counters["StreamBytes"] = static_cast<double>(m_buffer.size());
+        }
+
+        template<class Format>
+        void LoadLoop(benchmark::State& state)
+        {
+            {
+                V::IO::ByteContainerStream<VStd::vector<char>> stream(&m_buffer);
+                if (!Format::Save(stream, *m_serializeContext, m_object))
+                {
+                    state.SkipWithError("Save failed");
+                    return;
+                }
+            }
+
+            SerializationBenchmarkInternal::BenchmarkObject loaded;
+            for ([[maybe_unused]] auto _ : state)
+            {
+                V::IO::ByteContainerStream<VStd::vector<char>> stream(&m_buffer);
+                if (!Format::Load(stream, *m_serializeContext, loaded))
+                {
+                    state.SkipWithError("Load failed");
+                    break;
+                }
+                benchmark::DoNotOptimize(loaded.Items.data());
+            }
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * m_buffer.size()));
+            state.counters["StreamBytes"] = static_cast<double>(m_buffer.size());
+        }
+
+        VStd::unique_ptr<V::SerializeContext> m_serializeContext;
+        SerializationBenchmarkInternal::BenchmarkObject m_object;
+        VStd::vector<char> m_buffer;
+    };
+
+    BENCHMARK_DEFINE_F(SerializationBenchmarkFixture, BM_ObjectStream_Save)(benchmark::State& state)
+    {
+        SaveLoop<SerializationBenchmarkInternal::BinaryFormat>(state);
+    }
+    BENCHMARK_REGISTER_F(SerializationBenchmarkFixture, BM_ObjectStream_Save)->RangeMultiplier(8)->Range(8, 4096);
+
+    BENCHMARK_DEFINE_F(SerializationBenchmarkFixture, BM_Json_Save)(benchmark::State& state)
+    {
+        SaveLoop<SerializationBenchmarkInternal::JsonFormat>(state);
+    }
+    BENCHMARK_REGISTER_F(SerializationBenchmarkFixture, BM_Json_Save)->RangeMultiplier(8)->Range(8, 4096);
+
+    BENCHMARK_DEFINE_F(SerializationBenchmarkFixture, BM_ObjectStream_Load)(benchmark::State& state)
+    {
+        LoadLoop<SerializationBenchmarkInternal::BinaryFormat>(state);
+    }
+    BENCHMARK_REGISTER_F(SerializationBenchmarkFixture, BM_ObjectStream_Load)->RangeMultiplier(8)->Range(8, 4096);
+
+    BENCHMARK_DEFINE_F(SerializationBenchmarkFixture, BM_Json_Load)(benchmark::State& state)
+    {
+        LoadLoop<SerializationBenchmarkInternal::JsonFormat>(state);
+    }
+    BENCHMARK_REGISTER_F(SerializationBenchmarkFixture, BM_Json_Load)->RangeMultiplier(8)->Range(8, 4096);
+} // namespace Benchmark
@@ -0,0 +1,72 @@
+#include <vcore/std/string/string_view.h>
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmark
+{
+    namespace StringHashBenchmarkInternal
+    {
+        //! Number of keys hashed in turn, so a run isn't a single key sitting in the cache.
+        static constexpr size_t KeyCount = 1024;
+
+        //! Keys shaped like the ones hashed at run time (member, type and asset names), cut or repeated to the given length.
+        static std::vector<std::string> MakeKeys(size_t length)
+        {
+            static const char* const stems[] = { "m_position", "TransformComponent", "V::Render::MeshFeatureProcessor",
+                "materials/environment/rock_", "EntityId" };
+
+            std::vector<std::string> keys;
+            keys.reserve(KeyCount);
+            for (size_t i = 0; i < KeyCount; ++i)
+            {
+                std::string key = std::to_string(i) + stems[i % std::size(stems)];
+                while (key.size() < length)
+                {
+                    key += key;
+                }
+                key.resize(length);
+                keys.push_back(std::move(key));
+            }
+            return keys;
+        }
+
+        template<class HashFunction>
+        static void HashKeys(benchmark::State& state, HashFunction hashFunction)
+        {
+            const std::vector<std::string> keys = MakeKeys(static_cast<size_t>(state.range(0)));
+            size_t index = 0;
+            for ([[maybe_unused]] auto _ : state)
+            {
+                const std::string& key = keys[index];
+                benchmark::DoNotOptimize(hashFunction(key.data(), key.size()));
+                index = (index + 1) % KeyCount;
+            }
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        }
+    } // namespace StringHashBenchmarkInternal
+
+    //! FNV-1a, what Name and other network visible hashes use.
+    static void BM_StringHash_Fnv1a(benchmark::State& state)
+    {
+        StringHashBenchmarkInternal::HashKeys(state, [](const char* data, size_t length)
+        {
+            return VStd::hash_string(data, length);
+        });
+    }
+    BENCHMARK(BM_StringHash_Fnv1a)->RangeMultiplier(2)->Range(4, 256);
+
+    //! Word at a time wyhash, what VStd::hash uses for strings.
+    static void BM_StringHash_Fast(benchmark::State& state)
+    {
+        StringHashBenchmarkInternal::HashKeys(state, [](const char* data, size_t length)
+        {
+            return VStd::hash_string_fast(data, length);
+        });
+    }
+    BENCHMARK(BM_StringHash_Fast)->RangeMultiplier(2)->Range(4, 256);
+} // namespace Benchmark
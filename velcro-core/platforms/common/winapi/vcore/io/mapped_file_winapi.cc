@@ -0,0 +1,88 @@
+#include <vcore/io/mapped_file.h>
+#include <vcore/io/path/path.h>
+#include <vcore/std/string/conversions.h>
+
+#include <vcore/platform_incl.h>
+
+namespace V::IO
+{
+    using FixedMaxPathWString = VStd::fixed_wstring<MaxPathLength>;
+
+    bool MappedFile::Open(const char* filePath)
+    {
+        Close();
+
+        FixedMaxPathWString filePathW;
+        VStd::to_wstring(filePathW, filePath);
+
+        HANDLE file = CreateFileW(filePathW.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            V_TracePrintf("VSystem", "CreateFileMapping failed with error %d\n", GetLastError());
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            V_TracePrintf("VSystem", "MapViewOfFile failed with error %d\n", GetLastError());
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle = file;
+        m_mappingHandle = mapping;
+        m_data = static_cast<const V::u8*>(view);
+        m_size = static_cast<V::u64>(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+            m_data = nullptr;
+        }
+        if (m_mappingHandle)
+        {
+            CloseHandle(m_mappingHandle);
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = nullptr;
+        }
+        m_size = 0;
+    }
+
+    void MappedFile::Prefetch(V::u64 offset, V::u64 size) const
+    {
+        if (!m_data || offset >= m_size)
+        {
+            return;
+        }
+
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<V::u8*>(m_data + offset);
+        range.NumberOfBytes = static_cast<SIZE_T>(VStd::min(size, m_size - offset));
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+} // namespace V::IO
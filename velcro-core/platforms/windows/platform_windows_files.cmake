@@ -18,6 +18,8 @@ SET (FILES
     platforms/windows/vcore/std/parallel/internal/thread_windows.cc
     platforms/windows/vcore/std/parallel/config_platform.h
     platforms/windows/vcore/std/time_windows.cc
+    platforms/windows/vcore/time/time_platform.h
+    platforms/windows/vcore/time/time_windows.h
     platforms/windows/vcore/platform_id/platform_id_platform.h
     platforms/windows/vcore/io/system_file_platform.h
     platforms/windows/vcore/io/streamer/streamer_context_platform.h
@@ -44,6 +46,7 @@ SET (FILES
     platforms/common/winapi/vcore/utilitys/utility_winapi.cc
     platforms/common/winapi/vcore/io/streamer/streamer_context_winapi.h
     platforms/common/winapi/vcore/io/streamer/streamer_context_winapi.cc
+    platforms/common/winapi/vcore/io/mapped_file_winapi.cc
     platforms/common/winapi/vcore/io/system_file_winapi.h
     platforms/common/winapi/vcore/io/system_file_winapi.cc
     platforms/common/winapi/vcore/std/parallel/internal/thread_winapi.h
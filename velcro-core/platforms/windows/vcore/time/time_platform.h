@@ -0,0 +1,6 @@
+#ifndef V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_PLATFORM_H
+#define V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_PLATFORM_H
+
+#include <vcore/time/time_windows.h>
+
+#endif // V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_PLATFORM_H
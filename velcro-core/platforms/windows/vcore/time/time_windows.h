@@ -0,0 +1,34 @@
+#ifndef V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_WINDOWS_H
+#define V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_WINDOWS_H
+
+#include <vcore/platform.h>
+
+#if V_TRAIT_TIME_USE_TSC
+#   include <intrin.h>
+#endif
+
+namespace V::Platform {
+    //! Reads the raw processor time stamp counter.
+    //! Only meaningful when HasInvariantTimeStampCounter() returned true.
+    V_FORCE_INLINE V::u64 ReadTimeStampCounter()
+    {
+#if V_TRAIT_TIME_USE_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    //! Returns true if the CPU reports an invariant TSC (CPUID.80000007H:EDX[8]),
+    //! which ticks at a constant rate across P/C-states and is synchronized between cores.
+    inline bool HasInvariantTimeStampCounter()
+    {
+#if V_TRAIT_TIME_USE_TSC
+        return GetCpuFeatures().HasInvariantTsc;
+#else
+        return false;
+#endif
+    }
+}
+
+#endif // V_FRAMEWORK_CORE_PLATFORM_WINDOWS_TIME_TIME_WINDOWS_H
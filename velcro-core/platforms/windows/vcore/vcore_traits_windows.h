@@ -93,6 +93,7 @@
 #define V_TRAIT_THREAD_AFFINITY_MASK_WORKERTHREADS V_TRAIT_THREAD_AFFINITY_MASK_ALLTHREADS
 #define V_TRAIT_THREAD_AFFINITY_MASK_ASSET_PROCESSOR_CONNECTION_THREAD 4
 #define V_TRAIT_THREAD_HARDWARE_CONCURRENCY_RETURN_VALUE INVALID_RETURN_VALUE
+#define V_TRAIT_TIME_USE_TSC 1
 #define V_TRAIT_UNITTEST_NON_PREALLOCATED_HPHA_TEST 1
 #define V_TRAIT_UNITTEST_USE_TEST_RUNNER_ENVIRONMENT 0
 #define V_TRAIT_USE_CRY_SIGNAL_HANDLER 0
@@ -0,0 +1,268 @@
+#include <vcore/debug/trace_message_bus.h>
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/math/crc.h>
+#include <vcore/memory/system_allocator.h>
+#include <vcore/serialization/object_delta.h>
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/serialization/snapshot_format.h>
+#include <vcore/serialization/snapshot_reader.h>
+#include <vcore/serialization/snapshot_writer.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/smart_ptr/unique_ptr.h>
+#include <vcore/std/string/string.h>
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+namespace UnitTest
+{
+    struct RoundTripItem
+    {
+        VOBJECT(RoundTripItem, "{b5209ea5-73e3-446a-bb18-48a3dfd4994c}");
+        V_CLASS_ALLOCATOR(RoundTripItem, V::SystemAllocator, 0);
+
+        RoundTripItem() = default;
+        RoundTripItem(int id, const char* label)
+            : Id(id)
+            , Label(label)
+        {
+        }
+
+        int Id = 0;
+        VStd::string Label;
+    };
+
+    struct RoundTripObject
+    {
+        VOBJECT(RoundTripObject, "{6a5668cf-af76-4c47-a336-82aba2c81b4f}");
+        V_CLASS_ALLOCATOR(RoundTripObject, V::SystemAllocator, 0);
+
+        int Count = 0;
+        float Scale = 1.0f;
+        bool Enabled = false;
+        VStd::string Name;
+        VStd::vector<int> Values;
+        VStd::vector<RoundTripItem> Items;
+
+        static void Reflect(V::SerializeContext& sc)
+        {
+            sc.Class<RoundTripItem>()
+                ->Version(1)
+                ->Field("Id", &RoundTripItem::Id)
+                ->Field("Label", &RoundTripItem::Label);
+
+            sc.Class<RoundTripObject>()
+                ->Version(1)
+                ->Field("Count", &RoundTripObject::Count)
+                ->Field("Scale", &RoundTripObject::Scale)
+                ->Field("Enabled", &RoundTripObject::Enabled)
+                ->Field("Name", &RoundTripObject::Name)
+                ->Field("Values", &RoundTripObject::Values)
+                ->Field("Items", &RoundTripObject::Items);
+        }
+    };
+
+    //! Counts the errors raised while loading broken data, any other one fails the test.
+    class SerializationRoundTripTest
+        : public ::testing::Test
+        , public V::Debug::TraceMessageBus::Handler
+    {
+    protected:
+        void SetUp() override
+        {
+            V::AllocatorInstance<V::SystemAllocator>::Create();
+            BusConnect();
+            m_serializeContext = VStd::make_unique<V::SerializeContext>();
+            RoundTripObject::Reflect(*m_serializeContext);
+
+            m_object.Count = 42;
+            m_object.Scale = 0.25f;
+            m_object.Enabled = true;
+            m_object.Name = "round trip";
+            m_object.Values = { 1, 2, 3, 5, 8 };
+            m_object.Items.emplace_back(7, "seven");
+            m_object.Items.emplace_back(9, "nine");
+        }
+
+        void TearDown() override
+        {
+            if (!m_expectErrors)
+            {
+                EXPECT_EQ(0u, m_numErrors);
+            }
+            m_object = RoundTripObject();
+            m_serializeContext.reset();
+            BusDisconnect();
+            V::AllocatorInstance<V::SystemAllocator>::Destroy();
+        }
+
+        bool OnPreError(const char* /*window*/, const char* /*fileName*/, int /*line*/, const char* /*func*/, const char* /*message*/) override
+        {
+            ++m_numErrors;
+            return true;
+        }
+
+        bool AreEqual(const RoundTripObject& lhs, const RoundTripObject& rhs) const
+        {
+            return m_serializeContext->CompareObjects(&lhs, &rhs, V::VObject<RoundTripObject>::Id());
+        }
+
+        VStd::unique_ptr<V::SerializeContext> m_serializeContext;
+        RoundTripObject m_object;
+        bool m_expectErrors = false;
+        unsigned int m_numErrors = 0;
+    };
+
+    TEST_F(SerializationRoundTripTest, ObjectStream_SaveThenLoad_ReturnsEqualObject)
+    {
+        VStd::vector<char> buffer;
+        V::IO::ByteContainerStream<VStd::vector<char>> stream(&buffer);
+        ASSERT_TRUE(V::ObjectStream::SaveObject(stream, *m_serializeContext, &m_object));
+
+        stream.Seek(0, V::IO::GenericStream::ST_SEEK_BEGIN);
+        RoundTripObject* loaded = V::ObjectStream::LoadObject<RoundTripObject>(stream, *m_serializeContext);
+        ASSERT_NE(nullptr, loaded);
+        EXPECT_EQ(m_object.Count, loaded->Count);
+        EXPECT_EQ(m_object.Name, loaded->Name);
+        ASSERT_EQ(m_object.Items.size(), loaded->Items.size());
+        EXPECT_EQ(m_object.Items[1].Label, loaded->Items[1].Label);
+        EXPECT_TRUE(AreEqual(m_object, *loaded));
+        delete loaded;
+    }
+
+    TEST_F(SerializationRoundTripTest, ObjectStream_LoadTruncatedStream_Fails)
+    {
+        VStd::vector<char> buffer;
+        V::IO::ByteContainerStream<VStd::vector<char>> stream(&buffer);
+        ASSERT_TRUE(V::ObjectStream::SaveObject(stream, *m_serializeContext, &m_object));
+
+        buffer.resize(buffer.size() / 2);
+        m_expectErrors = true;
+        V::IO::ByteContainerStream<VStd::vector<char>> truncated(&buffer);
+        RoundTripObject* loaded = V::ObjectStream::LoadObject<RoundTripObject>(truncated, *m_serializeContext);
+        EXPECT_EQ(nullptr, loaded);
+        delete loaded;
+    }
+
+    TEST_F(SerializationRoundTripTest, CloneObject_ReturnsEqualObject)
+    {
+        RoundTripObject* clone = m_serializeContext->CloneObject(&m_object);
+        ASSERT_NE(nullptr, clone);
+        EXPECT_TRUE(AreEqual(m_object, *clone));
+
+        clone->Items[0].Label = "changed";
+        EXPECT_FALSE(AreEqual(m_object, *clone));
+        EXPECT_EQ("seven", m_object.Items[0].Label);
+        delete clone;
+    }
+
+    TEST_F(SerializationRoundTripTest, ObjectDelta_ApplyToBaseline_ReproducesObject)
+    {
+        const RoundTripObject baseline = m_object;
+        m_object.Count = 43;
+        m_object.Name = "changed";
+        m_object.Values.push_back(13);
+        m_object.Items.pop_back();
+
+        VStd::vector<char> delta;
+        ASSERT_TRUE(V::ObjectDelta::CreateDelta(delta, *m_serializeContext, m_object, baseline));
+        EXPECT_TRUE(V::ObjectDelta::HasChanges(delta.data(), delta.size()));
+
+        RoundTripObject patched = baseline;
+        ASSERT_TRUE(V::ObjectDelta::ApplyDelta(patched, *m_serializeContext, delta.data(), delta.size()));
+        EXPECT_TRUE(AreEqual(m_object, patched));
+    }
+
+    TEST_F(SerializationRoundTripTest, ObjectDelta_SameObject_HasNoChanges)
+    {
+        VStd::vector<char> delta;
+        ASSERT_TRUE(V::ObjectDelta::CreateDelta(delta, *m_serializeContext, m_object, m_object));
+        EXPECT_FALSE(V::ObjectDelta::HasChanges(delta.data(), delta.size()));
+    }
+
+    class SnapshotRoundTripTest
+        : public SerializationRoundTripTest
+    {
+    protected:
+        //! Snapshot images have to be 16 byte aligned in memory.
+        struct alignas(16) ImageBlock
+        {
+            char Bytes[16];
+        };
+
+        void SetUp() override
+        {
+            SerializationRoundTripTest::SetUp();
+
+            VStd::vector<char> image;
+            ASSERT_TRUE(V::SnapshotWriter::WriteImage(image, *m_serializeContext, &m_object, V::VObject<RoundTripObject>::Id()));
+            m_imageSize = image.size();
+            m_image.resize((m_imageSize + sizeof(ImageBlock) - 1) / sizeof(ImageBlock));
+            memcpy(m_image.data(), image.data(), m_imageSize);
+        }
+
+        void TearDown() override
+        {
+            m_image = {};
+            SerializationRoundTripTest::TearDown();
+        }
+
+        V::SnapshotFormat::Header& GetHeader()
+        {
+            return *reinterpret_cast<V::SnapshotFormat::Header*>(m_image.data());
+        }
+
+        VStd::vector<ImageBlock> m_image;
+        size_t m_imageSize = 0;
+    };
+
+    TEST_F(SnapshotRoundTripTest, OpenMemory_ValidImage_ReadsFields)
+    {
+        V::SnapshotReader reader;
+        ASSERT_TRUE(reader.OpenMemory(m_image.data(), m_imageSize));
+
+        const V::SnapshotValue root = reader.GetRoot();
+        int count = 0;
+        EXPECT_TRUE(root.FindField(V_CRC("Count")).LoadValue(count, *m_serializeContext));
+        EXPECT_EQ(m_object.Count, count);
+
+        VStd::string name;
+        EXPECT_TRUE(root.FindField(V_CRC("Name")).LoadValue(name, *m_serializeContext));
+        EXPECT_EQ(m_object.Name, name);
+
+        // the type id is checked, an int can't be loaded as a float
+        float scale = 0.0f;
+        EXPECT_FALSE(root.FindField(V_CRC("Count")).LoadValue(scale, *m_serializeContext));
+        EXPECT_EQ(m_object.Items.size(), root.FindField(V_CRC("Items")).GetSize());
+    }
+
+    TEST_F(SnapshotRoundTripTest, OpenMemory_TruncatedImage_Fails)
+    {
+        m_expectErrors = true;
+        V::SnapshotReader reader;
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), m_imageSize / 2));
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), sizeof(V::SnapshotFormat::Header) - 1));
+    }
+
+    TEST_F(SnapshotRoundTripTest, OpenMemory_CorruptHeader_Fails)
+    {
+        m_expectErrors = true;
+        V::SnapshotReader reader;
+
+        GetHeader().MagicNumber ^= 0xFFFFFFFF;
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), m_imageSize));
+        GetHeader().MagicNumber ^= 0xFFFFFFFF;
+
+        const V::u64 rootOffset = GetHeader().RootOffset;
+        GetHeader().RootOffset = m_imageSize;
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), m_imageSize));
+        GetHeader().RootOffset = rootOffset + 1;
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), m_imageSize));
+        GetHeader().RootOffset = rootOffset;
+
+        GetHeader().TypeCount = 0xFFFFFFFF;
+        EXPECT_FALSE(reader.OpenMemory(m_image.data(), m_imageSize));
+    }
+} // namespace UnitTest
@@ -0,0 +1,3 @@
+SET(FILES
+    serialization/round_trip_tests.cc
+)
@@ -32,6 +32,11 @@ namespace V::Debug
             return m_hash != rhs.m_hash;
         }
 
+        constexpr uint32_t GetHash() const
+        {
+            return m_hash;
+        }
+
     private:
         uint32_t m_hash{ 5381 }; // standard starting value for DJB2a hash
     };
@@ -57,6 +62,17 @@ namespace V::Debug
             uint32_t UserVersion{ 0 };
         };
 
+        //! Major version of logs whose chunks are each preceded by a ChunkHeader, which lets readers find the chunks
+        //! without walking the events and lets them be zstd compressed.
+        //! Version 1 logs are the raw thread buffers one after the other.
+        static constexpr uint32_t ChunkedMajorVersion = 2;
+
+        struct ChunkHeader
+        {
+            uint32_t CompressedSize;      //!< Number of bytes following this header.
+            uint32_t UncompressedSize;    //!< Size of the chunk once decompressed. Equal sizes mean the chunk was stored uncompressed.
+        };
+
         struct EventHeader
         {
             EventNameHash EventId;    //!< Unique id that identifies the event. This is typically a hash of the event name.
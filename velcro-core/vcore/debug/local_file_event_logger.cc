@@ -5,8 +5,10 @@
 #include <vcore/io/path/path.h>
 #include <vcore/std/parallel/scoped_lock.h>
 #include <vcore/std/parallel/thread.h>
+#include <vcore/std/sort.h>
 
 #include <time.h>
+#include <zstd.h>
 
 namespace V::Debug {
     //
@@ -31,6 +33,20 @@ namespace V::Debug {
             if (readSize == size)
             {
                 memcpy(&m_logHeader, buffer, sizeof(m_logHeader));
+                if (m_logHeader.MajorVersion > IEventLogger::ChunkedMajorVersion)
+                {
+                    V_Warning("EventLogReader", false, "Event log version %u is newer than this reader.", m_logHeader.MajorVersion);
+                    return false;
+                }
+                if (m_logHeader.MajorVersion == IEventLogger::ChunkedMajorVersion)
+                {
+                    VStd::vector<uint8_t> compressed = VStd::move(m_buffer);
+                    if (!DecompressChunks(compressed.data(), compressed.size()))
+                    {
+                        return false;
+                    }
+                    buffer = m_buffer.data();
+                }
                 m_current = reinterpret_cast<IEventLogger::EventHeader*>(buffer + sizeof(m_logHeader));
                 UpdateThreadId();
                 return true;
@@ -77,6 +93,43 @@ namespace V::Debug {
         return false;
     }
 
+    bool EventLogReader::DecompressChunks(const uint8_t* source, size_t sourceSize)
+    {
+        m_buffer.clear();
+        m_buffer.insert(m_buffer.end(), source, source + sizeof(IEventLogger::LogHeader));
+
+        size_t offset = sizeof(IEventLogger::LogHeader);
+        while (offset + sizeof(IEventLogger::ChunkHeader) <= sourceSize)
+        {
+            IEventLogger::ChunkHeader chunk;
+            memcpy(&chunk, source + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+            if (offset + chunk.CompressedSize > sourceSize)
+            {
+                V_Warning("EventLogReader", false, "Event log is truncated, ignoring the last chunk.");
+                break;
+            }
+
+            const size_t writeOffset = m_buffer.size();
+            m_buffer.resize_no_construct(writeOffset + chunk.UncompressedSize);
+            if (chunk.CompressedSize == chunk.UncompressedSize)
+            {
+                memcpy(m_buffer.data() + writeOffset, source + offset, chunk.CompressedSize);
+            }
+            else
+            {
+                size_t result = ZSTD_decompress(m_buffer.data() + writeOffset, chunk.UncompressedSize, source + offset, chunk.CompressedSize);
+                if (ZSTD_isError(result) || result != chunk.UncompressedSize)
+                {
+                    V_Warning("EventLogReader", false, "Unable to decompress event log chunk: %s", ZSTD_getErrorName(result));
+                    return false;
+                }
+            }
+            offset += chunk.CompressedSize;
+        }
+        return m_buffer.size() > sizeof(IEventLogger::LogHeader);
+    }
+
     void EventLogReader::UpdateThreadId()
     {
         if (GetEventName() == PrologEventHash)
@@ -104,6 +157,23 @@ namespace V::Debug {
         {
             m_threadDataBlocks.back()->Reset(nullptr);
         }
+
+        while (ThreadData* data = m_freeBlocks.pop())
+        {
+            delete data;
+        }
+
+        if (m_compressionContext)
+        {
+            ZSTD_freeCCtx(m_compressionContext);
+            m_compressionContext = nullptr;
+        }
+    }
+
+    void LocalFileEventLogger::SetCompressionLevel(int level)
+    {
+        V_Assert(!m_file.IsOpen(), "The compression level of the event logger can only be changed before it's started.");
+        m_compressionLevel = level;
     }
 
     bool LocalFileEventLogger::Start(const V::IO::Path& filePath)
@@ -113,8 +183,15 @@ namespace V::Debug {
         VStd::scoped_lock lock(m_fileGuard);
         if (m_file.Open(filePath.c_str(), SystemFile::SF_OPEN_WRITE_ONLY | SystemFile::SF_OPEN_CREATE | SystemFile::SF_OPEN_CREATE_PATH))
         {
+            // every chunk gets a header, even uncompressed, so readers can find the chunks without walking the events
             LogHeader defaultHeader;
+            defaultHeader.MajorVersion = ChunkedMajorVersion;
+            if (m_compressionLevel > 0 && !m_compressionContext)
+            {
+                m_compressionContext = ZSTD_createCCtx();
+            }
             m_file.Write(&defaultHeader, sizeof(LogHeader));
+            StartFlusher();
             return true;
         }
         return false;
@@ -161,19 +238,21 @@ namespace V::Debug {
     void LocalFileEventLogger::Stop()
     {
         Flush();
+        StopFlusher();
         m_file.Close();
     }
 
     void LocalFileEventLogger::Flush()
     {
         // Create new storage for a thread to write to. This will replace the storage already on the thread
-        // so it can continue to write and is not blocked during a flush. The data that was swapped in can
-        // then again be used for the next thread.
-        ThreadData* replacementData = new ThreadData();
-        bool flushedThread[MaxThreadCount] = {};
+        // so it can continue to write and is not blocked during a flush. The data that was swapped out is
+        // handed to the flusher which recycles it once it has been written.
+        ThreadData* replacementData = AcquireThreadData(0);
+        VStd::vector<bool> flushedThread;
 
         {
             VStd::scoped_lock fileGuardLock(m_fileGuard);
+            flushedThread.resize(m_threadDataBlocks.size(), false);
             bool allFlushed;
             do
             {
@@ -198,9 +277,10 @@ namespace V::Debug {
                         continue;
                     }
 
-                    // ensure the thread ID propagates after the exchange
-                    replacementData->ThreadId = threadData->ThreadId;
-                    if (!thread->Data.compare_exchange_strong(threadData, replacementData))
+                    // Take the buffer the same way the owning thread does when it records, it waits for the
+                    // replacement in RecordEventBegin. The buffer is then numbered before the thread can fill
+                    // and hand over the replacement.
+                    if (!thread->Data.compare_exchange_strong(threadData, nullptr))
                     {
                         // Since no other flush can reach this point due to the lock, failing this means
                         // that between looking up the address for the data and the swap the owning thread
@@ -210,35 +290,47 @@ namespace V::Debug {
                         continue;
                     }
 
-                    {
-                        VStd::scoped_lock fileWriteGuardLock(m_fileWriteGuard);
-                        WriteCacheToDisk(*threadData);
-                    }
-                    replacementData = threadData;
+                    thread->StampChunk(*threadData);
+                    replacementData->ThreadId = threadData->ThreadId;
+                    thread->Data.store(replacementData, VStd::memory_order_release);
+
+                    QueueForWrite(threadData);
+                    replacementData = AcquireThreadData(0);
                     flushedThread[i] = true;
                 }
             } while (!allFlushed);
-            m_file.Flush();
         }
 
-        delete replacementData;
+        RecycleThreadData(replacementData);
+
+        WaitForPendingWrites();
+        VStd::scoped_lock fileWriteGuardLock(m_fileWriteGuard);
+        m_file.Flush();
     }
 
     void* LocalFileEventLogger::RecordEventBegin(EventNameHash id, uint16_t size, uint16_t flags)
     {
         ThreadStorage& threadStorage = GetThreadStorage();
-        ThreadData* threadData = threadStorage.Data;
+        ThreadData* threadData = threadStorage.Data.load(VStd::memory_order_acquire);
 
-        // Set to nullptr so other threads doing a flush can't pick this up.
-        while (!threadStorage.Data.compare_exchange_strong(threadData, nullptr))
+        // Set to nullptr so other threads doing a flush can't pick this up. It's already nullptr while a flush
+        // swaps the buffer, wait for the replacement then.
+        while (!threadData || !threadStorage.Data.compare_exchange_weak(threadData, nullptr, VStd::memory_order_acquire))
         {
+            if (!threadData)
+            {
+                threadData = threadStorage.Data.load(VStd::memory_order_acquire);
+            }
         }
 
         uint32_t writeSize = V_SIZE_ALIGN_UP(sizeof(EventHeader) + size, EventBoundary);
         if (threadData->UsedBytes + writeSize >= ThreadData::BufferSize)
         {
-            VStd::scoped_lock lock(m_fileWriteGuard);
-            WriteCacheToDisk(*threadData);
+            // swap in an empty buffer and let the flusher write the full one
+            const uint64_t threadId = threadData->ThreadId;
+            threadStorage.StampChunk(*threadData);
+            QueueForWrite(threadData);
+            threadData = AcquireThreadData(threadId);
         }
 
         char* eventBuffer = (threadData->Buffer + threadData->UsedBytes);
@@ -282,6 +374,192 @@ namespace V::Debug {
         RecordEventEnd();
     }
 
+    LocalFileEventLogger::ThreadData* LocalFileEventLogger::AcquireThreadData(uint64_t threadId)
+    {
+        // Deliberately using system memory instead of regular allocators. If debug allocators
+        // are available in the future those should be used instead.
+        ThreadData* data = m_freeBlocks.pop();
+        if (data)
+        {
+            m_freeCount.fetch_sub(1, VStd::memory_order_relaxed);
+        }
+        else
+        {
+            data = new ThreadData();
+        }
+        data->ThreadId = threadId;
+        data->UsedBytes = sizeof(Prolog);
+        data->LastChunk = false;
+        return data;
+    }
+
+    void LocalFileEventLogger::RecycleThreadData(ThreadData* threadData)
+    {
+        if (m_freeCount.fetch_add(1, VStd::memory_order_relaxed) < MaxFreeBlocks)
+        {
+            m_freeBlocks.push(*threadData);
+        }
+        else
+        {
+            m_freeCount.fetch_sub(1, VStd::memory_order_relaxed);
+            delete threadData;
+        }
+    }
+
+    void LocalFileEventLogger::QueueForWrite(ThreadData* threadData)
+    {
+        // Announce the push before checking the flusher. Either StopFlusher sees this producer and waits for the push
+        // before its final drain, or the producer sees the flusher stopped and writes the buffer itself.
+        m_queueingCount.fetch_add(1, VStd::memory_order_seq_cst);
+        const bool useFlusher = m_flusherRunning.load(VStd::memory_order_seq_cst) &&
+            m_submittedCount.load(VStd::memory_order_relaxed) - m_writtenCount.load(VStd::memory_order_relaxed) < MaxPendingBlocks;
+        m_submittedCount.fetch_add(1, VStd::memory_order_acq_rel);
+        if (useFlusher)
+        {
+            m_pendingBlocks.push(*threadData);
+            m_queueingCount.fetch_sub(1, VStd::memory_order_release);
+            SignalFlusher();
+            return;
+        }
+        m_queueingCount.fetch_sub(1, VStd::memory_order_release);
+
+        // goes through the same ordering as the queued buffers, it waits there if one before it is still in flight
+        VStd::scoped_lock lock(m_fileWriteGuard);
+        m_writeBatch.push_back(threadData);
+        WritePendingBlocks();
+    }
+
+    void LocalFileEventLogger::SignalFlusher()
+    {
+        // only the first producer after the flusher woke up has to pay for the semaphore
+        if (!m_flusherSignaled.exchange(true, VStd::memory_order_acq_rel))
+        {
+            m_flusherWakeUp.release();
+        }
+    }
+
+    void LocalFileEventLogger::WaitForPendingWrites()
+    {
+        if (!m_flusherRunning.load(VStd::memory_order_acquire))
+        {
+            return;
+        }
+
+        const uint64_t target = m_submittedCount.load(VStd::memory_order_acquire);
+        SignalFlusher();
+        VStd::unique_lock<VStd::mutex> lock(m_writtenMutex);
+        m_writtenCondition.wait(lock, [this, target]()
+            {
+                return m_writtenCount.load(VStd::memory_order_acquire) >= target || !m_flusherRunning.load(VStd::memory_order_acquire);
+            });
+    }
+
+    void LocalFileEventLogger::StartFlusher()
+    {
+        if (m_flusherRunning.exchange(true))
+        {
+            return;
+        }
+
+        VStd::thread_desc desc;
+        desc.m_name = "Event Logger Flusher";
+        m_flusherThread = VStd::thread(desc, [this]()
+            {
+                FlusherMain();
+            });
+    }
+
+    void LocalFileEventLogger::StopFlusher()
+    {
+        if (!m_flusherRunning.exchange(false, VStd::memory_order_seq_cst))
+        {
+            return;
+        }
+
+        // producers that saw the flusher running finish their push, the ones coming after write their buffers themselves
+        while (m_queueingCount.load(VStd::memory_order_acquire) != 0)
+        {
+            VStd::this_thread::yield();
+        }
+
+        m_flusherWakeUp.release();
+        m_flusherThread.join();
+
+        // pick up anything that was queued while the flusher was shutting down
+        {
+            VStd::scoped_lock lock(m_fileWriteGuard);
+            WritePendingBlocks();
+        }
+        m_writtenCondition.notify_all();
+    }
+
+    void LocalFileEventLogger::FlusherMain()
+    {
+        bool running = true;
+        while (running)
+        {
+            m_flusherWakeUp.acquire();
+            // clear the signal before draining so producers pushing from here on wake us up again
+            m_flusherSignaled.store(false, VStd::memory_order_release);
+            running = m_flusherRunning.load(VStd::memory_order_acquire);
+
+            VStd::scoped_lock lock(m_fileWriteGuard);
+            WritePendingBlocks();
+        }
+    }
+
+    void LocalFileEventLogger::WritePendingBlocks()
+    {
+        // popped under the write guard, so a producer writing its own buffer can't get ahead of an older queued one
+        while (ThreadData* data = m_pendingBlocks.pop())
+        {
+            m_writeBatch.push_back(data);
+        }
+        if (m_writeBatch.empty())
+        {
+            return;
+        }
+
+        // The stack hands blocks back in reverse and a thread handing over a block can be preempted before its push,
+        // so order the blocks of each thread and keep the ones whose predecessor hasn't arrived for a later batch.
+        VStd::sort(m_writeBatch.begin(), m_writeBatch.end(), [](const ThreadData* lhs, const ThreadData* rhs)
+            {
+                return lhs->StreamId < rhs->StreamId || (lhs->StreamId == rhs->StreamId && lhs->Sequence < rhs->Sequence);
+            });
+
+        size_t heldCount = 0;
+        uint64_t writtenCount = 0;
+        for (ThreadData* data : m_writeBatch)
+        {
+            auto nextSequence = m_nextWriteSequence.try_emplace(data->StreamId, 0).first;
+            if (data->Sequence != nextSequence->second)
+            {
+                m_writeBatch[heldCount++] = data;
+                continue;
+            }
+
+            if (data->UsedBytes > sizeof(Prolog))
+            {
+                WriteCacheToDisk(*data);
+            }
+            nextSequence->second = data->Sequence + 1;
+            if (data->LastChunk)
+            {
+                m_nextWriteSequence.erase(nextSequence);
+            }
+            RecycleThreadData(data);
+            ++writtenCount;
+        }
+        m_writeBatch.resize(heldCount);
+
+        {
+            // count a batch as written only once all of it is on disk, see WaitForPendingWrites
+            VStd::scoped_lock lock(m_writtenMutex);
+            m_writtenCount.fetch_add(writtenCount, VStd::memory_order_acq_rel);
+        }
+        m_writtenCondition.notify_all();
+    }
+
     void LocalFileEventLogger::WriteCacheToDisk(ThreadData& threadData)
     {
         // ensure the front loaded prolog is accurate, ThreadData objects
@@ -292,7 +570,29 @@ namespace V::Debug {
         prologHeader->Flags = 0; // unused in the prolog
         prologHeader->ThreadId = threadData.ThreadId;
 
-        m_file.Write(threadData.Buffer, threadData.UsedBytes);
+        // uncompressed and incompressible chunks are stored as is
+        ChunkHeader chunk;
+        chunk.UncompressedSize = threadData.UsedBytes;
+        chunk.CompressedSize = threadData.UsedBytes;
+        const char* payload = threadData.Buffer;
+        if (m_compressionContext && m_compressionLevel > 0)
+        {
+            const size_t bound = ZSTD_compressBound(threadData.UsedBytes);
+            if (m_compressionBuffer.size() < bound)
+            {
+                m_compressionBuffer.resize_no_construct(bound);
+            }
+
+            size_t result = ZSTD_compressCCtx(m_compressionContext, m_compressionBuffer.data(), bound,
+                threadData.Buffer, threadData.UsedBytes, m_compressionLevel);
+            if (!ZSTD_isError(result) && result < threadData.UsedBytes)
+            {
+                chunk.CompressedSize = static_cast<uint32_t>(result);
+                payload = m_compressionBuffer.data();
+            }
+        }
+        m_file.Write(&chunk, sizeof(chunk));
+        m_file.Write(payload, chunk.CompressedSize);
         threadData.UsedBytes = sizeof(Prolog); // keep enough room for the next chunk's prolog
     }
 
@@ -323,34 +623,40 @@ namespace V::Debug {
         {
             VStd::scoped_lock guard(Owner->m_fileGuard);
 
-            // Save to access thread data because of the lock.
+            // Save to access thread data because of the lock. The last buffer is queued even when it's empty,
+            // it tells the writer that no more buffers come from this storage.
             ThreadData* data = Data;
-            if (data->UsedBytes > 0)
+            if (data)
             {
-                Owner->WriteCacheToDisk(*data);
+                StampChunk(*data);
+                data->LastChunk = true;
+                Owner->QueueForWrite(data);
             }
+            Data = nullptr;
 
             auto it = VStd::find(Owner->m_threadDataBlocks.begin(), Owner->m_threadDataBlocks.end(), this);
             if (it != Owner->m_threadDataBlocks.end())
             {
                 Owner->m_threadDataBlocks.erase(it);
             }
-
-            delete data;
         }
 
         Owner = owner;
 
         if (Owner)
         {
-            // Deliberately using system memory instead of regular allocators. If debug allocators
-            // are available in the future those should be used instead.
-            ThreadData* data = new ThreadData();
-            data->ThreadId = vlossy_caster(VStd::hash<VStd::thread_id>{}(VStd::this_thread::get_id()));
-            Data = data;
+            StreamId = Owner->m_nextStreamId.fetch_add(1, VStd::memory_order_relaxed);
+            NextSequence = 0;
+            Data = Owner->AcquireThreadData(vlossy_caster(VStd::hash<VStd::thread_id>{}(VStd::this_thread::get_id())));
 
             VStd::scoped_lock guard(Owner->m_fileGuard);
             Owner->m_threadDataBlocks.push_back(this);
         }
     }
-} // namespace V::Debug
\ No newline at end of file
+
+    void LocalFileEventLogger::ThreadStorage::StampChunk(ThreadData& data)
+    {
+        data.StreamId = StreamId;
+        data.Sequence = NextSequence++;
+    }
+} // namespace V::Debug
@@ -6,12 +6,18 @@
 #include <vcore/interface/interface.h>
 #include <vcore/io/path/path.h>
 #include <vcore/io/system_file.h>
-#include <vcore/std/containers/fixed_vector.h>
+#include <vcore/std/containers/unordered_map.h>
 #include <vcore/std/containers/vector.h>
 #include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/condition_variable.h>
 #include <vcore/std/parallel/mutex.h>
+#include <vcore/std/parallel/semaphore.h>
+#include <vcore/std/parallel/thread.h>
+#include <vcore/std/parallel/containers/lock_free_intrusive_stamped_stack.h>
 #include <vcore/std/string/string_view.h>
 
+struct ZSTD_CCtx_s;
+
 namespace V::Debug
 {
     class EventLogReader
@@ -36,6 +42,7 @@ namespace V::Debug
 
     private:
         void UpdateThreadId();
+        bool DecompressChunks(const uint8_t* source, size_t sourceSize);
 
         VStd::vector<uint8_t> m_buffer;
         IEventLogger::LogHeader m_logHeader;
@@ -45,14 +52,25 @@ namespace V::Debug
     };
 
 
+    //! Event logger that writes the thread local event buffers to a file.
+    //! Recording threads never touch the file: a full buffer is handed to a background flusher thread through
+    //! a lock-free stack and the thread continues on a spare buffer, so the recording cost stays a memcpy
+    //! even while the disk is busy. Threads register on their first event, there is no limit on their number.
+    //! Every buffer is numbered within its thread when it's taken from the thread, and the writer holds a buffer
+    //! back until the ones before it are written, so the chunks of a thread reach the file in order however the
+    //! threads handing them over are scheduled.
+    //! When the flusher falls MaxPendingBlocks behind, or once it's stopped, threads write their buffers themselves,
+    //! which bounds the memory held by queued buffers. At most MaxFreeBlocks spare buffers are kept for reuse.
     class LocalFileEventLogger
         : public Interface<IEventLogger>::Registrar
     {
     public:
-        inline static constexpr size_t MaxThreadCount = 512;
-
         ~LocalFileEventLogger() override;
 
+        //! Enables zstd compression of every flushed chunk. Has to be called before Start.
+        //! @param level zstd compression level, 0 disables compression.
+        void SetCompressionLevel(int level);
+
         bool Start(const V::IO::Path& filePath);
         bool Start(VStd::string_view outputPath, VStd::string_view fileNameHint);
         void Stop();
@@ -64,15 +82,25 @@ namespace V::Debug
 
         void  RecordStringEvent(EventNameHash id, VStd::string_view text, uint16_t flags = 0) override;
 
+        //! Buffers that can wait for the flusher before recording threads write their own.
+        static constexpr uint64_t MaxPendingBlocks = 64;
+        //! Written buffers kept for reuse, the ones past this are freed.
+        static constexpr uint32_t MaxFreeBlocks = 16;
+
     protected:
         struct ThreadData
+            : public VStd::lock_free_intrusive_stack_node<ThreadData>
         {
             // ensure there is enough room for one large event with header + prolog
             static constexpr size_t BufferSize = VStd::numeric_limits<decltype(EventHeader::Size)>::max() + sizeof(EventHeader) + sizeof(Prolog);
             char Buffer[BufferSize]{ 0 };
             uint64_t ThreadId{ 0 };
+            uint64_t StreamId{ 0 }; // the ThreadStorage the buffer was taken from
+            uint64_t Sequence{ 0 }; // position of the buffer among the buffers taken from its ThreadStorage
             uint32_t UsedBytes{ sizeof(Prolog) }; // always front load the buffer with a prolog
+            bool LastChunk{ false }; // the ThreadStorage was reset, no buffer follows this one
         };
+        using ThreadDataStack = VStd::lock_free_intrusive_stamped_stack<ThreadData, VStd::lock_free_intrusive_stack_base_hook<ThreadData>>;
 
         struct ThreadStorage
         {
@@ -80,17 +108,64 @@ namespace V::Debug
             ~ThreadStorage();
 
             void Reset(LocalFileEventLogger* owner);
+            //! Numbers a buffer taken out of Data. Only called by whoever swapped Data to nullptr, which is the
+            //! owning thread while it records and Flush while it swaps the buffer.
+            void StampChunk(ThreadData& data);
 
+            // nullptr while the owning thread records an event or Flush swaps the buffer
             VStd::atomic<ThreadData*> Data{ nullptr };
             ThreadData* PendingData{ nullptr };
             LocalFileEventLogger* Owner{ nullptr };
+            uint64_t StreamId{ 0 };
+            uint64_t NextSequence{ 0 };
         };
 
+        //! Hands a filled buffer to the flusher, or writes it directly if the flusher isn't running.
+        //! Ownership of the buffer moves to the logger.
+        void QueueForWrite(ThreadData* threadData);
+        //! Returns a recycled or new empty buffer for the given thread.
+        ThreadData* AcquireThreadData(uint64_t threadId);
+        //! Keeps a written buffer for reuse, or frees it if there are enough spare buffers.
+        void RecycleThreadData(ThreadData* threadData);
+        void SignalFlusher();
+        //! Blocks until every buffer submitted so far has been written.
+        void WaitForPendingWrites();
+
+        void StartFlusher();
+        void StopFlusher();
+        void FlusherMain();
+        //! Writes the queued buffers whose predecessors are written, the others wait for a later call.
+        //! m_fileWriteGuard has to be held.
+        void WritePendingBlocks();
+
         void WriteCacheToDisk(ThreadData& threadData);
 
         ThreadStorage& GetThreadStorage();
 
-        VStd::fixed_vector<ThreadStorage*, MaxThreadCount> m_threadDataBlocks;
+        VStd::vector<ThreadStorage*> m_threadDataBlocks;
+
+        ThreadDataStack m_pendingBlocks;
+        ThreadDataStack m_freeBlocks;
+        VStd::atomic<uint32_t> m_freeCount{ 0 };
+        // producers between checking m_flusherRunning and pushing their buffer, StopFlusher waits for them
+        VStd::atomic<uint32_t> m_queueingCount{ 0 };
+        VStd::atomic<uint64_t> m_submittedCount{ 0 };
+        VStd::atomic<uint64_t> m_writtenCount{ 0 };
+        VStd::atomic<uint64_t> m_nextStreamId{ 1 };
+        VStd::atomic_bool m_flusherSignaled{ false };
+        VStd::atomic_bool m_flusherRunning{ false };
+        VStd::semaphore m_flusherWakeUp;
+        VStd::thread m_flusherThread;
+        VStd::mutex m_writtenMutex;
+        VStd::condition_variable m_writtenCondition;
+
+        int m_compressionLevel{ 0 };
+        VStd::vector<char> m_compressionBuffer;
+        // blocks taken off m_pendingBlocks and waiting to be written, guarded by m_fileWriteGuard
+        VStd::vector<ThreadData*> m_writeBatch;
+        // sequence of the next block to write for every thread storage with blocks in flight, guarded by m_fileWriteGuard
+        VStd::unordered_map<uint64_t, uint64_t> m_nextWriteSequence;
+        ZSTD_CCtx_s* m_compressionContext{ nullptr };
 
         V::IO::SystemFile m_file;
         VStd::recursive_mutex m_fileGuard;
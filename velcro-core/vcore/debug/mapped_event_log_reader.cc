@@ -0,0 +1,601 @@
+#include <vcore/debug/mapped_event_log_reader.h>
+#include <vcore/io/system_file.h>
+#include <vcore/std/algorithm.h>
+
+#include <zstd.h>
+
+namespace V::Debug
+{
+    namespace MappedEventLogReaderInternal
+    {
+        // Layout of an index file: the header, ChunkCount IndexedChunks, then EventNameCount lists made of the
+        // name hash, the number of chunks and their sorted indices, all as uint32_t.
+        struct IndexHeader
+        {
+            int8_t V4CC[4]{ 'V', 'O', 'E', 'I' };
+            uint32_t Version{ 1 };
+            uint64_t LogSize{ 0 };
+            uint64_t ChunkCount{ 0 };
+            uint64_t EventNameCount{ 0 };
+            uint32_t HasTimestamps{ 0 };
+            uint32_t Padding{ 0 };
+        };
+
+        struct IndexedChunk
+        {
+            uint64_t Offset;
+            uint64_t StoredSize;
+            uint64_t Size;
+            uint64_t ThreadId;
+            uint64_t FirstTimestamp;
+            uint64_t LastTimestamp;
+            uint32_t EventCount;
+            uint32_t Compressed;
+        };
+    } // namespace MappedEventLogReaderInternal
+
+    bool MappedEventLogReader::ReadLog(const char* filePath, TimestampExtractor timestampExtractor)
+    {
+        Close();
+
+        if (!m_file.Open(filePath) || m_file.Size() < sizeof(IEventLogger::LogHeader))
+        {
+            m_file.Close();
+            return false;
+        }
+        m_timestampExtractor = VStd::move(timestampExtractor);
+
+        const uint8_t* data = m_file.Data();
+        const uint64_t fileSize = m_file.Size();
+        memcpy(&m_logHeader, data, sizeof(m_logHeader));
+        if (m_logHeader.MajorVersion > IEventLogger::ChunkedMajorVersion)
+        {
+            V_Warning("MappedEventLogReader", false, "Event log version %u isn't supported.", m_logHeader.MajorVersion);
+            m_file.Close();
+            return false;
+        }
+
+        uint64_t offset = sizeof(IEventLogger::LogHeader);
+        if (m_logHeader.MajorVersion == IEventLogger::ChunkedMajorVersion)
+        {
+            // Every chunk is preceded by its size, so only the chunk headers are touched to find them.
+            while (offset + sizeof(IEventLogger::ChunkHeader) <= fileSize)
+            {
+                IEventLogger::ChunkHeader header;
+                memcpy(&header, data + offset, sizeof(header));
+                offset += sizeof(header);
+                if (header.CompressedSize > fileSize - offset)
+                {
+                    V_Warning("MappedEventLogReader", false, "Event log is truncated, ignoring the last chunk.");
+                    break;
+                }
+
+                ChunkInfo& chunk = m_chunks.emplace_back();
+                chunk.Offset = offset;
+                chunk.StoredSize = header.CompressedSize;
+                chunk.Size = header.UncompressedSize;
+                chunk.Compressed = header.CompressedSize != header.UncompressedSize;
+                offset += header.CompressedSize;
+            }
+        }
+        else
+        {
+            // Version 1 chunks aren't delimited, but every chunk starts with a prolog event.
+            while (offset + sizeof(IEventLogger::EventHeader) <= fileSize)
+            {
+                const auto* event = reinterpret_cast<const IEventLogger::EventHeader*>(data + offset);
+                if (event->EventId == PrologEventHash || m_chunks.empty())
+                {
+                    if (!m_chunks.empty())
+                    {
+                        ChunkInfo& previous = m_chunks.back();
+                        previous.Size = previous.StoredSize = offset - previous.Offset;
+                    }
+                    m_chunks.emplace_back().Offset = offset;
+                }
+                offset += V_SIZE_ALIGN_UP(sizeof(IEventLogger::EventHeader) + event->Size, EventBoundary);
+            }
+            if (!m_chunks.empty())
+            {
+                ChunkInfo& last = m_chunks.back();
+                last.Size = last.StoredSize = VStd::min(offset, fileSize) - last.Offset;
+            }
+        }
+
+        Rewind();
+        return !m_chunks.empty();
+    }
+
+    void MappedEventLogReader::Close()
+    {
+        m_file.Close();
+        m_timestampExtractor = {};
+        m_chunks.clear();
+        m_chunksByThread.clear();
+        m_chunksByEventName.clear();
+        m_candidates.clear();
+        m_candidate = 0;
+        m_scratch.clear();
+        m_chunkBegin = nullptr;
+        m_chunkEnd = nullptr;
+        m_current = nullptr;
+        m_currentChunk = 0;
+        m_indexed = false;
+    }
+
+    void MappedEventLogReader::FilterThread(uint64_t threadId)
+    {
+        m_filterThreadId = threadId;
+        m_filterByThread = true;
+    }
+
+    void MappedEventLogReader::FilterEventName(EventNameHash eventName)
+    {
+        m_filterEventName = eventName;
+        m_filterByEventName = true;
+    }
+
+    void MappedEventLogReader::FilterTimeRange(uint64_t begin, uint64_t end)
+    {
+        V_Warning("MappedEventLogReader", static_cast<bool>(m_timestampExtractor), "Filtering by time requires a timestamp extractor, no events will be found.");
+        m_filterTimeBegin = begin;
+        m_filterTimeEnd = end;
+        m_filterByTime = true;
+    }
+
+    void MappedEventLogReader::ClearFilters()
+    {
+        m_filterByThread = false;
+        m_filterByEventName = false;
+        m_filterByTime = false;
+    }
+
+    bool MappedEventLogReader::Rewind()
+    {
+        if (HasFilters() && !BuildIndex())
+        {
+            return false;
+        }
+
+        m_candidates.clear();
+        m_candidate = 0;
+        m_current = nullptr;
+
+        // Start from the smallest index list that applies and check the remaining filters per chunk.
+        const VStd::vector<uint32_t>* source = nullptr;
+        if (m_filterByThread)
+        {
+            auto it = m_chunksByThread.find(m_filterThreadId);
+            if (it == m_chunksByThread.end())
+            {
+                return false;
+            }
+            source = &it->second;
+        }
+        if (m_filterByEventName)
+        {
+            auto it = m_chunksByEventName.find(m_filterEventName.GetHash());
+            if (it == m_chunksByEventName.end())
+            {
+                return false;
+            }
+            if (!source || it->second.size() < source->size())
+            {
+                source = &it->second;
+            }
+        }
+
+        if (source)
+        {
+            for (uint32_t chunkIndex : *source)
+            {
+                if (ChunkMatches(m_chunks[chunkIndex]))
+                {
+                    m_candidates.push_back(chunkIndex);
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t chunkIndex = 0; chunkIndex < m_chunks.size(); ++chunkIndex)
+            {
+                if (ChunkMatches(m_chunks[chunkIndex]))
+                {
+                    m_candidates.push_back(chunkIndex);
+                }
+            }
+        }
+
+        if (m_candidates.empty() || !LoadChunk(m_candidates[0]))
+        {
+            return false;
+        }
+        return FindMatch();
+    }
+
+    bool MappedEventLogReader::Next()
+    {
+        if (!m_current)
+        {
+            return false;
+        }
+        Advance();
+        return FindMatch();
+    }
+
+    EventNameHash MappedEventLogReader::GetEventName() const
+    {
+        return m_current->EventId;
+    }
+
+    uint16_t MappedEventLogReader::GetEventSize() const
+    {
+        return m_current->Size;
+    }
+
+    uint16_t MappedEventLogReader::GetEventFlags() const
+    {
+        return m_current->Flags;
+    }
+
+    uint64_t MappedEventLogReader::GetThreadId() const
+    {
+        return m_chunks[m_currentChunk].ThreadId;
+    }
+
+    VStd::string_view MappedEventLogReader::GetString() const
+    {
+        return VStd::string_view(reinterpret_cast<const char*>(m_current + 1), m_current->Size);
+    }
+
+    auto MappedEventLogReader::GetChunks() const -> const VStd::vector<ChunkInfo>&
+    {
+        return m_chunks;
+    }
+
+    size_t MappedEventLogReader::GetCurrentChunk() const
+    {
+        return m_currentChunk;
+    }
+
+    bool MappedEventLogReader::SeekChunk(size_t chunkIndex)
+    {
+        if (HasFilters() && !BuildIndex())
+        {
+            return false;
+        }
+
+        m_candidates.clear();
+        m_candidate = 0;
+        m_current = nullptr;
+        if (chunkIndex >= m_chunks.size())
+        {
+            return false;
+        }
+
+        m_candidates.push_back(v_numeric_cast<uint32_t>(chunkIndex));
+        for (uint32_t i = v_numeric_cast<uint32_t>(chunkIndex) + 1; i < m_chunks.size(); ++i)
+        {
+            if (ChunkMatches(m_chunks[i]))
+            {
+                m_candidates.push_back(i);
+            }
+        }
+        return LoadChunk(chunkIndex) && FindMatch();
+    }
+
+    bool MappedEventLogReader::BuildIndex()
+    {
+        if (m_indexed)
+        {
+            return true;
+        }
+
+        // Indexing moves through the chunks, so the iteration has to be restarted afterwards.
+        m_candidates.clear();
+        m_candidate = 0;
+        for (uint32_t i = 0; i < m_chunks.size(); ++i)
+        {
+            if (!IndexChunk(i))
+            {
+                m_chunksByThread.clear();
+                m_chunksByEventName.clear();
+                m_current = nullptr;
+                return false;
+            }
+        }
+        m_current = nullptr;
+        m_indexed = true;
+        return true;
+    }
+
+    bool MappedEventLogReader::IsIndexed() const
+    {
+        return m_indexed;
+    }
+
+    bool MappedEventLogReader::SaveIndex(const char* indexPath)
+    {
+        using namespace MappedEventLogReaderInternal;
+        using namespace V::IO;
+
+        if (!BuildIndex())
+        {
+            return false;
+        }
+
+        SystemFile file;
+        if (!file.Open(indexPath, SystemFile::SF_OPEN_WRITE_ONLY | SystemFile::SF_OPEN_CREATE | SystemFile::SF_OPEN_CREATE_PATH))
+        {
+            return false;
+        }
+
+        IndexHeader header;
+        header.LogSize = m_file.Size();
+        header.ChunkCount = m_chunks.size();
+        header.EventNameCount = m_chunksByEventName.size();
+        header.HasTimestamps = m_timestampExtractor ? 1 : 0;
+        bool result = file.Write(&header, sizeof(header)) == sizeof(header);
+
+        for (const ChunkInfo& chunk : m_chunks)
+        {
+            IndexedChunk indexed{ chunk.Offset, chunk.StoredSize, chunk.Size, chunk.ThreadId, chunk.FirstTimestamp,
+                chunk.LastTimestamp, chunk.EventCount, chunk.Compressed ? 1u : 0u };
+            result = result && file.Write(&indexed, sizeof(indexed)) == sizeof(indexed);
+        }
+        for (const auto& [nameHash, chunks] : m_chunksByEventName)
+        {
+            const uint32_t list[2] = { nameHash, v_numeric_cast<uint32_t>(chunks.size()) };
+            const SystemFile::SizeType listSize = chunks.size() * sizeof(uint32_t);
+            result = result && file.Write(list, sizeof(list)) == sizeof(list);
+            result = result && file.Write(chunks.data(), listSize) == listSize;
+        }
+        return result;
+    }
+
+    bool MappedEventLogReader::LoadIndex(const char* indexPath)
+    {
+        using namespace MappedEventLogReaderInternal;
+        using namespace V::IO;
+
+        if (!m_file.IsOpen() || !SystemFile::Exists(indexPath))
+        {
+            return false;
+        }
+
+        VStd::vector<uint8_t> buffer;
+        buffer.resize_no_construct(SystemFile::Length(indexPath));
+        if (buffer.size() < sizeof(IndexHeader) || SystemFile::Read(indexPath, buffer.data(), buffer.size()) != buffer.size())
+        {
+            return false;
+        }
+
+        IndexHeader header;
+        memcpy(&header, buffer.data(), sizeof(header));
+        const IndexHeader expected;
+        if (memcmp(header.V4CC, expected.V4CC, sizeof(header.V4CC)) != 0 || header.Version != expected.Version ||
+            header.LogSize != m_file.Size() || header.ChunkCount != m_chunks.size() ||
+            (m_timestampExtractor && !header.HasTimestamps))
+        {
+            return false;
+        }
+        if ((buffer.size() - sizeof(header)) / sizeof(IndexedChunk) < header.ChunkCount)
+        {
+            V_Warning("MappedEventLogReader", false, "Event log index '%s' is truncated.", indexPath);
+            return false;
+        }
+
+        // Everything is validated before the index is replaced, so a bad file leaves the reader as it was.
+        VStd::unordered_map<uint32_t, VStd::vector<uint32_t>> chunksByEventName;
+        size_t offset = sizeof(header) + header.ChunkCount * sizeof(IndexedChunk);
+        for (uint64_t i = 0; i < header.EventNameCount; ++i)
+        {
+            uint32_t list[2];
+            if (buffer.size() - offset < sizeof(list))
+            {
+                V_Warning("MappedEventLogReader", false, "Event log index '%s' is truncated.", indexPath);
+                return false;
+            }
+            memcpy(list, buffer.data() + offset, sizeof(list));
+            offset += sizeof(list);
+            if ((buffer.size() - offset) / sizeof(uint32_t) < list[1])
+            {
+                V_Warning("MappedEventLogReader", false, "Event log index '%s' is truncated.", indexPath);
+                return false;
+            }
+
+            VStd::vector<uint32_t>& chunks = chunksByEventName[list[0]];
+            chunks.resize_no_construct(list[1]);
+            memcpy(chunks.data(), buffer.data() + offset, list[1] * sizeof(uint32_t));
+            offset += list[1] * sizeof(uint32_t);
+            // ChunkMatches does a binary search on the lists.
+            for (size_t j = 0; j < chunks.size(); ++j)
+            {
+                if (chunks[j] >= m_chunks.size() || (j > 0 && chunks[j - 1] >= chunks[j]))
+                {
+                    V_Warning("MappedEventLogReader", false, "Event log index '%s' is corrupt.", indexPath);
+                    return false;
+                }
+            }
+        }
+
+        const uint8_t* indexedChunks = buffer.data() + sizeof(header);
+        for (size_t i = 0; i < m_chunks.size(); ++i)
+        {
+            IndexedChunk indexed;
+            memcpy(&indexed, indexedChunks + i * sizeof(IndexedChunk), sizeof(indexed));
+            const ChunkInfo& chunk = m_chunks[i];
+            if (indexed.Offset != chunk.Offset || indexed.StoredSize != chunk.StoredSize || indexed.Size != chunk.Size ||
+                (indexed.Compressed != 0) != chunk.Compressed)
+            {
+                return false;
+            }
+        }
+
+        m_chunksByThread.clear();
+        for (uint32_t i = 0; i < m_chunks.size(); ++i)
+        {
+            IndexedChunk indexed;
+            memcpy(&indexed, indexedChunks + i * sizeof(IndexedChunk), sizeof(indexed));
+            ChunkInfo& chunk = m_chunks[i];
+            chunk.ThreadId = indexed.ThreadId;
+            chunk.FirstTimestamp = indexed.FirstTimestamp;
+            chunk.LastTimestamp = indexed.LastTimestamp;
+            chunk.EventCount = indexed.EventCount;
+            m_chunksByThread[chunk.ThreadId].push_back(i);
+        }
+        m_chunksByEventName = VStd::move(chunksByEventName);
+        m_indexed = true;
+        return true;
+    }
+
+    bool MappedEventLogReader::HasFilters() const
+    {
+        return m_filterByThread || m_filterByEventName || m_filterByTime;
+    }
+
+    bool MappedEventLogReader::IndexChunk(uint32_t chunkIndex)
+    {
+        if (!LoadChunk(chunkIndex))
+        {
+            return false;
+        }
+
+        ChunkInfo& chunk = m_chunks[chunkIndex];
+        chunk.EventCount = 0;
+        chunk.FirstTimestamp = VStd::numeric_limits<uint64_t>::max();
+        chunk.LastTimestamp = 0;
+        for (; m_current; Advance())
+        {
+            ++chunk.EventCount;
+            if (m_current->EventId == PrologEventHash)
+            {
+                chunk.ThreadId = reinterpret_cast<const IEventLogger::Prolog*>(m_current)->ThreadId;
+            }
+
+            VStd::vector<uint32_t>& chunksWithName = m_chunksByEventName[m_current->EventId.GetHash()];
+            if (chunksWithName.empty() || chunksWithName.back() != chunkIndex)
+            {
+                chunksWithName.push_back(chunkIndex);
+            }
+
+            uint64_t timestamp;
+            if (m_timestampExtractor && m_timestampExtractor(*this, timestamp))
+            {
+                chunk.FirstTimestamp = VStd::min(chunk.FirstTimestamp, timestamp);
+                chunk.LastTimestamp = VStd::max(chunk.LastTimestamp, timestamp);
+            }
+        }
+        m_chunksByThread[chunk.ThreadId].push_back(chunkIndex);
+        return true;
+    }
+
+    bool MappedEventLogReader::LoadChunk(size_t chunkIndex)
+    {
+        ChunkInfo& chunk = m_chunks[chunkIndex];
+        m_currentChunk = chunkIndex;
+        m_current = nullptr;
+
+        if (chunk.Compressed)
+        {
+            m_scratch.resize_no_construct(chunk.Size);
+            size_t result = ZSTD_decompress(m_scratch.data(), chunk.Size, m_file.Data() + chunk.Offset, chunk.StoredSize);
+            if (ZSTD_isError(result) || result != chunk.Size)
+            {
+                V_Warning("MappedEventLogReader", false, "Unable to decompress event log chunk %zu: %s", chunkIndex, ZSTD_getErrorName(result));
+                return false;
+            }
+            m_chunkBegin = m_scratch.data();
+        }
+        else
+        {
+            m_file.Prefetch(chunk.Offset, chunk.StoredSize);
+            m_chunkBegin = m_file.Data() + chunk.Offset;
+        }
+        m_chunkEnd = m_chunkBegin + chunk.Size;
+
+        if (chunk.Size >= sizeof(IEventLogger::EventHeader))
+        {
+            m_current = reinterpret_cast<const IEventLogger::EventHeader*>(m_chunkBegin);
+            // Every chunk starts with a prolog, so the thread is known before the chunk is indexed.
+            if (m_current->EventId == PrologEventHash)
+            {
+                chunk.ThreadId = reinterpret_cast<const IEventLogger::Prolog*>(m_current)->ThreadId;
+            }
+        }
+        return true;
+    }
+
+    bool MappedEventLogReader::ChunkMatches(const ChunkInfo& chunk) const
+    {
+        if (m_filterByThread && chunk.ThreadId != m_filterThreadId)
+        {
+            return false;
+        }
+        if (m_filterByEventName)
+        {
+            auto it = m_chunksByEventName.find(m_filterEventName.GetHash());
+            const uint32_t chunkIndex = v_numeric_cast<uint32_t>(&chunk - m_chunks.data());
+            if (it == m_chunksByEventName.end() || !VStd::binary_search(it->second.begin(), it->second.end(), chunkIndex))
+            {
+                return false;
+            }
+        }
+        // Chunks without any timestamped events are skipped as well.
+        if (m_filterByTime && (chunk.FirstTimestamp > m_filterTimeEnd || chunk.LastTimestamp < m_filterTimeBegin))
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool MappedEventLogReader::EventMatches() const
+    {
+        if (m_filterByEventName && m_current->EventId != m_filterEventName)
+        {
+            return false;
+        }
+        if (m_filterByTime)
+        {
+            // Events without a timestamp are kept if their chunk overlaps the range.
+            uint64_t timestamp;
+            if (m_timestampExtractor && m_timestampExtractor(*this, timestamp) && (timestamp < m_filterTimeBegin || timestamp > m_filterTimeEnd))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MappedEventLogReader::Advance()
+    {
+        const size_t increment = V_SIZE_ALIGN_UP(sizeof(IEventLogger::EventHeader) + m_current->Size, EventBoundary);
+        const uint8_t* next = reinterpret_cast<const uint8_t*>(m_current) + increment;
+        if (next + sizeof(IEventLogger::EventHeader) <= m_chunkEnd)
+        {
+            m_current = reinterpret_cast<const IEventLogger::EventHeader*>(next);
+        }
+        else
+        {
+            m_current = nullptr;
+        }
+    }
+
+    bool MappedEventLogReader::FindMatch()
+    {
+        for (;;)
+        {
+            for (; m_current; Advance())
+            {
+                if (EventMatches())
+                {
+                    return true;
+                }
+            }
+            if (++m_candidate >= m_candidates.size() || !LoadChunk(m_candidates[m_candidate]))
+            {
+                return false;
+            }
+        }
+    }
+} // namespace V::Debug
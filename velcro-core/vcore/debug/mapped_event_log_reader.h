@@ -0,0 +1,131 @@
+#ifndef V_FRAMEWORK_CORE_DEBUG_MAPPED_EVENT_LOG_READER_H
+#define V_FRAMEWORK_CORE_DEBUG_MAPPED_EVENT_LOG_READER_H
+
+#include <vcore/debug/ievent_logger.h>
+#include <vcore/io/mapped_file.h>
+#include <vcore/std/containers/unordered_map.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/functional.h>
+#include <vcore/std/string/string_view.h>
+
+namespace V::Debug
+{
+    //! Reader for event logs that are too large to load in memory.
+    //! The log is memory mapped and opening it only reads the chunk headers. A sparse index with one entry per chunk
+    //! is built the first time a filter is used: every entry stores the thread the chunk was recorded on and, when a
+    //! timestamp extractor is provided, the time range it covers. The chunks are also indexed by thread and by event
+    //! name. Filters are applied to the index so chunks that can't contain a matching event are skipped without touching
+    //! their pages. Compressed logs are decompressed one chunk at a time while iterating.
+    //! Building the index reads the whole log, SaveIndex stores it next to the log so reopening it only costs LoadIndex.
+    class MappedEventLogReader
+    {
+    public:
+        //! Returns the timestamp of the current event, or false if the event doesn't carry one.
+        //! Events don't have a timestamp of their own, so the user tells the reader which events do.
+        using TimestampExtractor = VStd::function<bool(const MappedEventLogReader& reader, uint64_t& timestamp)>;
+
+        struct ChunkInfo
+        {
+            uint64_t Offset{ 0 };               //!< Offset of the chunk data in the mapped file.
+            uint64_t StoredSize{ 0 };           //!< Size of the chunk in the file.
+            uint64_t Size{ 0 };                 //!< Size of the chunk once decompressed.
+            uint64_t ThreadId{ 0 };
+            uint64_t FirstTimestamp{ VStd::numeric_limits<uint64_t>::max() };
+            uint64_t LastTimestamp{ 0 };
+            uint32_t EventCount{ 0 };
+            bool Compressed{ false };
+        };
+
+        MappedEventLogReader() = default;
+        ~MappedEventLogReader() = default;
+
+        //! Maps the log and locates its chunks from their headers. Version 1 logs don't have chunk headers, they're
+        //! walked event by event instead.
+        bool ReadLog(const char* filePath, TimestampExtractor timestampExtractor = {});
+        void Close();
+
+        //! Limit iteration to events recorded on the given thread.
+        void FilterThread(uint64_t threadId);
+        //! Limit iteration to events with the given name.
+        void FilterEventName(EventNameHash eventName);
+        //! Limit iteration to chunks overlapping the [begin, end] range. Requires a timestamp extractor.
+        void FilterTimeRange(uint64_t begin, uint64_t end);
+        void ClearFilters();
+
+        //! Moves to the first event that passes the filters. Must be called after changing the filters.
+        bool Rewind();
+        //! Moves to the next event that passes the filters.
+        bool Next();
+
+        EventNameHash GetEventName() const;
+        uint16_t GetEventSize() const;
+        uint16_t GetEventFlags() const;
+        uint64_t GetThreadId() const;
+
+        VStd::string_view GetString() const;
+        template<typename T>
+        const T* GetValue() const
+        {
+            V_Assert(sizeof(T) <= m_current->Size, "Attempting to retrieve a value that's larger than the amount of stored data.");
+            return reinterpret_cast<const T*>(m_current + 1);
+        }
+
+        //! Reads every chunk to build the thread, event name and time index. Done on the first Rewind or SeekChunk with
+        //! a filter set, call it up front to pay the cost at a convenient time or to fill in the chunk info.
+        bool BuildIndex();
+        bool IsIndexed() const;
+
+        //! Builds the index if needed and writes it to indexPath, typically the log path with ".idx" appended.
+        bool SaveIndex(const char* indexPath);
+        //! Loads an index written by SaveIndex for the log that's open. Fails, leaving the index to be built, when the
+        //! file doesn't match the chunks of the log or lacks the timestamps the extractor would provide. The
+        //! timestamps are the ones of the extractor used when the index was saved.
+        bool LoadIndex(const char* indexPath);
+
+        //! The thread id, timestamps and event count of the chunks are only filled in once the index is built.
+        const VStd::vector<ChunkInfo>& GetChunks() const;
+        //! Index of the chunk the current event is in.
+        size_t GetCurrentChunk() const;
+        //! Moves to the first event in the given chunk, ignoring the filters for the chunk selection.
+        bool SeekChunk(size_t chunkIndex);
+
+    private:
+        bool HasFilters() const;
+        bool IndexChunk(uint32_t chunkIndex);
+        bool LoadChunk(size_t chunkIndex);
+        bool ChunkMatches(const ChunkInfo& chunk) const;
+        bool EventMatches() const;
+        void Advance();
+        bool FindMatch();
+
+        V::IO::MappedFile m_file;
+        IEventLogger::LogHeader m_logHeader;
+        TimestampExtractor m_timestampExtractor;
+
+        VStd::vector<ChunkInfo> m_chunks;
+        VStd::unordered_map<uint64_t, VStd::vector<uint32_t>> m_chunksByThread;
+        VStd::unordered_map<uint32_t, VStd::vector<uint32_t>> m_chunksByEventName;
+        // Chunks that can contain events passing the current filters, rebuilt by Rewind.
+        VStd::vector<uint32_t> m_candidates;
+        size_t m_candidate{ 0 };
+
+        // Decompression target for compressed chunks.
+        VStd::vector<uint8_t> m_scratch;
+
+        const uint8_t* m_chunkBegin{ nullptr };
+        const uint8_t* m_chunkEnd{ nullptr };
+        const IEventLogger::EventHeader* m_current{ nullptr };
+        size_t m_currentChunk{ 0 };
+        bool m_indexed{ false };
+
+        uint64_t m_filterThreadId{ 0 };
+        uint64_t m_filterTimeBegin{ 0 };
+        uint64_t m_filterTimeEnd{ 0 };
+        EventNameHash m_filterEventName{ "" };
+        bool m_filterByThread{ false };
+        bool m_filterByEventName{ false };
+        bool m_filterByTime{ false };
+    };
+} // namespace V::Debug
+
+#endif // V_FRAMEWORK_CORE_DEBUG_MAPPED_EVENT_LOG_READER_H
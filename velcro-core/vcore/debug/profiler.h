@@ -3,6 +3,7 @@
 
 #include <vcore/debug/budget.h>
 #include <vcore/statistics/statistical_profiler_proxy.h>
+#include <vcore/std/typetraits/is_pointer.h>
 
 #ifdef USE_PIX
 #include <vcore/platform_incl.h>
@@ -35,17 +36,40 @@
 #endif // V_PROFILER_MACRO_DISABLE
 
 #ifndef V_PROFILE_INTERVAL_START
-#define V_PROFILE_INTERVAL_START(...)
-#define V_PROFILE_INTERVAL_START_COLORED(...)
-#define V_PROFILE_INTERVAL_END(...)
+#if defined(V_PROFILER_MACRO_DISABLE)
+    #define V_PROFILE_INTERVAL_START(...)
+    #define V_PROFILE_INTERVAL_START_COLORED(...)
+    #define V_PROFILE_INTERVAL_END(...)
+#else
+    /**
+     * Interval markers may begin and end on different threads, the scopeNameId pairs them up. It can be an integer or
+     * a pointer, usually the object the interval tracks.
+     * format is: V_PROFILE_INTERVAL_START(budget, scopeNameId, const char* formatStr, ...)
+     */
+    #define V_PROFILE_INTERVAL_START(budget, scopeNameId, ...) \
+        ::V::Debug::ProfileScope::BeginInterval(V_BUDGET_GETTER(budget)(), ::V::Debug::ProfileScope::IntervalId(scopeNameId), __VA_ARGS__)
+    #define V_PROFILE_INTERVAL_START_COLORED(budget, scopeNameId, color, ...) V_PROFILE_INTERVAL_START(budget, scopeNameId, __VA_ARGS__)
+    #define V_PROFILE_INTERVAL_END(budget, scopeNameId) \
+        ::V::Debug::ProfileScope::EndInterval(V_BUDGET_GETTER(budget)(), ::V::Debug::ProfileScope::IntervalId(scopeNameId))
+#endif // V_PROFILER_MACRO_DISABLE
 #define V_PROFILE_INTERVAL_SCOPED(budget, scopeNameId, ...) \
     static constexpr V::Crc32 V_JOIN(blockId, __LINE__)(scopeNameId); \
     V::Statistics::StatisticalProfilerProxy::TimedScope V_JOIN(scope, __LINE__)(V_CRC_CE(#budget), V_JOIN(blockId, __LINE__));
 #endif
 
 #ifndef V_PROFILE_DATAPOINT
-#define V_PROFILE_DATAPOINT(...)
-#define V_PROFILE_DATAPOINT_PERCENT(...)
+#if defined(V_PROFILER_MACRO_DISABLE)
+    #define V_PROFILE_DATAPOINT(...)
+    #define V_PROFILE_DATAPOINT_PERCENT(...)
+#else
+    /**
+     * Records a counter sample.
+     * format is: V_PROFILE_DATAPOINT(budget, value, const char* formatStr, ...)
+     */
+    #define V_PROFILE_DATAPOINT(budget, value, ...) \
+        ::V::Debug::ProfileScope::RecordDataPoint(V_BUDGET_GETTER(budget)(), static_cast<double>(value), __VA_ARGS__)
+    #define V_PROFILE_DATAPOINT_PERCENT(budget, value, ...) V_PROFILE_DATAPOINT(budget, (value) * 100.0, __VA_ARGS__)
+#endif // V_PROFILER_MACRO_DISABLE
 #endif
 
 namespace VStd {
@@ -64,6 +88,12 @@ namespace V::Debug {
         // support for the extra macro args (e.g. format strings) will come in a later PR
         virtual void BeginRegion(const Budget* budget, const char* eventName) = 0;
         virtual void EndRegion(const Budget* budget) = 0;
+
+        // intervals and data points are optional, profilers that don't track them can ignore these
+        // their names are formatted into a temporary buffer, copy them if they are kept past the call
+        virtual void BeginInterval([[maybe_unused]] const Budget* budget, [[maybe_unused]] uint64_t intervalId, [[maybe_unused]] const char* eventName) {}
+        virtual void EndInterval([[maybe_unused]] const Budget* budget, [[maybe_unused]] uint64_t intervalId) {}
+        virtual void RecordDataPoint([[maybe_unused]] const Budget* budget, [[maybe_unused]] const char* counterName, [[maybe_unused]] double value) {}
     };
 
     class ProfileScope {
@@ -73,12 +103,31 @@ namespace V::Debug {
 
         static void EndRegion([[maybe_unused]] Budget* budget);
 
+        template<typename... T>
+        static void BeginInterval([[maybe_unused]] Budget* budget, [[maybe_unused]] uint64_t intervalId, [[maybe_unused]] const char* eventName, [[maybe_unused]] T const&... args);
+
+        static void EndInterval([[maybe_unused]] Budget* budget, [[maybe_unused]] uint64_t intervalId);
+
+        template<typename... T>
+        static void RecordDataPoint([[maybe_unused]] Budget* budget, [[maybe_unused]] double value, [[maybe_unused]] const char* counterName, [[maybe_unused]] T const&... args);
+
+        //! Converts the scopeNameId of the interval macros, pointers are used by address.
+        template<typename T>
+        static uint64_t IntervalId(const T& scopeNameId);
+
         template<typename... T>
         ProfileScope(Budget* budget, char const* eventName, T const&... args);
 
         ~ProfileScope();
 
     private:
+        //! Maximum length of a formatted interval or data point name, longer names are truncated.
+        static constexpr size_t MaxFormattedNameLength = 256;
+
+        //! Returns format as is when there are no args, otherwise formats it into buffer.
+        template<size_t N, typename... T>
+        static const char* FormatName(char (&buffer)[N], const char* format, T const&... args);
+
         Budget* m_budget;
     };
 } // V::Debug
@@ -42,6 +42,81 @@ namespace V::Debug
 #endif
     }
 
+    template<typename... T>
+    void ProfileScope::BeginInterval(
+        [[maybe_unused]] Budget* budget, [[maybe_unused]] uint64_t intervalId, [[maybe_unused]] const char* eventName, [[maybe_unused]] T const&... args)
+    {
+        if (!budget)
+        {
+            return;
+        }
+#if !defined(_RELEASE)
+        if (auto profiler = V::Interface<Profiler>::Get(); profiler)
+        {
+            char name[MaxFormattedNameLength];
+            profiler->BeginInterval(budget, intervalId, FormatName(name, eventName, args...));
+        }
+#endif
+    }
+
+    inline void ProfileScope::EndInterval([[maybe_unused]] Budget* budget, [[maybe_unused]] uint64_t intervalId)
+    {
+        if (!budget)
+        {
+            return;
+        }
+#if !defined(_RELEASE)
+        if (auto profiler = V::Interface<Profiler>::Get(); profiler)
+        {
+            profiler->EndInterval(budget, intervalId);
+        }
+#endif
+    }
+
+    template<typename... T>
+    void ProfileScope::RecordDataPoint(
+        [[maybe_unused]] Budget* budget, [[maybe_unused]] double value, [[maybe_unused]] const char* counterName, [[maybe_unused]] T const&... args)
+    {
+        if (!budget)
+        {
+            return;
+        }
+#if !defined(_RELEASE)
+        if (auto profiler = V::Interface<Profiler>::Get(); profiler)
+        {
+            char name[MaxFormattedNameLength];
+            profiler->RecordDataPoint(budget, FormatName(name, counterName, args...), value);
+        }
+#endif
+    }
+
+    template<typename T>
+    uint64_t ProfileScope::IntervalId(const T& scopeNameId)
+    {
+        if constexpr (VStd::is_pointer_v<T>)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(scopeNameId));
+        }
+        else
+        {
+            return static_cast<uint64_t>(scopeNameId);
+        }
+    }
+
+    template<size_t N, typename... T>
+    const char* ProfileScope::FormatName(char (&buffer)[N], const char* format, T const&... args)
+    {
+        if constexpr (sizeof...(T) == 0)
+        {
+            return format;
+        }
+        else
+        {
+            v_snprintf(buffer, N, format, args...);
+            return buffer;
+        }
+    }
+
     template<typename... T>
     ProfileScope::ProfileScope(Budget* budget, char const* eventName, T const&... args)
         : m_budget{ budget }
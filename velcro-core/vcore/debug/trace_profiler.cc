@@ -0,0 +1,648 @@
+#include <vcore/debug/trace_profiler.h>
+#include <vcore/console/iconsole.h>
+#include <vcore/io/system_file.h>
+#include <vcore/std/containers/unordered_map.h>
+#include <vcore/std/parallel/scoped_lock.h>
+#include <vcore/std/parallel/thread.h>
+#include <vcore/time/time_system.h>
+
+#include <string.h>
+
+namespace V::Debug
+{
+    namespace TraceProfilerInternal
+    {
+        constexpr const char* DefaultCaptureFile = "profiler_capture.json";
+        constexpr size_t WriteChunkSize = 256 * 1024;
+        // Profilers a thread can record into at the same time, events for more are dropped.
+        constexpr size_t MaxProfilersPerThread = 8;
+
+        VStd::atomic<uint64_t> s_nextGeneration{ 1 };
+
+        // Ring slots taken by a name copied after its event.
+        template<typename EventType>
+        size_t NameSlots(size_t nameLength)
+        {
+            return nameLength == 0 ? 0 : (nameLength + sizeof(EventType) - 1) / sizeof(EventType);
+        }
+
+        void AppendEscaped(VStd::string& out, const char* text)
+        {
+            if (!text)
+            {
+                return;
+            }
+            for (const char* c = text; *c; ++c)
+            {
+                switch (*c)
+                {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20)
+                    {
+                        char escaped[8];
+                        v_snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += *c;
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Chrome trace timestamps are in microseconds, keep the nanosecond part as a fraction.
+        void AppendTimestamp(VStd::string& out, V::s64 timeNs)
+        {
+            char buffer[32];
+            v_snprintf(buffer, sizeof(buffer), "%lld.%03lld", static_cast<long long>(timeNs / 1000), static_cast<long long>(timeNs % 1000));
+            out += buffer;
+        }
+    }
+
+    //
+    // TraceProfiler::ThreadBuffer
+    //
+
+    TraceProfiler::ThreadBuffer::ThreadBuffer(size_t capacity, uint64_t threadId, uint64_t profilerGeneration)
+        : m_events(new Event[capacity])
+        , m_mask(capacity - 1)
+        , m_threadId(threadId)
+        , m_profilerGeneration(profilerGeneration)
+    {
+    }
+
+    TraceProfiler::ThreadBuffer::~ThreadBuffer()
+    {
+        delete[] m_events;
+    }
+
+    void TraceProfiler::ThreadBuffer::Release()
+    {
+        if (m_refCount.fetch_sub(1, VStd::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+    //
+    // TraceProfiler::ThreadBufferList
+    //
+
+    struct TraceProfiler::ThreadBufferList
+    {
+        ~ThreadBufferList()
+        {
+            for (size_t i = 0; i < m_count; ++i)
+            {
+                m_buffers[i]->Release();
+            }
+        }
+
+        // Drops the buffers of profilers that were destroyed.
+        void RemoveOrphans()
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < m_count; ++i)
+            {
+                if (m_buffers[i]->m_profilerDestroyed.load(VStd::memory_order_acquire))
+                {
+                    m_buffers[i]->Release();
+                }
+                else
+                {
+                    m_buffers[kept++] = m_buffers[i];
+                }
+            }
+            m_count = kept;
+        }
+
+        // A fixed array rather than a vector, the list is destroyed on thread exit which can be after the allocators are gone.
+        ThreadBuffer* m_buffers[TraceProfilerInternal::MaxProfilersPerThread];
+        size_t m_count = 0;
+    };
+
+    //
+    // TraceProfiler
+    //
+
+    TraceProfiler::TraceProfiler(size_t eventsPerThread)
+        : m_eventsPerThread(eventsPerThread)
+        , m_generation(TraceProfilerInternal::s_nextGeneration.fetch_add(1, VStd::memory_order_relaxed))
+    {
+        V_Assert(eventsPerThread > 0 && (eventsPerThread & (eventsPerThread - 1)) == 0, "TraceProfiler ring size must be a power of two.");
+        Interface<Profiler>::Register(this);
+        Interface<TraceProfiler>::Register(this);
+    }
+
+    TraceProfiler::~TraceProfiler()
+    {
+        Interface<TraceProfiler>::Unregister(this);
+        Interface<Profiler>::Unregister(this);
+
+        if (IsCapturing())
+        {
+            StopCapture();
+        }
+
+        // Threads that are still alive keep their buffer until they look up a buffer again or exit
+        VStd::scoped_lock lock(m_mutex);
+        for (ThreadBuffer* buffer : m_threadBuffers)
+        {
+            buffer->m_profilerDestroyed.store(true, VStd::memory_order_release);
+            buffer->Release();
+        }
+        m_threadBuffers.clear();
+    }
+
+    bool TraceProfiler::StartCapture(VStd::string_view outputFilePath)
+    {
+        VStd::scoped_lock captureLock(m_captureMutex);
+        {
+            VStd::scoped_lock lock(m_mutex);
+            if (m_capturing)
+            {
+                return false;
+            }
+
+            // discard anything left over from a previous capture
+            for (ThreadBuffer* buffer : m_threadBuffers)
+            {
+                buffer->m_tail.store(buffer->m_head.load(VStd::memory_order_acquire), VStd::memory_order_release);
+            }
+            m_captured.clear();
+            m_captureNames.reset(vnew InternedStringPool(InternedStringPool::Lifetime::Forever));
+            m_dropped = 0;
+            m_outputFilePath = outputFilePath;
+            m_captureId.fetch_add(1, VStd::memory_order_release);
+            m_capturing = true;
+        }
+
+        VStd::thread_desc desc;
+        desc.m_name = "Trace Profiler Drain";
+        m_drainThread = VStd::thread(desc, [this]()
+            {
+                DrainThreadMain();
+            });
+        return true;
+    }
+
+    bool TraceProfiler::StopCapture()
+    {
+        VStd::vector<CapturedEvent> captured;
+        VStd::unique_ptr<InternedStringPool> captureNames;
+        VStd::string outputFilePath;
+        {
+            VStd::scoped_lock captureLock(m_captureMutex);
+            if (!m_capturing.exchange(false))
+            {
+                return false;
+            }
+            m_drainWakeUp.release();
+            m_drainThread.join();
+
+            VStd::scoped_lock lock(m_mutex);
+            DrainLocked();
+            captured.swap(m_captured);
+            captureNames.swap(m_captureNames);
+            outputFilePath.swap(m_outputFilePath);
+        }
+
+        // Writing the file can take a while, threads registering their first event shouldn't wait for it
+        bool result = WriteChromeTrace(outputFilePath.c_str(), captured);
+        V_Warning("TraceProfiler", m_dropped == 0, "%llu events were dropped because a thread buffer was full, consider a larger ring.",
+            static_cast<unsigned long long>(m_dropped.load()));
+        return result;
+    }
+
+    bool TraceProfiler::IsCapturing() const
+    {
+        return m_capturing.load(VStd::memory_order_relaxed);
+    }
+
+    void TraceProfiler::Drain()
+    {
+        VStd::scoped_lock lock(m_mutex);
+        DrainLocked();
+    }
+
+    void TraceProfiler::DrainThreadMain()
+    {
+        while (true)
+        {
+            m_drainWakeUp.try_acquire_for(VStd::chrono::milliseconds(DrainPeriodMs));
+            // clear the signal before draining so rings filling up from here on wake us up again
+            m_drainSignaled.store(false, VStd::memory_order_release);
+            if (!m_capturing.load(VStd::memory_order_acquire))
+            {
+                // StopCapture drains what is left
+                return;
+            }
+
+            VStd::scoped_lock lock(m_mutex);
+            DrainLocked();
+        }
+    }
+
+    uint64_t TraceProfiler::GetDroppedEventCount() const
+    {
+        return m_dropped;
+    }
+
+    void TraceProfiler::BeginRegion(const Budget* budget, const char* eventName)
+    {
+        Record(EventType::Begin, budget, eventName, false);
+    }
+
+    void TraceProfiler::EndRegion(const Budget* budget)
+    {
+        Record(EventType::End, budget, nullptr, false);
+    }
+
+    void TraceProfiler::BeginInterval(const Budget* budget, uint64_t intervalId, const char* eventName)
+    {
+        Record(EventType::IntervalBegin, budget, eventName, true, intervalId);
+    }
+
+    void TraceProfiler::EndInterval(const Budget* budget, uint64_t intervalId)
+    {
+        Record(EventType::IntervalEnd, budget, nullptr, false, intervalId);
+    }
+
+    void TraceProfiler::RecordDataPoint(const Budget* budget, const char* counterName, double value)
+    {
+        Record(EventType::Counter, budget, counterName, true, 0, value);
+    }
+
+    TraceProfiler::ThreadBuffer* TraceProfiler::GetThreadBuffer()
+    {
+        thread_local static ThreadBufferList _list;
+
+        for (size_t i = 0; i < _list.m_count; ++i)
+        {
+            if (_list.m_buffers[i]->m_profilerGeneration == m_generation)
+            {
+                return _list.m_buffers[i];
+            }
+        }
+
+        _list.RemoveOrphans();
+        if (_list.m_count == TraceProfilerInternal::MaxProfilersPerThread)
+        {
+            return nullptr;
+        }
+
+        const uint64_t threadId = static_cast<uint64_t>(VStd::hash<VStd::thread_id>{}(VStd::this_thread::get_id()));
+        ThreadBuffer* buffer = new ThreadBuffer(m_eventsPerThread, threadId, m_generation);
+        {
+            VStd::scoped_lock lock(m_mutex);
+            m_threadBuffers.push_back(buffer);
+        }
+        _list.m_buffers[_list.m_count++] = buffer;
+        return buffer;
+    }
+
+    void TraceProfiler::Record(EventType type, const Budget* budget, const char* name, bool copyName, uint64_t id, double value)
+    {
+        if (!m_capturing.load(VStd::memory_order_relaxed))
+        {
+            return;
+        }
+
+        ThreadBuffer* buffer = GetThreadBuffer();
+        if (!buffer)
+        {
+            m_dropped.fetch_add(1, VStd::memory_order_relaxed);
+            return;
+        }
+
+        // Regions that were open when the capture started are not part of it
+        const uint64_t captureId = m_captureId.load(VStd::memory_order_acquire);
+        if (buffer->m_captureId != captureId)
+        {
+            buffer->m_captureId = captureId;
+            buffer->m_openRegions = 0;
+            buffer->m_droppedRegions = 0;
+        }
+
+        size_t nameLength = 0;
+        if (copyName && name)
+        {
+            nameLength = VStd::min(strlen(name), MaxNameLength);
+        }
+        const size_t nameSlots = TraceProfilerInternal::NameSlots<Event>(nameLength);
+
+        const size_t head = buffer->m_head.load(VStd::memory_order_relaxed);
+        const size_t tail = buffer->m_tail.load(VStd::memory_order_acquire);
+        // the slots kept for the ends of the open regions can't be used by other events
+        const size_t freeSlots = buffer->m_mask + 1 - (head - tail) - buffer->m_openRegions;
+        switch (type)
+        {
+        case EventType::Begin:
+            // a begin also keeps the slot of its end
+            if (buffer->m_droppedRegions > 0 || freeSlots < 2)
+            {
+                ++buffer->m_droppedRegions;
+                m_dropped.fetch_add(1, VStd::memory_order_relaxed);
+                return;
+            }
+            ++buffer->m_openRegions;
+            break;
+        case EventType::End:
+            if (buffer->m_droppedRegions > 0)
+            {
+                --buffer->m_droppedRegions;
+                m_dropped.fetch_add(1, VStd::memory_order_relaxed);
+                return;
+            }
+            if (buffer->m_openRegions == 0)
+            {
+                return;
+            }
+            // uses the slot its begin kept
+            --buffer->m_openRegions;
+            break;
+        default:
+            if (freeSlots < 1 + nameSlots)
+            {
+                m_dropped.fetch_add(1, VStd::memory_order_relaxed);
+                return;
+            }
+            break;
+        }
+
+        Event& event = buffer->m_events[head & buffer->m_mask];
+        event.m_timeNs = MonotonicClock::NowNs();
+        event.m_name = copyName ? nullptr : name;
+        event.m_budget = budget;
+        if (type == EventType::Counter)
+        {
+            event.m_value = value;
+        }
+        else
+        {
+            event.m_id = id;
+        }
+        event.m_nameLength = static_cast<uint32_t>(nameLength);
+        event.m_type = type;
+
+        // The name can't be kept as a pointer, it may live in a temporary buffer of the profile macros
+        for (size_t slot = 0; slot < nameSlots; ++slot)
+        {
+            const size_t offset = slot * sizeof(Event);
+            memcpy(&buffer->m_events[(head + 1 + slot) & buffer->m_mask], name + offset, VStd::min(sizeof(Event), nameLength - offset));
+        }
+
+        // publish the event to the draining thread
+        const size_t newHead = head + 1 + nameSlots;
+        buffer->m_head.store(newHead, VStd::memory_order_release);
+
+        // wake the drain thread up early when the ring is half full
+        if (newHead - tail > (buffer->m_mask >> 1) && !m_drainSignaled.exchange(true, VStd::memory_order_acq_rel))
+        {
+            m_drainWakeUp.release();
+        }
+    }
+
+    void TraceProfiler::DrainLocked()
+    {
+        for (size_t bufferIndex = 0; bufferIndex < m_threadBuffers.size();)
+        {
+            ThreadBuffer* buffer = m_threadBuffers[bufferIndex];
+            // Only the profiler's reference is left once the thread exited, it won't record anything more
+            const bool threadExited = buffer->m_refCount.load(VStd::memory_order_acquire) == 1;
+
+            const size_t tail = buffer->m_tail.load(VStd::memory_order_relaxed);
+            const size_t head = buffer->m_head.load(VStd::memory_order_acquire);
+            // without a capture the events of a thread that raced with StopCapture are discarded
+            for (size_t i = tail; i != head && m_captureNames;)
+            {
+                CapturedEvent captured{ buffer->m_events[i & buffer->m_mask], buffer->m_threadId };
+                ++i;
+                if (const size_t nameLength = captured.m_event.m_nameLength; nameLength > 0)
+                {
+                    char name[MaxNameLength + 1];
+                    const size_t nameSlots = TraceProfilerInternal::NameSlots<Event>(nameLength);
+                    for (size_t slot = 0; slot < nameSlots; ++slot, ++i)
+                    {
+                        const size_t offset = slot * sizeof(Event);
+                        memcpy(name + offset, &buffer->m_events[i & buffer->m_mask], VStd::min(sizeof(Event), nameLength - offset));
+                    }
+                    captured.m_event.m_name = m_captureNames->Intern(VStd::string_view(name, nameLength)).GetCStr();
+                }
+                m_captured.push_back(captured);
+            }
+            // hand the slots back to the owning thread
+            buffer->m_tail.store(head, VStd::memory_order_release);
+
+            if (threadExited)
+            {
+                m_threadBuffers.erase(m_threadBuffers.begin() + bufferIndex);
+                buffer->Release();
+            }
+            else
+            {
+                ++bufferIndex;
+            }
+        }
+    }
+
+    bool TraceProfiler::WriteChromeTrace(const char* filePath, const VStd::vector<CapturedEvent>& captured)
+    {
+        using namespace TraceProfilerInternal;
+        using namespace V::IO;
+
+        SystemFile file;
+        if (!file.Open(filePath, SystemFile::SF_OPEN_WRITE_ONLY | SystemFile::SF_OPEN_CREATE | SystemFile::SF_OPEN_CREATE_PATH))
+        {
+            V_Warning("TraceProfiler", false, "Unable to open '%s' to write the profiler capture.", filePath);
+            return false;
+        }
+
+        VStd::string out;
+        out.reserve(WriteChunkSize + 1024);
+        out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+        bool first = true;
+        auto appendEvent = [&out, &first](const Event& event, const char* name, uint64_t threadId)
+        {
+            if (!first)
+            {
+                out += ",\n";
+            }
+            first = false;
+
+            switch (event.m_type)
+            {
+            case EventType::Begin:
+                out += "{\"ph\":\"B\"";
+                break;
+            case EventType::End:
+                out += "{\"ph\":\"E\"";
+                break;
+            case EventType::IntervalBegin:
+                out += "{\"ph\":\"b\"";
+                break;
+            case EventType::IntervalEnd:
+                out += "{\"ph\":\"e\"";
+                break;
+            case EventType::Counter:
+                out += "{\"ph\":\"C\"";
+                break;
+            }
+
+            if (name)
+            {
+                out += ",\"name\":\"";
+                AppendEscaped(out, name);
+                out += "\"";
+            }
+            if (event.m_budget)
+            {
+                out += ",\"cat\":\"";
+                AppendEscaped(out, event.m_budget->Name());
+                out += "\"";
+            }
+
+            char buffer[96];
+            if (event.m_type == EventType::IntervalBegin || event.m_type == EventType::IntervalEnd)
+            {
+                v_snprintf(buffer, sizeof(buffer), ",\"id\":\"0x%llx\"", static_cast<unsigned long long>(event.m_id));
+                out += buffer;
+            }
+            else if (event.m_type == EventType::Counter)
+            {
+                v_snprintf(buffer, sizeof(buffer), ",\"args\":{\"value\":%.17g}", event.m_value);
+                out += buffer;
+            }
+
+            out += ",\"ts\":";
+            AppendTimestamp(out, event.m_timeNs);
+            v_snprintf(buffer, sizeof(buffer), ",\"pid\":1,\"tid\":%llu}", static_cast<unsigned long long>(threadId));
+            out += buffer;
+        };
+
+        // Async end events have to repeat the name of the matching begin event.
+        VStd::unordered_map<uint64_t, const CapturedEvent*> openIntervals;
+        // Regions still open on each thread when the capture stopped.
+        VStd::unordered_map<uint64_t, size_t> openRegions;
+        V::s64 lastTimeNs = 0;
+
+        for (const CapturedEvent& capturedEvent : captured)
+        {
+            const Event& event = capturedEvent.m_event;
+            const char* name = event.m_name;
+            lastTimeNs = VStd::max(lastTimeNs, event.m_timeNs);
+            switch (event.m_type)
+            {
+            case EventType::Begin:
+                ++openRegions[capturedEvent.m_threadId];
+                break;
+            case EventType::End:
+                if (size_t& depth = openRegions[capturedEvent.m_threadId]; depth > 0)
+                {
+                    --depth;
+                }
+                else
+                {
+                    continue;
+                }
+                break;
+            case EventType::IntervalBegin:
+                openIntervals[event.m_id] = &capturedEvent;
+                break;
+            case EventType::IntervalEnd:
+                if (auto it = openIntervals.find(event.m_id); it != openIntervals.end())
+                {
+                    name = it->second->m_event.m_name;
+                    openIntervals.erase(it);
+                }
+                else
+                {
+                    // its begin was dropped or came before the capture
+                    continue;
+                }
+                break;
+            default:
+                break;
+            }
+
+            appendEvent(event, name, capturedEvent.m_threadId);
+            if (out.size() >= WriteChunkSize)
+            {
+                file.Write(out.data(), out.size());
+                out.clear();
+            }
+        }
+
+        // Close what was still open when the capture stopped, so the viewers don't drop the unterminated events
+        for (const auto& [threadId, depth] : openRegions)
+        {
+            Event end{};
+            end.m_timeNs = lastTimeNs;
+            end.m_type = EventType::End;
+            for (size_t i = 0; i < depth; ++i)
+            {
+                appendEvent(end, nullptr, threadId);
+            }
+        }
+        for (const auto& [intervalId, begin] : openIntervals)
+        {
+            Event end = begin->m_event;
+            end.m_timeNs = lastTimeNs;
+            end.m_type = EventType::IntervalEnd;
+            appendEvent(end, begin->m_event.m_name, begin->m_threadId);
+        }
+
+        out += "\n]}\n";
+        file.Write(out.data(), out.size());
+        file.Close();
+        return true;
+    }
+
+    //
+    // Console commands
+    //
+
+    static void profiler_capture_start(const V::ConsoleCommandContainer& arguments)
+    {
+        TraceProfiler* profiler = Interface<TraceProfiler>::Get();
+        if (!profiler)
+        {
+            V_Warning("TraceProfiler", false, "No TraceProfiler has been created, nothing to capture.");
+            return;
+        }
+
+        VStd::string_view filePath = arguments.empty() ? VStd::string_view(TraceProfilerInternal::DefaultCaptureFile) : arguments.front();
+        if (!profiler->StartCapture(filePath))
+        {
+            V_Warning("TraceProfiler", false, "A profiler capture is already in progress.");
+        }
+    }
+    V_CONSOLEFREEFUNC(profiler_capture_start, V::ConsoleFunctorFlags::DontReplicate,
+        "Starts recording profiler events, optionally to the given Chrome trace (json) file.");
+
+    static void profiler_capture_stop([[maybe_unused]] const V::ConsoleCommandContainer& arguments)
+    {
+        TraceProfiler* profiler = Interface<TraceProfiler>::Get();
+        if (!profiler || !profiler->StopCapture())
+        {
+            V_Warning("TraceProfiler", false, "No profiler capture was written.");
+        }
+    }
+    V_CONSOLEFREEFUNC(profiler_capture_stop, V::ConsoleFunctorFlags::DontReplicate,
+        "Stops recording profiler events and writes the capture file.");
+} // namespace V::Debug
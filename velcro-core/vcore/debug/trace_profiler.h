@@ -0,0 +1,169 @@
+#ifndef V_FRAMEWORK_CORE_DEBUG_TRACE_PROFILER_H
+#define V_FRAMEWORK_CORE_DEBUG_TRACE_PROFILER_H
+
+#include <vcore/debug/profiler.h>
+#include <vcore/interface/interface.h>
+#include <vcore/name/interned_string.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/mutex.h>
+#include <vcore/std/parallel/semaphore.h>
+#include <vcore/std/parallel/thread.h>
+#include <vcore/std/smart_ptr/unique_ptr.h>
+#include <vcore/std/string/string.h>
+#include <vcore/std/string/string_view.h>
+
+namespace V::Debug
+{
+    //! @class TraceProfiler
+    //! Profiler that records regions, intervals and data points into per-thread ring buffers and
+    //! writes them out in the Chrome trace event JSON format, which chrome://tracing and ui.perfetto.dev both load.
+    //!
+    //! Recording is wait-free for the producing thread: every thread owns a single producer / single consumer ring
+    //! and only publishes its write cursor with a release store. Timestamps come from V::MonotonicClock, calibrate it
+    //! (for example by creating a V::TimeSystem) before starting a capture for TSC resolution.
+    //! A background thread drains the rings while capturing, every DrainPeriodMs and whenever a ring gets half full.
+    //! When a ring is full anyway new events are dropped and counted instead of blocking the thread. A region is
+    //! dropped as a whole: a recorded begin keeps a slot for its end, and the regions nested in a dropped one are
+    //! dropped with it, so the exported begin and end events stay balanced.
+    //!
+    //! Rings are shared between the profiler and the recording thread and freed by whichever lets go last, so a thread
+    //! can outlive the profiler and the events of threads that exited are still exported. Interval and data point
+    //! names may be formatted into a temporary buffer by the profile macros, they are copied into the ring after their
+    //! event and interned into a pool that only lives as long as the capture.
+    //!
+    //! Captures can be controlled from the console with profiler_capture_start [file] and profiler_capture_stop.
+    class TraceProfiler
+        : public Profiler
+    {
+    public:
+        VOBJECT(TraceProfiler, "{0e3c7b1d-9a54-4f26-b8c1-6d27e4a5f903}");
+
+        //! Number of events each thread can hold before the capture is drained, must be a power of two.
+        inline static constexpr size_t DefaultEventsPerThread = 64 * 1024;
+        //! Interval between two drains of the thread rings during a capture.
+        inline static constexpr V::u32 DrainPeriodMs = 50;
+        //! Longer interval and data point names are truncated.
+        inline static constexpr size_t MaxNameLength = 255;
+
+        explicit TraceProfiler(size_t eventsPerThread = DefaultEventsPerThread);
+        ~TraceProfiler() override;
+
+        //! Starts recording, events are written to outputFilePath when the capture is stopped.
+        //! @return false if a capture is already in progress.
+        bool StartCapture(VStd::string_view outputFilePath);
+        //! Stops recording and writes the captured events.
+        //! @return false if no capture was running or the output file could not be written.
+        bool StopCapture();
+        bool IsCapturing() const;
+
+        //! Moves all events recorded so far out of the thread rings into the capture, freeing room in the rings.
+        //! The capture's drain thread already does this, call it to make room right away.
+        void Drain();
+
+        //! Number of events lost because a thread ring was full.
+        uint64_t GetDroppedEventCount() const;
+
+        //////////////////////////////////////////////////////////////////////////
+        // Profiler
+        void BeginRegion(const Budget* budget, const char* eventName) override;
+        void EndRegion(const Budget* budget) override;
+        void BeginInterval(const Budget* budget, uint64_t intervalId, const char* eventName) override;
+        void EndInterval(const Budget* budget, uint64_t intervalId) override;
+        void RecordDataPoint(const Budget* budget, const char* counterName, double value) override;
+        //////////////////////////////////////////////////////////////////////////
+
+    private:
+        enum class EventType : uint8_t
+        {
+            Begin,
+            End,
+            IntervalBegin,
+            IntervalEnd,
+            Counter
+        };
+
+        struct Event
+        {
+            V::s64 m_timeNs;
+            const char* m_name;
+            const Budget* m_budget;
+            union
+            {
+                uint64_t m_id;
+                double m_value;
+            };
+            // Length of the name copied into the slots that follow the event, 0 if m_name is used as is.
+            uint32_t m_nameLength;
+            EventType m_type;
+        };
+
+        struct ThreadBuffer
+        {
+            ThreadBuffer(size_t capacity, uint64_t threadId, uint64_t profilerGeneration);
+            ~ThreadBuffer();
+
+            //! Drops a reference, the profiler and the recording thread each hold one.
+            void Release();
+
+            Event* m_events;
+            size_t m_mask;
+            uint64_t m_threadId;
+            uint64_t m_profilerGeneration;
+            // written by the owning thread only
+            VStd::atomic<size_t> m_head{ 0 };
+            // written by the draining thread only
+            VStd::atomic<size_t> m_tail{ 0 };
+            VStd::atomic_int m_refCount{ 2 };
+            // set when the profiler is destroyed, the thread then drops its reference the next time it looks up a buffer
+            VStd::atomic_bool m_profilerDestroyed{ false };
+
+            // Regions of the current capture, used by the owning thread only. Every recorded region that is still open
+            // keeps a slot for its end event.
+            uint64_t m_captureId = 0;
+            size_t m_openRegions = 0;
+            size_t m_droppedRegions = 0;
+        };
+
+        // The buffers of the calling thread, one per profiler it recorded into. Released when the thread exits.
+        struct ThreadBufferList;
+
+        struct CapturedEvent
+        {
+            Event m_event;
+            uint64_t m_threadId;
+        };
+
+        ThreadBuffer* GetThreadBuffer();
+        //! Records an event, the name is copied into the ring when copyName is set.
+        void Record(EventType type, const Budget* budget, const char* name, bool copyName, uint64_t id = 0, double value = 0.0);
+        void DrainLocked();
+        void DrainThreadMain();
+        static bool WriteChromeTrace(const char* filePath, const VStd::vector<CapturedEvent>& captured);
+
+        size_t m_eventsPerThread;
+        // Identifies the profiler in the thread buffer lists, unlike its address it is never reused.
+        uint64_t m_generation;
+        VStd::atomic_bool m_capturing{ false };
+        // Bumped by every StartCapture, threads reset their open regions when it changes.
+        VStd::atomic<uint64_t> m_captureId{ 0 };
+        VStd::atomic<uint64_t> m_dropped{ 0 };
+
+        // serializes StartCapture and StopCapture, which start and join the drain thread
+        VStd::mutex m_captureMutex;
+
+        // guards the thread buffer list and the captured events, recording threads only take it when they register
+        mutable VStd::mutex m_mutex;
+        VStd::vector<ThreadBuffer*> m_threadBuffers;
+        VStd::vector<CapturedEvent> m_captured;
+        VStd::string m_outputFilePath;
+        // Interval and data point names of the capture, released with the captured events once they are written.
+        VStd::unique_ptr<InternedStringPool> m_captureNames;
+
+        VStd::atomic_bool m_drainSignaled{ false };
+        VStd::semaphore m_drainWakeUp;
+        VStd::thread m_drainThread;
+    };
+} // namespace V::Debug
+
+#endif // V_FRAMEWORK_CORE_DEBUG_TRACE_PROFILER_H
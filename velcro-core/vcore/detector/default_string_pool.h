@@ -12,12 +12,6 @@ namespace V
 {
     namespace Debug
     {
-        template<class Key, class Mapped>
-        struct unordered_map
-        {
-            typedef VStd::unordered_map<Key, Mapped, VStd::hash<Key>, VStd::equal_to<Key>, OSStdAllocator> type;
-        };
-
         template<class Key>
         struct unordered_set
         {
@@ -12,10 +12,80 @@
 #   include <vcore/compression/compression.h>
 #endif // V_FILE_STREAM_COMPRESSION
 
+#if !defined(VCORE_EXCLUDE_ZSTANDARD)
+#   define V_FILE_STREAM_ZSTD_COMPRESSION
+#   include <zstd.h>
+#endif // VCORE_EXCLUDE_ZSTANDARD
+
 namespace V
 {
     namespace Debug
     {
+        namespace DetectorStreamInternal
+        {
+            static const unsigned int maxVarintSize = 10;
+
+            inline unsigned int EncodeVarint(u8* buffer, u64 value)
+            {
+                unsigned int size = 0;
+                while (value >= 0x80)
+                {
+                    buffer[size++] = static_cast<u8>(value | 0x80);
+                    value >>= 7;
+                }
+                buffer[size++] = static_cast<u8>(value);
+                return size;
+            }
+
+            /// Returns false if the data ends before the varint does.
+            inline bool DecodeVarint(const u8*& cursor, const u8* end, u64& value)
+            {
+                value = 0;
+                const u8* data = cursor;
+                for (unsigned int shift = 0; data != end && shift < maxVarintSize * 7; shift += 7)
+                {
+                    u8 byte = *data++;
+                    value |= static_cast<u64>(byte & 0x7f) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        cursor = data;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            inline u64 ZigZagEncode(s64 value)
+            {
+                return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+            }
+
+            inline s64 ZigZagDecode(u64 value)
+            {
+                return static_cast<s64>(value >> 1) ^ -static_cast<s64>(value & 1);
+            }
+
+            inline unsigned int SizeClass(unsigned int size)
+            {
+                return size == 8 ? 3 : size == 4 ? 2 : size == 2 ? 1 : 0;
+            }
+
+            inline s64 SignExtend(u64 value, unsigned int size)
+            {
+                switch (size)
+                {
+                case 1:
+                    return static_cast<s8>(value);
+                case 2:
+                    return static_cast<s16>(value);
+                case 4:
+                    return static_cast<s32>(value);
+                default:
+                    return static_cast<s64>(value);
+                }
+            }
+        } // namespace DetectorStreamInternal
+
         //////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////
         // Detector output stream
@@ -23,22 +93,158 @@ namespace V
         //////////////////////////////////////////////////////////////////////////
         void DetectorOutputStream::WriteHeader()
         {
-            StreamHeader sh; // StreamHeader should be endianess independent.
+            StreamHeader sh(m_isCompact); // StreamHeader should be endianess independent.
+            // every session starts with empty tables
+            m_compactNames.clear();
+            m_compactDeltaBase.clear();
+            m_compactPooledStrings.clear();
             WriteBinary(&sh, sizeof(sh));
         }
 
         void DetectorOutputStream::WriteTimeUTC(u32 name)
         {
             VStd::sys_time_t now = VStd::GetTimeUTCMilliSecond();
+            if (m_isCompact)
+            {
+                WriteCompactDelta(name, static_cast<u64>(now), sizeof(now));
+                return;
+            }
             Write(name, now);
         }
 
         void DetectorOutputStream::WriteTimeMicrosecond(u32 name)
         {
             VStd::sys_time_t now = VStd::GetTimeNowMicroSecond();
+            if (m_isCompact)
+            {
+                WriteCompactDelta(name, static_cast<u64>(now), sizeof(now));
+                return;
+            }
             Write(name, now);
         }
 
+        void DetectorOutputStream::WriteDelta(u32 name, u64 value)
+        {
+            if (m_isCompact)
+            {
+                WriteCompactDelta(name, value, sizeof(value));
+                return;
+            }
+            Write(name, value);
+        }
+
+        //=========================================================================
+        // EncodeCompactKey
+        //=========================================================================
+        unsigned int DetectorOutputStream::EncodeCompactKey(u8* buffer, u32 name, CompactEntry::Kind kind, unsigned int sizeClass)
+        {
+            u64 nameToken = 0;
+            auto nameIt = m_compactNames.find(name);
+            if (nameIt != m_compactNames.end())
+            {
+                nameToken = nameIt->second + 1;
+            }
+            else
+            {
+                m_compactNames.insert(VStd::make_pair(name, static_cast<u32>(m_compactNames.size())));
+            }
+
+            u64 key = (nameToken << CompactEntry::nameTokenShift) | (sizeClass << CompactEntry::sizeClassShift) | kind;
+            unsigned int size = DetectorStreamInternal::EncodeVarint(buffer, key);
+            if (nameToken == 0)
+            {
+                buffer[size++] = static_cast<u8>(name);
+                buffer[size++] = static_cast<u8>(name >> 8);
+                buffer[size++] = static_cast<u8>(name >> 16);
+                buffer[size++] = static_cast<u8>(name >> 24);
+            }
+            return size;
+        }
+
+        void DetectorOutputStream::WriteCompactTag(u32 name, bool isOpen)
+        {
+            u8 buffer[CompactEntry::maxKeySize];
+            unsigned int size = EncodeCompactKey(buffer, name, isOpen ? CompactEntry::CE_TAG_BEGIN : CompactEntry::CE_TAG_END, 0);
+            WriteBinary(buffer, size);
+        }
+
+        void DetectorOutputStream::WriteCompactInteger(u32 name, u64 value, unsigned int size, bool isSigned)
+        {
+            using namespace DetectorStreamInternal;
+            u8 buffer[CompactEntry::maxKeySize + maxVarintSize];
+            unsigned int bufferSize;
+            if (isSigned)
+            {
+                bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_SINT, SizeClass(size));
+                bufferSize += EncodeVarint(buffer + bufferSize, ZigZagEncode(SignExtend(value, size)));
+            }
+            else
+            {
+                bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_UINT, SizeClass(size));
+                bufferSize += EncodeVarint(buffer + bufferSize, value);
+            }
+            WriteBinary(buffer, bufferSize);
+        }
+
+        void DetectorOutputStream::WriteCompactDelta(u32 name, u64 value, unsigned int size)
+        {
+            using namespace DetectorStreamInternal;
+            u64& base = m_compactDeltaBase[name];
+            s64 delta = static_cast<s64>(value - base);
+            base = value;
+
+            u8 buffer[CompactEntry::maxKeySize + maxVarintSize];
+            unsigned int bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_DELTA, SizeClass(size));
+            bufferSize += EncodeVarint(buffer + bufferSize, ZigZagEncode(delta));
+            WriteBinary(buffer, bufferSize);
+        }
+
+        void DetectorOutputStream::WriteCompactBlob(u32 name, const void* data, unsigned int dataSize)
+        {
+            using namespace DetectorStreamInternal;
+            u8 buffer[CompactEntry::maxKeySize + maxVarintSize];
+            unsigned int bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_BLOB, 0);
+            bufferSize += EncodeVarint(buffer + bufferSize, dataSize);
+            WriteBinary(buffer, bufferSize);
+            if (data && dataSize)
+            {
+                WriteBinary(data, dataSize);
+            }
+        }
+
+        void DetectorOutputStream::WriteCompactString(u32 name, const char* string, unsigned int length, bool isCopyString)
+        {
+            using namespace DetectorStreamInternal;
+            if (!m_stringPool)
+            {
+                WriteCompactBlob(name, string, length);
+                return;
+            }
+
+            u8 buffer[CompactEntry::maxKeySize + maxVarintSize];
+            unsigned int bufferSize;
+            V::u32 crc;
+            bool isInserted = isCopyString ? m_stringPool->InsertCopy(string, length, crc) : m_stringPool->Insert(string, length, crc);
+            if (!isInserted)
+            {
+                auto indexIt = m_compactPooledStrings.find(crc);
+                if (indexIt != m_compactPooledStrings.end()) // already in this stream, store the index only.
+                {
+                    bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_POOLED_STRING_REF, 0);
+                    bufferSize += EncodeVarint(buffer + bufferSize, indexIt->second);
+                    WriteBinary(buffer, bufferSize);
+                    return;
+                }
+                // The pool can be shared with previous sessions, the string still needs to be sent once in this stream.
+            }
+
+            m_compactPooledStrings.insert(VStd::make_pair(crc, static_cast<u32>(m_compactPooledStrings.size())));
+            bufferSize = EncodeCompactKey(buffer, name, CompactEntry::CE_POOLED_STRING, 0);
+            bufferSize += EncodeVarint(buffer + bufferSize, length);
+            WriteBinary(buffer, bufferSize);
+            WriteBinary(string, length);
+        }
+
         //////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////
         // Detector Input Stream
@@ -54,10 +260,85 @@ namespace V
             {
                 return false;
             }
-            m_isEndianSwap = V::IsBigEndian(static_cast<V::PlatformID>(sh.platform)) != V::IsBigEndian(V::g_currentPlatform);
+            const u8 platform = sh.platform & ~DetectorOutputStream::StreamHeader::compactEncodingFlag;
+            m_isEndianSwap = V::IsBigEndian(static_cast<V::PlatformID>(platform)) != V::IsBigEndian(V::g_currentPlatform);
+            m_isCompact = (sh.platform & DetectorOutputStream::StreamHeader::compactEncodingFlag) != 0;
+            m_compactNames.clear();
+            m_compactDeltaBase.clear();
+            m_compactPooledStrings.clear();
             return true;
         }
 
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        // Detector chunked memory stream
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        DetectorOutputChunkedMemoryStream::DetectorOutputChunkedMemoryStream(unsigned int chunkSize)
+            : m_chunkSize(chunkSize)
+            , m_numUsedChunks(0)
+            , m_lastChunkSize(0)
+            , m_dataSize(0)
+        {
+            V_Assert(chunkSize > 0, "Chunk size must be greater than 0!");
+        }
+
+        DetectorOutputChunkedMemoryStream::~DetectorOutputChunkedMemoryStream()
+        {
+            for (unsigned char* chunk : m_chunks)
+            {
+                vfree(chunk, OSAllocator, m_chunkSize);
+            }
+        }
+
+        unsigned int DetectorOutputChunkedMemoryStream::GetChunkDataSize(unsigned int chunkIndex) const
+        {
+            V_Assert(chunkIndex < m_numUsedChunks, "Invalid chunk index %u!", chunkIndex);
+            return chunkIndex + 1 == m_numUsedChunks ? m_lastChunkSize : m_chunkSize;
+        }
+
+        void DetectorOutputChunkedMemoryStream::CopyData(void* buffer) const
+        {
+            unsigned char* destination = reinterpret_cast<unsigned char*>(buffer);
+            for (unsigned int i = 0; i < m_numUsedChunks; ++i)
+            {
+                unsigned int chunkDataSize = GetChunkDataSize(i);
+                memcpy(destination, m_chunks[i], chunkDataSize);
+                destination += chunkDataSize;
+            }
+        }
+
+        void DetectorOutputChunkedMemoryStream::Reset()
+        {
+            // keep the chunks for reuse
+            m_numUsedChunks = 0;
+            m_lastChunkSize = 0;
+            m_dataSize = 0;
+        }
+
+        void DetectorOutputChunkedMemoryStream::WriteBinary(const void* data, unsigned int dataSize)
+        {
+            const unsigned char* source = reinterpret_cast<const unsigned char*>(data);
+            m_dataSize += dataSize;
+            while (dataSize > 0)
+            {
+                if (m_numUsedChunks == 0 || m_lastChunkSize == m_chunkSize)
+                {
+                    if (m_numUsedChunks == m_chunks.size())
+                    {
+                        m_chunks.push_back(reinterpret_cast<unsigned char*>(vmalloc(m_chunkSize, 16, OSAllocator)));
+                    }
+                    ++m_numUsedChunks;
+                    m_lastChunkSize = 0;
+                }
+                unsigned int dataToCopy = VStd::GetMin(dataSize, m_chunkSize - m_lastChunkSize);
+                memcpy(m_chunks[m_numUsedChunks - 1] + m_lastChunkSize, source, dataToCopy);
+                m_lastChunkSize += dataToCopy;
+                source += dataToCopy;
+                dataSize -= dataToCopy;
+            }
+        }
+
         //////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////
         // Detector file stream
@@ -67,6 +348,8 @@ namespace V
         // DetectorOutputFileStream::DetectorOutputFileStream
         //=========================================================================
         DetectorOutputFileStream::DetectorOutputFileStream()
+            : m_zstd(nullptr)
+            , m_zstdLevel(0)
         {
 #if defined(V_FILE_STREAM_COMPRESSION)
             m_zlib = vcreate(ZLib, (&AllocatorInstance<OSAllocator>::GetAllocator()), OSAllocator);
@@ -81,6 +364,28 @@ namespace V
         {
 #if defined(V_FILE_STREAM_COMPRESSION)
             vdestroy(m_zlib, OSAllocator);
+#endif
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+            ZSTD_freeCCtx(m_zstd);
+#endif
+        }
+
+        //=========================================================================
+        // DetectorOutputFileStream::SetZstdCompression
+        //=========================================================================
+        void DetectorOutputFileStream::SetZstdCompression(int compressionLevel)
+        {
+            V_Assert(!IsOpen(), "Compression must be selected before the file is opened!");
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+            m_zstdLevel = compressionLevel;
+            if (m_zstdLevel == 0 && m_zstd)
+            {
+                ZSTD_freeCCtx(m_zstd);
+                m_zstd = nullptr;
+            }
+#else
+            (void)compressionLevel;
+            V_Warning("Detector", false, "Zstd is excluded from this build, the detector file will use the default compression.");
 #endif
         }
 
@@ -92,6 +397,18 @@ namespace V
             if (IO::SystemFile::Open(fileName, mode, platformFlags))
             {
                 m_dataBuffer.reserve(100 * 1024);
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+                if (m_zstdLevel != 0)
+                {
+                    if (!m_zstd)
+                    {
+                        m_zstd = ZSTD_createCCtx();
+                    }
+                    ZSTD_CCtx_reset(m_zstd, ZSTD_reset_session_only);
+                    ZSTD_CCtx_setParameter(m_zstd, ZSTD_c_compressionLevel, m_zstdLevel);
+                    return true;
+                }
+#endif
 #if defined(V_FILE_STREAM_COMPRESSION)
                 //              // Enable optional: encode the file in the same format as the streamer so they are interchangeable
                 //              IO::CompressorHeader ch;
@@ -114,16 +431,56 @@ namespace V
         // DetectorOutputFileStream::Close
         //=========================================================================
         void DetectorOutputFileStream::Close()
+        {
+            FlushDataBuffer(true);
+            IO::SystemFile::Close();
+        }
+
+        //=========================================================================
+        // DetectorOutputFileStream::FlushDataBuffer
+        //=========================================================================
+        void DetectorOutputFileStream::FlushDataBuffer(bool isFinish)
         {
             unsigned int dataSizeInBuffer = static_cast<unsigned int>(m_dataBuffer.size());
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+            if (m_zstd && m_zstdLevel != 0)
             {
-#if defined(V_FILE_STREAM_COMPRESSION)
-                unsigned int minCompressBufferSize = m_zlib->GetMinCompressedBufferSize(dataSizeInBuffer);
-                if (m_compressionBuffer.size() < minCompressBufferSize) // grow compression buffer if needed
+                if (m_compressionBuffer.size() < ZSTD_CStreamOutSize())
                 {
                     m_compressionBuffer.clear();
-                    m_compressionBuffer.resize(minCompressBufferSize);
+                    m_compressionBuffer.resize(ZSTD_CStreamOutSize());
                 }
+                ZSTD_inBuffer input = { m_dataBuffer.data(), dataSizeInBuffer, 0 };
+                const ZSTD_EndDirective mode = isFinish ? ZSTD_e_end : ZSTD_e_continue;
+                bool isDone;
+                do
+                {
+                    ZSTD_outBuffer output = { m_compressionBuffer.data(), m_compressionBuffer.size(), 0 };
+                    size_t remaining = ZSTD_compressStream2(m_zstd, &output, &input, mode);
+                    if (ZSTD_isError(remaining))
+                    {
+                        V_Error("Detector", false, "Failed to compress detector data: %s", ZSTD_getErrorName(remaining));
+                        break;
+                    }
+                    if (output.pos)
+                    {
+                        IO::SystemFile::Write(m_compressionBuffer.data(), output.pos);
+                    }
+                    isDone = isFinish ? remaining == 0 : input.pos == input.size;
+                } while (!isDone);
+                m_dataBuffer.clear();
+                return;
+            }
+#endif
+#if defined(V_FILE_STREAM_COMPRESSION)
+            unsigned int minCompressBufferSize = m_zlib->GetMinCompressedBufferSize(dataSizeInBuffer);
+            if (m_compressionBuffer.size() < minCompressBufferSize) // grow compression buffer if needed
+            {
+                m_compressionBuffer.clear();
+                m_compressionBuffer.resize(minCompressBufferSize);
+            }
+            if (isFinish)
+            {
                 unsigned int compressedSize;
                 do
                 {
@@ -134,18 +491,30 @@ namespace V
                     }
                 } while (compressedSize > 0);
                 m_zlib->ResetCompressor();
-#else
-                if (dataSizeInBuffer) {
-                    IO::SystemFile::Write(m_dataBuffer.data(), m_dataBuffer.size());
+            }
+            else
+            {
+                while (dataSizeInBuffer > 0)
+                {
+                    unsigned int compressedSize = m_zlib->Compress(m_dataBuffer.data(), dataSizeInBuffer, m_compressionBuffer.data(), (unsigned)m_compressionBuffer.size());
+                    if (compressedSize)
+                    {
+                        IO::SystemFile::Write(m_compressionBuffer.data(), compressedSize);
+                    }
                 }
-#endif
-                m_dataBuffer.clear();
             }
-            IO::SystemFile::Close();
+#else
+            (void)isFinish;
+            if (dataSizeInBuffer)
+            {
+                IO::SystemFile::Write(m_dataBuffer.data(), m_dataBuffer.size());
+            }
+#endif
+            m_dataBuffer.clear();
         }
+
         //=========================================================================
         // DetectorOutputFileStream::WriteBinary
-        
         //=========================================================================
         void DetectorOutputFileStream::WriteBinary(const void* data, unsigned int dataSize)
         {
@@ -154,27 +523,8 @@ namespace V
             {
                 if (dataSizeInBuffer > 0)
                 {
-#if defined(V_FILE_STREAM_COMPRESSION)
                     // we need to flush the data
-                    unsigned int dataToCompress = static_cast<unsigned int>(dataSizeInBuffer);
-                    unsigned int minCompressBufferSize = m_zlib->GetMinCompressedBufferSize(dataToCompress);
-                    if (m_compressionBuffer.size() < minCompressBufferSize) // grow compression buffer if needed
-                    {
-                        m_compressionBuffer.clear();
-                        m_compressionBuffer.resize(minCompressBufferSize);
-                    }
-                    while (dataToCompress > 0)
-                    {
-                        unsigned int compressedSize = m_zlib->Compress(m_dataBuffer.data(), dataToCompress, m_compressionBuffer.data(), (unsigned)m_compressionBuffer.size());
-                        if (compressedSize)
-                        {
-                            IO::SystemFile::Write(m_compressionBuffer.data(), compressedSize);
-                        }
-                    }
-#else
-                    IO::SystemFile::Write(m_dataBuffer.data(), m_dataBuffer.size());
-#endif
-                    m_dataBuffer.clear();
+                    FlushDataBuffer(false);
                 }
             }
             m_dataBuffer.insert(m_dataBuffer.end(), reinterpret_cast<const unsigned char*>(data), reinterpret_cast<const unsigned char*>(data) + dataSize);
@@ -191,6 +541,8 @@ namespace V
         
         //=========================================================================
         DetectorInputFileStream::DetectorInputFileStream()
+            : m_zstd(nullptr)
+            , m_isCompressionDetected(false)
         {
 #if defined(V_FILE_STREAM_COMPRESSION)
             m_zlib = vcreate(ZLib, (&AllocatorInstance<OSAllocator>::GetAllocator()), OSAllocator);
@@ -206,6 +558,9 @@ namespace V
         {
 #if defined(V_FILE_STREAM_COMPRESSION)
             vdestroy(m_zlib, OSAllocator);
+#endif
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+            ZSTD_freeDCtx(m_zstd);
 #endif
         }
 
@@ -248,6 +603,47 @@ namespace V
                     break;
                 }
             }
+#if defined(V_FILE_STREAM_ZSTD_COMPRESSION)
+            if (!m_isCompressionDetected && m_compressedData.size() >= sizeof(u32))
+            {
+                // zstd frames start with a little endian magic number, zlib streams never do.
+                const u32 magic = static_cast<u32>(m_compressedData[0]) | (static_cast<u32>(m_compressedData[1]) << 8) |
+                    (static_cast<u32>(m_compressedData[2]) << 16) | (static_cast<u32>(m_compressedData[3]) << 24);
+                if (magic == ZSTD_MAGICNUMBER)
+                {
+                    if (!m_zstd)
+                    {
+                        m_zstd = ZSTD_createDCtx();
+                    }
+                    ZSTD_DCtx_reset(m_zstd, ZSTD_reset_session_only);
+                }
+                else if (m_zstd)
+                {
+                    ZSTD_freeDCtx(m_zstd);
+                    m_zstd = nullptr;
+                }
+                m_isCompressionDetected = true;
+            }
+            if (m_zstd)
+            {
+                ZSTD_inBuffer input = { m_compressedData.data(), m_compressedData.size(), 0 };
+                ZSTD_outBuffer output = { data, maxDataSize, 0 };
+                size_t inputPos, outputPos;
+                do
+                {
+                    inputPos = input.pos;
+                    outputPos = output.pos;
+                    size_t result = ZSTD_decompressStream(m_zstd, &output, &input);
+                    if (ZSTD_isError(result))
+                    {
+                        V_Error("Detector", false, "Failed to decompress detector data: %s", ZSTD_getErrorName(result));
+                        break;
+                    }
+                } while (output.pos < output.size && (input.pos != inputPos || output.pos != outputPos));
+                m_compressedData.erase(m_compressedData.begin(), m_compressedData.begin() + input.pos);
+                return static_cast<unsigned int>(output.pos);
+            }
+#endif
 #if defined(V_FILE_STREAM_COMPRESSION)
             unsigned int dataSize = maxDataSize;
             unsigned int bytesProcessed = m_zlib->Decompress(m_compressedData.data(), (unsigned)m_compressedData.size(), data, dataSize);
@@ -272,6 +668,7 @@ namespace V
                 m_zlib->ResetDecompressor();
             }
 #endif // V_FILE_STREAM_COMPRESSION
+            m_isCompressionDetected = false;
             V::IO::SystemFile::Close();
         }
 
@@ -300,6 +697,25 @@ namespace V
             static const int processChunkSize = 15 * 1024;
             char buffer[processChunkSize];
             unsigned int dataSize;
+            if (stream.IsCompactEncoding())
+            {
+                while ((dataSize = stream.ReadBinary(buffer, processChunkSize)) > 0)
+                {
+                    if (m_buffer.empty())
+                    {
+                        size_t dataProcessed = ProcessCompactData(stream, buffer, dataSize);
+                        m_buffer.insert(m_buffer.end(), buffer + dataProcessed, buffer + dataSize);
+                    }
+                    else
+                    {
+                        m_buffer.insert(m_buffer.end(), buffer, buffer + dataSize);
+                        size_t dataProcessed = ProcessCompactData(stream, m_buffer.data(), m_buffer.size());
+                        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + dataProcessed);
+                    }
+                }
+                return;
+            }
+
             bool isEndianSwap = stream.IsEndianSwap();
             while ((dataSize = stream.ReadBinary(buffer, processChunkSize)) > 0)
             {
@@ -446,6 +862,163 @@ namespace V
             }
         }
 
+        //=========================================================================
+        // ProcessCompactData
+        //=========================================================================
+        size_t DetectorSAXParser::ProcessCompactData(DetectorInputStream& stream, const char* data, size_t dataSize)
+        {
+            using namespace DetectorStreamInternal;
+            typedef DetectorOutputStream::CompactEntry CompactEntry;
+
+            const u8* dataStart = reinterpret_cast<const u8*>(data);
+            const u8* dataEnd = dataStart + dataSize;
+            const u8* cursor = dataStart;
+            while (cursor != dataEnd)
+            {
+                // Nothing is committed to the stream tables until the whole entry is available.
+                const u8* entryStart = cursor;
+                u64 key;
+                if (!DecodeVarint(cursor, dataEnd, key))
+                {
+                    return entryStart - dataStart;
+                }
+
+                const u32 kind = static_cast<u32>(key & CompactEntry::kindMask);
+                const u32 sizeClass = static_cast<u32>((key >> CompactEntry::sizeClassShift) & CompactEntry::sizeClassMask);
+                const u64 nameToken = key >> CompactEntry::nameTokenShift;
+                u32 name;
+                if (nameToken == 0)
+                {
+                    if (dataEnd - cursor < 4)
+                    {
+                        return entryStart - dataStart;
+                    }
+                    name = static_cast<u32>(cursor[0]) | (static_cast<u32>(cursor[1]) << 8) | (static_cast<u32>(cursor[2]) << 16) | (static_cast<u32>(cursor[3]) << 24);
+                    cursor += 4;
+                }
+                else if (nameToken <= stream.m_compactNames.size())
+                {
+                    name = stream.m_compactNames[static_cast<size_t>(nameToken - 1)];
+                }
+                else
+                {
+                    V_Error("DetectorSAXParser", false, "Invalid name token %llu while processing stream (%s). Aborting stream.\n", nameToken, stream.GetIdentifier());
+                    return dataSize;
+                }
+
+                u64 payload = 0;
+                if (kind != CompactEntry::CE_TAG_BEGIN && kind != CompactEntry::CE_TAG_END)
+                {
+                    if (!DecodeVarint(cursor, dataEnd, payload))
+                    {
+                        return entryStart - dataStart;
+                    }
+                    if ((kind == CompactEntry::CE_BLOB || kind == CompactEntry::CE_POOLED_STRING) && payload > static_cast<u64>(dataEnd - cursor))
+                    {
+                        return entryStart - dataStart;
+                    }
+                }
+
+                // the entry is complete
+                if (nameToken == 0)
+                {
+                    stream.m_compactNames.push_back(name);
+                }
+
+                Data de;
+                de.Name = name;
+                de.StringPool = stream.GetStringPool();
+                de.IsPooledString = false;
+                de.IsPooledStringCrc32 = false;
+                de.IsEndianSwap = false;
+                union
+                {
+                    u8 value8;
+                    u16 value16;
+                    u32 value32;
+                    u64 value64;
+                } value;
+
+                switch (kind)
+                {
+                case CompactEntry::CE_TAG_BEGIN:
+                case CompactEntry::CE_TAG_END:
+                    m_tagCallback(name, kind == CompactEntry::CE_TAG_BEGIN);
+                    break;
+                case CompactEntry::CE_UINT:
+                case CompactEntry::CE_SINT:
+                case CompactEntry::CE_DELTA:
+                {
+                    u64 result = payload;
+                    if (kind == CompactEntry::CE_SINT)
+                    {
+                        result = static_cast<u64>(ZigZagDecode(payload));
+                    }
+                    else if (kind == CompactEntry::CE_DELTA)
+                    {
+                        u64& base = stream.m_compactDeltaBase[name];
+                        result = base + static_cast<u64>(ZigZagDecode(payload));
+                        base = result;
+                    }
+                    // values are decoded in the native endianess with the size of the written type
+                    switch (sizeClass)
+                    {
+                    case 0:
+                        value.value8 = static_cast<u8>(result);
+                        break;
+                    case 1:
+                        value.value16 = static_cast<u16>(result);
+                        break;
+                    case 2:
+                        value.value32 = static_cast<u32>(result);
+                        break;
+                    default:
+                        value.value64 = result;
+                        break;
+                    }
+                    de.DataPtr = &value;
+                    de.DataSize = 1 << sizeClass;
+                    m_dataCallback(de);
+                } break;
+                case CompactEntry::CE_BLOB:
+                {
+                    de.DataPtr = const_cast<u8*>(cursor);
+                    de.DataSize = static_cast<unsigned int>(payload);
+                    de.IsEndianSwap = stream.IsEndianSwap();
+                    cursor += payload;
+                    m_dataCallback(de);
+                } break;
+                case CompactEntry::CE_POOLED_STRING:
+                {
+                    V_Assert(de.StringPool != nullptr, "We require a string pool to parse this stream");
+                    V::u32 crc32;
+                    const char* stringPtr;
+                    de.StringPool->InsertCopy(reinterpret_cast<const char*>(cursor), static_cast<unsigned int>(payload), crc32, &stringPtr);
+                    stream.m_compactPooledStrings.push_back(crc32);
+                    de.DataPtr = const_cast<void*>(static_cast<const void*>(stringPtr));
+                    de.DataSize = static_cast<unsigned int>(payload);
+                    de.IsPooledString = true;
+                    cursor += payload;
+                    m_dataCallback(de);
+                } break;
+                case CompactEntry::CE_POOLED_STRING_REF:
+                {
+                    if (payload >= stream.m_compactPooledStrings.size())
+                    {
+                        V_Error("DetectorSAXParser", false, "Invalid pooled string index %llu while processing stream (%s). Aborting stream.\n", payload, stream.GetIdentifier());
+                        return dataSize;
+                    }
+                    value.value32 = stream.m_compactPooledStrings[static_cast<size_t>(payload)];
+                    de.DataPtr = &value;
+                    de.DataSize = sizeof(u32);
+                    de.IsPooledStringCrc32 = true;
+                    m_dataCallback(de);
+                } break;
+                }
+            }
+            return dataSize;
+        }
+
         const char*  DetectorSAXParser::Data::PrepareString(unsigned int& stringLength) const
         {
             const char* srcData = reinterpret_cast<const char*>(DataPtr);
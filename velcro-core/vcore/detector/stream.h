@@ -6,6 +6,7 @@
 #include <vcore/std/delegate/delegate.h>
 #include <vcore/std/containers/vector.h>
 #include <vcore/std/containers/forward_list.h>
+#include <vcore/std/containers/unordered_map.h>
 #include <vcore/std/typetraits/is_signed.h>
 #include <vcore/std/typetraits/is_pod.h>
 
@@ -13,6 +14,9 @@
 #include <vcore/platform_id/platform_id.h>
 #include <vcore/std/string/string.h>
 
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
 namespace V {
     class ZLib;
 
@@ -34,6 +38,12 @@ namespace V {
             typedef VStd::forward_list<T, OSStdAllocator> type;
         };
 
+        template<class Key, class Mapped>
+        struct unordered_map
+        {
+            typedef VStd::unordered_map<Key, Mapped, VStd::hash<Key>, VStd::equal_to<Key>, OSStdAllocator> type;
+        };
+
         /**
          * Interface for a string pool which can be used by input/output streams to avoid storing multiple copies of the same
          * string in the stream. Of course this comes at the bookkeeping cost of the table.
@@ -92,6 +102,33 @@ namespace V {
                 u32     sizeAndFlags;       ///<
             };
 
+            /**
+             * Compact encoding, used instead of StreamEntry when enabled with SetCompactEncoding.
+             * Every entry starts with a varint key: (nameToken << 5) | (sizeClass << 3) | kind.
+             * A nameToken of 0 is followed by the 4 byte little endian name, which is added to the stream name table,
+             * otherwise the name is nameTable[nameToken - 1]. The size class is log2 of the integral size in bytes.
+             * Integers are varints (zigzag for signed values) so the encoding doesn't depend on the platform endianess.
+             */
+            struct CompactEntry
+            {
+                enum Kind // max 8 values as we use 3 bits to store them
+                {
+                    CE_TAG_BEGIN = 0,
+                    CE_TAG_END,
+                    CE_UINT,                ///< Varint value.
+                    CE_SINT,                ///< Zigzag varint value.
+                    CE_DELTA,               ///< Zigzag varint difference to the previous value written with the same name.
+                    CE_BLOB,                ///< Varint size followed by the raw data.
+                    CE_POOLED_STRING,       ///< Varint size followed by a string that gets the next string pool index.
+                    CE_POOLED_STRING_REF,   ///< Varint index of a string previously stored with CE_POOLED_STRING.
+                };
+                static const u32 kindMask = 0x7;
+                static const u32 sizeClassShift = 3;
+                static const u32 sizeClassMask = 0x3;
+                static const u32 nameTokenShift = 5;
+                static const unsigned int maxKeySize = 10 + 4; ///< Max varint size plus literal name.
+            };
+
             template<class T, size_t Size, bool isIntegralType>
             struct IntergralType;
 
@@ -100,6 +137,11 @@ namespace V {
             {
                 static void Write(DetectorOutputStream& stream, u32 name, const T& data)
                 {
+                    if (stream.m_isCompact)
+                    {
+                        stream.WriteCompactInteger(name, *reinterpret_cast<const u8*>(&data), 1, VStd::is_signed<T>::value);
+                        return;
+                    }
                     StreamEntry de;
                     de.name = name;
                     de.sizeAndFlags = (u32)(StreamEntry::INT_DATA_U8) << StreamEntry::dataInternalShift;
@@ -112,6 +154,11 @@ namespace V {
             {
                 static void Write(DetectorOutputStream& stream, u32 name, const T& data)
                 {
+                    if (stream.m_isCompact)
+                    {
+                        stream.WriteCompactInteger(name, *reinterpret_cast<const u16*>(&data), 2, VStd::is_signed<T>::value);
+                        return;
+                    }
                     StreamEntry de;
                     de.name = name;
                     de.sizeAndFlags = (u32)(StreamEntry::INT_DATA_U16) << StreamEntry::dataInternalShift;
@@ -124,6 +171,11 @@ namespace V {
             {
                 static void Write(DetectorOutputStream& stream, u32 name, const T& data)
                 {
+                    if (stream.m_isCompact)
+                    {
+                        stream.WriteCompactInteger(name, *reinterpret_cast<const u32*>(&data), 4, VStd::is_signed<T>::value);
+                        return;
+                    }
                     StreamEntry de;
                     de.name = name;
                     const u32* uintData = reinterpret_cast<const u32*>(&data);
@@ -146,6 +198,11 @@ namespace V {
             {
                 static void Write(DetectorOutputStream& stream, u32 name, const T& data)
                 {
+                    if (stream.m_isCompact)
+                    {
+                        stream.WriteCompactInteger(name, *reinterpret_cast<const u64*>(&data), 8, VStd::is_signed<T>::value);
+                        return;
+                    }
                     StreamEntry de;
                     de.name = name;
                     const u64* uintData = reinterpret_cast<const u64*>(&data);
@@ -169,6 +226,12 @@ namespace V {
                 static void Write(DetectorOutputStream& stream, u32 name, const T* pointer)
                 {
                     size_t id = reinterpret_cast<size_t>(pointer);
+                    if (stream.m_isCompact)
+                    {
+                        // addresses are usually close to the previous address we stored
+                        stream.WriteCompactDelta(name, id, sizeof(id));
+                        return;
+                    }
                     IntergralType<size_t, sizeof(id), true>::Write(stream, name, id);
                 }
             };
@@ -179,19 +242,35 @@ namespace V {
              */
             struct StreamHeader
             {
-                StreamHeader()
-                    : platform((u8)g_currentPlatform)    {}
+                /// Set in the platform byte when the stream uses the CompactEntry encoding.
+                static const u8 compactEncodingFlag = 0x80;
+
+                StreamHeader(bool isCompact = false)
+                    : platform((u8)g_currentPlatform | (isCompact ? compactEncodingFlag : 0))    {}
                 u8   platform;
             };
 
             DetectorOutputStream(DetectorStringPool* stringPool = NULL)
-                : m_stringPool(stringPool) { }
+                : m_stringPool(stringPool)
+                , m_isCompact(false) { }
             virtual ~DetectorOutputStream() {}
 
+            /**
+             * Enables the compact encoding (varint names and sizes, delta encoded addresses and time stamps and string pool
+             * indices instead of crc32). It must be set before the session starts writing to the stream.
+             */
+            void SetCompactEncoding(bool isCompact)     { m_isCompact = isCompact; }
+            bool IsCompactEncoding() const              { return m_isCompact; }
+
             //////////////////////////////////////////////////////////////////////////
             // Write
             inline void BeginTag(u32 name)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactTag(name, true);
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = (u32)(StreamEntry::INT_TAG) << StreamEntry::dataInternalShift;
@@ -200,6 +279,11 @@ namespace V {
             }
             inline void EndTag(u32 name)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactTag(name, false);
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = (u32)(StreamEntry::INT_TAG) << StreamEntry::dataInternalShift;
@@ -219,6 +303,11 @@ namespace V {
             // Binary and strings
             inline void Write(u32 name, const void* data, unsigned int dataSize)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactBlob(name, data, dataSize);
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = dataSize;
@@ -227,6 +316,11 @@ namespace V {
             }
             inline void Write(u32 name, const char* string, bool isCopyString = true)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactString(name, string, static_cast<unsigned int>(strlen(string)), isCopyString);
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = static_cast<unsigned int>(strlen(string));
@@ -260,6 +354,11 @@ namespace V {
             template<class Allocator>
             inline void Write(u32 name, const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, bool isCopyString = true)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactString(name, str.c_str(), static_cast<unsigned int>(str.size()), isCopyString);
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = static_cast<V::u32>(str.size());
@@ -293,6 +392,11 @@ namespace V {
             template<class Allocator>
             inline void Write(u32 name, const VStd::basic_string<VStd::wstring::value_type, VStd::wstring::traits_type, Allocator>& str)
             {
+                if (m_isCompact)
+                {
+                    WriteCompactBlob(name, str.data(), static_cast<unsigned int>(str.size() * sizeof(VStd::wstring::value_type)));
+                    return;
+                }
                 StreamEntry de;
                 de.name = name;
                 de.sizeAndFlags = static_cast<V::u32>(str.size());
@@ -321,11 +425,18 @@ namespace V {
                 size_t numElements = VStd::distance(first, last);
                 size_t elementSize = sizeof(typename VStd::iterator_traits<InputIterator>::value_type);
                 unsigned int dataSize = static_cast<unsigned int>(numElements * elementSize);
-                StreamEntry de;
-                de.name = name;
-                de.sizeAndFlags = dataSize;
-                V_Assert(dataSize < StreamEntry::dataSizeMask, "Invalid data size, size is limited to %d bytes!", StreamEntry::dataSizeMask - 1);
-                WriteBinary(de);
+                if (m_isCompact)
+                {
+                    WriteCompactBlob(name, nullptr, dataSize); // header only, elements follow
+                }
+                else
+                {
+                    StreamEntry de;
+                    de.name = name;
+                    de.sizeAndFlags = dataSize;
+                    V_Assert(dataSize < StreamEntry::dataSizeMask, "Invalid data size, size is limited to %d bytes!", StreamEntry::dataSizeMask - 1);
+                    WriteBinary(de);
+                }
                 //WriteBinary(data,dataSize); for contiguous_iterator_tag
                 for (; first != last; ++first)
                 {
@@ -357,6 +468,12 @@ namespace V {
              */
             void WriteTimeMicrosecond(u32 name);
 
+            /**
+             * Write a value that changes slowly with every write (counters, time stamps, addresses). With the compact encoding
+             * only the difference to the previous value written with the same name is stored.
+             */
+            void WriteDelta(u32 name, u64 value);
+
             /// Called when the driller is moving on the next frame, so you can flush you current buffer to network/disk.
             virtual void OnEndOfFrame() {}
 
@@ -367,7 +484,23 @@ namespace V {
             /// Write the Stream header structure (should be endianess independent).
             void WriteHeader();
 
+            //////////////////////////////////////////////////////////////////////////
+            // Compact encoding
+            unsigned int EncodeCompactKey(u8* buffer, u32 name, CompactEntry::Kind kind, unsigned int sizeClass);
+            void WriteCompactTag(u32 name, bool isOpen);
+            void WriteCompactInteger(u32 name, u64 value, unsigned int size, bool isSigned);
+            void WriteCompactDelta(u32 name, u64 value, unsigned int size);
+            /// Writes the entry and data, if data is NULL only the entry is written and the caller writes the data.
+            void WriteCompactBlob(u32 name, const void* data, unsigned int dataSize);
+            void WriteCompactString(u32 name, const char* string, unsigned int length, bool isCopyString);
+            //////////////////////////////////////////////////////////////////////////
+
             DetectorStringPool*  m_stringPool;       ///< Optional pointer to a string pool.
+            bool                 m_isCompact;        ///< True if we use the CompactEntry encoding.
+
+            unordered_map<u32, u32>::type   m_compactNames;         ///< Name to name token, reset with every header.
+            unordered_map<u32, u64>::type   m_compactDeltaBase;     ///< Last value written with WriteCompactDelta per name.
+            unordered_map<u32, u32>::type   m_compactPooledStrings; ///< String crc32 to the index used in the stream.
         };
 
         /**
@@ -378,10 +511,13 @@ namespace V {
         public:
             DetectorInputStream(DetectorStringPool* stringPool = NULL)
                 : m_isEndianSwap(false)
+                , m_isCompact(false)
                 , m_stringPool(stringPool) {}
             virtual ~DetectorInputStream() {}
 
             bool IsEndianSwap() const       { return m_isEndianSwap; }
+            /// True if the stream was written with the compact encoding (read from the stream header).
+            bool IsCompactEncoding() const  { return m_isCompact; }
             /// Reads binary data from a stream to to maxDataSize. Returns 0 if no more data.
             virtual unsigned int ReadBinary(void* data, unsigned int maxDataSize) = 0;
 
@@ -396,9 +532,17 @@ namespace V {
             /// Read the Stream header structure
             bool ReadHeader();
 
+            friend class DetectorSAXParser;
+
             bool m_isEndianSwap;
+            bool m_isCompact;
             DetectorStringPool*          m_stringPool;       ///< Optional pointer to a string pool.
             VStd::string               m_streamIdentifier;
+
+            // Compact encoding tables, they mirror the ones of the output stream.
+            vector<u32>::type               m_compactNames;
+            unordered_map<u32, u64>::type   m_compactDeltaBase;
+            vector<u32>::type               m_compactPooledStrings;   ///< String pool index to crc32.
         };
 
         /**
@@ -420,6 +564,37 @@ namespace V {
                 m_data.insert(m_data.end(), reinterpret_cast<const unsigned char*>(data), reinterpret_cast<const unsigned char*>(data) + dataSize);
             }
         };
+
+        /**
+         * Outputs all stream data into a list of fixed size memory chunks. Unlike DetectorOutputMemoryStream, writing never
+         * moves the data already written, and the chunks are kept for reuse when the stream is Reset.
+         */
+        class DetectorOutputChunkedMemoryStream
+            : public DetectorOutputStream
+        {
+        public:
+            V_CLASS_ALLOCATOR(DetectorOutputChunkedMemoryStream, OSAllocator, 0)
+            DetectorOutputChunkedMemoryStream(unsigned int chunkSize = 64 * 1024);
+            ~DetectorOutputChunkedMemoryStream();
+
+            /// Number of chunks that contain data.
+            unsigned int GetNumChunks() const               { return m_numUsedChunks; }
+            const unsigned char* GetChunkData(unsigned int chunkIndex) const    { return m_chunks[chunkIndex]; }
+            unsigned int GetChunkDataSize(unsigned int chunkIndex) const;
+            size_t GetDataSize() const                      { return m_dataSize; }
+            /// Copies all the data into a contiguous buffer of at least GetDataSize() bytes.
+            void CopyData(void* buffer) const;
+            void Reset();
+
+            void WriteBinary(const void* data, unsigned int dataSize) override;
+
+        private:
+            vector<unsigned char*>::type m_chunks;
+            unsigned int m_chunkSize;
+            unsigned int m_numUsedChunks;
+            unsigned int m_lastChunkSize;   ///< Bytes used in the last used chunk.
+            size_t m_dataSize;
+        };
         /**
          * Reads data from a memory stream. Data is NOT copied and must be persistent while we are using it.
          */
@@ -486,12 +661,22 @@ namespace V {
             , public DetectorOutputStream
         {
             ZLib* m_zlib;
+            ZSTD_CCtx_s* m_zstd;
+            int m_zstdLevel;
             vector<unsigned char>::type m_compressionBuffer;
             vector<unsigned char>::type m_dataBuffer;
+
+            void FlushDataBuffer(bool isFinish);
         public:
             V_CLASS_ALLOCATOR(DetectorOutputFileStream, OSAllocator, 0)
             DetectorOutputFileStream();
             ~DetectorOutputFileStream();
+            /**
+             * Compress the file with streaming zstd instead of zlib, 0 restores the default. Zstd compresses faster at
+             * similar ratios which matters when the captured process is sensitive to the capture overhead.
+             * Must be called before Open. DetectorInputFileStream detects the compression automatically.
+             */
+            void SetZstdCompression(int compressionLevel = 1);
             bool Open(const char* fileName, int mode, int platformFlags = 0);
             void Close();
 
@@ -506,6 +691,8 @@ namespace V {
             , public DetectorInputStream
         {
             ZLib* m_zlib;
+            ZSTD_DCtx_s* m_zstd;
+            bool m_isCompressionDetected;
             vector<unsigned char>::type m_compressedData;
         public:
             V_CLASS_ALLOCATOR(DetectorInputFileStream, OSAllocator, 0)
@@ -692,6 +879,8 @@ namespace V {
             /// Processes an input stream until all data is consumed (read returns 0 bytes).
             void ProcessStream(DetectorInputStream& stream);
         protected:
+            /// Parses compact encoded entries, returns the number of bytes consumed. Incomplete entries are left in the data.
+            size_t ProcessCompactData(DetectorInputStream& stream, const char* data, size_t dataSize);
 
             typedef vector<char>::type  BufferType;
             BufferType                  m_buffer;
@@ -98,7 +98,7 @@ namespace V
                 if (requiredSize > buffer->capacity())
                 {
                     // grow by 50%, if we can.
-                    size_t newCapacityGrowSize = AZ::GetClamp<size_t>(requiredSize / 2, 4, maxCapacityGrowSize);
+                    size_t newCapacityGrowSize = V::GetClamp<size_t>(requiredSize / 2, 4, maxCapacityGrowSize);
                     size_t newCapacity = requiredSize + newCapacityGrowSize;
                     buffer->set_capacity(newCapacity);
                 }
@@ -185,7 +185,7 @@ namespace V
         template<typename T>
         SizeType ByteContainerStream<ContainerType>::Write(SizeType bytes, const void* iBuffer, typename T::type)
         {
-            size_t bytesToCopy = aznumeric_cast<size_t>(PrepareToWrite(bytes));
+            size_t bytesToCopy = v_numeric_cast<size_t>(PrepareToWrite(bytes));
             memcpy(m_buffer->data() + m_pos, iBuffer, bytesToCopy);
             m_pos += bytesToCopy;
             return bytes;
@@ -197,7 +197,7 @@ namespace V
         {
             V_Assert(inputStream, "Input stream is null!");
             V_Assert(inputStream != this, "Can't write and read from the same stream.");
-            size_t bytesToCopy = aznumeric_cast<size_t>(PrepareToWrite(bytes));
+            size_t bytesToCopy = v_numeric_cast<size_t>(PrepareToWrite(bytes));
             bytesToCopy = inputStream->Read(bytesToCopy, m_buffer->data() + m_pos);
             m_pos += bytesToCopy;
             return bytesToCopy;
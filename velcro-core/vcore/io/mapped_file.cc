@@ -0,0 +1,36 @@
+#include <vcore/io/mapped_file.h>
+#include <vcore/std/utils.h>
+
+namespace V {
+    namespace IO {
+        MappedFile::~MappedFile()
+        {
+            Close();
+        }
+
+        MappedFile::MappedFile(MappedFile&& rhs)
+            : m_data(rhs.m_data)
+            , m_size(rhs.m_size)
+            , m_fileHandle(rhs.m_fileHandle)
+            , m_mappingHandle(rhs.m_mappingHandle)
+        {
+            rhs.m_data = nullptr;
+            rhs.m_size = 0;
+            rhs.m_fileHandle = nullptr;
+            rhs.m_mappingHandle = nullptr;
+        }
+
+        MappedFile& MappedFile::operator=(MappedFile&& rhs)
+        {
+            if (this != &rhs)
+            {
+                Close();
+                VStd::swap(m_data, rhs.m_data);
+                VStd::swap(m_size, rhs.m_size);
+                VStd::swap(m_fileHandle, rhs.m_fileHandle);
+                VStd::swap(m_mappingHandle, rhs.m_mappingHandle);
+            }
+            return *this;
+        }
+    } // namespace IO
+} // namespace V
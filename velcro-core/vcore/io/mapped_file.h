@@ -0,0 +1,45 @@
+#ifndef V_FRAMEWORK_CORE_IO_MAPPED_FILE_H
+#define V_FRAMEWORK_CORE_IO_MAPPED_FILE_H
+
+#include <vcore/base.h>
+
+namespace V {
+    namespace IO {
+        /**
+         * Read only memory mapping of a complete file.
+         * The operating system pages the file in on demand, so files larger than the physical memory
+         * can be mapped as long as they fit in the address space.
+         */
+        class MappedFile {
+        public:
+            MappedFile() = default;
+            ~MappedFile();
+
+            MappedFile(MappedFile&& rhs);
+            MappedFile& operator=(MappedFile&& rhs);
+
+            /// Maps the file at filePath, closing any previously mapped file. Returns false if the file can't be mapped.
+            bool Open(const char* filePath);
+            /// Unmaps the file, pointers returned by Data() are invalid afterwards.
+            void Close();
+            bool IsOpen() const             { return m_data != nullptr; }
+
+            const V::u8* Data() const       { return m_data; }
+            V::u64 Size() const             { return m_size; }
+
+            /// Hints the operating system that the given range will be accessed soon.
+            void Prefetch(V::u64 offset, V::u64 size) const;
+
+        private:
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const V::u8* m_data = nullptr;
+            V::u64 m_size = 0;
+            void* m_fileHandle = nullptr;
+            void* m_mappingHandle = nullptr;
+        };
+    } // namespace IO
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_IO_MAPPED_FILE_H
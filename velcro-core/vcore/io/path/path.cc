@@ -1,4 +1,35 @@
 #include <vcore/io/path/path.h>
+#include <vcore/math/math_intrinsics.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace V::IO::Internal
+{
+    size_t FindSeparatorVectorized(const char* data, size_t size) noexcept
+    {
+        size_t offset = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        const __m128i forwardSlash = _mm_set1_epi8('/');
+        const __m128i backSlash = _mm_set1_epi8('\\');
+        for (; offset + 16 <= size; offset += 16)
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            const __m128i separators = _mm_or_si128(_mm_cmpeq_epi8(chars, forwardSlash), _mm_cmpeq_epi8(chars, backSlash));
+            if (const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(separators)); mask != 0)
+            {
+                return offset + v_ctz_u32(mask);
+            }
+        }
+#endif
+        while (offset < size && !IsSeparator(data[offset]))
+        {
+            ++offset;
+        }
+        return offset;
+    }
+}
 
 
 // Explicit instantations of our support Path classes
@@ -269,6 +269,11 @@ namespace V::IO
         //! If the path input = 'C:bar', then the new PathIterable parts = [C:', '/', 'foo', 'bar' ]
         //! If the path input = 'D:bar', then the new PathIterable parts = [D:, 'bar' ]
         static constexpr void AppendNormalPathParts(PathIterable& pathIterableResult, const V::IO::PathView& path) noexcept;
+        //! Single pass version of LexicallyNormal for paths without a root name, which writes the normal form
+        //! straight into the empty pathResult instead of going through a PathIterable and Append
+        //! Returns false without modifying pathResult if the path needs the general normalization
+        template <typename StringType>
+        static constexpr bool MakeLexicallyNormal(BasicPath<StringType>& pathResult, const V::IO::PathView& path) noexcept;
 
         constexpr int ComparePathView(const PathView& other) const;
         constexpr VStd::string_view root_name_view() const;
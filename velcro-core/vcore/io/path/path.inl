@@ -400,6 +400,12 @@ namespace V::IO
 
     constexpr int PathView::ComparePathView(const PathView& other) const
     {
+        // The same text parsed with the same rules has the same parts
+        if (m_preferred_separator == other.m_preferred_separator && m_path == other.m_path)
+        {
+            return 0;
+        }
+
         auto lhsPathParser = parser::PathParser::CreateBegin(m_path, m_preferred_separator);
         auto rhsPathParser = parser::PathParser::CreateBegin(other.m_path, other.m_preferred_separator);
 
@@ -660,6 +666,85 @@ namespace V::IO
         AppendNormalPathParts(pathIterable, path);
         return pathIterable;
     }
+
+    template <typename StringType>
+    constexpr auto PathView::MakeLexicallyNormal(BasicPath<StringType>& pathResult, const V::IO::PathView& path) noexcept -> bool
+    {
+#if defined(V_TRAIT_CUSTOM_PATH_ROOT_SEPARATOR)
+        if (path.m_preferred_separator == PosixPathSeparator)
+        {
+            return false;
+        }
+#endif
+        const VStd::string_view pathView = path.m_path;
+        auto& result = pathResult.m_path;
+        if (pathView.size() > result.max_size()
+            || Internal::ConsumeRootName(pathView.begin(), pathView.end(), path.m_preferred_separator) != pathView.begin())
+        {
+            return false;
+        }
+
+        // The normal form never grows, so it is built in place with a single separator between the parts
+        // The parts are "..", "..", ..., filename, filename, ..., as a ".." only stays when there is no filename before it
+        const bool windowsPath = path.m_preferred_separator != PosixPathSeparator;
+        size_t rootSize = 0;
+        size_t filenameCount = 0;
+        if (!pathView.empty() && Internal::IsSeparator(pathView.front()))
+        {
+            result.push_back(path.m_preferred_separator == PosixPathSeparator ? PosixPathSeparator : WindowsPathSeparator);
+            rootSize = 1;
+        }
+
+        auto AppendPart = [&result, rootSize, separator = pathResult.m_preferred_separator](VStd::string_view part) constexpr
+        {
+            if (result.size() > rootSize)
+            {
+                result.push_back(separator);
+            }
+            result.append(part.data(), part.size());
+        };
+
+        for (size_t offset = Internal::SkipSeparators(pathView, 0); offset < pathView.size();)
+        {
+            const size_t partEnd = Internal::FindSeparator(pathView, offset);
+            const VStd::string_view part = pathView.substr(offset, partEnd - offset);
+            offset = Internal::SkipSeparators(pathView, partEnd);
+
+            if (part == ".")
+            {
+                continue;
+            }
+            if (part == "..")
+            {
+                if (filenameCount > 0)
+                {
+                    // The ".." cancels the previous filename, remove it along with the separator before it
+                    size_t partBegin = result.size();
+                    while (partBegin > rootSize && !Internal::IsSeparator(result[partBegin - 1]))
+                    {
+                        --partBegin;
+                    }
+                    result.erase(partBegin > rootSize ? partBegin - 1 : rootSize);
+                    --filenameCount;
+                }
+                else if (rootSize == 0)
+                {
+                    // A ".." directly after the root directory is dropped
+                    AppendPart(part);
+                }
+                continue;
+            }
+            if (windowsPath && Internal::HasDrivePrefix(part))
+            {
+                // A filename that starts with a root name, i.e D:/foo/C:/baz, restarts the path
+                result.clear();
+                return false;
+            }
+            AppendPart(part);
+            ++filenameCount;
+        }
+        return true;
+    }
 }
 
 namespace V::IO
@@ -1242,6 +1327,10 @@ namespace V::IO
     constexpr auto BasicPath<StringType>::LexicallyNormal() const -> BasicPath
     {
         BasicPath pathResult(m_preferred_separator);
+        if (PathView::MakeLexicallyNormal(pathResult, *this))
+        {
+            return pathResult;
+        }
         PathView::PathIterable pathIterable = PathView::GetNormalPathParts(*this);
         for ([[maybe_unused]] auto [pathPartView, pathPartKind] : pathIterable)
         {
@@ -1378,6 +1467,10 @@ namespace V::IO
     constexpr auto PathView::LexicallyNormal() const -> FixedMaxPath
     {
         FixedMaxPath pathResult(m_preferred_separator);
+        if (MakeLexicallyNormal(pathResult, *this))
+        {
+            return pathResult;
+        }
         PathIterable pathIterable = GetNormalPathParts(*this);
         for ([[maybe_unused]] auto [pathPartView, pathPartKind] : pathIterable)
         {
@@ -1504,8 +1597,7 @@ namespace VStd
     {
         size_t operator()(const V::IO::PathView& pathToHash) noexcept
         {
-            auto pathParser = V::IO::parser::PathParser::CreateBegin(pathToHash.Native(), pathToHash.m_preferred_separator);
-            return V::IO::parser::HashPath(pathParser);
+            return V::IO::parser::HashPathView(pathToHash.Native(), pathToHash.m_preferred_separator);
         }
     };
     template <typename StringType>
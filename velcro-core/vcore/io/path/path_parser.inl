@@ -3,6 +3,7 @@
 #include <vcore/vcore_traits_platform.h>
 #include <vcore/casting/numeric_cast.h>
 #include <vcore/std/string/string.h>
+#include <vcore/std/typetraits/is_constant_evaluated.h>
 
 namespace V::IO::Internal
 {
@@ -124,6 +125,34 @@ namespace V::IO::Internal
         }
     }
 
+    //! Returns the offset of the first path separator in data, or size if there is none
+    //! Checks 16 characters at a time, defined in path.cc
+    size_t FindSeparatorVectorized(const char* data, size_t size) noexcept;
+
+    //! Returns the offset of the first path separator in path at or after offset, or path.size() if there is none
+    constexpr size_t FindSeparator(VStd::string_view path, size_t offset) noexcept
+    {
+        if (!VStd::is_constant_evaluated())
+        {
+            return offset + FindSeparatorVectorized(path.data() + offset, path.size() - offset);
+        }
+        while (offset < path.size() && !IsSeparator(path[offset]))
+        {
+            ++offset;
+        }
+        return offset;
+    }
+
+    //! Returns the offset of the first character at or after offset that isn't a path separator
+    constexpr size_t SkipSeparators(VStd::string_view path, size_t offset) noexcept
+    {
+        while (offset < path.size() && IsSeparator(path[offset]))
+        {
+            ++offset;
+        }
+        return offset;
+    }
+
     //! Returns an iterator past the end of the consumed path separator(s)
     template <typename InputIt>
     constexpr InputIt ConsumeSeparator(InputIt entryBeginIter, InputIt entryEndIter) noexcept
@@ -685,6 +714,33 @@ namespace V::IO::parser
         return hash_value;
     }
 
+    //! Returns the same value as HashPath without going through the parser states
+    //! The root name is hashed first, then "/" for a root directory and each filename between separators
+    inline size_t HashPathView(VStd::string_view path, const char preferredSeparator)
+    {
+        size_t hash_value = 0;
+        const bool hashExactPath = preferredSeparator == V::IO::PosixPathSeparator;
+        const size_t rootNameSize = static_cast<size_t>(
+            Internal::ConsumeRootName(path.begin(), path.end(), preferredSeparator) - path.begin());
+        if (rootNameSize != 0)
+        {
+            VStd::hash_combine(hash_value, HashSegment(path.substr(0, rootNameSize), hashExactPath));
+        }
+
+        size_t offset = Internal::SkipSeparators(path, rootNameSize);
+        if (offset != rootNameSize)
+        {
+            VStd::hash_combine(hash_value, HashSegment("/", hashExactPath));
+        }
+        while (offset < path.size())
+        {
+            const size_t filenameEnd = Internal::FindSeparator(path, offset);
+            VStd::hash_combine(hash_value, HashSegment(path.substr(offset, filenameEnd - offset), hashExactPath));
+            offset = Internal::SkipSeparators(path, filenameEnd);
+        }
+        return hash_value;
+    }
+
     constexpr int DetermineLexicalElementCount(PathParser pathParser)
     {
         int count = 0;
@@ -72,7 +72,7 @@ namespace V
         {
             m_path = VStd::move(path);
             m_relativePathOffset = 0;
-            m_absolutePathHash = VStd::hash<VStd::string>{}(m_path);
+            m_absolutePathHash = HashAbsolutePath(m_path);
         }
 
         bool RequestPath::IsValid() const
@@ -106,6 +106,14 @@ namespace V
             return m_absolutePathHash;
         }
 
+        size_t RequestPath::HashAbsolutePath(const VStd::string& path)
+        {
+            // A hash that lands on one of the markers would make the path look unresolved or invalid,
+            // which resolves and rehashes it on every use
+            const size_t hash = VStd::hash<VStd::string>{}(path);
+            return (hash == s_emptyPathHash || hash == s_invalidPathHash) ? hash ^ 1 : hash;
+        }
+
         void RequestPath::ResolvePath() const
         {
             if (m_absolutePathHash == s_emptyPathHash)
@@ -122,7 +130,7 @@ namespace V
 
                 size_t relativePathLength = m_path.length() - m_relativePathOffset;
                 m_path = fullPath;
-                m_absolutePathHash = VStd::hash<VStd::string>{}(m_path);
+                m_absolutePathHash = HashAbsolutePath(m_path);
                 if (m_path.length() >= relativePathLength)
                 {
                     m_relativePathOffset = m_path.length() - relativePathLength;
@@ -41,6 +41,8 @@ namespace V
             constexpr static const size_t s_invalidPathHash = std::numeric_limits<size_t>::max();
             constexpr static const size_t s_emptyPathHash = std::numeric_limits<size_t>::min();
 
+            static size_t HashAbsolutePath(const VStd::string& path);
+
             void ResolvePath() const;
             size_t FindAliasOffset(const VStd::string& path) const;
 
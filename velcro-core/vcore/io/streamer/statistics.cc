@@ -40,7 +40,7 @@ namespace V
             [[maybe_unused]] VStd::string_view name,
             [[maybe_unused]] double value)
         {
-            V_PROFILE_DATAPOINT(AzCore, value,
+            V_PROFILE_DATAPOINT(Core, value,
                 "Streamer/%.*s/%.*s (Raw)",
                 v_numeric_cast<int>(owner.size()), owner.data(),
                 v_numeric_cast<int>(name.size()), name.data());
@@ -1,26 +1,309 @@
 #include <vcore/math/crc.h>
+#include <vcore/platform.h>
 
 
 #include <string.h>
 
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#   include <smmintrin.h>
+#   include <nmmintrin.h>
+#   include <wmmintrin.h>
+#endif
+
+#if defined(V_COMPILER_MSVC)
+#   define V_CRC_TARGET(features)
+#else
+#   define V_CRC_TARGET(features) __attribute__((target(features)))
+#endif
+
 namespace V {
+    namespace CrcInternal
+    {
+        //=========================================================================
+        // Slicing-by-8
+        //=========================================================================
+        struct SliceTables
+        {
+            u32 Table[8][256];
+        };
+
+        /// Table[0] is the classic byte table, Table[n] advances a byte through n more zero bytes.
+        constexpr SliceTables MakeSliceTables(u32 polynomial)
+        {
+            SliceTables tables{};
+            for (u32 i = 0; i < 256; ++i)
+            {
+                u32 crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+                }
+                tables.Table[0][i] = crc;
+            }
+            for (u32 i = 0; i < 256; ++i)
+            {
+                for (int slice = 1; slice < 8; ++slice)
+                {
+                    const u32 previous = tables.Table[slice - 1][i];
+                    tables.Table[slice][i] = (previous >> 8) ^ tables.Table[0][previous & 0xff];
+                }
+            }
+            return tables;
+        }
+
+        static constexpr SliceTables s_crc32Tables = MakeSliceTables(0xedb88320);
+        static constexpr SliceTables s_crc32CTables = MakeSliceTables(0x82f63b78);
+
+        V_FORCE_INLINE u32 ReadU32(const u8* data)
+        {
+            return static_cast<u32>(data[0]) | (static_cast<u32>(data[1]) << 8) | (static_cast<u32>(data[2]) << 16) | (static_cast<u32>(data[3]) << 24);
+        }
+
+        static u32 UpdateSliceBy8(const SliceTables& tables, u32 crc, const u8* data, size_t size)
+        {
+            const u32 (&t)[8][256] = tables.Table;
+            for (; size >= 8; size -= 8, data += 8)
+            {
+                const u32 low = crc ^ ReadU32(data);
+                const u32 high = ReadU32(data + 4);
+                crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+                      t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+            }
+            for (; size; --size)
+            {
+                crc = t[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+            }
+            return crc;
+        }
+
+        //=========================================================================
+        // Lower case folding
+        //=========================================================================
+        static constexpr size_t LowerCaseBlockSize = 256;
+
+        /// Copies size bytes to dest with 'A'-'Z' turned into 'a'-'z', the same folding Crc32 applies byte by byte.
+        static void FoldLowerCase(u8* dest, const u8* src, size_t size)
+        {
+            size_t i = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            // signed compares, bytes >= 0x80 are negative and never in range
+            const __m128i beforeA = _mm_set1_epi8('A' - 1);
+            const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+            const __m128i caseBit = _mm_set1_epi8('a' - 'A');
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chars, beforeA), _mm_cmplt_epi8(chars, afterZ));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_add_epi8(chars, _mm_and_si128(isUpper, caseBit)));
+            }
+#endif
+            for (; i < size; ++i)
+            {
+                const u8 c = src[i];
+                dest[i] = (c >= 'A' && c <= 'Z') ? static_cast<u8>(c + 'a' - 'A') : c;
+            }
+        }
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        //=========================================================================
+        // PCLMULQDQ folding
+        //=========================================================================
+        /// Minimum size for the folding kernel, it starts with four 16 byte lanes.
+        static constexpr size_t PclmulMinSize = 64;
+
+        /// Folds 64 bytes at a time with carry-less multiplies, then reduces to 32 bits with a Barrett reduction.
+        /// Constants are the bit reflected ones from "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+        /// Instruction" (Intel). size must be at least PclmulMinSize and a multiple of 16.
+        V_CRC_TARGET("sse4.1,pclmul") static u32 UpdatePclmul(u32 crc, const u8* data, size_t size)
+        {
+            alignas(16) static const u64 k1k2[2] = { 0x0154442bd4ull, 0x01c6e41596ull };
+            alignas(16) static const u64 k3k4[2] = { 0x01751997d0ull, 0x00ccaa009eull };
+            alignas(16) static const u64 k5k0[2] = { 0x0163cd6124ull, 0x0000000000ull };
+            alignas(16) static const u64 poly[2] = { 0x01db710641ull, 0x01f7011641ull };
+
+            __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+            __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+            __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+            __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+            x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+            data += 64;
+            size -= 64;
+
+            // four lanes in parallel
+            __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+            for (; size >= 64; data += 64, size -= 64)
+            {
+                const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+                const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+                const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+                const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+                x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+                x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+                x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+                x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+                x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+                x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+                x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+            }
+
+            // fold the lanes into one
+            k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+            __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+            x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x2), x5);
+            x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+            x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x3), x5);
+            x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+            x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x4), x5);
+
+            for (; size >= 16; data += 16, size -= 16)
+            {
+                x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+                x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+            }
+
+            // 128 to 64 bits
+            const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+            x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+            x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+            k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+            x2 = _mm_srli_si128(x1, 4);
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00), x2);
+
+            // Barrett reduction to 32 bits
+            k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+            x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+            x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+            x1 = _mm_xor_si128(x1, x2);
+            return static_cast<u32>(_mm_extract_epi32(x1, 1));
+        }
+
+        //=========================================================================
+        // SSE4.2 crc32
+        //=========================================================================
+        V_CRC_TARGET("sse4.2") static u32 UpdateSse42(u32 crc, const u8* data, size_t size)
+        {
+#if defined(_M_X64) || defined(__x86_64__)
+            u64 crc64 = crc;
+            for (; size >= 8; data += 8, size -= 8)
+            {
+                u64 word;
+                memcpy(&word, data, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+            }
+            crc = static_cast<u32>(crc64);
+#endif
+            for (; size >= 4; data += 4, size -= 4)
+            {
+                u32 word;
+                memcpy(&word, data, sizeof(word));
+                crc = _mm_crc32_u32(crc, word);
+            }
+            for (; size; --size)
+            {
+                crc = _mm_crc32_u8(crc, *data++);
+            }
+            return crc;
+        }
+#endif // V_TRAIT_USE_PLATFORM_SIMD_SSE
+
+        static u32 UpdateCrc32(u32 crc, const u8* data, size_t size)
+        {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (size >= PclmulMinSize && V::Platform::GetCpuFeatures().HasPclmul)
+            {
+                const size_t foldSize = size & ~static_cast<size_t>(15);
+                crc = UpdatePclmul(crc, data, foldSize);
+                data += foldSize;
+                size -= foldSize;
+            }
+#endif
+            return UpdateSliceBy8(s_crc32Tables, crc, data, size);
+        }
+    } // namespace CrcInternal
+
+    namespace Internal
+    {
+        //=========================================================================
+        // Crc32Update
+        //=========================================================================
+        u32 Crc32Update(u32 crc, const void* data, size_t size, bool forceLowerCase)
+        {
+            const u8* bytes = reinterpret_cast<const u8*>(data);
+            if (!forceLowerCase)
+            {
+                return CrcInternal::UpdateCrc32(crc, bytes, size);
+            }
+
+            u8 folded[CrcInternal::LowerCaseBlockSize];
+            while (size)
+            {
+                const size_t blockSize = size < sizeof(folded) ? size : sizeof(folded);
+                CrcInternal::FoldLowerCase(folded, bytes, blockSize);
+                crc = CrcInternal::UpdateCrc32(crc, folded, blockSize);
+                bytes += blockSize;
+                size -= blockSize;
+            }
+            return crc;
+        }
+
+        //=========================================================================
+        // Crc32CUpdate
+        //=========================================================================
+        u32 Crc32CUpdate(u32 crc, const void* data, size_t size)
+        {
+            const u8* bytes = reinterpret_cast<const u8*>(data);
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (V::Platform::GetCpuFeatures().HasSse42)
+            {
+                return CrcInternal::UpdateSse42(crc, bytes, size);
+            }
+#endif
+            return CrcInternal::UpdateSliceBy8(CrcInternal::s_crc32CTables, crc, bytes, size);
+        }
+    } // namespace Internal
+
     //=========================================================================
     //
     // Crc32 constructor
     //
     //=========================================================================
     Crc32::Crc32(const void* data, size_t size, bool forceLowerCase)
-        : Crc32{ reinterpret_cast<const uint8_t*>(data), size, forceLowerCase } {
+        : m_value{ 0 } {
+        Set(data, size, forceLowerCase);
     }
 
     void Crc32::Set(const void* data, size_t size, bool forceLowerCase) {
-        Internal::Crc32Set(reinterpret_cast<const uint8_t*>(data), size, forceLowerCase, m_value);
+        m_value = data ? Internal::Crc32Update(0xffffffff, data, size, forceLowerCase) ^ 0xffffffff : 0;
     }
 
     //=========================================================================
     // Crc32 - Add
     //=========================================================================
     void Crc32::Add(const void* data, size_t size, bool forceLowerCase) {
-        Combine(Crc32{ data, size, forceLowerCase }, size);
+        // continuing the register gives the same value as combining with the crc of data
+        if (data && size) {
+            m_value = Internal::Crc32Update(m_value ^ 0xffffffff, data, size, forceLowerCase) ^ 0xffffffff;
+        }
+    }
+
+    //=========================================================================
+    //
+    // Crc32C constructor
+    //
+    //=========================================================================
+    Crc32C::Crc32C(const void* data, size_t size)
+        : m_value{ 0 } {
+        Add(data, size);
+    }
+
+    //=========================================================================
+    // Crc32C - Add
+    //=========================================================================
+    void Crc32C::Add(const void* data, size_t size) {
+        if (data && size) {
+            m_value = Internal::Crc32CUpdate(m_value ^ 0xffffffff, data, size) ^ 0xffffffff;
+        }
     }
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 #include <vcore/base.h>
 #include <vcore/std/hash.h>
 #include <vcore/std/string/string_view.h>
+#include <vcore/std/typetraits/is_constant_evaluated.h>
 
 //////////////////////////////////////////////////////////////////////////
 // Macros for pre-processor Crc32 conversion
@@ -94,6 +95,37 @@ namespace V {
     protected:
         u32 m_value;
     };
+
+    /**
+     * CRC-32C (Castagnoli polynomial), the checksum used by storage and network formats (iSCSI, ext4, SCTP...).
+     * Computed with the SSE4.2 crc32 instruction when the CPU has it. Unlike Crc32 there is no lower case folding and
+     * no compile time evaluation, it's meant for checksumming blocks of data.
+     */
+    class Crc32C {
+    public:
+        constexpr Crc32C()
+            : m_value(0)    {  }
+
+        constexpr Crc32C(V::u32 value) : m_value{ value } {}
+
+        /**
+         * Calculates the value from a block of raw data.
+         */
+        Crc32C(const void* data, size_t size);
+
+        /**
+         * Continues the checksum as if data was appended to the data it was calculated from.
+         */
+        void Add(const void* data, size_t size);
+
+        constexpr operator u32() const               { return m_value; }
+
+        constexpr bool operator==(Crc32C rhs) const  { return (m_value == rhs.m_value); }
+        constexpr bool operator!=(Crc32C rhs) const  { return (m_value != rhs.m_value); }
+
+    protected:
+        u32 m_value;
+    };
 }
 
 namespace VStd {
@@ -105,6 +137,14 @@ namespace VStd {
             return hasher(static_cast<V::u32>(id));
         }
     };
+    template<>
+    struct hash<V::Crc32C> {
+        size_t operator()(const V::Crc32C& id) const
+        {
+            VStd::hash<V::u32> hasher;
+            return hasher(static_cast<V::u32>(id));
+        }
+    };
 }
 
 #include <vcore/math/crc.inl>
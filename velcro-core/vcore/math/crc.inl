@@ -99,6 +99,12 @@ namespace V {
         template <auto CrcValue>
         inline static constexpr V::Crc32 CompileTimeCrc32 = V::Crc32(CrcValue);
 
+        /// Runs the CRC-32 register over data with the fastest kernel of the CPU (PCLMULQDQ folding or slicing-by-8).
+        /// crc is the raw register, start with 0xffffffff and invert the result.
+        u32 Crc32Update(u32 crc, const void* data, size_t size, bool forceLowerCase);
+        /// Same for CRC-32C, with the SSE4.2 crc32 instruction or slicing-by-8.
+        u32 Crc32CUpdate(u32 crc, const void* data, size_t size);
+
         constexpr unsigned int ComputeCrc32Octet(unsigned int currentCrc, uint8_t dataOctet)
         {
             return crc_table[(static_cast<int>(currentCrc) ^ dataOctet) & 0xff] ^ (currentCrc >> 8);
@@ -112,6 +118,11 @@ namespace V {
             {
                 value = 0;
             }
+            else if (!VStd::is_constant_evaluated())
+            {
+                // run time calls go to the kernels in crc.cc
+                value = Crc32Update(0xffffffff, buf, size, forceLowerCase) ^ 0xffffffff;
+            }
             else
             {
                 unsigned int crc = 0xffffffffL;
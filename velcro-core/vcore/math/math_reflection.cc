@@ -9,8 +9,9 @@
 
 namespace V
 {
-    void MathReflect(SerializeContext& context)
+    void MathReflect(ReflectContext* context)
     {
+        V_UNUSED(context);
         // aggregates
         //context.Class<Uuid>()->
         //    Serializer<UuidSerializer>();
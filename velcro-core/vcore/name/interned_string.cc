@@ -0,0 +1,383 @@
+#include <vcore/name/interned_string.h>
+#include <vcore/std/hash.h>
+#include <vcore/std/parallel/lock.h>
+
+#include <string.h>
+
+namespace V
+{
+    using Internal::InternedStringEntry;
+
+    namespace InternedStringInternal
+    {
+        static constexpr size_t MinTableCapacity = 64;
+
+        // Marks a slot whose entry was removed, lookups continue past it
+        static InternedStringEntry* Tombstone()
+        {
+            return reinterpret_cast<InternedStringEntry*>(alignof(InternedStringEntry));
+        }
+
+        static bool IsEntry(const InternedStringEntry* entry)
+        {
+            return entry != nullptr && entry != Tombstone();
+        }
+
+        static bool Matches(const InternedStringEntry* entry, VStd::string_view str, size_t hash)
+        {
+            return entry->m_hash == hash && entry->m_size == str.size() && memcmp(entry->GetChars(), str.data(), str.size()) == 0;
+        }
+    }
+    using namespace InternedStringInternal;
+
+    //! Open addressed table with linear probing. It is kept at most half full, tombstones included,
+    //! so a probe always reaches an empty slot.
+    struct InternedStringPool::Table
+    {
+        size_t m_mask;
+        VStd::atomic<InternedStringEntry*>* m_slots;
+    };
+
+    struct InternedStringPool::ArenaBlock
+    {
+        ArenaBlock* m_next;
+        size_t m_byteSize;
+    };
+
+    class InternedStringPool::ReaderScope
+    {
+    public:
+        ReaderScope(const InternedStringPool& pool)
+            : m_pool(pool.m_lifetime == Lifetime::RefCounted ? &pool : nullptr)
+        {
+            // Entries of a Forever pool are never removed, so there is nothing to protect
+            if (m_pool)
+            {
+                m_pool->m_activeReaders.fetch_add(1, VStd::memory_order_relaxed);
+                // Pairs with the fence in ReclaimRetired, either the pool sees this reader or this reader sees the
+                // table and slots as they were after the pool retired its entries
+                VStd::atomic_thread_fence(VStd::memory_order_seq_cst);
+            }
+        }
+
+        ~ReaderScope()
+        {
+            if (!m_pool)
+            {
+                return;
+            }
+            if (m_pool->m_activeReaders.fetch_sub(1, VStd::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+
+            // This was the last running lookup. Pairs with the fence in ReclaimRetired, either the pool sees that no
+            // lookup is running and frees what it retired itself, or this lookup sees that something was retired.
+            VStd::atomic_thread_fence(VStd::memory_order_seq_cst);
+            if (m_pool->m_hasRetired.load(VStd::memory_order_relaxed))
+            {
+                // Lookups never hold the mutex, and a new lookup may have started meanwhile, which ReclaimRetired checks
+                VStd::lock_guard<VStd::mutex> lock(m_pool->m_mutex);
+                m_pool->ReclaimRetired();
+            }
+        }
+
+    private:
+        const InternedStringPool* m_pool;
+    };
+
+    InternedStringPool::InternedStringPool(Lifetime lifetime, size_t arenaBlockSize)
+        : m_arenaBlockSize(arenaBlockSize)
+        , m_lifetime(lifetime)
+    {
+        m_table.store(CreateTable(MinTableCapacity), VStd::memory_order_relaxed);
+    }
+
+    InternedStringPool::~InternedStringPool()
+    {
+        Table* table = m_table.load(VStd::memory_order_relaxed);
+        [[maybe_unused]] bool leaksDetected = false;
+        for (size_t index = 0; index <= table->m_mask; ++index)
+        {
+            InternedStringEntry* entry = table->m_slots[index].load(VStd::memory_order_relaxed);
+            if (!IsEntry(entry) || m_lifetime == Lifetime::Forever)
+            {
+                continue;
+            }
+
+            if (const int useCount = entry->m_useCount; useCount > 0)
+            {
+                leaksDetected = true;
+                V_TracePrintf("InternedStringPool", "\tLeaked InternedString [%3d reference(s)]: '%.*s'\n",
+                    useCount, static_cast<int>(entry->m_size), entry->GetChars());
+            }
+            vfree(entry, V::SystemAllocator);
+        }
+        V_Assert(!leaksDetected, "InternedStringPool still has active string references. See debug output for the list of leaked strings.");
+
+        for (InternedStringEntry* entry : m_retiredEntries)
+        {
+            vfree(entry, V::SystemAllocator);
+        }
+        for (Table* retiredTable : m_retiredTables)
+        {
+            vfree(retiredTable, V::SystemAllocator);
+        }
+        vfree(table, V::SystemAllocator);
+
+        while (m_arenaBlocks)
+        {
+            ArenaBlock* next = m_arenaBlocks->m_next;
+            vfree(m_arenaBlocks, V::SystemAllocator);
+            m_arenaBlocks = next;
+        }
+    }
+
+    InternedString InternedStringPool::Intern(VStd::string_view str)
+    {
+        if (str.empty())
+        {
+            return InternedString();
+        }
+
+        const size_t hash = VStd::hash<VStd::string_view>{}(str);
+        {
+            ReaderScope reader(*this);
+            if (InternedStringEntry* entry = AcquireExisting(*m_table.load(VStd::memory_order_acquire), str, hash))
+            {
+                return InternedString(entry);
+            }
+        }
+
+        // The string isn't in the pool, or its entry is being removed, so take the lock to add it
+        VStd::lock_guard<VStd::mutex> lock(m_mutex);
+
+        // Entries are only removed with the lock held, so an entry found now has a count of 0 or more
+        if (InternedStringEntry* entry = AcquireExisting(*m_table.load(VStd::memory_order_relaxed), str, hash))
+        {
+            return InternedString(entry);
+        }
+
+        if ((m_count + m_tombstoneCount + 1) * 2 > m_table.load(VStd::memory_order_relaxed)->m_mask + 1)
+        {
+            Grow();
+        }
+
+        const Table& table = *m_table.load(VStd::memory_order_relaxed);
+        size_t index = hash & table.m_mask;
+        InternedStringEntry* slotEntry = table.m_slots[index].load(VStd::memory_order_relaxed);
+        while (IsEntry(slotEntry))
+        {
+            index = (index + 1) & table.m_mask;
+            slotEntry = table.m_slots[index].load(VStd::memory_order_relaxed);
+        }
+        if (slotEntry == Tombstone())
+        {
+            --m_tombstoneCount;
+        }
+
+        InternedStringEntry* entry = CreateEntry(str, hash);
+        table.m_slots[index].store(entry, VStd::memory_order_release);
+        ++m_count;
+        return InternedString(entry);
+    }
+
+    InternedString InternedStringPool::Find(VStd::string_view str) const
+    {
+        if (str.empty())
+        {
+            return InternedString();
+        }
+
+        const size_t hash = VStd::hash<VStd::string_view>{}(str);
+        ReaderScope reader(*this);
+        return InternedString(AcquireExisting(*m_table.load(VStd::memory_order_acquire), str, hash));
+    }
+
+    auto InternedStringPool::GetLifetime() const -> Lifetime
+    {
+        return m_lifetime;
+    }
+
+    size_t InternedStringPool::GetCount() const
+    {
+        VStd::lock_guard<VStd::mutex> lock(m_mutex);
+        return m_count;
+    }
+
+    auto InternedStringPool::CreateTable(size_t capacity) -> Table*
+    {
+        void* memory = vmalloc(sizeof(Table) + capacity * sizeof(VStd::atomic<InternedStringEntry*>),
+            alignof(Table), V::SystemAllocator, "InternedStringPool");
+        Table* table = new (memory) Table;
+        table->m_mask = capacity - 1;
+        table->m_slots = reinterpret_cast<VStd::atomic<InternedStringEntry*>*>(table + 1);
+        for (size_t index = 0; index < capacity; ++index)
+        {
+            new (&table->m_slots[index]) VStd::atomic<InternedStringEntry*>(nullptr);
+        }
+        return table;
+    }
+
+    InternedStringEntry* InternedStringPool::CreateEntry(VStd::string_view str, size_t hash)
+    {
+        const size_t byteSize = sizeof(InternedStringEntry) + str.size() + 1;
+        void* memory = m_lifetime == Lifetime::Forever
+            ? AllocateFromArena(byteSize)
+            : vmalloc(byteSize, alignof(InternedStringEntry), V::SystemAllocator, "InternedString");
+
+        InternedStringEntry* entry = new (memory) InternedStringEntry;
+        entry->m_hash = hash;
+        entry->m_pool = m_lifetime == Lifetime::RefCounted ? this : nullptr;
+        entry->m_useCount.store(1, VStd::memory_order_relaxed);
+        entry->m_size = static_cast<uint32_t>(str.size());
+        char* chars = reinterpret_cast<char*>(entry + 1);
+        memcpy(chars, str.data(), str.size());
+        chars[str.size()] = '\0';
+        return entry;
+    }
+
+    void* InternedStringPool::AllocateFromArena(size_t byteSize)
+    {
+        byteSize = (byteSize + alignof(InternedStringEntry) - 1) & ~(alignof(InternedStringEntry) - 1);
+        if (static_cast<size_t>(m_arenaEnd - m_arenaCursor) < byteSize)
+        {
+            // Strings larger than a block get a block of their own
+            const size_t blockSize = VStd::max(m_arenaBlockSize, byteSize + sizeof(ArenaBlock));
+            ArenaBlock* block = reinterpret_cast<ArenaBlock*>(vmalloc(blockSize, alignof(ArenaBlock), V::SystemAllocator, "InternedStringPool"));
+            block->m_next = m_arenaBlocks;
+            block->m_byteSize = blockSize;
+            m_arenaBlocks = block;
+            m_arenaCursor = reinterpret_cast<char*>(block + 1);
+            m_arenaEnd = reinterpret_cast<char*>(block) + blockSize;
+        }
+
+        void* memory = m_arenaCursor;
+        m_arenaCursor += byteSize;
+        return memory;
+    }
+
+    InternedStringEntry* InternedStringPool::AcquireExisting(const Table& table, VStd::string_view str, size_t hash) const
+    {
+        for (size_t index = hash & table.m_mask;; index = (index + 1) & table.m_mask)
+        {
+            InternedStringEntry* entry = table.m_slots[index].load(VStd::memory_order_acquire);
+            if (entry == nullptr)
+            {
+                return nullptr;
+            }
+            if (entry == Tombstone() || !Matches(entry, str, hash))
+            {
+                continue;
+            }
+            if (!entry->m_pool)
+            {
+                return entry;
+            }
+
+            // An entry whose count dropped to 0 can still be taken back until the pool marks it with -1
+            int useCount = entry->m_useCount.load(VStd::memory_order_relaxed);
+            while (useCount >= 0)
+            {
+                if (entry->m_useCount.compare_exchange_weak(useCount, useCount + 1, VStd::memory_order_acquire, VStd::memory_order_relaxed))
+                {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    void InternedStringPool::Grow()
+    {
+        const Table* oldTable = m_table.load(VStd::memory_order_relaxed);
+        size_t capacity = oldTable->m_mask + 1;
+        while ((m_count + 1) * 4 > capacity)
+        {
+            capacity *= 2;
+        }
+
+        Table* newTable = CreateTable(capacity);
+        for (size_t index = 0; index <= oldTable->m_mask; ++index)
+        {
+            InternedStringEntry* entry = oldTable->m_slots[index].load(VStd::memory_order_relaxed);
+            if (!IsEntry(entry))
+            {
+                continue;
+            }
+            size_t newIndex = entry->m_hash & newTable->m_mask;
+            while (newTable->m_slots[newIndex].load(VStd::memory_order_relaxed) != nullptr)
+            {
+                newIndex = (newIndex + 1) & newTable->m_mask;
+            }
+            newTable->m_slots[newIndex].store(entry, VStd::memory_order_relaxed);
+        }
+
+        m_table.store(newTable, VStd::memory_order_release);
+        m_retiredTables.push_back(const_cast<Table*>(oldTable));
+        m_tombstoneCount = 0;
+        ReclaimRetired();
+    }
+
+    void InternedStringPool::TryRelease(InternedStringEntry* entry, size_t hash)
+    {
+        VStd::lock_guard<VStd::mutex> lock(m_mutex);
+
+        // The entry may already have been removed and freed by an earlier release,
+        // in which case it isn't in the table anymore and must not be touched
+        const Table& table = *m_table.load(VStd::memory_order_relaxed);
+        size_t index = hash & table.m_mask;
+        for (InternedStringEntry* slotEntry = table.m_slots[index].load(VStd::memory_order_relaxed); slotEntry != entry;
+             slotEntry = table.m_slots[index].load(VStd::memory_order_relaxed))
+        {
+            if (slotEntry == nullptr)
+            {
+                return;
+            }
+            index = (index + 1) & table.m_mask;
+        }
+
+        // A lookup may have taken a new reference since the count reached 0
+        int expectedUseCount = 0;
+        if (!entry->m_useCount.compare_exchange_strong(expectedUseCount, -1, VStd::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        table.m_slots[index].store(Tombstone(), VStd::memory_order_release);
+        --m_count;
+        ++m_tombstoneCount;
+        m_retiredEntries.push_back(entry);
+        ReclaimRetired();
+    }
+
+    void InternedStringPool::ReclaimRetired() const
+    {
+        // Lookups of a Forever pool aren't counted, its tables are kept until the pool is destroyed.
+        // They only grow, so the retired tables take less memory than the current one.
+        if (m_lifetime == Lifetime::Forever || (m_retiredEntries.empty() && m_retiredTables.empty()))
+        {
+            return;
+        }
+
+        // A lookup that starts after the entries and tables were retired can't reach them, so once no lookup
+        // is running nothing can be reading them anymore. If one is, the last one to finish sees the flag.
+        m_hasRetired.store(true, VStd::memory_order_relaxed);
+        VStd::atomic_thread_fence(VStd::memory_order_seq_cst);
+        if (m_activeReaders.load(VStd::memory_order_acquire) != 0)
+        {
+            return;
+        }
+        m_hasRetired.store(false, VStd::memory_order_relaxed);
+        for (InternedStringEntry* entry : m_retiredEntries)
+        {
+            vfree(entry, V::SystemAllocator);
+        }
+        m_retiredEntries.clear();
+        for (Table* table : m_retiredTables)
+        {
+            vfree(table, V::SystemAllocator);
+        }
+        m_retiredTables.clear();
+    }
+} // namespace V
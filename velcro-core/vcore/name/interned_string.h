@@ -0,0 +1,271 @@
+#ifndef V_FRAMEWORK_CORE_NAME_INTERNED_STRING_H
+#define V_FRAMEWORK_CORE_NAME_INTERNED_STRING_H
+
+#include <vcore/memory/system_allocator.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/mutex.h>
+#include <vcore/std/string/string_view.h>
+
+
+namespace V
+{
+    class InternedStringPool;
+
+    namespace Internal
+    {
+        //! A string held by an InternedStringPool. The characters and a null terminator follow the entry in the same allocation.
+        struct InternedStringEntry
+        {
+            size_t m_hash;
+            //! Pool of a reference counted entry, null for the entries of a Forever pool.
+            InternedStringPool* m_pool;
+            //! Number of InternedString objects referring to the entry, -1 once the pool has removed it.
+            VStd::atomic_int m_useCount;
+            uint32_t m_size;
+
+            const char* GetChars() const
+            {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+    }
+
+    //! An immutable string held by an InternedStringPool.
+    //! A pool keeps a single copy of each string, so InternedString objects of the same pool compare equal
+    //! exactly when they point to the same entry, and the hash is computed once when the string is interned.
+    //!
+    //! Copying an InternedString of a RefCounted pool increments an atomic count, copying one of a Forever pool
+    //! only copies a pointer. Strings of different pools never compare equal, even if they have the same characters.
+    //! The pool must outlive all of its InternedString objects.
+    class InternedString
+    {
+        friend InternedStringPool;
+    public:
+        V_CLASS_ALLOCATOR(InternedString, V::SystemAllocator, 0);
+
+        InternedString() = default;
+        InternedString(const InternedString& rhs);
+        InternedString(InternedString&& rhs);
+        ~InternedString();
+        InternedString& operator=(const InternedString& rhs);
+        InternedString& operator=(InternedString&& rhs);
+
+        //! Returns the string's value.
+        //! This is always null-terminated and points to a string in memory (i.e. it will return "" instead of null).
+        VStd::string_view GetStringView() const;
+        const char* GetCStr() const;
+
+        bool IsEmpty() const
+        {
+            return m_entry == nullptr;
+        }
+
+        //! Returns VStd::hash<VStd::string_view> of the string, which was computed when the string was interned.
+        size_t GetHash() const
+        {
+            return m_entry ? m_entry->m_hash : 0;
+        }
+
+        bool operator==(const InternedString& other) const
+        {
+            return m_entry == other.m_entry;
+        }
+
+        bool operator!=(const InternedString& other) const
+        {
+            return m_entry != other.m_entry;
+        }
+
+        // As with Name, the point of InternedString is fast equality comparison and lookup, unordered containers should be used.
+        friend bool operator<(const InternedString& lhs, const InternedString& rhs) = delete;
+        friend bool operator<=(const InternedString& lhs, const InternedString& rhs) = delete;
+        friend bool operator>(const InternedString& lhs, const InternedString& rhs) = delete;
+        friend bool operator>=(const InternedString& lhs, const InternedString& rhs) = delete;
+
+    private:
+        // Takes over a reference that the pool has already added to the entry.
+        explicit InternedString(Internal::InternedStringEntry* entry);
+
+        void AddRef() const;
+        void Release();
+
+        Internal::InternedStringEntry* m_entry = nullptr;
+    };
+
+    //! A table of unique strings for InternedString objects, meant to be owned by the subsystem that uses the strings.
+    //! Unlike the global NameDictionary, each subsystem can keep its own pool and choose how long its strings live.
+    //!
+    //! Looking up a string that is already in the pool doesn't take a lock, the table is open addressed and new
+    //! tables are published atomically when it grows. Adding a string takes the pool's mutex.
+    //!
+    //! Strings of a Forever pool are allocated from arena blocks and released all together with the pool.
+    //! Strings of a RefCounted pool are allocated one by one and removed when their last InternedString is gone, the
+    //! memory is reclaimed once no lookup that could still see it is running.
+    class InternedStringPool final
+    {
+        friend InternedString;
+    public:
+        enum class Lifetime : uint8_t
+        {
+            RefCounted, //!< Strings are removed once no InternedString refers to them.
+            Forever     //!< Strings stay until the pool is destroyed, InternedString objects don't count references.
+        };
+
+        V_CLASS_ALLOCATOR(InternedStringPool, V::SystemAllocator, 0);
+
+        //! @param lifetime How long the strings of this pool live.
+        //! @param arenaBlockSize Size of the blocks that the strings of a Forever pool are allocated from.
+        explicit InternedStringPool(Lifetime lifetime = Lifetime::RefCounted, size_t arenaBlockSize = 16 * 1024);
+        ~InternedStringPool();
+
+        InternedStringPool(const InternedStringPool&) = delete;
+        InternedStringPool& operator=(const InternedStringPool&) = delete;
+
+        //! Returns the pool's InternedString for str, adding str to the pool if it isn't in it yet.
+        //! An empty str returns an empty InternedString.
+        InternedString Intern(VStd::string_view str);
+
+        //! Returns the pool's InternedString for str without adding it, or an empty InternedString if str isn't in the pool.
+        InternedString Find(VStd::string_view str) const;
+
+        Lifetime GetLifetime() const;
+
+        //! Returns the number of strings in the pool.
+        size_t GetCount() const;
+
+    private:
+        struct Table;
+        struct ArenaBlock;
+
+        // Counts a lookup that is reading the table without the mutex, so that removed entries are not freed under it.
+        class ReaderScope;
+
+        Table* CreateTable(size_t capacity);
+        Internal::InternedStringEntry* CreateEntry(VStd::string_view str, size_t hash);
+        void* AllocateFromArena(size_t byteSize);
+
+        // Returns the entry for str with a reference added, or null if it isn't in the table or is being removed.
+        Internal::InternedStringEntry* AcquireExisting(const Table& table, VStd::string_view str, size_t hash) const;
+        void Grow();
+
+        // Removes the entry if its count is still 0. Called when the last InternedString that refers to it is released.
+        void TryRelease(Internal::InternedStringEntry* entry, size_t hash);
+        // Frees the removed entries and replaced tables if no lookup is running, otherwise the last running lookup
+        // frees them when it finishes. Must be called with the mutex held.
+        void ReclaimRetired() const;
+
+        VStd::atomic<Table*> m_table;
+        mutable VStd::atomic_uint m_activeReaders = { 0 };
+        // Set while there are retired entries or tables, tells the last lookup to leave that it has to reclaim them
+        mutable VStd::atomic_bool m_hasRetired = { false };
+        mutable VStd::mutex m_mutex;
+        size_t m_count = 0;
+        size_t m_tombstoneCount = 0;
+
+        // Tables replaced by Grow and entries removed from the table, which a running lookup may still be reading.
+        mutable VStd::vector<Table*> m_retiredTables;
+        mutable VStd::vector<Internal::InternedStringEntry*> m_retiredEntries;
+
+        ArenaBlock* m_arenaBlocks = nullptr;
+        char* m_arenaCursor = nullptr;
+        char* m_arenaEnd = nullptr;
+        size_t m_arenaBlockSize;
+
+        Lifetime m_lifetime;
+    };
+
+    inline void InternedString::AddRef() const
+    {
+        if (m_entry && m_entry->m_pool)
+        {
+            m_entry->m_useCount.fetch_add(1, VStd::memory_order_relaxed);
+        }
+    }
+
+    inline void InternedString::Release()
+    {
+        if (m_entry && m_entry->m_pool)
+        {
+            // The entry can be freed as soon as the count reaches 0, so read what TryRelease needs first
+            InternedStringPool* pool = m_entry->m_pool;
+            const size_t hash = m_entry->m_hash;
+            if (m_entry->m_useCount.fetch_sub(1, VStd::memory_order_acq_rel) == 1)
+            {
+                pool->TryRelease(m_entry, hash);
+            }
+        }
+        m_entry = nullptr;
+    }
+
+    inline InternedString::InternedString(Internal::InternedStringEntry* entry)
+        : m_entry(entry)
+    {}
+
+    inline InternedString::InternedString(const InternedString& rhs)
+        : m_entry(rhs.m_entry)
+    {
+        AddRef();
+    }
+
+    inline InternedString::InternedString(InternedString&& rhs)
+        : m_entry(rhs.m_entry)
+    {
+        rhs.m_entry = nullptr;
+    }
+
+    inline InternedString::~InternedString()
+    {
+        Release();
+    }
+
+    inline InternedString& InternedString::operator=(const InternedString& rhs)
+    {
+        if (m_entry != rhs.m_entry)
+        {
+            rhs.AddRef();
+            Release();
+            m_entry = rhs.m_entry;
+        }
+        return *this;
+    }
+
+    inline InternedString& InternedString::operator=(InternedString&& rhs)
+    {
+        if (this != &rhs)
+        {
+            Release();
+            m_entry = rhs.m_entry;
+            rhs.m_entry = nullptr;
+        }
+        return *this;
+    }
+
+    inline VStd::string_view InternedString::GetStringView() const
+    {
+        return m_entry ? VStd::string_view(m_entry->GetChars(), m_entry->m_size) : VStd::string_view("");
+    }
+
+    inline const char* InternedString::GetCStr() const
+    {
+        return m_entry ? m_entry->GetChars() : "";
+    }
+} // namespace V
+
+namespace VStd
+{
+    template <typename T>
+    struct hash;
+
+    // hashing support for STL containers
+    template <>
+    struct hash<V::InternedString>
+    {
+        size_t operator()(const V::InternedString& value) const
+        {
+            return value.GetHash();
+        }
+    };
+}
+
+#endif // V_FRAMEWORK_CORE_NAME_INTERNED_STRING_H
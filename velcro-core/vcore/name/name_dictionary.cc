@@ -276,9 +276,10 @@ namespace V
 
     Name::Hash NameDictionary::CalcHash(VStd::string_view name)
     {
-        // VStd::hash<VStd::string_view> returns 64 bits but we want 32 bit hashes for the sake
-        // of network synchronization. So just take the low 32 bits.
-        const uint32_t hash = VStd::hash<VStd::string_view>()(name) & 0xFFFFFFFF;
+        // Name hashes are sent over the network, so they stay on the FNV-1a hash_string whatever VStd::hash uses
+        // for strings. It returns 64 bits but we want 32 bit hashes for the sake of network synchronization,
+        // so just take the low 32 bits.
+        const uint32_t hash = VStd::hash_string(name.data(), name.size()) & 0xFFFFFFFF;
         return hash;
     }
 }
\ No newline at end of file
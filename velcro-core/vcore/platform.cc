@@ -1,4 +1,13 @@
 #include <vcore/platform.h>
+#include <vcore/vcore_traits_platform.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   if defined(V_COMPILER_MSVC)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
 
 namespace V {
     namespace Platform {
@@ -10,5 +19,72 @@ namespace V {
                 _machineId = machineId;
             }
         }*/
+
+        namespace Internal {
+            //! Returns false if the leaf is above the highest one the processor supports.
+            static bool ReadCpuId(unsigned int leaf, unsigned int subLeaf, unsigned int (&registers)[4])
+            {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   if defined(V_COMPILER_MSVC)
+                int info[4];
+                __cpuid(info, static_cast<int>(leaf & 0x80000000u));
+                if (static_cast<unsigned int>(info[0]) < leaf) {
+                    return false;
+                }
+                __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+                for (int i = 0; i < 4; ++i) {
+                    registers[i] = static_cast<unsigned int>(info[i]);
+                }
+                return true;
+#   else
+                return __get_cpuid_count(leaf, subLeaf, &registers[0], &registers[1], &registers[2], &registers[3]) != 0;
+#   endif
+#else
+                (void)leaf;
+                (void)subLeaf;
+                (void)registers;
+                return false;
+#endif
+            }
+
+            static CpuFeatures QueryCpuFeatures()
+            {
+                CpuFeatures features;
+                unsigned int leaf1[4] = {};
+                unsigned int leaf7[4] = {};
+                unsigned int leaf80000007[4] = {};
+                ReadCpuId(1, 0, leaf1);
+                ReadCpuId(7, 0, leaf7);
+                ReadCpuId(0x80000007u, 0, leaf80000007);
+
+                const unsigned int leaf1Ecx = leaf1[2];
+                features.HasSsse3 = (leaf1Ecx & (1u << 9)) != 0;
+                features.HasSse42 = (leaf1Ecx & (1u << 20)) != 0;
+                features.HasPclmul = (leaf1Ecx & (1u << 19)) != 0 && (leaf1Ecx & (1u << 1)) != 0;
+                features.HasInvariantTsc = (leaf80000007[3] & (1u << 8)) != 0;
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+                // AVX and OSXSAVE, then check that the OS saves the ymm registers
+                const unsigned int avxBits = (1u << 27) | (1u << 28);
+                if ((leaf1Ecx & avxBits) == avxBits && (leaf7[1] & (1u << 5)) != 0) {
+#   if defined(V_COMPILER_MSVC)
+                    const unsigned long long xcr0 = _xgetbv(0);
+#   else
+                    unsigned int xcr0Low, xcr0High;
+                    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+                    const unsigned long long xcr0 = xcr0Low;
+#   endif
+                    features.HasAvx2 = (xcr0 & 6) == 6;
+                }
+#endif
+                return features;
+            }
+        }
+
+        const CpuFeatures& GetCpuFeatures()
+        {
+            static const CpuFeatures features = Internal::QueryCpuFeatures();
+            return features;
+        }
     }
-}
\ No newline at end of file
+}
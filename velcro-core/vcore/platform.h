@@ -3,4 +3,18 @@
 
 #include <vcore/base.h>
 
-#endif // V_FRAMEWORK_CORE_PLATFORM_H
\ No newline at end of file
+namespace V::Platform {
+    //! Instruction set extensions of the processor, read with cpuid the first time GetCpuFeatures() is called.
+    //! All false on processors without cpuid, the SIMD code paths then fall back to their scalar versions.
+    struct CpuFeatures {
+        bool HasSsse3 = false;
+        bool HasSse42 = false;
+        bool HasPclmul = false;         //!< PCLMULQDQ and SSE4.1.
+        bool HasAvx2 = false;           //!< Also requires the OS to save the ymm registers.
+        bool HasInvariantTsc = false;   //!< The time stamp counter ticks at a constant rate and is synchronized between cores.
+    };
+
+    const CpuFeatures& GetCpuFeatures();
+}
+
+#endif // V_FRAMEWORK_CORE_PLATFORM_H
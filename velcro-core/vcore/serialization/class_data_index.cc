@@ -0,0 +1,148 @@
+#include <vcore/serialization/class_data_index.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/std/parallel/atomic.h>
+
+#include <string.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace V
+{
+    namespace ClassDataIndexInternal
+    {
+        /// Uuid::GetHash only uses the first bytes, ids made from names need all of them mixed in.
+        static u64 HashTypeId(const Uuid& typeId)
+        {
+            u64 low;
+            u64 high;
+            memcpy(&low, typeId.data, sizeof(low));
+            memcpy(&high, typeId.data + sizeof(low), sizeof(high));
+            u64 hash = low ^ (high * 0x9e3779b97f4a7c15ull);
+            hash ^= hash >> 31;
+            hash *= 0xbf58476d1ce4e5b9ull;
+            hash ^= hash >> 29;
+            return hash;
+        }
+
+        /// Tags are never 0, that marks an empty slot.
+        V_FORCE_INLINE u32 GetTag(u64 hash)
+        {
+            return static_cast<u32>(hash >> 32) | 1;
+        }
+
+        /// Returns a bit per slot of group whose tag equals tag.
+        V_FORCE_INLINE u32 MatchTags(const u32* tags, u32 tag)
+        {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(tags));
+            const __m128i match = _mm_cmpeq_epi32(group, _mm_set1_epi32(static_cast<int>(tag)));
+            return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(match)));
+#else
+            return (tags[0] == tag ? 1u : 0u) | (tags[1] == tag ? 2u : 0u) | (tags[2] == tag ? 4u : 0u) | (tags[3] == tag ? 8u : 0u);
+#endif
+        }
+
+        static VStd::atomic<u64> s_nextGeneration{ 1 };
+
+        struct RecentEntry
+        {
+            u64 Generation;
+            const ClassDataIndex::Entry* EntryPtr;
+        };
+
+        // Generations are never reused, so a slot with a matching generation always points into the live index asking for it.
+        static V_THREAD_LOCAL RecentEntry t_recentEntries[4];
+        static V_THREAD_LOCAL u32 t_nextRecentEntry;
+    } // namespace ClassDataIndexInternal
+
+    //=========================================================================
+    // ClassDataIndex
+    //=========================================================================
+    ClassDataIndex::ClassDataIndex(VStd::vector<Entry>&& entries)
+        : m_entries(VStd::move(entries))
+        , m_generation(ClassDataIndexInternal::s_nextGeneration.fetch_add(1))
+    {
+        static_assert(sizeof(ClassDataIndexInternal::t_recentEntries) / sizeof(ClassDataIndexInternal::t_recentEntries[0]) == RecentCacheSize, "Recent entry cache size mismatch");
+
+        // keep the table at most half full, so probes rarely go past the first group
+        size_t numGroups = 1;
+        while (numGroups * GroupWidth < m_entries.size() * 2)
+        {
+            numGroups <<= 1;
+        }
+        m_groupMask = numGroups - 1;
+        m_groups.resize(numGroups);
+        memset(m_groups.data(), 0, numGroups * sizeof(Group));
+
+        for (size_t entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+        {
+            const u64 hash = ClassDataIndexInternal::HashTypeId(m_entries[entryIndex].TypeId);
+            for (size_t groupIndex = hash & m_groupMask;; groupIndex = (groupIndex + 1) & m_groupMask)
+            {
+                Group& group = m_groups[groupIndex];
+                const u32 emptySlots = ClassDataIndexInternal::MatchTags(group.Tags, 0);
+                if (emptySlots)
+                {
+                    const u32 slot = v_ctz_u32(emptySlots);
+                    group.Tags[slot] = ClassDataIndexInternal::GetTag(hash);
+                    group.Entries[slot] = static_cast<u32>(entryIndex);
+                    break;
+                }
+            }
+        }
+    }
+
+    //=========================================================================
+    // Find
+    //=========================================================================
+    const ClassDataIndex::Entry* ClassDataIndex::Find(const Uuid& typeId) const
+    {
+        using namespace ClassDataIndexInternal;
+
+        for (const RecentEntry& recent : t_recentEntries)
+        {
+            if (recent.Generation == m_generation && recent.EntryPtr->TypeId == typeId)
+            {
+                return recent.EntryPtr;
+            }
+        }
+
+        const Entry* entry = FindInTable(typeId);
+        if (entry)
+        {
+            RecentEntry& recent = t_recentEntries[t_nextRecentEntry++ % RecentCacheSize];
+            recent.Generation = m_generation;
+            recent.EntryPtr = entry;
+        }
+        return entry;
+    }
+
+    //=========================================================================
+    // FindInTable
+    //=========================================================================
+    const ClassDataIndex::Entry* ClassDataIndex::FindInTable(const Uuid& typeId) const
+    {
+        const u64 hash = ClassDataIndexInternal::HashTypeId(typeId);
+        const u32 tag = ClassDataIndexInternal::GetTag(hash);
+        for (size_t groupIndex = hash & m_groupMask;; groupIndex = (groupIndex + 1) & m_groupMask)
+        {
+            const Group& group = m_groups[groupIndex];
+            for (u32 matches = ClassDataIndexInternal::MatchTags(group.Tags, tag); matches; matches &= matches - 1)
+            {
+                const Entry& entry = m_entries[group.Entries[v_ctz_u32(matches)]];
+                if (entry.TypeId == typeId)
+                {
+                    return &entry;
+                }
+            }
+
+            // the entry would have been placed in the first free slot
+            if (ClassDataIndexInternal::MatchTags(group.Tags, 0))
+            {
+                return nullptr;
+            }
+        }
+    }
+} // namespace V
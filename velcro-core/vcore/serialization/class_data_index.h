@@ -0,0 +1,57 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_CLASS_DATA_INDEX_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_CLASS_DATA_INDEX_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/std/containers/vector.h>
+
+namespace V
+{
+    /**
+     * Read only lookup table from type ids to ClassData, built by SerializeContext::FreezeClassIndex once
+     * reflection is complete.
+     *
+     * Entries live in one flat array. The table is open addressed in groups of four 32 bit tags, so a probe
+     * compares a whole group with a single SIMD compare and only touches the entry when a tag matches. Each thread
+     * also remembers the last few entries it found, serialization asks for the same handful of types over and over.
+     *
+     * The index is immutable, it's dropped and has to be frozen again when reflection changes.
+     */
+    class ClassDataIndex
+    {
+    public:
+        V_CLASS_ALLOCATOR(ClassDataIndex, SystemAllocator, 0);
+
+        struct Entry
+        {
+            Uuid TypeId;
+            const SerializeContext::ClassData* ClassDataPtr;   ///< Class reflected with this id, null if it's only known as a fallback.
+            const SerializeContext::ClassData* FallbackPtr;    ///< Generic class info or underlying enum type, used when the parent scope has no match.
+        };
+
+        explicit ClassDataIndex(VStd::vector<Entry>&& entries);
+
+        /// Returns the entry of typeId or null if the id is unknown.
+        const Entry* Find(const Uuid& typeId) const;
+
+        size_t GetNumEntries() const { return m_entries.size(); }
+
+    private:
+        static constexpr u32 GroupWidth = 4;
+        static constexpr u32 RecentCacheSize = 4;
+
+        struct alignas(16) Group
+        {
+            u32 Tags[GroupWidth];       ///< 0 marks an empty slot.
+            u32 Entries[GroupWidth];
+        };
+
+        const Entry* FindInTable(const Uuid& typeId) const;
+
+        VStd::vector<Entry> m_entries;
+        VStd::vector<Group> m_groups;
+        size_t m_groupMask = 0;
+        u64 m_generation = 0;           ///< Unique per index, tags the per thread cache.
+    };
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_CLASS_DATA_INDEX_H
@@ -1,11 +1,9 @@
 #include <vcore/serialization/dynamic_serializable_field.h>
 
 
-#include <vcore/io/byte_container_stream.h>
 #include <vcore/serialization/serialization_context.h>
-//#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/root_object_arena.h>
 //#include <vcore/serialization/utils.h>
-#include <vcore/std/containers/vector.h>
 
 namespace V
 {
@@ -19,7 +17,9 @@ namespace V
     //-------------------------------------------------------------------------
     DynamicSerializableField::DynamicSerializableField(const DynamicSerializableField& serializableField)
     {
-        DataPtr = serializableField.CloneData();
+        // copies of arena backed fields live in the same arena
+        ArenaPtr = serializableField.ArenaPtr;
+        DataPtr = ArenaPtr ? serializableField.CloneData(*ArenaPtr) : serializableField.CloneData();
         TypeId  = serializableField.TypeId;
     }
     //-------------------------------------------------------------------------
@@ -37,6 +37,14 @@ namespace V
     {
         if (IsValid())
         {
+            if (ArenaPtr && ArenaPtr->DestroyObject(DataPtr))
+            {
+                DataPtr = nullptr;
+                TypeId = Uuid::CreateNull();
+                ArenaPtr = nullptr;
+                return;
+            }
+
             // Right now we rely on the fact that destructor info has to be reflected in the default
             // SerializeContext held by the ComponentApplication.
             // If we ever need to have multiple contexts, we will have to add a way to refer to the context
@@ -55,7 +63,8 @@ namespace V
                     {
                         classData->Factory->Destroy(DataPtr);
                         DataPtr = nullptr;
-                        TypeId = Uuid::CreateNull();                        
+                        TypeId = Uuid::CreateNull();
+                        ArenaPtr = nullptr;
                         return;
                     }
                     else
@@ -89,11 +98,36 @@ namespace V
         return nullptr;
     }
     //-------------------------------------------------------------------------
+    void* DynamicSerializableField::CloneData(RootObjectArena& arena, SerializeContext* useContext) const
+    {
+        if (IsValid())
+        {
+            if (!useContext)
+            {
+                V_Error("DynamicSerializableField", useContext, "Can't find valid serialize context. Dynamic data cannot be cloned without it!");
+            }
+            if (useContext)
+            {
+                return useContext->CloneObject(DataPtr, TypeId, arena);
+            }
+        }
+        return nullptr;
+    }
+    //-------------------------------------------------------------------------
     void DynamicSerializableField::CopyDataFrom(const DynamicSerializableField& other, SerializeContext* useContext)
     {
         DestroyData();
         TypeId    = other.TypeId;        
         DataPtr   = other.CloneData(useContext);
+        ArenaPtr  = nullptr;
+    }
+    //-------------------------------------------------------------------------
+    void DynamicSerializableField::CopyDataFrom(const DynamicSerializableField& other, RootObjectArena& arena, SerializeContext* useContext)
+    {
+        DestroyData(useContext);
+        TypeId    = other.TypeId;
+        DataPtr   = other.CloneData(arena, useContext);
+        ArenaPtr  = &arena;
     }
     //-------------------------------------------------------------------------
     bool DynamicSerializableField::IsEqualTo(const DynamicSerializableField& other, SerializeContext* useContext) const
@@ -122,16 +156,7 @@ namespace V
                 }
                 else
                 {
-                    VStd::vector<V::u8> myData;
-                    V::IO::ByteContainerStream<decltype(myData)> myDataStream(&myData);
-
-                    //Utils::SaveObjectToStream(myDataStream, V::ObjectStream::ST_BINARY, DataPtr, TypeId);
-
-                    VStd::vector<V::u8> otherData;
-                    V::IO::ByteContainerStream<decltype(otherData)> otherDataStream(&otherData);
-
-                    //Utils::SaveObjectToStream(otherDataStream, V::ObjectStream::ST_BINARY, other.DataPtr, other.TypeId);
-                    isEqual = (myData.size() == otherData.size()) && (memcmp(myData.data(), otherData.data(), myData.size()) == 0);
+                    isEqual = useContext->CompareObjects(DataPtr, other.DataPtr, TypeId);
                 }
             }
             else
@@ -9,6 +9,7 @@ namespace V
 {
     struct Uuid;
     class SerializeContext;
+    class RootObjectArena;
 
      // 允许用户使用 void* 和 Uuid 对序列化数据.
      // 它当前由脚本组件使用. 我们可以将其用于其
@@ -29,6 +30,10 @@ namespace V
         void* CloneData(SerializeContext* useContext = nullptr) const;
 
         void CopyDataFrom(const DynamicSerializableField& other, SerializeContext* useContext = nullptr);
+
+        /// Same as above with the data created in arena, DestroyData hands it back to the arena.
+        void* CloneData(RootObjectArena& arena, SerializeContext* useContext = nullptr) const;
+        void CopyDataFrom(const DynamicSerializableField& other, RootObjectArena& arena, SerializeContext* useContext = nullptr);
         bool IsEqualTo(const DynamicSerializableField& other, SerializeContext* useContext = nullptr) const;
 
         template<class T>
@@ -36,6 +41,7 @@ namespace V
         {
             DataPtr = object;
             TypeId = VObject<T>::Id();
+            ArenaPtr = nullptr;
         }
 
         // Keep in mind that this function will not do rtti_casts to T, you will need to
@@ -52,6 +58,7 @@ namespace V
     
         void* DataPtr;
         Uuid  TypeId;
+        RootObjectArena* ArenaPtr = nullptr;    ///< Arena owning DataPtr, null when the data comes from the class factory.
     };
 }   // namespace V
 
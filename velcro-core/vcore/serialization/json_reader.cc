@@ -0,0 +1,772 @@
+#include <vcore/serialization/json_reader.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/std/charconv.h>
+#include <vcore/std/limits.h>
+
+#include <string.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace V
+{
+    namespace JsonReaderInternal
+    {
+        constexpr size_t BlockSize = 64;
+        constexpr u32 MaxDepth = 1024;
+
+        /// Bitmasks of one 64 byte block, bit n describes byte n.
+        struct BlockMasks
+        {
+            u64 Backslash;
+            u64 Quote;
+            u64 Operator;
+            u64 Whitespace;
+        };
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        static BlockMasks ClassifyBlock(const char* block)
+        {
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i lowerCaseBit = _mm_set1_epi8(0x20);
+            const __m128i openBrace = _mm_set1_epi8('{');
+            const __m128i closeBrace = _mm_set1_epi8('}');
+            const __m128i colon = _mm_set1_epi8(':');
+            const __m128i comma = _mm_set1_epi8(',');
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i lineFeed = _mm_set1_epi8('\n');
+            const __m128i carriageReturn = _mm_set1_epi8('\r');
+
+            BlockMasks masks = { 0, 0, 0, 0 };
+            for (size_t i = 0; i < BlockSize / 16; ++i)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+                // '[' and ']' only differ from '{' and '}' by the 0x20 bit
+                const __m128i folded = _mm_or_si128(chunk, lowerCaseBit);
+                const __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(folded, openBrace), _mm_cmpeq_epi8(folded, closeBrace)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+                const __m128i ws = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, lineFeed), _mm_cmpeq_epi8(chunk, carriageReturn)));
+
+                const unsigned shift = static_cast<unsigned>(i * 16);
+                masks.Backslash |= static_cast<u64>(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)))) << shift;
+                masks.Quote |= static_cast<u64>(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)))) << shift;
+                masks.Operator |= static_cast<u64>(static_cast<u32>(_mm_movemask_epi8(op))) << shift;
+                masks.Whitespace |= static_cast<u64>(static_cast<u32>(_mm_movemask_epi8(ws))) << shift;
+            }
+            return masks;
+        }
+#else
+        static BlockMasks ClassifyBlock(const char* block)
+        {
+            BlockMasks masks = { 0, 0, 0, 0 };
+            for (size_t i = 0; i < BlockSize; ++i)
+            {
+                const u64 bit = u64(1) << i;
+                switch (block[i])
+                {
+                case '\\':
+                    masks.Backslash |= bit;
+                    break;
+                case '"':
+                    masks.Quote |= bit;
+                    break;
+                case '{':
+                case '}':
+                case '[':
+                case ']':
+                case ':':
+                case ',':
+                    masks.Operator |= bit;
+                    break;
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                    masks.Whitespace |= bit;
+                    break;
+                default:
+                    break;
+                }
+            }
+            return masks;
+        }
+#endif
+
+        /// Sets every bit from a set bit up to (not including) the next one, in-string regions from their quotes.
+        static u64 PrefixXor(u64 bits)
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        /// Returns the characters escaped by an odd run of backslashes, carrying runs across blocks in prevEscaped.
+        static u64 FindEscaped(u64 backslash, u64& prevEscaped)
+        {
+            const u64 evenBits = 0x5555555555555555ULL;
+            backslash &= ~prevEscaped;
+            const u64 followsEscape = (backslash << 1) | prevEscaped;
+            const u64 oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+            const u64 sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+            prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+            const u64 invertMask = sequencesStartingOnEvenBits << 1;
+            return (evenBits ^ invertMask) & followsEscape;
+        }
+
+        static bool IsScalarEnd(char c)
+        {
+            switch (c)
+            {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case ',':
+            case ']':
+            case '}':
+            case ':':
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        static int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        static bool ReadHex4(const char* text, u32& codePoint)
+        {
+            codePoint = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int digit = HexValue(text[i]);
+                if (digit < 0)
+                {
+                    return false;
+                }
+                codePoint = (codePoint << 4) | static_cast<u32>(digit);
+            }
+            return true;
+        }
+
+        static size_t EncodeUtf8(u32 codePoint, char* out)
+        {
+            if (codePoint < 0x80)
+            {
+                out[0] = static_cast<char>(codePoint);
+                return 1;
+            }
+            if (codePoint < 0x800)
+            {
+                out[0] = static_cast<char>(0xc0 | (codePoint >> 6));
+                out[1] = static_cast<char>(0x80 | (codePoint & 0x3f));
+                return 2;
+            }
+            if (codePoint < 0x10000)
+            {
+                out[0] = static_cast<char>(0xe0 | (codePoint >> 12));
+                out[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                out[2] = static_cast<char>(0x80 | (codePoint & 0x3f));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xf0 | (codePoint >> 18));
+            out[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+            out[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+            out[3] = static_cast<char>(0x80 | (codePoint & 0x3f));
+            return 4;
+        }
+
+        /// Powers of ten that are exact in a double.
+        static const double ExactPowersOf10[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+    } // namespace JsonReaderInternal
+
+    //=========================================================================
+    // Value accessors
+    //=========================================================================
+    double JsonReader::Value::GetDouble() const
+    {
+        switch (ValueType)
+        {
+        case Type::Int:
+            return static_cast<double>(Int);
+        case Type::UInt:
+            return static_cast<double>(UInt);
+        case Type::Double:
+            return Double;
+        default:
+            return 0.0;
+        }
+    }
+
+    s64 JsonReader::Value::GetInt() const
+    {
+        switch (ValueType)
+        {
+        case Type::Int:
+            return Int;
+        case Type::UInt:
+            return static_cast<s64>(UInt);
+        case Type::Double:
+            return static_cast<s64>(Double);
+        default:
+            return 0;
+        }
+    }
+
+    u64 JsonReader::Value::GetUInt() const
+    {
+        switch (ValueType)
+        {
+        case Type::Int:
+            return static_cast<u64>(Int);
+        case Type::UInt:
+            return UInt;
+        case Type::Double:
+            return static_cast<u64>(Double);
+        default:
+            return 0;
+        }
+    }
+
+    //=========================================================================
+    // Parse
+    //=========================================================================
+    bool JsonReader::Parse(char* json, size_t length)
+    {
+        m_structurals.clear();
+        m_values.clear();
+        m_error.clear();
+        m_errorOffset = 0;
+        m_length = length;
+
+        if (length >= InvalidIndex)
+        {
+            return SetError("Json documents are limited to 4GB.", 0);
+        }
+        if (!BuildStructuralIndex(json, length))
+        {
+            return false;
+        }
+        if (m_structurals.empty())
+        {
+            return SetError("The document is empty.", 0);
+        }
+
+        // the value count is bounded by the number of structurals, so m_values never reallocates while parsing
+        m_values.reserve(m_structurals.size());
+        size_t structural = 0;
+        if (!ParseValue(json, structural, 0))
+        {
+            return false;
+        }
+        if (structural != m_structurals.size())
+        {
+            return SetError("Unexpected data after the root value.", m_structurals[structural]);
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // BuildStructuralIndex
+    //=========================================================================
+    bool JsonReader::BuildStructuralIndex(const char* json, size_t length)
+    {
+        using namespace JsonReaderInternal;
+
+        m_structurals.reserve(length / 4 + 16);
+
+        u64 prevEscaped = 0;
+        u64 prevInString = 0;
+        u64 prevScalar = 0;
+        char tail[BlockSize];
+        for (size_t position = 0; position < length; position += BlockSize)
+        {
+            const char* block = json + position;
+            if (length - position < BlockSize)
+            {
+                // pad the last block with whitespace, it doesn't add any structurals
+                memset(tail, ' ', BlockSize);
+                memcpy(tail, block, length - position);
+                block = tail;
+            }
+
+            const BlockMasks masks = ClassifyBlock(block);
+            const u64 escaped = FindEscaped(masks.Backslash, prevEscaped);
+            const u64 quotes = masks.Quote & ~escaped;
+            // opening quotes and string contents are set, closing quotes are not
+            const u64 inString = PrefixXor(quotes) ^ prevInString;
+            prevInString = static_cast<u64>(static_cast<s64>(inString) >> 63);
+
+            const u64 scalar = ~(masks.Operator | masks.Whitespace | quotes) & ~inString;
+            const u64 scalarStarts = scalar & ~((scalar << 1) | prevScalar);
+            prevScalar = scalar >> 63;
+
+            u64 structurals = (masks.Operator & ~inString) | scalarStarts | (quotes & inString);
+            while (structurals)
+            {
+                m_structurals.push_back(static_cast<u32>(position + v_ctz_u64(structurals)));
+                structurals &= structurals - 1;
+            }
+        }
+
+        if (prevInString)
+        {
+            return SetError("Unterminated string.", length);
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // ParseValue
+    //=========================================================================
+    bool JsonReader::ParseValue(char* json, size_t& structural, u32 depth)
+    {
+        using namespace JsonReaderInternal;
+
+        if (depth > MaxDepth)
+        {
+            return SetError("The document is nested too deeply.", m_structurals[structural - 1]);
+        }
+        if (structural >= m_structurals.size())
+        {
+            return SetError("Unexpected end of the document.", m_length);
+        }
+
+        const u32 offset = m_structurals[structural++];
+        const u32 index = static_cast<u32>(m_values.size());
+        m_values.emplace_back();
+
+        switch (json[offset])
+        {
+        case '{':
+            m_values[index].ValueType = Type::Object;
+            if (structural < m_structurals.size() && json[m_structurals[structural]] == '}')
+            {
+                ++structural;
+                break;
+            }
+            for (;;)
+            {
+                if (structural >= m_structurals.size() || json[m_structurals[structural]] != '"')
+                {
+                    return SetError("Expected a string key.", structural < m_structurals.size() ? m_structurals[structural] : m_length);
+                }
+                if (!ParseValue(json, structural, depth + 1))
+                {
+                    return false;
+                }
+                if (structural >= m_structurals.size() || json[m_structurals[structural]] != ':')
+                {
+                    return SetError("Expected ':' after the key.", structural < m_structurals.size() ? m_structurals[structural] : m_length);
+                }
+                ++structural;
+                if (!ParseValue(json, structural, depth + 1))
+                {
+                    return false;
+                }
+                m_values[index].Length += 2;
+
+                if (structural >= m_structurals.size())
+                {
+                    return SetError("Unexpected end of the document.", m_length);
+                }
+                const u32 separatorOffset = m_structurals[structural++];
+                if (json[separatorOffset] == '}')
+                {
+                    break;
+                }
+                if (json[separatorOffset] != ',')
+                {
+                    return SetError("Expected ',' or '}' in object.", separatorOffset);
+                }
+            }
+            break;
+        case '[':
+            m_values[index].ValueType = Type::Array;
+            if (structural < m_structurals.size() && json[m_structurals[structural]] == ']')
+            {
+                ++structural;
+                break;
+            }
+            for (;;)
+            {
+                if (!ParseValue(json, structural, depth + 1))
+                {
+                    return false;
+                }
+                ++m_values[index].Length;
+
+                if (structural >= m_structurals.size())
+                {
+                    return SetError("Unexpected end of the document.", m_length);
+                }
+                const u32 separatorOffset = m_structurals[structural++];
+                if (json[separatorOffset] == ']')
+                {
+                    break;
+                }
+                if (json[separatorOffset] != ',')
+                {
+                    return SetError("Expected ',' or ']' in array.", separatorOffset);
+                }
+            }
+            break;
+        case '"':
+            if (!ParseString(json, offset, m_values[index]))
+            {
+                return false;
+            }
+            break;
+        case 't':
+            m_values[index].ValueType = Type::True;
+            if (!ParseLiteral(json, offset, "true", 4))
+            {
+                return false;
+            }
+            break;
+        case 'f':
+            m_values[index].ValueType = Type::False;
+            if (!ParseLiteral(json, offset, "false", 5))
+            {
+                return false;
+            }
+            break;
+        case 'n':
+            m_values[index].ValueType = Type::Null;
+            if (!ParseLiteral(json, offset, "null", 4))
+            {
+                return false;
+            }
+            break;
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+            if (!ParseNumber(json, offset, m_values[index]))
+            {
+                return false;
+            }
+            break;
+        default:
+            return SetError("Unexpected character.", offset);
+        }
+
+        m_values[index].End = static_cast<u32>(m_values.size());
+        return true;
+    }
+
+    //=========================================================================
+    // ParseString
+    //=========================================================================
+    bool JsonReader::ParseString(char* json, u32 offset, Value& value)
+    {
+        using namespace JsonReaderInternal;
+
+        const size_t start = offset + 1;
+        size_t src = start;
+        // fast path, nothing has to move until the first escape
+        while (src < m_length && json[src] != '"' && json[src] != '\\' && static_cast<u8>(json[src]) >= 0x20)
+        {
+            ++src;
+        }
+
+        size_t dst = src;
+        while (src < m_length && json[src] != '"')
+        {
+            const char c = json[src];
+            if (static_cast<u8>(c) < 0x20)
+            {
+                return SetError("Control characters must be escaped in strings.", src);
+            }
+            if (c != '\\')
+            {
+                json[dst++] = c;
+                ++src;
+                continue;
+            }
+
+            if (src + 1 >= m_length)
+            {
+                return SetError("Unterminated escape sequence.", src);
+            }
+            const char escape = json[src + 1];
+            src += 2;
+            switch (escape)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                json[dst++] = escape;
+                break;
+            case 'b':
+                json[dst++] = '\b';
+                break;
+            case 'f':
+                json[dst++] = '\f';
+                break;
+            case 'n':
+                json[dst++] = '\n';
+                break;
+            case 'r':
+                json[dst++] = '\r';
+                break;
+            case 't':
+                json[dst++] = '\t';
+                break;
+            case 'u':
+            {
+                u32 codePoint = 0;
+                if (src + 4 > m_length || !ReadHex4(json + src, codePoint))
+                {
+                    return SetError("Invalid \\u escape sequence.", src - 2);
+                }
+                src += 4;
+                if (codePoint >= 0xd800 && codePoint < 0xdc00)
+                {
+                    u32 lowSurrogate = 0;
+                    if (src + 6 > m_length || json[src] != '\\' || json[src + 1] != 'u' || !ReadHex4(json + src + 2, lowSurrogate) ||
+                        lowSurrogate < 0xdc00 || lowSurrogate >= 0xe000)
+                    {
+                        return SetError("Unpaired UTF-16 surrogate.", src - 6);
+                    }
+                    src += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+                }
+                else if (codePoint >= 0xdc00 && codePoint < 0xe000)
+                {
+                    return SetError("Unpaired UTF-16 surrogate.", src - 6);
+                }
+                // the encoded form is never longer than the escape sequence
+                dst += EncodeUtf8(codePoint, json + dst);
+                break;
+            }
+            default:
+                return SetError("Invalid escape sequence.", src - 2);
+            }
+        }
+
+        if (src >= m_length)
+        {
+            return SetError("Unterminated string.", offset);
+        }
+
+        // terminate in place, dst is at most the closing quote
+        json[dst] = '\0';
+        value.ValueType = Type::String;
+        value.String = json + start;
+        value.Length = static_cast<u32>(dst - start);
+        return true;
+    }
+
+    //=========================================================================
+    // ParseNumber
+    //=========================================================================
+    bool JsonReader::ParseNumber(const char* json, u32 offset, Value& value)
+    {
+        using namespace JsonReaderInternal;
+
+        const char* text = json + offset;
+        const char* end = json + m_length;
+        const char* p = text;
+
+        const bool isNegative = *p == '-';
+        if (isNegative)
+        {
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9')
+        {
+            return SetError("Invalid number.", offset);
+        }
+        if (*p == '0' && p + 1 < end && p[1] >= '0' && p[1] <= '9')
+        {
+            return SetError("Numbers can't have leading zeros.", offset);
+        }
+
+        u64 mantissa = 0;
+        int exponent = 0;
+        bool isTruncated = false;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p)
+        {
+            const u64 digit = static_cast<u64>(*p - '0');
+            if (!isTruncated && mantissa <= (~u64(0) - digit) / 10)
+            {
+                mantissa = mantissa * 10 + digit;
+            }
+            else
+            {
+                isTruncated = true;
+                ++exponent;
+            }
+        }
+
+        bool isInteger = true;
+        if (p < end && *p == '.')
+        {
+            isInteger = false;
+            ++p;
+            if (p == end || *p < '0' || *p > '9')
+            {
+                return SetError("Expected digits after the decimal point.", offset);
+            }
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+            {
+                const u64 digit = static_cast<u64>(*p - '0');
+                if (!isTruncated && mantissa <= (~u64(0) - digit) / 10)
+                {
+                    mantissa = mantissa * 10 + digit;
+                    --exponent;
+                }
+                else
+                {
+                    isTruncated = true;
+                }
+            }
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            isInteger = false;
+            ++p;
+            bool isNegativeExponent = false;
+            if (p < end && (*p == '+' || *p == '-'))
+            {
+                isNegativeExponent = *p == '-';
+                ++p;
+            }
+            if (p == end || *p < '0' || *p > '9')
+            {
+                return SetError("Expected digits in the exponent.", offset);
+            }
+            int explicitExponent = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+            {
+                if (explicitExponent < 100000)
+                {
+                    explicitExponent = explicitExponent * 10 + (*p - '0');
+                }
+            }
+            exponent += isNegativeExponent ? -explicitExponent : explicitExponent;
+        }
+
+        if (p < end && !IsScalarEnd(*p))
+        {
+            return SetError("Invalid number.", offset);
+        }
+
+        if (isInteger && !isTruncated)
+        {
+            const u64 maxInt = static_cast<u64>(s64(0x7fffffffffffffffLL));
+            if (!isNegative && mantissa > maxInt)
+            {
+                value.ValueType = Type::UInt;
+                value.UInt = mantissa;
+                return true;
+            }
+            if (mantissa <= maxInt + 1)
+            {
+                value.ValueType = Type::Int;
+                value.Int = isNegative ? static_cast<s64>(u64(0) - mantissa) : static_cast<s64>(mantissa);
+                return true;
+            }
+        }
+
+        value.ValueType = Type::Double;
+        if (!isTruncated && mantissa <= (u64(1) << 53) && exponent >= -22 && exponent <= 22)
+        {
+            // both operands are exact, so the single rounding of the multiply/divide is the correct result
+            double result = static_cast<double>(mantissa);
+            result = exponent < 0 ? result / ExactPowersOf10[-exponent] : result * ExactPowersOf10[exponent];
+            value.Double = isNegative ? -result : result;
+            return true;
+        }
+
+        // slow path, from_chars reads the token in place and doesn't depend on the locale like strtod does
+        double result = 0.0;
+        if (VStd::from_chars(text, p, result).ec == VStd::errc::result_out_of_range)
+        {
+            // the mantissa is below 10^20, so the sign of the exponent tells an overflow from an underflow
+            const double magnitude = exponent > 0 ? VStd::numeric_limits<double>::infinity() : 0.0;
+            result = isNegative ? -magnitude : magnitude;
+        }
+        value.Double = result;
+        return true;
+    }
+
+    //=========================================================================
+    // ParseLiteral
+    //=========================================================================
+    bool JsonReader::ParseLiteral(const char* json, u32 offset, const char* literal, size_t literalLength)
+    {
+        if (offset + literalLength > m_length || memcmp(json + offset, literal, literalLength) != 0 ||
+            (offset + literalLength < m_length && !JsonReaderInternal::IsScalarEnd(json[offset + literalLength])))
+        {
+            return SetError("Invalid literal.", offset);
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // FindMember
+    //=========================================================================
+    u32 JsonReader::FindMember(u32 object, VStd::string_view key) const
+    {
+        if (m_values[object].ValueType != Type::Object)
+        {
+            return InvalidIndex;
+        }
+        for (u32 child = GetFirstChild(object); child != InvalidIndex; child = GetNextSibling(object, child + 1))
+        {
+            if (m_values[child].GetString() == key)
+            {
+                return child + 1;
+            }
+        }
+        return InvalidIndex;
+    }
+
+    //=========================================================================
+    // SetError
+    //=========================================================================
+    bool JsonReader::SetError(const char* message, size_t offset)
+    {
+        m_error = message;
+        m_errorOffset = offset;
+        return false;
+    }
+} // namespace V
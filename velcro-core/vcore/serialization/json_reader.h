@@ -0,0 +1,103 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_JSON_READER_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_JSON_READER_H
+
+#include <vcore/base.h>
+#include <vcore/memory/system_allocator.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/string/string.h>
+#include <vcore/std/string/string_view.h>
+
+namespace V
+{
+    /**
+     * Two stage JSON parser.
+     *
+     * Stage 1 classifies the input 64 bytes at a time (SSE2 where available) into bitmasks for quotes,
+     * backslashes, operators and whitespace. String regions are resolved with a prefix xor over the unescaped
+     * quotes, which leaves the index of every structural character and of the first byte of every scalar.
+     * Stage 2 walks that index instead of the raw text and builds a flat array of values in document order,
+     * where every array and object knows the index one past its last descendant.
+     *
+     * Parsing is in situ: escape sequences are decoded into the input buffer and string values point into it,
+     * so the buffer has to outlive the reader's values.
+     */
+    class JsonReader
+    {
+    public:
+        V_CLASS_ALLOCATOR(JsonReader, SystemAllocator, 0);
+
+        enum class Type : u8
+        {
+            Null,
+            False,
+            True,
+            Int,        ///< Integer that fits into s64.
+            UInt,       ///< Integer above the s64 range.
+            Double,
+            String,
+            Array,
+            Object,     ///< Children alternate between a String key and its value.
+        };
+
+        struct Value
+        {
+            Type ValueType = Type::Null;
+            u32 Length = 0;         ///< String length or number of children of arrays and objects (keys included).
+            u32 End = 0;            ///< Index one past the last descendant, the next sibling starts there.
+            union
+            {
+                s64 Int;
+                u64 UInt;
+                double Double;
+                const char* String;
+            };
+
+            Value() : Int(0) {}
+
+            bool IsNumber() const { return ValueType == Type::Int || ValueType == Type::UInt || ValueType == Type::Double; }
+            bool IsContainer() const { return ValueType == Type::Array || ValueType == Type::Object; }
+            VStd::string_view GetString() const { return ValueType == Type::String ? VStd::string_view(String, Length) : VStd::string_view(); }
+            double GetDouble() const;
+            s64 GetInt() const;
+            u64 GetUInt() const;
+        };
+
+        static constexpr u32 InvalidIndex = 0xffffffff;
+
+        /// Parses json in place. Returns false on malformed input, see GetError for the reason.
+        bool Parse(char* json, size_t length);
+
+        const VStd::string& GetError() const { return m_error; }
+        /// Byte offset in the input where the error was found.
+        size_t GetErrorOffset() const { return m_errorOffset; }
+
+        /// The root value is always at index 0.
+        const Value& GetValue(u32 index) const { return m_values[index]; }
+        u32 GetNumValues() const { return static_cast<u32>(m_values.size()); }
+        /// Index of the first child of an array or object, InvalidIndex if it is empty.
+        u32 GetFirstChild(u32 index) const { return m_values[index].Length ? index + 1 : InvalidIndex; }
+        /// Index of the next sibling of a value inside the container parent, InvalidIndex after the last one.
+        u32 GetNextSibling(u32 parent, u32 index) const { return m_values[index].End < m_values[parent].End ? m_values[index].End : InvalidIndex; }
+        /// Finds a member of an object by key, returns the index of its value or InvalidIndex.
+        u32 FindMember(u32 object, VStd::string_view key) const;
+
+        /// Offsets of all structural characters and scalar starts found by stage 1.
+        const VStd::vector<u32>& GetStructuralIndex() const { return m_structurals; }
+
+    private:
+        bool BuildStructuralIndex(const char* json, size_t length);
+        bool ParseValue(char* json, size_t& structural, u32 depth);
+        bool ParseString(char* json, u32 offset, Value& value);
+        bool ParseNumber(const char* json, u32 offset, Value& value);
+        bool ParseLiteral(const char* json, u32 offset, const char* literal, size_t literalLength);
+        bool SetError(const char* message, size_t offset);
+
+        VStd::vector<u32> m_structurals;
+        VStd::vector<Value> m_values;
+        size_t m_length = 0;
+        VStd::string m_error;
+        size_t m_errorOffset = 0;
+    };
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_JSON_READER_H
@@ -0,0 +1,955 @@
+#include <vcore/serialization/json_serialization.h>
+#include <vcore/serialization/json_reader.h>
+#include <vcore/serialization/json_writer.h>
+#include <vcore/serialization/dynamic_serializable_field.h>
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/io/generic_streams.h>
+#include <vcore/std/containers/unordered_map.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/limits.h>
+#include <vcore/std/typetraits/is_signed.h>
+
+#include <math.h>
+
+namespace V
+{
+    namespace JsonSerializationInternal
+    {
+        using ClassData = SerializeContext::ClassData;
+        using ClassElement = SerializeContext::ClassElement;
+        using ErrorHandler = SerializeContext::ErrorHandler;
+        using IDataContainer = SerializeContext::IDataContainer;
+
+        /// How a type with an IDataSerializer maps to a JSON value, None uses DataToText.
+        enum class ScalarKind : u8
+        {
+            None,
+            Bool,
+            Char,
+            S8,
+            Short,
+            Int,
+            Long,
+            S64,
+            UChar,
+            UShort,
+            UInt,
+            ULong,
+            U64,
+            Float,
+            Double,
+            String,
+        };
+
+        static ScalarKind FindScalarKind(const Uuid& typeId)
+        {
+            static const VStd::pair<Uuid, ScalarKind> scalarTypes[] =
+            {
+                { SerializeTypeInfo<bool>::GetUuid(), ScalarKind::Bool },
+                { SerializeTypeInfo<char>::GetUuid(), ScalarKind::Char },
+                { SerializeTypeInfo<V::s8>::GetUuid(), ScalarKind::S8 },
+                { SerializeTypeInfo<short>::GetUuid(), ScalarKind::Short },
+                { SerializeTypeInfo<int>::GetUuid(), ScalarKind::Int },
+                { SerializeTypeInfo<long>::GetUuid(), ScalarKind::Long },
+                { SerializeTypeInfo<V::s64>::GetUuid(), ScalarKind::S64 },
+                { SerializeTypeInfo<unsigned char>::GetUuid(), ScalarKind::UChar },
+                { SerializeTypeInfo<unsigned short>::GetUuid(), ScalarKind::UShort },
+                { SerializeTypeInfo<unsigned int>::GetUuid(), ScalarKind::UInt },
+                { SerializeTypeInfo<unsigned long>::GetUuid(), ScalarKind::ULong },
+                { SerializeTypeInfo<V::u64>::GetUuid(), ScalarKind::U64 },
+                { SerializeTypeInfo<float>::GetUuid(), ScalarKind::Float },
+                { SerializeTypeInfo<double>::GetUuid(), ScalarKind::Double },
+                { SerializeTypeInfo<VStd::string>::GetUuid(), ScalarKind::String },
+            };
+            for (const auto& scalarType : scalarTypes)
+            {
+                if (scalarType.first == typeId)
+                {
+                    return scalarType.second;
+                }
+            }
+            return ScalarKind::None;
+        }
+
+        /// Classes without serializer or container are written inline into the object of the derived class.
+        static bool IsInlinedBase(const ClassData* classData)
+        {
+            return !classData->SerializerPtr && !classData->ContainerPtr;
+        }
+
+        template<class T>
+        static bool ReadInteger(const JsonReader::Value& value, void* objectPtr)
+        {
+            using Limits = VStd::numeric_limits<T>;
+            T result = 0;
+            switch (value.ValueType)
+            {
+            case JsonReader::Type::Int:
+                if constexpr (VStd::is_signed_v<T>)
+                {
+                    if (value.Int < static_cast<s64>(Limits::min()) || value.Int > static_cast<s64>(Limits::max()))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    if (value.Int < 0 || static_cast<u64>(value.Int) > static_cast<u64>(Limits::max()))
+                    {
+                        return false;
+                    }
+                }
+                result = static_cast<T>(value.Int);
+                break;
+            case JsonReader::Type::UInt:
+                if (value.UInt > static_cast<u64>(Limits::max()))
+                {
+                    return false;
+                }
+                result = static_cast<T>(value.UInt);
+                break;
+            case JsonReader::Type::Double:
+                if (value.Double != floor(value.Double) || value.Double < static_cast<double>(Limits::lowest()) || value.Double > static_cast<double>(Limits::max()))
+                {
+                    return false;
+                }
+                result = static_cast<T>(value.Double);
+                break;
+            default:
+                return false;
+            }
+            *reinterpret_cast<T*>(objectPtr) = result;
+            return true;
+        }
+
+        //=========================================================================
+        // JsonSaver
+        //=========================================================================
+        class JsonSaver
+        {
+        public:
+            JsonSaver(const SerializeContext* sc, ErrorHandler* errorHandler, JsonWriter& writer)
+                : m_context(sc)
+                , m_errorHandler(errorHandler)
+                , m_writer(writer)
+            {
+            }
+
+            bool Save(const void* object, const Uuid& classId);
+
+        private:
+            enum class FrameKind : u8
+            {
+                Object,
+                Array,
+                SmartPointer,
+                Inlined,    ///< Base class, its members go into the object of the derived class.
+                Scalar,
+                Skipped,
+            };
+
+            struct Frame
+            {
+                FrameKind Kind;
+                bool IsWrapped;     ///< Written inside a {"$type", "$value"} object.
+                bool HasValue;      ///< Smart pointers write null when nothing was enumerated.
+            };
+
+            bool BeginSaveElement(void* ptr, const ClassData* classData, const ClassElement* classElement);
+            bool EndSaveElement();
+            void WriteScalar(const void* objectPtr, const ClassData* classData);
+            ScalarKind GetScalarKind(const ClassData* classData);
+
+            const SerializeContext* m_context;
+            ErrorHandler* m_errorHandler;
+            JsonWriter& m_writer;
+            VStd::vector<Frame> m_frames;
+            VStd::unordered_map<const ClassData*, ScalarKind> m_scalarKinds;
+            VStd::vector<char> m_dataBuffer;
+            VStd::vector<char> m_textBuffer;
+        };
+
+        bool JsonSaver::Save(const void* object, const Uuid& classId)
+        {
+            const unsigned int numErrors = m_errorHandler->GetErrorCount();
+
+            SerializeContext::EnumerateInstanceCallContext callContext(
+                [this](void* ptr, const ClassData* classData, const ClassElement* classElement)
+                {
+                    return BeginSaveElement(ptr, classData, classElement);
+                },
+                [this]()
+                {
+                    return EndSaveElement();
+                },
+                m_context,
+                SerializeContext::ENUM_ACCESS_FOR_READ,
+                m_errorHandler);
+
+            m_context->EnumerateInstanceConst(&callContext, object, classId, nullptr, nullptr);
+
+            return m_writer.Flush() && m_errorHandler->GetErrorCount() == numErrors;
+        }
+
+        bool JsonSaver::BeginSaveElement(void* ptr, const ClassData* classData, const ClassElement* classElement)
+        {
+            const void* objectPtr = ptr;
+            if (classElement && (classElement->Flags & ClassElement::FLG_POINTER))
+            {
+                objectPtr = *reinterpret_cast<void* const*>(ptr);
+                if (classElement->VObjectRtti && classData->VObjectRtti)
+                {
+                    objectPtr = classElement->VObjectRtti->Cast(objectPtr, classData->VObjectRtti->GetTypeId());
+                }
+            }
+
+            if (classData->IsDeprecated() || (classElement && classData->DoSave && !classData->DoSave(objectPtr)))
+            {
+                m_frames.push_back({ FrameKind::Skipped, false, false });
+                return false;
+            }
+
+            Frame* parent = m_frames.empty() ? nullptr : &m_frames.back();
+            const bool isInObject = parent && (parent->Kind == FrameKind::Object || parent->Kind == FrameKind::Inlined);
+            if (parent && parent->Kind == FrameKind::SmartPointer)
+            {
+                parent->HasValue = true;
+            }
+
+            if (isInObject && classElement && (classElement->Flags & ClassElement::FLG_BASE_CLASS) && IsInlinedBase(classData))
+            {
+                m_frames.push_back({ FrameKind::Inlined, false, false });
+                return true;
+            }
+            if (isInObject)
+            {
+                m_writer.Key(classElement ? classElement->Name : "");
+            }
+
+            // dynamic fields are always stored as their actual type, everything else needs the type when it differs
+            const bool isWrapped = classElement && (classElement->Flags & ClassElement::FLG_POINTER) &&
+                !(classElement->Flags & ClassElement::FLG_DYNAMIC_FIELD) && classData->TypeId != classElement->TypeId;
+            if (isWrapped)
+            {
+                m_writer.StartObject();
+                m_writer.Key(JsonSerialization::TypeKey);
+                m_writer.String(classData->TypeId.ToString<VStd::string>());
+                m_writer.Key(JsonSerialization::ValueKey);
+            }
+
+            if (classData->SerializerPtr)
+            {
+                WriteScalar(objectPtr, classData);
+                m_frames.push_back({ FrameKind::Scalar, isWrapped, false });
+                return false;
+            }
+            if (classData->ContainerPtr)
+            {
+                if (classData->ContainerPtr->IsSmartPointer())
+                {
+                    m_frames.push_back({ FrameKind::SmartPointer, isWrapped, false });
+                }
+                else
+                {
+                    m_writer.StartArray();
+                    m_frames.push_back({ FrameKind::Array, isWrapped, false });
+                }
+                return true;
+            }
+            m_writer.StartObject();
+            m_frames.push_back({ FrameKind::Object, isWrapped, false });
+            return true;
+        }
+
+        bool JsonSaver::EndSaveElement()
+        {
+            const Frame frame = m_frames.back();
+            m_frames.pop_back();
+            switch (frame.Kind)
+            {
+            case FrameKind::Object:
+                m_writer.EndObject();
+                break;
+            case FrameKind::Array:
+                m_writer.EndArray();
+                break;
+            case FrameKind::SmartPointer:
+                if (!frame.HasValue)
+                {
+                    m_writer.Null();
+                }
+                break;
+            default:
+                break;
+            }
+            if (frame.IsWrapped)
+            {
+                m_writer.EndObject();
+            }
+            return true;
+        }
+
+        ScalarKind JsonSaver::GetScalarKind(const ClassData* classData)
+        {
+            auto insertResult = m_scalarKinds.insert_key(classData);
+            if (insertResult.second)
+            {
+                insertResult.first->second = FindScalarKind(classData->TypeId);
+            }
+            return insertResult.first->second;
+        }
+
+        void JsonSaver::WriteScalar(const void* objectPtr, const ClassData* classData)
+        {
+            switch (GetScalarKind(classData))
+            {
+            case ScalarKind::Bool:
+                m_writer.Bool(*reinterpret_cast<const bool*>(objectPtr));
+                break;
+            case ScalarKind::Char:
+                m_writer.Int(*reinterpret_cast<const char*>(objectPtr));
+                break;
+            case ScalarKind::S8:
+                m_writer.Int(*reinterpret_cast<const V::s8*>(objectPtr));
+                break;
+            case ScalarKind::Short:
+                m_writer.Int(*reinterpret_cast<const short*>(objectPtr));
+                break;
+            case ScalarKind::Int:
+                m_writer.Int(*reinterpret_cast<const int*>(objectPtr));
+                break;
+            case ScalarKind::Long:
+                m_writer.Int(*reinterpret_cast<const long*>(objectPtr));
+                break;
+            case ScalarKind::S64:
+                m_writer.Int(*reinterpret_cast<const V::s64*>(objectPtr));
+                break;
+            case ScalarKind::UChar:
+                m_writer.UInt(*reinterpret_cast<const unsigned char*>(objectPtr));
+                break;
+            case ScalarKind::UShort:
+                m_writer.UInt(*reinterpret_cast<const unsigned short*>(objectPtr));
+                break;
+            case ScalarKind::UInt:
+                m_writer.UInt(*reinterpret_cast<const unsigned int*>(objectPtr));
+                break;
+            case ScalarKind::ULong:
+                m_writer.UInt(*reinterpret_cast<const unsigned long*>(objectPtr));
+                break;
+            case ScalarKind::U64:
+                m_writer.UInt(*reinterpret_cast<const V::u64*>(objectPtr));
+                break;
+            case ScalarKind::Float:
+                m_writer.Float(*reinterpret_cast<const float*>(objectPtr));
+                break;
+            case ScalarKind::Double:
+                m_writer.Double(*reinterpret_cast<const double*>(objectPtr));
+                break;
+            case ScalarKind::String:
+            {
+                const VStd::string& text = *reinterpret_cast<const VStd::string*>(objectPtr);
+                m_writer.String(VStd::string_view(text.data(), text.size()));
+                break;
+            }
+            case ScalarKind::None:
+            {
+                m_dataBuffer.clear();
+                IO::ByteContainerStream<VStd::vector<char>> dataStream(&m_dataBuffer);
+                classData->SerializerPtr->Save(objectPtr, dataStream);
+                dataStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+
+                m_textBuffer.clear();
+                IO::ByteContainerStream<VStd::vector<char>> textStream(&m_textBuffer);
+                classData->SerializerPtr->DataToText(dataStream, textStream, false);
+                m_writer.String(VStd::string_view(m_textBuffer.data(), m_textBuffer.size()));
+                break;
+            }
+            }
+        }
+
+        //=========================================================================
+        // JsonLoader
+        //=========================================================================
+        class JsonLoader
+        {
+        public:
+            JsonLoader(SerializeContext* sc, ErrorHandler* errorHandler, const JsonReader& reader)
+                : m_context(sc)
+                , m_errorHandler(errorHandler)
+                , m_reader(reader)
+            {
+            }
+
+            bool Load(const Uuid& classId, void* inPlaceObject, void** createdObject);
+
+        private:
+            bool LoadValue(u32 valueIndex, void* objectPtr, const ClassData* classData);
+            bool LoadMembers(u32 objectIndex, void* objectPtr, const ClassData* classData);
+            bool LoadElement(u32 valueIndex, void* destPtr, const ClassElement* classElement, const ClassData* parentClassData);
+            bool LoadPointer(u32 valueIndex, void* destPtr, const ClassElement* classElement, const ClassData* classData);
+            bool LoadDynamicField(u32 valueIndex, void* objectPtr);
+            bool LoadContainer(u32 valueIndex, void* containerPtr, const ClassData* classData);
+            bool LoadScalar(u32 valueIndex, void* objectPtr, const ClassData* classData);
+            const ClassData* ResolveWrappedType(u32& valueIndex, const ClassData* classData);
+            const ClassElement* FindMember(const ClassData*& classData, VStd::string_view name, void*& objectPtr) const;
+            void NotifyInlinedBases(const ClassData* classData, void* objectPtr, bool isBegin) const;
+            const VStd::vector<const ClassElement*>& GetContainerElements(const ClassData* classData);
+            ScalarKind GetScalarKind(const ClassData* classData);
+
+            void ReportError(const VStd::string& message) { m_errorHandler->ReportError(message.c_str()); }
+            void ReportWarning(const VStd::string& message) { m_errorHandler->ReportWarning(message.c_str()); }
+
+            SerializeContext* m_context;
+            ErrorHandler* m_errorHandler;
+            const JsonReader& m_reader;
+            VStd::unordered_map<const ClassData*, VStd::vector<const ClassElement*>> m_containerElements;
+            VStd::unordered_map<const ClassData*, ScalarKind> m_scalarKinds;
+            VStd::vector<char> m_dataBuffer;
+        };
+
+        bool JsonLoader::Load(const Uuid& classId, void* inPlaceObject, void** createdObject)
+        {
+            const unsigned int numErrors = m_errorHandler->GetErrorCount();
+
+            const ClassData* rootClassData = m_context->FindClassData(classId);
+            if (!rootClassData)
+            {
+                ReportError(VStd::string::format("Json can't be loaded as %s, the type is not reflected in the serialize context.", classId.ToString<VStd::string>().c_str()));
+                return false;
+            }
+
+            u32 rootIndex = 0;
+            const ClassData* classData = ResolveWrappedType(rootIndex, rootClassData);
+            if (!classData)
+            {
+                return false;
+            }
+
+            if (inPlaceObject)
+            {
+                if (classData != rootClassData)
+                {
+                    ReportError(VStd::string::format("Json contains %s, it can't be loaded in place into %s.", classData->Name, rootClassData->Name));
+                    return false;
+                }
+                return LoadValue(rootIndex, inPlaceObject, classData) && m_errorHandler->GetErrorCount() == numErrors;
+            }
+
+            if (!classData->Factory || !m_context->CanDowncast(classData->TypeId, classId, classData->VObjectRtti))
+            {
+                ReportError(VStd::string::format("Json contains %s, which can't be created as %s.", classData->Name, rootClassData->Name));
+                return false;
+            }
+            void* object = classData->Factory->Create(classData->Name);
+            if (!LoadValue(rootIndex, object, classData))
+            {
+                classData->Factory->Destroy(object);
+                return false;
+            }
+            *createdObject = m_context->DownCast(object, classData->TypeId, classId, classData->VObjectRtti);
+            return true;
+        }
+
+        bool JsonLoader::LoadValue(u32 valueIndex, void* objectPtr, const ClassData* classData)
+        {
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteBegin(objectPtr);
+            }
+
+            bool result = false;
+            if (classData->SerializerPtr)
+            {
+                result = LoadScalar(valueIndex, objectPtr, classData);
+            }
+            else if (classData->ContainerPtr)
+            {
+                result = LoadContainer(valueIndex, objectPtr, classData);
+            }
+            else if (m_reader.GetValue(valueIndex).ValueType == JsonReader::Type::Object)
+            {
+                result = LoadMembers(valueIndex, objectPtr, classData);
+            }
+            else
+            {
+                ReportError(VStd::string::format("Expected a json object for %s.", classData->Name));
+            }
+
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteEnd(objectPtr);
+                classData->EventHandlerPtr->OnLoadedFromObjectStream(objectPtr);
+            }
+            return result;
+        }
+
+        bool JsonLoader::LoadMembers(u32 objectIndex, void* objectPtr, const ClassData* classData)
+        {
+            NotifyInlinedBases(classData, objectPtr, true);
+
+            const bool isDynamicField = classData->TypeId == SerializeTypeInfo<DynamicSerializableField>::GetUuid();
+            bool result = true;
+            size_t nextElementHint = 0;  // members are written in reflection order
+            for (u32 keyIndex = m_reader.GetFirstChild(objectIndex); keyIndex != JsonReader::InvalidIndex; keyIndex = m_reader.GetNextSibling(objectIndex, keyIndex + 1))
+            {
+                const VStd::string_view name = m_reader.GetValue(keyIndex).GetString();
+                const u32 valueIndex = keyIndex + 1;
+
+                if (isDynamicField && name == "m_data")
+                {
+                    result = LoadDynamicField(valueIndex, objectPtr) && result;
+                    continue;
+                }
+
+                const ClassData* ownerClassData = classData;
+                void* ownerPtr = objectPtr;
+                const ClassElement* classElement = nullptr;
+                if (nextElementHint < classData->Elements.size() && name == classData->Elements[nextElementHint].Name)
+                {
+                    classElement = &classData->Elements[nextElementHint++];
+                }
+                else
+                {
+                    classElement = FindMember(ownerClassData, name, ownerPtr);
+                    if (classElement && ownerClassData == classData)
+                    {
+                        nextElementHint = static_cast<size_t>(classElement - classData->Elements.data()) + 1;
+                    }
+                }
+
+                if (!classElement)
+                {
+                    ReportWarning(VStd::string::format("Class %s has no member '%.*s', the stored value is skipped.",
+                        classData->Name, static_cast<int>(name.size()), name.data()));
+                    continue;
+                }
+                result = LoadElement(valueIndex, reinterpret_cast<char*>(ownerPtr) + classElement->Offset, classElement, ownerClassData) && result;
+            }
+
+            NotifyInlinedBases(classData, objectPtr, false);
+            return result;
+        }
+
+        bool JsonLoader::LoadElement(u32 valueIndex, void* destPtr, const ClassElement* classElement, const ClassData* parentClassData)
+        {
+            const ClassData* classData = classElement->GenericClassInfoPtr
+                ? classElement->GenericClassInfoPtr->GetClassData()
+                : m_context->FindClassData(classElement->TypeId, parentClassData, classElement->NameCrc);
+            if (!classData)
+            {
+                ReportWarning(VStd::string::format("Element '%s' of %s has a type that is not reflected, the stored value is skipped.",
+                    classElement->Name, parentClassData->Name));
+                return true;
+            }
+            if (classData->IsDeprecated())
+            {
+                return true;
+            }
+            if (classElement->Flags & ClassElement::FLG_POINTER)
+            {
+                return LoadPointer(valueIndex, destPtr, classElement, classData);
+            }
+            return LoadValue(valueIndex, destPtr, classData);
+        }
+
+        bool JsonLoader::LoadPointer(u32 valueIndex, void* destPtr, const ClassElement* classElement, const ClassData* classData)
+        {
+            if (m_reader.GetValue(valueIndex).ValueType == JsonReader::Type::Null)
+            {
+                return true;
+            }
+
+            classData = ResolveWrappedType(valueIndex, classData);
+            if (!classData)
+            {
+                return false;
+            }
+            if (classData->TypeId != classElement->TypeId && !m_context->CanDowncast(classData->TypeId, classElement->TypeId, classData->VObjectRtti, classElement->VObjectRtti))
+            {
+                ReportError(VStd::string::format("%s can't be stored in element '%s'.", classData->Name, classElement->Name));
+                return false;
+            }
+            if (!classData->Factory)
+            {
+                ReportError(VStd::string::format("Unable to create '%s' for element '%s', no factory is provided.", classData->Name, classElement->Name));
+                return false;
+            }
+
+            void* newElement = classData->Factory->Create(classData->Name);
+            const bool result = LoadValue(valueIndex, newElement, classData);
+            *reinterpret_cast<void**>(destPtr) = m_context->DownCast(newElement, classData->TypeId, classElement->TypeId, classData->VObjectRtti, classElement->VObjectRtti);
+            return result;
+        }
+
+        bool JsonLoader::LoadDynamicField(u32 valueIndex, void* objectPtr)
+        {
+            // TypeId is written before m_data, so it's already loaded here
+            DynamicSerializableField* dynamicField = reinterpret_cast<DynamicSerializableField*>(objectPtr);
+            dynamicField->DestroyData(m_context);
+            if (m_reader.GetValue(valueIndex).ValueType == JsonReader::Type::Null)
+            {
+                return true;
+            }
+
+            const ClassData* classData = m_context->FindClassData(dynamicField->TypeId);
+            if (!classData || !classData->Factory)
+            {
+                ReportWarning(VStd::string::format("Dynamic field of type %s can't be created, the stored value is skipped.",
+                    dynamicField->TypeId.ToString<VStd::string>().c_str()));
+                return true;
+            }
+            dynamicField->DataPtr = classData->Factory->Create(classData->Name);
+            dynamicField->ArenaPtr = nullptr;
+            return LoadValue(valueIndex, dynamicField->DataPtr, classData);
+        }
+
+        bool JsonLoader::LoadContainer(u32 valueIndex, void* containerPtr, const ClassData* classData)
+        {
+            IDataContainer* container = classData->ContainerPtr;
+            const JsonReader::Value& value = m_reader.GetValue(valueIndex);
+            const VStd::vector<const ClassElement*>& elements = GetContainerElements(classData);
+            if (elements.empty())
+            {
+                ReportError(VStd::string::format("Container %s doesn't report its element types and can't be loaded.", classData->Name));
+                return false;
+            }
+
+            container->ClearElements(containerPtr, m_context);
+
+            if (container->IsSmartPointer())
+            {
+                if (value.ValueType == JsonReader::Type::Null)
+                {
+                    return true;
+                }
+                void* element = container->ReserveElement(containerPtr, elements[0]);
+                if (!element)
+                {
+                    return false;
+                }
+                const bool result = LoadElement(valueIndex, element, elements[0], classData);
+                container->StoreElement(containerPtr, element);
+                return result;
+            }
+
+            if (value.ValueType != JsonReader::Type::Array)
+            {
+                ReportError(VStd::string::format("Expected a json array for %s.", classData->Name));
+                return false;
+            }
+
+            const bool canAccessByIndex = container->CanAccessElementsByIndex();
+            bool result = true;
+            size_t index = 0;
+            for (u32 child = m_reader.GetFirstChild(valueIndex); child != JsonReader::InvalidIndex; child = m_reader.GetNextSibling(valueIndex, child), ++index)
+            {
+                // pairs and tuples have one element type per position, other containers a single one
+                const ClassElement* classElement = elements[index < elements.size() ? index : elements.size() - 1];
+                void* element = canAccessByIndex && container->Size(containerPtr) > index
+                    ? container->GetElementByIndex(containerPtr, classElement, index)
+                    : container->ReserveElement(containerPtr, classElement);
+                if (!element)
+                {
+                    ReportError(VStd::string::format("Failed to reserve element in container %s. The container may be full, %u elements will not be added.",
+                        classData->Name, value.Length - static_cast<unsigned int>(index)));
+                    return false;
+                }
+                result = LoadElement(child, element, classElement, classData) && result;
+                container->StoreElement(containerPtr, element);
+            }
+            return result;
+        }
+
+        bool JsonLoader::LoadScalar(u32 valueIndex, void* objectPtr, const ClassData* classData)
+        {
+            const JsonReader::Value& value = m_reader.GetValue(valueIndex);
+            bool isValid = false;
+            switch (GetScalarKind(classData))
+            {
+            case ScalarKind::Bool:
+                isValid = value.ValueType == JsonReader::Type::True || value.ValueType == JsonReader::Type::False;
+                if (isValid)
+                {
+                    *reinterpret_cast<bool*>(objectPtr) = value.ValueType == JsonReader::Type::True;
+                }
+                break;
+            case ScalarKind::Char:
+                isValid = ReadInteger<char>(value, objectPtr);
+                break;
+            case ScalarKind::S8:
+                isValid = ReadInteger<V::s8>(value, objectPtr);
+                break;
+            case ScalarKind::Short:
+                isValid = ReadInteger<short>(value, objectPtr);
+                break;
+            case ScalarKind::Int:
+                isValid = ReadInteger<int>(value, objectPtr);
+                break;
+            case ScalarKind::Long:
+                isValid = ReadInteger<long>(value, objectPtr);
+                break;
+            case ScalarKind::S64:
+                isValid = ReadInteger<V::s64>(value, objectPtr);
+                break;
+            case ScalarKind::UChar:
+                isValid = ReadInteger<unsigned char>(value, objectPtr);
+                break;
+            case ScalarKind::UShort:
+                isValid = ReadInteger<unsigned short>(value, objectPtr);
+                break;
+            case ScalarKind::UInt:
+                isValid = ReadInteger<unsigned int>(value, objectPtr);
+                break;
+            case ScalarKind::ULong:
+                isValid = ReadInteger<unsigned long>(value, objectPtr);
+                break;
+            case ScalarKind::U64:
+                isValid = ReadInteger<V::u64>(value, objectPtr);
+                break;
+            case ScalarKind::Float:
+                isValid = value.IsNumber();
+                if (isValid)
+                {
+                    *reinterpret_cast<float*>(objectPtr) = static_cast<float>(value.GetDouble());
+                }
+                break;
+            case ScalarKind::Double:
+                isValid = value.IsNumber();
+                if (isValid)
+                {
+                    *reinterpret_cast<double*>(objectPtr) = value.GetDouble();
+                }
+                break;
+            case ScalarKind::String:
+                isValid = value.ValueType == JsonReader::Type::String;
+                if (isValid)
+                {
+                    reinterpret_cast<VStd::string*>(objectPtr)->assign(value.String, value.Length);
+                }
+                break;
+            case ScalarKind::None:
+                isValid = value.ValueType == JsonReader::Type::String;
+                if (isValid)
+                {
+                    // strings are terminated in place by the reader, so they can go straight to TextToData
+                    m_dataBuffer.clear();
+                    IO::ByteContainerStream<VStd::vector<char>> dataStream(&m_dataBuffer);
+                    classData->SerializerPtr->TextToData(value.String, classData->Version, dataStream);
+                    dataStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+                    isValid = classData->SerializerPtr->Load(objectPtr, dataStream, classData->Version);
+                }
+                break;
+            }
+
+            if (!isValid)
+            {
+                ReportError(VStd::string::format("Json value can't be stored as %s.", classData->Name));
+            }
+            return isValid;
+        }
+
+        const SerializeContext::ClassData* JsonLoader::ResolveWrappedType(u32& valueIndex, const ClassData* classData)
+        {
+            if (m_reader.GetValue(valueIndex).ValueType != JsonReader::Type::Object)
+            {
+                return classData;
+            }
+            const u32 typeIndex = m_reader.FindMember(valueIndex, JsonSerialization::TypeKey);
+            if (typeIndex == JsonReader::InvalidIndex)
+            {
+                return classData;
+            }
+
+            const JsonReader::Value& typeValue = m_reader.GetValue(typeIndex);
+            const u32 wrappedIndex = m_reader.FindMember(valueIndex, JsonSerialization::ValueKey);
+            if (typeValue.ValueType != JsonReader::Type::String || wrappedIndex == JsonReader::InvalidIndex)
+            {
+                ReportError(VStd::string::format("Typed value for %s needs a \"%s\" string and a \"%s\" member.", classData->Name, JsonSerialization::TypeKey, JsonSerialization::ValueKey));
+                return nullptr;
+            }
+
+            const Uuid typeId = Uuid::CreateString(typeValue.String, typeValue.Length);
+            const ClassData* actualClassData = m_context->FindClassData(typeId);
+            if (!actualClassData)
+            {
+                ReportError(VStd::string::format("Type %.*s is not reflected in the serialize context.", static_cast<int>(typeValue.Length), typeValue.String));
+                return nullptr;
+            }
+            valueIndex = wrappedIndex;
+            return actualClassData;
+        }
+
+        const SerializeContext::ClassElement* JsonLoader::FindMember(const ClassData*& classData, VStd::string_view name, void*& objectPtr) const
+        {
+            for (const ClassElement& classElement : classData->Elements)
+            {
+                if (name == classElement.Name)
+                {
+                    return &classElement;
+                }
+            }
+
+            for (const ClassElement& classElement : classData->Elements)
+            {
+                if (!(classElement.Flags & ClassElement::FLG_BASE_CLASS))
+                {
+                    continue;
+                }
+                const ClassData* baseClassData = m_context->FindClassData(classElement.TypeId, classData, classElement.NameCrc);
+                if (baseClassData && IsInlinedBase(baseClassData))
+                {
+                    void* basePtr = reinterpret_cast<char*>(objectPtr) + classElement.Offset;
+                    if (const ClassElement* baseElement = FindMember(baseClassData, name, basePtr))
+                    {
+                        classData = baseClassData;
+                        objectPtr = basePtr;
+                        return baseElement;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        void JsonLoader::NotifyInlinedBases(const ClassData* classData, void* objectPtr, bool isBegin) const
+        {
+            for (const ClassElement& classElement : classData->Elements)
+            {
+                if (!(classElement.Flags & ClassElement::FLG_BASE_CLASS))
+                {
+                    continue;
+                }
+                const ClassData* baseClassData = m_context->FindClassData(classElement.TypeId, classData, classElement.NameCrc);
+                if (!baseClassData || !IsInlinedBase(baseClassData))
+                {
+                    continue;
+                }
+                void* basePtr = reinterpret_cast<char*>(objectPtr) + classElement.Offset;
+                if (baseClassData->EventHandlerPtr)
+                {
+                    if (isBegin)
+                    {
+                        baseClassData->EventHandlerPtr->OnWriteBegin(basePtr);
+                    }
+                    else
+                    {
+                        baseClassData->EventHandlerPtr->OnWriteEnd(basePtr);
+                        baseClassData->EventHandlerPtr->OnLoadedFromObjectStream(basePtr);
+                    }
+                }
+                NotifyInlinedBases(baseClassData, basePtr, isBegin);
+            }
+        }
+
+        const VStd::vector<const SerializeContext::ClassElement*>& JsonLoader::GetContainerElements(const ClassData* classData)
+        {
+            auto insertResult = m_containerElements.insert_key(classData);
+            if (insertResult.second)
+            {
+                VStd::vector<const ClassElement*>& elements = insertResult.first->second;
+                classData->ContainerPtr->EnumTypes([&elements](const Uuid&, const ClassElement* classElement)
+                {
+                    elements.push_back(classElement);
+                    return true;
+                });
+            }
+            return insertResult.first->second;
+        }
+
+        ScalarKind JsonLoader::GetScalarKind(const ClassData* classData)
+        {
+            auto insertResult = m_scalarKinds.insert_key(classData);
+            if (insertResult.second)
+            {
+                insertResult.first->second = FindScalarKind(classData->TypeId);
+            }
+            return insertResult.first->second;
+        }
+
+        //=========================================================================
+        // Helpers shared by the public entry points
+        //=========================================================================
+        static bool ReadStream(IO::GenericStream& stream, VStd::vector<char>& buffer)
+        {
+            const IO::SizeType length = stream.GetLength() - stream.GetCurPos();
+            buffer.resize_no_construct(static_cast<size_t>(length));
+            return stream.Read(length, buffer.data()) == length;
+        }
+
+        static bool Load(char* json, size_t jsonLength, SerializeContext& sc, const Uuid& classId, void* inPlaceObject, void** createdObject, ErrorHandler* errorHandler)
+        {
+            ErrorHandler defaultErrorHandler;
+            ErrorHandler* usedErrorHandler = errorHandler ? errorHandler : &defaultErrorHandler;
+
+            JsonReader reader;
+            if (!reader.Parse(json, jsonLength))
+            {
+                usedErrorHandler->ReportError(VStd::string::format("Invalid json at offset %zu: %s", reader.GetErrorOffset(), reader.GetError().c_str()).c_str());
+                return false;
+            }
+
+            JsonLoader loader(&sc, usedErrorHandler, reader);
+            return loader.Load(classId, inPlaceObject, createdObject);
+        }
+    } // namespace JsonSerializationInternal
+
+    //=========================================================================
+    // SaveObject
+    //=========================================================================
+    bool JsonSerialization::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        ErrorHandler defaultErrorHandler;
+        ErrorHandler* usedErrorHandler = errorHandler ? errorHandler : &defaultErrorHandler;
+        if (!object || !sc.FindClassData(classId))
+        {
+            usedErrorHandler->ReportError(VStd::string::format("Json can't save type %s, it's not reflected in the serialize context.", classId.ToString<VStd::string>().c_str()).c_str());
+            return false;
+        }
+
+        JsonWriter writer(stream);
+        JsonSerializationInternal::JsonSaver saver(&sc, usedErrorHandler, writer);
+        return saver.Save(object, classId);
+    }
+
+    //=========================================================================
+    // LoadObject
+    //=========================================================================
+    void* JsonSerialization::LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        VStd::vector<char> json;
+        if (!JsonSerializationInternal::ReadStream(stream, json))
+        {
+            return nullptr;
+        }
+        return LoadObject(json.data(), json.size(), sc, classId, errorHandler);
+    }
+
+    void* JsonSerialization::LoadObject(char* json, size_t jsonLength, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        void* object = nullptr;
+        JsonSerializationInternal::Load(json, jsonLength, sc, classId, nullptr, &object, errorHandler);
+        return object;
+    }
+
+    //=========================================================================
+    // LoadObjectInPlace
+    //=========================================================================
+    bool JsonSerialization::LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler)
+    {
+        VStd::vector<char> json;
+        if (!JsonSerializationInternal::ReadStream(stream, json))
+        {
+            return false;
+        }
+        return LoadObjectInPlace(json.data(), json.size(), sc, classId, object, errorHandler);
+    }
+
+    bool JsonSerialization::LoadObjectInPlace(char* json, size_t jsonLength, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler)
+    {
+        V_Assert(object, "JsonSerialization::LoadObjectInPlace - Attempt to load into a nullptr.");
+        if (!object)
+        {
+            return false;
+        }
+        return JsonSerializationInternal::Load(json, jsonLength, sc, classId, object, nullptr, errorHandler);
+    }
+} // namespace V
@@ -0,0 +1,74 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_JSON_SERIALIZATION_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_JSON_SERIALIZATION_H
+
+#include <vcore/serialization/serialization_context.h>
+
+namespace V
+{
+    namespace IO
+    {
+        class GenericStream;
+    }
+
+    /**
+     * JSON representation of objects reflected in a SerializeContext.
+     *
+     * Classes are written as objects keyed by the reflected field names, with the fields of base classes inlined.
+     * Containers become arrays (pairs as [first, second], so maps are arrays of pairs), smart pointers become their
+     * pointee or null. Fundamental types and VStd::string map to JSON numbers, booleans and strings, any other type
+     * with an IDataSerializer is stored as the string produced by IDataSerializer::DataToText.
+     * A pointer that holds a type derived from the reflected one is wrapped as {"$type": "{uuid}", "$value": ...}.
+     *
+     * Loading matches members by name, so fields can be added, removed and reordered without a version converter.
+     * Missing members keep the value they had, unknown ones are reported as warnings and skipped.
+     * The char* overloads parse in situ and modify the buffer, the stream overloads read into a scratch buffer first.
+     */
+    class JsonSerialization
+    {
+    public:
+        using ErrorHandler = SerializeContext::ErrorHandler;
+
+        static constexpr const char* TypeKey = "$type";
+        static constexpr const char* ValueKey = "$value";
+
+        template<class T>
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler = nullptr);
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Creates a new object from the document. The document can hold classId or, with a "$type" wrapper, a type derived from it.
+        template<class T>
+        static T* LoadObject(IO::GenericStream& stream, SerializeContext& sc, ErrorHandler* errorHandler = nullptr);
+        static void* LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+        static void* LoadObject(char* json, size_t jsonLength, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Loads the document into an existing object.
+        template<class T>
+        static bool LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, T& object, ErrorHandler* errorHandler = nullptr);
+        static bool LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler = nullptr);
+        static bool LoadObjectInPlace(char* json, size_t jsonLength, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler = nullptr);
+    };
+
+    template<class T>
+    bool JsonSerialization::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(object, SerializeTypeInfo<T>::GetRttiTypeId(object));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(object);
+        return SaveObject(stream, sc, classPtr, classId, errorHandler);
+    }
+
+    template<class T>
+    T* JsonSerialization::LoadObject(IO::GenericStream& stream, SerializeContext& sc, ErrorHandler* errorHandler)
+    {
+        return reinterpret_cast<T*>(LoadObject(stream, sc, SerializeTypeInfo<T>::GetUuid(), errorHandler));
+    }
+
+    template<class T>
+    bool JsonSerialization::LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, T& object, ErrorHandler* errorHandler)
+    {
+        void* classPtr = SerializeTypeInfo<T>::RttiCast(&object, SerializeTypeInfo<T>::GetRttiTypeId(&object));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(&object);
+        return LoadObjectInPlace(stream, sc, classId, classPtr, errorHandler);
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_JSON_SERIALIZATION_H
@@ -0,0 +1,460 @@
+#include <vcore/serialization/json_writer.h>
+#include <vcore/io/generic_streams.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/std/charconv.h>
+
+#include <math.h>
+#include <string.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace V
+{
+    namespace JsonWriterInternal
+    {
+        constexpr size_t BufferSize = 64 * 1024;
+
+        static const char DigitPairs[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        static const double ExactPowersOf10[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /// Integers up to 2^53 are exact in a double.
+        constexpr double MaxExactInteger = 9007199254740992.0;
+
+        /// Writes digits as a decimal with numDecimals digits after the point.
+        static size_t FormatDecimal(u64 digits, int numDecimals, bool isNegative, char* output)
+        {
+            char integer[JsonWriter::MaxNumberLength];
+            const size_t numDigits = JsonWriter::FormatUInt(digits, integer);
+
+            char* out = output;
+            if (isNegative)
+            {
+                *out++ = '-';
+            }
+            if (numDecimals == 0)
+            {
+                memcpy(out, integer, numDigits);
+                return (out - output) + numDigits;
+            }
+            if (numDigits > static_cast<size_t>(numDecimals))
+            {
+                const size_t numIntegerDigits = numDigits - numDecimals;
+                memcpy(out, integer, numIntegerDigits);
+                out += numIntegerDigits;
+                *out++ = '.';
+                memcpy(out, integer + numIntegerDigits, numDecimals);
+                return (out - output) + numDecimals;
+            }
+            *out++ = '0';
+            *out++ = '.';
+            for (size_t i = numDigits; i < static_cast<size_t>(numDecimals); ++i)
+            {
+                *out++ = '0';
+            }
+            memcpy(out, integer, numDigits);
+            return (out - output) + numDigits;
+        }
+
+        /**
+         * Looks for the fewest decimals k for which round(value * 10^k) / 10^k gives value back. Both the power of ten
+         * and the rounded integer are exact, so the division is correctly rounded and the printed digits read back to
+         * the same value. isExact checks the round trip in the precision of the target type.
+         */
+        template<class IsExact>
+        static size_t FormatShortest(double absValue, int maxDecimals, bool isNegative, char* output, const IsExact& isExact)
+        {
+            if (absValue < 1e-5 || absValue >= 1e15)
+            {
+                return 0;
+            }
+            for (int decimals = 0; decimals <= maxDecimals; ++decimals)
+            {
+                const double scaled = absValue * ExactPowersOf10[decimals];
+                if (scaled >= MaxExactInteger)
+                {
+                    break;
+                }
+                const double digits = floor(scaled + 0.5);
+                if (isExact(digits / ExactPowersOf10[decimals]))
+                {
+                    return FormatDecimal(static_cast<u64>(digits), decimals, isNegative, output);
+                }
+            }
+            return 0;
+        }
+
+        /// Slow path for very large and very small values, to_chars gives the shortest form that reads back to the
+        /// same value and, unlike printf, doesn't depend on the locale.
+        template<class T>
+        static size_t FormatShortestScientific(T value, char* output)
+        {
+            const VStd::to_chars_result result = VStd::to_chars(output, output + JsonWriter::MaxNumberLength, value);
+            return result.ec == VStd::errc{} ? static_cast<size_t>(result.ptr - output) : 0;
+        }
+    } // namespace JsonWriterInternal
+
+    //=========================================================================
+    // JsonWriter
+    //=========================================================================
+    JsonWriter::JsonWriter(IO::GenericStream& stream)
+        : m_stream(stream)
+    {
+        m_buffer.resize_no_construct(JsonWriterInternal::BufferSize);
+    }
+
+    JsonWriter::~JsonWriter()
+    {
+        Flush();
+    }
+
+    //=========================================================================
+    // Structure
+    //=========================================================================
+    void JsonWriter::StartObject()
+    {
+        BeginValue();
+        WriteChar('{');
+        m_needsComma.push_back(false);
+    }
+
+    void JsonWriter::EndObject()
+    {
+        m_needsComma.pop_back();
+        WriteChar('}');
+    }
+
+    void JsonWriter::StartArray()
+    {
+        BeginValue();
+        WriteChar('[');
+        m_needsComma.push_back(false);
+    }
+
+    void JsonWriter::EndArray()
+    {
+        m_needsComma.pop_back();
+        WriteChar(']');
+    }
+
+    void JsonWriter::Key(VStd::string_view key)
+    {
+        BeginValue();
+        WriteChar('"');
+        WriteEscaped(key.data(), key.size());
+        Write("\":", 2);
+        m_afterKey = true;
+    }
+
+    void JsonWriter::BeginValue()
+    {
+        if (m_afterKey)
+        {
+            m_afterKey = false;
+            return;
+        }
+        if (!m_needsComma.empty())
+        {
+            if (m_needsComma.back())
+            {
+                WriteChar(',');
+            }
+            m_needsComma.back() = true;
+        }
+    }
+
+    //=========================================================================
+    // Values
+    //=========================================================================
+    void JsonWriter::String(VStd::string_view value)
+    {
+        BeginValue();
+        WriteChar('"');
+        WriteEscaped(value.data(), value.size());
+        WriteChar('"');
+    }
+
+    void JsonWriter::Bool(bool value)
+    {
+        BeginValue();
+        if (value)
+        {
+            Write("true", 4);
+        }
+        else
+        {
+            Write("false", 5);
+        }
+    }
+
+    void JsonWriter::Null()
+    {
+        BeginValue();
+        Write("null", 4);
+    }
+
+    void JsonWriter::Int(s64 value)
+    {
+        BeginValue();
+        char text[MaxNumberLength];
+        Write(text, FormatInt(value, text));
+    }
+
+    void JsonWriter::UInt(u64 value)
+    {
+        BeginValue();
+        char text[MaxNumberLength];
+        Write(text, FormatUInt(value, text));
+    }
+
+    void JsonWriter::Double(double value)
+    {
+        char text[MaxNumberLength];
+        const size_t length = FormatDouble(value, text);
+        if (length == 0)
+        {
+            Null();
+            return;
+        }
+        BeginValue();
+        Write(text, length);
+    }
+
+    void JsonWriter::Float(float value)
+    {
+        char text[MaxNumberLength];
+        const size_t length = FormatFloat(value, text);
+        if (length == 0)
+        {
+            Null();
+            return;
+        }
+        BeginValue();
+        Write(text, length);
+    }
+
+    //=========================================================================
+    // Number formatting
+    //=========================================================================
+    size_t JsonWriter::FormatInt(s64 value, char* output)
+    {
+        if (value < 0)
+        {
+            *output = '-';
+            return 1 + FormatUInt(u64(0) - static_cast<u64>(value), output + 1);
+        }
+        return FormatUInt(static_cast<u64>(value), output);
+    }
+
+    size_t JsonWriter::FormatUInt(u64 value, char* output)
+    {
+        using namespace JsonWriterInternal;
+
+        // fill from the back two digits at a time
+        char digits[20];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        while (value >= 100)
+        {
+            const size_t pair = static_cast<size_t>(value % 100) * 2;
+            value /= 100;
+            p -= 2;
+            p[0] = DigitPairs[pair];
+            p[1] = DigitPairs[pair + 1];
+        }
+        if (value >= 10)
+        {
+            const size_t pair = static_cast<size_t>(value) * 2;
+            p -= 2;
+            p[0] = DigitPairs[pair];
+            p[1] = DigitPairs[pair + 1];
+        }
+        else
+        {
+            *--p = static_cast<char>('0' + value);
+        }
+
+        const size_t length = static_cast<size_t>(end - p);
+        memcpy(output, p, length);
+        return length;
+    }
+
+    size_t JsonWriter::FormatDouble(double value, char* output)
+    {
+        if (!isfinite(value))
+        {
+            return 0;
+        }
+        const bool isNegative = signbit(value) != 0;
+        const double absValue = fabs(value);
+        if (absValue == 0.0)
+        {
+            return JsonWriterInternal::FormatDecimal(0, 0, isNegative, output);
+        }
+
+        auto isExact = [value](double candidate) { return fabs(candidate) == fabs(value); };
+        size_t length = JsonWriterInternal::FormatShortest(absValue, 22, isNegative, output, isExact);
+        if (length == 0)
+        {
+            length = JsonWriterInternal::FormatShortestScientific(value, output);
+        }
+        return length;
+    }
+
+    size_t JsonWriter::FormatFloat(float value, char* output)
+    {
+        if (!isfinite(value))
+        {
+            return 0;
+        }
+        const bool isNegative = signbit(value) != 0;
+        const float absValue = fabsf(value);
+        if (absValue == 0.0f)
+        {
+            return JsonWriterInternal::FormatDecimal(0, 0, isNegative, output);
+        }
+
+        // a float needs at most 9 significant digits, checking the round trip as float keeps them short
+        auto isExact = [absValue](double candidate) { return static_cast<float>(fabs(candidate)) == absValue; };
+        size_t length = JsonWriterInternal::FormatShortest(absValue, 22, isNegative, output, isExact);
+        if (length == 0)
+        {
+            length = JsonWriterInternal::FormatShortestScientific(value, output);
+        }
+        return length;
+    }
+
+    //=========================================================================
+    // Output
+    //=========================================================================
+    void JsonWriter::Write(const char* data, size_t size)
+    {
+        if (m_size + size > m_buffer.size())
+        {
+            Flush();
+            if (size >= m_buffer.size())
+            {
+                m_hasFailed |= m_stream.Write(size, data) != size;
+                return;
+            }
+        }
+        memcpy(m_buffer.data() + m_size, data, size);
+        m_size += size;
+    }
+
+    void JsonWriter::WriteChar(char c)
+    {
+        if (m_size == m_buffer.size())
+        {
+            Flush();
+        }
+        m_buffer[m_size++] = c;
+    }
+
+    void JsonWriter::WriteEscaped(const char* data, size_t size)
+    {
+        static const char HexDigits[] = "0123456789abcdef";
+
+        size_t runStart = 0;
+        size_t i = 0;
+        while (i < size)
+        {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            // skip 16 bytes at a time while there is nothing to escape
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i maxControl = _mm_set1_epi8(0x1f);
+            while (i + 16 <= size)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i isControl = _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxControl), maxControl);
+                const __m128i needsEscape = _mm_or_si128(isControl, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+                const u32 mask = static_cast<u32>(_mm_movemask_epi8(needsEscape));
+                if (mask)
+                {
+                    i += v_ctz_u32(mask);
+                    break;
+                }
+                i += 16;
+            }
+#endif
+            while (i < size)
+            {
+                const u8 c = static_cast<u8>(data[i]);
+                if (c < 0x20 || c == '"' || c == '\\')
+                {
+                    break;
+                }
+                ++i;
+            }
+            if (i == size)
+            {
+                break;
+            }
+
+            Write(data + runStart, i - runStart);
+            const u8 c = static_cast<u8>(data[i]);
+            switch (c)
+            {
+            case '"':
+                Write("\\\"", 2);
+                break;
+            case '\\':
+                Write("\\\\", 2);
+                break;
+            case '\b':
+                Write("\\b", 2);
+                break;
+            case '\f':
+                Write("\\f", 2);
+                break;
+            case '\n':
+                Write("\\n", 2);
+                break;
+            case '\r':
+                Write("\\r", 2);
+                break;
+            case '\t':
+                Write("\\t", 2);
+                break;
+            default:
+            {
+                const char escape[6] = { '\\', 'u', '0', '0', HexDigits[c >> 4], HexDigits[c & 0xf] };
+                Write(escape, sizeof(escape));
+                break;
+            }
+            }
+            runStart = ++i;
+        }
+        Write(data + runStart, size - runStart);
+    }
+
+    //=========================================================================
+    // Flush
+    //=========================================================================
+    bool JsonWriter::Flush()
+    {
+        if (m_size)
+        {
+            m_hasFailed |= m_stream.Write(m_size, m_buffer.data()) != m_size;
+            m_size = 0;
+        }
+        return !m_hasFailed;
+    }
+} // namespace V
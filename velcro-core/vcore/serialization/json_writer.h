@@ -0,0 +1,78 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_JSON_WRITER_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_JSON_WRITER_H
+
+#include <vcore/base.h>
+#include <vcore/memory/system_allocator.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/string/string_view.h>
+
+namespace V
+{
+    namespace IO
+    {
+        class GenericStream;
+    }
+
+    /**
+     * Compact JSON writer on top of an IO::GenericStream.
+     *
+     * Output is collected in a fixed size buffer and only written to the stream when it fills up. Strings are
+     * scanned 16 bytes at a time for characters that need escaping and copied in runs. Numbers are formatted
+     * without printf, so the output doesn't depend on the locale: integers two digits at a time, floating point
+     * values as the shortest decimal that reads back to the same value, with VStd::to_chars for the very large and
+     * very small ones.
+     */
+    class JsonWriter
+    {
+    public:
+        V_CLASS_ALLOCATOR(JsonWriter, SystemAllocator, 0);
+
+        /// Large enough for any formatted number.
+        static constexpr size_t MaxNumberLength = 32;
+
+        explicit JsonWriter(IO::GenericStream& stream);
+        ~JsonWriter();
+
+        void StartObject();
+        void EndObject();
+        void StartArray();
+        void EndArray();
+        /// Writes the key of the next object member.
+        void Key(VStd::string_view key);
+
+        void String(VStd::string_view value);
+        void Bool(bool value);
+        void Null();
+        void Int(s64 value);
+        void UInt(u64 value);
+        /// Non finite values have no JSON representation and are written as null.
+        void Double(double value);
+        void Float(float value);
+
+        /// Writes the buffered output to the stream. Returns false if any write failed.
+        bool Flush();
+        bool HasFailed() const { return m_hasFailed; }
+
+        /// Number formatters, the output is not terminated. Return the number of characters written.
+        static size_t FormatInt(s64 value, char* output);
+        static size_t FormatUInt(u64 value, char* output);
+        /// Return 0 for non finite values.
+        static size_t FormatDouble(double value, char* output);
+        static size_t FormatFloat(float value, char* output);
+
+    private:
+        void BeginValue();
+        void Write(const char* data, size_t size);
+        void WriteChar(char c);
+        void WriteEscaped(const char* data, size_t size);
+
+        IO::GenericStream& m_stream;
+        VStd::vector<char> m_buffer;
+        size_t m_size = 0;
+        VStd::vector<bool> m_needsComma;    ///< One entry per open array or object.
+        bool m_afterKey = false;
+        bool m_hasFailed = false;
+    };
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_JSON_WRITER_H
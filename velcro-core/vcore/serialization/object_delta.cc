@@ -0,0 +1,912 @@
+#include <vcore/serialization/object_delta.h>
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/serialize_plan.h>
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/io/generic_streams.h>
+
+#include <string.h>
+
+namespace V
+{
+    namespace ObjectDeltaInternal
+    {
+        using ClassData = SerializeContext::ClassData;
+        using ClassElement = SerializeContext::ClassElement;
+        using IDataContainer = SerializeContext::IDataContainer;
+        using ErrorHandler = SerializeContext::ErrorHandler;
+
+        /// How a pointer changed, written in front of its data.
+        enum PointerChange : u8
+        {
+            PC_NULL = 0,        ///< The pointer is null now.
+            PC_DELTA = 1,       ///< Same type of pointee, a nested delta follows.
+            PC_REPLACE = 2,     ///< New pointee, its type id and ObjectStream follow.
+        };
+
+        /// How a container changed, written in front of its data.
+        enum ContainerChange : u8
+        {
+            CC_INDEXED = 0,     ///< New size and the changed element ranges follow.
+            CC_REPLACE = 1,     ///< The ObjectStream of the whole container follows.
+        };
+
+        constexpr u8 HeaderFlagBigEndian = 1 << 0;
+        // tag, format version, flags, class id
+        constexpr size_t HasChangesOffset = sizeof(u32) + 2 + 16;
+        constexpr size_t HeaderSize = HasChangesOffset + 1;
+
+        static bool IsPlatformBigEndian()
+        {
+            const u16 value = 1;
+            return *reinterpret_cast<const u8*>(&value) == 0;
+        }
+
+        /// Finds the actual type of the object a pointer element points to and casts object to it. Null if it isn't reflected.
+        static const ClassData* ResolvePointee(const SerializeContext& sc, const ClassElement* element, const ClassData* classData, const void*& object)
+        {
+            if (element->VObjectRtti)
+            {
+                const Uuid& actualClassId = element->VObjectRtti->GetActualUuid(object);
+                if (actualClassId != classData->TypeId)
+                {
+                    classData = sc.FindClassData(actualClassId);
+                    if (!classData)
+                    {
+                        return nullptr;
+                    }
+                }
+                if (classData->VObjectRtti)
+                {
+                    object = element->VObjectRtti->Cast(object, classData->VObjectRtti->GetTypeId());
+                }
+            }
+            return classData->IsDeprecated() ? nullptr : classData;
+        }
+
+        /// Element of containers with a single element type, null for pairs, tuples and variants.
+        static const ClassElement* GetSingleElement(const ClassData* classData)
+        {
+            const ClassElement* result = nullptr;
+            size_t numTypes = 0;
+            classData->ContainerPtr->EnumTypes([&result, &numTypes](const Uuid&, const ClassElement* classElement)
+                {
+                    result = classElement;
+                    ++numTypes;
+                    return true;
+                });
+            return numTypes == 1 ? result : nullptr;
+        }
+
+        /// Element class of containers that are diffed element by element, null for the ones replaced as a whole.
+        static const ClassData* GetIndexedElementClass(const SerializeContext& sc, const ClassData* classData, const ClassElement*& element)
+        {
+            IDataContainer* container = classData->ContainerPtr;
+            element = container->IsSmartPointer() || !container->CanAccessElementsByIndex() ? nullptr : GetSingleElement(classData);
+            if (!element)
+            {
+                return nullptr;
+            }
+            const ClassData* elementClass = element->GenericClassInfoPtr
+                ? element->GenericClassInfoPtr->GetClassData()
+                : sc.FindClassData(element->TypeId, classData, element->NameCrc);
+            return elementClass && !elementClass->IsDeprecated() ? elementClass : nullptr;
+        }
+
+        class DeltaWriter
+        {
+        public:
+            DeltaWriter(const SerializeContext& sc, VStd::vector<char>& output, ErrorHandler* errorHandler)
+                : m_context(sc)
+                , m_output(output)
+                , m_errorHandler(errorHandler)
+            {
+            }
+
+            void WriteHeader(const Uuid& classId);
+            /// Writes the changes of object against baseline, writes nothing and returns false if there are none.
+            bool WriteValue(const ClassData* classData, const void* object, const void* baseline);
+
+        private:
+            bool WritePlanned(const SerializePlan& plan, const void* object, const void* baseline);
+            bool WritePointer(const ClassElement* element, const ClassData* classData, const void* slot, const void* baselineSlot, bool isNewSlot);
+            bool WriteContainer(const ClassData* classData, const void* object, const void* baseline);
+            bool WriteReplacement(const void* object, const void* baseline, const Uuid& classId);
+            void WriteFullValue(const void* object, const Uuid& classId);
+
+            void WriteByte(u8 value) { m_output.push_back(static_cast<char>(value)); }
+            void WriteBytes(const void* data, size_t size)
+            {
+                const char* bytes = reinterpret_cast<const char*>(data);
+                m_output.insert(m_output.end(), bytes, bytes + size);
+            }
+            void WriteVarUInt(u64 value)
+            {
+                while (value >= 0x80)
+                {
+                    WriteByte(u8(value | 0x80));
+                    value >>= 7;
+                }
+                WriteByte(u8(value));
+            }
+
+            size_t Mark() const { return m_output.size(); }
+            void Rollback(size_t mark) { m_output.resize(mark); }
+
+            const SerializeContext& m_context;
+            VStd::vector<char>& m_output;
+            ErrorHandler* m_errorHandler;
+            VStd::vector<char> m_scratchBuffer;
+            VStd::vector<char> m_baselineBuffer;
+        };
+
+        class DeltaReader
+        {
+        public:
+            DeltaReader(SerializeContext& sc, const u8* data, size_t size, ErrorHandler* errorHandler)
+                : m_context(sc)
+                , m_data(data)
+                , m_end(data + size)
+                , m_errorHandler(errorHandler)
+            {
+            }
+
+            /// Returns the class id of the delta, null if the header is invalid.
+            Uuid ReadHeader();
+            bool ReadValue(const ClassData* classData, void* object);
+            bool IsAtEnd() const { return m_data == m_end; }
+
+        private:
+            bool ReadPlanned(const SerializePlan& plan, void* object);
+            bool ReadPointer(const ClassElement* element, const ClassData* classData, void* slot);
+            bool ReadContainer(const ClassData* classData, void* object);
+            bool ReadReplacement(const ClassData* classData, void* object);
+            void DestroyPointee(const ClassElement* element, const ClassData* classData, void* slot);
+
+            const u8* Take(u64 size)
+            {
+                if (m_failed || size > static_cast<u64>(m_end - m_data))
+                {
+                    m_failed = true;
+                    return nullptr;
+                }
+                const u8* data = m_data;
+                m_data += size;
+                return data;
+            }
+            u8 ReadByte()
+            {
+                const u8* data = Take(1);
+                return data ? *data : 0;
+            }
+            u64 ReadVarUInt()
+            {
+                u64 value = 0;
+                for (unsigned int shift = 0; shift < 64; shift += 7)
+                {
+                    const u8 byte = ReadByte();
+                    value |= u64(byte & 0x7f) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return value;
+                    }
+                }
+                m_failed = true;
+                return 0;
+            }
+            bool Fail(const VStd::string& message)
+            {
+                m_failed = true;
+                m_errorHandler->ReportError(message.c_str());
+                return false;
+            }
+            bool ReportTruncated() { return Fail("ObjectDelta: the delta is truncated or damaged."); }
+
+            SerializeContext& m_context;
+            const u8* m_data;
+            const u8* m_end;
+            ErrorHandler* m_errorHandler;
+            bool m_failed = false;
+        };
+
+        //=========================================================================
+        // DeltaWriter::WriteHeader
+        //=========================================================================
+        void DeltaWriter::WriteHeader(const Uuid& classId)
+        {
+            const u32 tag = ObjectDelta::Tag;
+            const u8 tagBytes[4] = { u8(tag), u8(tag >> 8), u8(tag >> 16), u8(tag >> 24) };
+            WriteBytes(tagBytes, sizeof(tagBytes));
+            WriteByte(ObjectDelta::FormatVersion);
+            WriteByte(IsPlatformBigEndian() ? HeaderFlagBigEndian : 0);
+            WriteBytes(classId.data, sizeof(classId.data));
+            WriteByte(0); // has changes, set once the root was written
+        }
+
+        //=========================================================================
+        // DeltaWriter::WriteValue
+        //=========================================================================
+        bool DeltaWriter::WriteValue(const ClassData* classData, const void* object, const void* baseline)
+        {
+            if (const SerializePlan* plan = m_context.GetSerializePlan(classData->TypeId))
+            {
+                return WritePlanned(*plan, object, baseline);
+            }
+            if (classData->ContainerPtr)
+            {
+                return WriteContainer(classData, object, baseline);
+            }
+            // event handlers have to see the whole object loaded
+            return WriteReplacement(object, baseline, classData->TypeId);
+        }
+
+        //=========================================================================
+        // DeltaWriter::WritePlanned
+        //=========================================================================
+        bool DeltaWriter::WritePlanned(const SerializePlan& plan, const void* object, const void* baseline)
+        {
+            const char* objectBytes = reinterpret_cast<const char*>(object);
+            const char* baselineBytes = reinterpret_cast<const char*>(baseline);
+            const VStd::vector<SerializePlan::Op>& ops = plan.GetOps();
+            size_t nextOp = 0;
+            for (size_t opIndex = 0; opIndex < ops.size(); ++opIndex)
+            {
+                const SerializePlan::Op& op = ops[opIndex];
+                const char* objectPtr = objectBytes + op.Offset;
+                const char* baselinePtr = baselineBytes + op.Offset;
+
+                // ops are written as the distance to the previous changed op, 0 ends the list
+                const size_t entryMark = Mark();
+                WriteVarUInt(opIndex - nextOp + 1);
+
+                bool isChanged = false;
+                switch (op.Type)
+                {
+                case SerializePlan::OpType::CopyRun:
+                case SerializePlan::OpType::FloatRun:
+                    // runs are compared bitwise, so -0.0 and NaN payloads replicate exactly
+                    if (memcmp(objectPtr, baselinePtr, op.Size) != 0)
+                    {
+                        size_t first = 0;
+                        while (objectPtr[first] == baselinePtr[first])
+                        {
+                            ++first;
+                        }
+                        size_t last = op.Size;
+                        while (objectPtr[last - 1] == baselinePtr[last - 1])
+                        {
+                            --last;
+                        }
+                        WriteVarUInt(first);
+                        WriteVarUInt(last - first);
+                        WriteBytes(objectPtr + first, last - first);
+                        isChanged = true;
+                    }
+                    break;
+                case SerializePlan::OpType::Serializer:
+                    if (!op.ClassDataPtr->SerializerPtr->CompareValueData(objectPtr, baselinePtr))
+                    {
+                        m_scratchBuffer.clear();
+                        IO::ByteContainerStream<VStd::vector<char>> stream(&m_scratchBuffer);
+                        op.ClassDataPtr->SerializerPtr->Save(objectPtr, stream);
+                        WriteVarUInt(m_scratchBuffer.size());
+                        WriteBytes(m_scratchBuffer.data(), m_scratchBuffer.size());
+                        isChanged = true;
+                    }
+                    break;
+                case SerializePlan::OpType::Pointer:
+                    isChanged = WritePointer(op.ElementPtr, op.ClassDataPtr, objectPtr, baselinePtr, false);
+                    break;
+                case SerializePlan::OpType::Generic:
+                    isChanged = WriteValue(op.ClassDataPtr, objectPtr, baselinePtr);
+                    break;
+                }
+
+                if (isChanged)
+                {
+                    nextOp = opIndex + 1;
+                }
+                else
+                {
+                    Rollback(entryMark);
+                }
+            }
+
+            if (nextOp == 0)
+            {
+                return false;
+            }
+            WriteVarUInt(0);
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaWriter::WritePointer
+        //=========================================================================
+        bool DeltaWriter::WritePointer(const ClassElement* element, const ClassData* classData, const void* slot, const void* baselineSlot, bool isNewSlot)
+        {
+            const void* object = *reinterpret_cast<const void* const*>(slot);
+            const void* baselineObject = *reinterpret_cast<const void* const*>(baselineSlot);
+            const ClassData* objectClass = object ? ResolvePointee(m_context, element, classData, object) : nullptr;
+            if (!objectClass)
+            {
+                if (object)
+                {
+                    m_errorHandler->ReportWarning(VStd::string::format("ObjectDelta: pointer element %s points to a type which isn't reflected, it's written as null.", element->Name).c_str());
+                }
+                if (!baselineObject && !isNewSlot)
+                {
+                    return false;
+                }
+                WriteByte(PC_NULL);
+                return true;
+            }
+
+            if (baselineObject && ResolvePointee(m_context, element, classData, baselineObject) == objectClass)
+            {
+                const size_t mark = Mark();
+                WriteByte(PC_DELTA);
+                if (WriteValue(objectClass, object, baselineObject))
+                {
+                    return true;
+                }
+                Rollback(mark);
+                return false;
+            }
+
+            WriteByte(PC_REPLACE);
+            WriteBytes(objectClass->TypeId.data, sizeof(objectClass->TypeId.data));
+            WriteFullValue(object, objectClass->TypeId);
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaWriter::WriteContainer
+        //=========================================================================
+        bool DeltaWriter::WriteContainer(const ClassData* classData, const void* object, const void* baseline)
+        {
+            const size_t mark = Mark();
+            const ClassElement* element = nullptr;
+            const ClassData* elementClass = GetIndexedElementClass(m_context, classData, element);
+            if (!elementClass)
+            {
+                WriteByte(CC_REPLACE);
+                if (WriteReplacement(object, baseline, classData->TypeId))
+                {
+                    return true;
+                }
+                Rollback(mark);
+                return false;
+            }
+
+            IDataContainer* container = classData->ContainerPtr;
+            void* objectContainer = const_cast<void*>(object);
+            void* baselineContainer = const_cast<void*>(baseline);
+            const size_t size = container->Size(objectContainer);
+            const size_t baselineSize = container->Size(baselineContainer);
+            const size_t commonSize = VStd::min(size, baselineSize);
+            const bool isPointer = (element->Flags & ClassElement::FLG_POINTER) != 0;
+            const size_t rawSize = isPointer ? 0 : SerializePlan::GetRawCopySize(elementClass->TypeId);
+
+            WriteByte(CC_INDEXED);
+            WriteVarUInt(size);
+
+            // Dirty ranges are written as their element count and distance from the end of the previous range,
+            // a count of 0 ends the list. Elements past the baseline size are always dirty.
+            bool isChanged = size != baselineSize;
+            size_t next = 0;
+            auto beginRange = [this, &next](size_t first, size_t count)
+            {
+                WriteVarUInt(count);
+                WriteVarUInt(first - next);
+                next = first + count;
+            };
+            auto getElement = [container, element](void* instance, size_t index)
+            {
+                return container->GetElementByIndex(instance, element, index);
+            };
+
+            if (rawSize)
+            {
+                auto isDirty = [&](size_t index)
+                {
+                    return index >= baselineSize || memcmp(getElement(objectContainer, index), getElement(baselineContainer, index), rawSize) != 0;
+                };
+                for (size_t first = 0; first < size;)
+                {
+                    if (!isDirty(first))
+                    {
+                        ++first;
+                        continue;
+                    }
+                    size_t end = first + 1;
+                    while (end < size && isDirty(end))
+                    {
+                        ++end;
+                    }
+                    beginRange(first, end - first);
+                    for (size_t index = first; index < end; ++index)
+                    {
+                        WriteBytes(getElement(objectContainer, index), rawSize);
+                    }
+                    isChanged = true;
+                    first = end;
+                }
+            }
+            else
+            {
+                for (size_t index = 0; index < commonSize; ++index)
+                {
+                    const size_t entryMark = Mark();
+                    const size_t previousNext = next;
+                    beginRange(index, 1);
+                    const void* elementPtr = getElement(objectContainer, index);
+                    const void* baselineElementPtr = getElement(baselineContainer, index);
+                    const bool isElementChanged = isPointer
+                        ? WritePointer(element, elementClass, elementPtr, baselineElementPtr, false)
+                        : WriteValue(elementClass, elementPtr, baselineElementPtr);
+                    if (isElementChanged)
+                    {
+                        isChanged = true;
+                    }
+                    else
+                    {
+                        Rollback(entryMark);
+                        next = previousNext;
+                    }
+                }
+
+                if (size > baselineSize)
+                {
+                    // new elements are default constructed by the resize, pointers start out null
+                    static const void* const nullSlot = nullptr;
+                    beginRange(baselineSize, size - baselineSize);
+                    for (size_t index = baselineSize; index < size; ++index)
+                    {
+                        const void* elementPtr = getElement(objectContainer, index);
+                        if (isPointer)
+                        {
+                            WritePointer(element, elementClass, elementPtr, &nullSlot, true);
+                        }
+                        else
+                        {
+                            WriteFullValue(elementPtr, elementClass->TypeId);
+                        }
+                    }
+                }
+            }
+
+            if (!isChanged)
+            {
+                Rollback(mark);
+                return false;
+            }
+            WriteVarUInt(0);
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaWriter::WriteReplacement
+        //=========================================================================
+        bool DeltaWriter::WriteReplacement(const void* object, const void* baseline, const Uuid& classId)
+        {
+            m_scratchBuffer.clear();
+            IO::ByteContainerStream<VStd::vector<char>> objectStream(&m_scratchBuffer);
+            ObjectStream::SaveObject(objectStream, m_context, object, classId, m_errorHandler);
+
+            m_baselineBuffer.clear();
+            IO::ByteContainerStream<VStd::vector<char>> baselineStream(&m_baselineBuffer);
+            ObjectStream::SaveObject(baselineStream, m_context, baseline, classId, m_errorHandler);
+
+            if (m_scratchBuffer.size() == m_baselineBuffer.size() && memcmp(m_scratchBuffer.data(), m_baselineBuffer.data(), m_scratchBuffer.size()) == 0)
+            {
+                return false;
+            }
+            WriteVarUInt(m_scratchBuffer.size());
+            WriteBytes(m_scratchBuffer.data(), m_scratchBuffer.size());
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaWriter::WriteFullValue
+        //=========================================================================
+        void DeltaWriter::WriteFullValue(const void* object, const Uuid& classId)
+        {
+            m_scratchBuffer.clear();
+            IO::ByteContainerStream<VStd::vector<char>> stream(&m_scratchBuffer);
+            ObjectStream::SaveObject(stream, m_context, object, classId, m_errorHandler);
+            WriteVarUInt(m_scratchBuffer.size());
+            WriteBytes(m_scratchBuffer.data(), m_scratchBuffer.size());
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadHeader
+        //=========================================================================
+        Uuid DeltaReader::ReadHeader()
+        {
+            const u8* header = Take(HeaderSize);
+            if (!header)
+            {
+                ReportTruncated();
+                return Uuid::CreateNull();
+            }
+            const u32 tag = u32(header[0]) | (u32(header[1]) << 8) | (u32(header[2]) << 16) | (u32(header[3]) << 24);
+            if (tag != ObjectDelta::Tag || header[4] > ObjectDelta::FormatVersion)
+            {
+                Fail("ObjectDelta: the data is not an object delta or was written by a newer version.");
+                return Uuid::CreateNull();
+            }
+            if (((header[5] & HeaderFlagBigEndian) != 0) != IsPlatformBigEndian())
+            {
+                Fail("ObjectDelta: the delta was written on a platform with a different byte order.");
+                return Uuid::CreateNull();
+            }
+            Uuid classId;
+            memcpy(classId.data, header + 6, sizeof(classId.data));
+            return classId;
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadValue
+        //=========================================================================
+        bool DeltaReader::ReadValue(const ClassData* classData, void* object)
+        {
+            if (const SerializePlan* plan = m_context.GetSerializePlan(classData->TypeId))
+            {
+                return ReadPlanned(*plan, object);
+            }
+            if (classData->ContainerPtr)
+            {
+                return ReadContainer(classData, object);
+            }
+            return ReadReplacement(classData, object);
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadPlanned
+        //=========================================================================
+        bool DeltaReader::ReadPlanned(const SerializePlan& plan, void* object)
+        {
+            char* objectBytes = reinterpret_cast<char*>(object);
+            const VStd::vector<SerializePlan::Op>& ops = plan.GetOps();
+            size_t nextOp = 0;
+            for (;;)
+            {
+                const u64 distance = ReadVarUInt();
+                if (m_failed)
+                {
+                    return ReportTruncated();
+                }
+                if (distance == 0)
+                {
+                    return true;
+                }
+                if (distance - 1 >= ops.size() - nextOp)
+                {
+                    return Fail(VStd::string::format("ObjectDelta: member index out of range for class %s, the reflection differs from the writer's.", plan.GetClassData()->Name));
+                }
+
+                const size_t opIndex = nextOp + static_cast<size_t>(distance - 1);
+                const SerializePlan::Op& op = ops[opIndex];
+                char* objectPtr = objectBytes + op.Offset;
+                switch (op.Type)
+                {
+                case SerializePlan::OpType::CopyRun:
+                case SerializePlan::OpType::FloatRun:
+                {
+                    const u64 first = ReadVarUInt();
+                    const u64 size = ReadVarUInt();
+                    if (first > op.Size || size > op.Size - first)
+                    {
+                        return ReportTruncated();
+                    }
+                    const u8* data = Take(size);
+                    if (!data)
+                    {
+                        return ReportTruncated();
+                    }
+                    memcpy(objectPtr + first, data, static_cast<size_t>(size));
+                    break;
+                }
+                case SerializePlan::OpType::Serializer:
+                {
+                    const u64 size = ReadVarUInt();
+                    const u8* data = Take(size);
+                    if (!data)
+                    {
+                        return ReportTruncated();
+                    }
+                    IO::MemoryStream stream(data, static_cast<size_t>(size));
+                    if (!op.ClassDataPtr->SerializerPtr->Load(objectPtr, stream, op.ClassDataPtr->Version))
+                    {
+                        return Fail(VStd::string::format("ObjectDelta: failed to load a value of type %s.", op.ClassDataPtr->Name));
+                    }
+                    break;
+                }
+                case SerializePlan::OpType::Pointer:
+                    if (!ReadPointer(op.ElementPtr, op.ClassDataPtr, objectPtr))
+                    {
+                        return false;
+                    }
+                    break;
+                case SerializePlan::OpType::Generic:
+                    if (!ReadValue(op.ClassDataPtr, objectPtr))
+                    {
+                        return false;
+                    }
+                    break;
+                }
+                nextOp = opIndex + 1;
+            }
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadPointer
+        //=========================================================================
+        bool DeltaReader::ReadPointer(const ClassElement* element, const ClassData* classData, void* slot)
+        {
+            void*& pointer = *reinterpret_cast<void**>(slot);
+            const u8 change = ReadByte();
+            if (m_failed)
+            {
+                return ReportTruncated();
+            }
+            switch (change)
+            {
+            case PC_NULL:
+                DestroyPointee(element, classData, slot);
+                pointer = nullptr;
+                return true;
+            case PC_DELTA:
+            {
+                const void* object = pointer;
+                const ClassData* objectClass = object ? ResolvePointee(m_context, element, classData, object) : nullptr;
+                if (!objectClass)
+                {
+                    return Fail(VStd::string::format("ObjectDelta: pointer element %s doesn't hold the baseline object.", element->Name));
+                }
+                return ReadValue(objectClass, const_cast<void*>(object));
+            }
+            case PC_REPLACE:
+            {
+                const u8* typeIdData = Take(16);
+                const u64 size = ReadVarUInt();
+                const u8* data = Take(size);
+                if (!typeIdData || !data)
+                {
+                    return ReportTruncated();
+                }
+                Uuid typeId;
+                memcpy(typeId.data, typeIdData, sizeof(typeId.data));
+                const ClassData* objectClass = m_context.FindClassData(typeId);
+                if (!objectClass)
+                {
+                    return Fail(VStd::string::format("ObjectDelta: type %s of pointer element %s is not reflected.", typeId.ToString<VStd::string>().c_str(), element->Name));
+                }
+
+                IO::MemoryStream stream(data, static_cast<size_t>(size));
+                void* newObject = ObjectStream::LoadObject(stream, m_context, typeId, m_errorHandler);
+                if (!newObject)
+                {
+                    return Fail(VStd::string::format("ObjectDelta: failed to load the new object of pointer element %s.", element->Name));
+                }
+                DestroyPointee(element, classData, slot);
+                pointer = m_context.DownCast(newObject, typeId, element->TypeId, objectClass->VObjectRtti, element->VObjectRtti);
+                return true;
+            }
+            default:
+                return ReportTruncated();
+            }
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadContainer
+        //=========================================================================
+        bool DeltaReader::ReadContainer(const ClassData* classData, void* object)
+        {
+            IDataContainer* container = classData->ContainerPtr;
+            const u8 change = ReadByte();
+            if (m_failed)
+            {
+                return ReportTruncated();
+            }
+            if (change == CC_REPLACE)
+            {
+                container->ClearElements(object, &m_context);
+                return ReadReplacement(classData, object);
+            }
+
+            const ClassElement* element = nullptr;
+            const ClassData* elementClass = GetIndexedElementClass(m_context, classData, element);
+            if (change != CC_INDEXED || !elementClass)
+            {
+                return Fail(VStd::string::format("ObjectDelta: unexpected change of container %s, the reflection differs from the writer's.", classData->Name));
+            }
+
+            const bool isPointer = (element->Flags & ClassElement::FLG_POINTER) != 0;
+            const size_t rawSize = isPointer ? 0 : SerializePlan::GetRawCopySize(elementClass->TypeId);
+            const size_t baselineSize = container->Size(object);
+            const u64 size = ReadVarUInt();
+            // every new element takes at least a byte, reject sizes the remaining data can't hold
+            if (m_failed || (size > baselineSize && size - baselineSize > static_cast<u64>(m_end - m_data)))
+            {
+                return ReportTruncated();
+            }
+
+            if (size != baselineSize)
+            {
+                if (isPointer)
+                {
+                    for (size_t index = static_cast<size_t>(size); index < baselineSize; ++index)
+                    {
+                        DestroyPointee(element, elementClass, container->GetElementByIndex(object, element, index));
+                    }
+                }
+                if (!container->ResizeElements(object, static_cast<size_t>(size)))
+                {
+                    return Fail(VStd::string::format("ObjectDelta: container %s can't be resized to %llu elements.", classData->Name, static_cast<unsigned long long>(size)));
+                }
+            }
+
+            size_t next = 0;
+            for (;;)
+            {
+                const u64 count = ReadVarUInt();
+                if (m_failed)
+                {
+                    return ReportTruncated();
+                }
+                if (count == 0)
+                {
+                    break;
+                }
+                const u64 skip = ReadVarUInt();
+                if (m_failed || skip > size - next || count > size - next - skip)
+                {
+                    return ReportTruncated();
+                }
+
+                const size_t first = next + static_cast<size_t>(skip);
+                next = first + static_cast<size_t>(count);
+                for (size_t index = first; index < next; ++index)
+                {
+                    void* elementPtr = container->GetElementByIndex(object, element, index);
+                    bool isLoaded;
+                    if (rawSize)
+                    {
+                        const u8* data = Take(rawSize);
+                        isLoaded = data != nullptr || ReportTruncated();
+                        if (data)
+                        {
+                            memcpy(elementPtr, data, rawSize);
+                        }
+                    }
+                    else if (isPointer)
+                    {
+                        isLoaded = ReadPointer(element, elementClass, elementPtr);
+                    }
+                    else if (index < baselineSize)
+                    {
+                        isLoaded = ReadValue(elementClass, elementPtr);
+                    }
+                    else
+                    {
+                        isLoaded = ReadReplacement(elementClass, elementPtr);
+                    }
+                    if (!isLoaded)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            container->ElementsUpdated(object);
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaReader::ReadReplacement
+        //=========================================================================
+        bool DeltaReader::ReadReplacement(const ClassData* classData, void* object)
+        {
+            const u64 size = ReadVarUInt();
+            const u8* data = Take(size);
+            if (!data)
+            {
+                return ReportTruncated();
+            }
+            IO::MemoryStream stream(data, static_cast<size_t>(size));
+            if (!ObjectStream::LoadObjectInPlace(stream, m_context, classData->TypeId, object, m_errorHandler))
+            {
+                return Fail(VStd::string::format("ObjectDelta: failed to load a value of type %s.", classData->Name));
+            }
+            return true;
+        }
+
+        //=========================================================================
+        // DeltaReader::DestroyPointee
+        //=========================================================================
+        void DeltaReader::DestroyPointee(const ClassElement* element, const ClassData* classData, void* slot)
+        {
+            const void* object = *reinterpret_cast<void* const*>(slot);
+            if (!object)
+            {
+                return;
+            }
+            const ClassData* objectClass = ResolvePointee(m_context, element, classData, object);
+            if (objectClass && objectClass->Factory)
+            {
+                objectClass->Factory->Destroy(const_cast<void*>(object));
+            }
+            else
+            {
+                m_errorHandler->ReportWarning(VStd::string::format("ObjectDelta: failed to delete the old object of pointer element %s, memory could leak.", element->Name).c_str());
+            }
+        }
+    } // namespace ObjectDeltaInternal
+
+    //=========================================================================
+    // CreateDelta
+    //=========================================================================
+    bool ObjectDelta::CreateDelta(VStd::vector<char>& delta, const SerializeContext& sc, const void* object, const void* baseline, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        ErrorHandler defaultErrorHandler;
+        errorHandler = errorHandler ? errorHandler : &defaultErrorHandler;
+        const unsigned int startErrorCount = errorHandler->GetErrorCount();
+
+        delta.clear();
+        const SerializeContext::ClassData* classData = sc.FindClassData(classId);
+        if (!classData || classData->IsDeprecated())
+        {
+            errorHandler->ReportError(VStd::string::format("ObjectDelta: class %s is not reflected.", classId.ToString<VStd::string>().c_str()).c_str());
+            return false;
+        }
+
+        ObjectDeltaInternal::DeltaWriter writer(sc, delta, errorHandler);
+        writer.WriteHeader(classId);
+        delta[ObjectDeltaInternal::HasChangesOffset] = writer.WriteValue(classData, object, baseline) ? 1 : 0;
+        return errorHandler->GetErrorCount() == startErrorCount;
+    }
+
+    //=========================================================================
+    // ApplyDelta
+    //=========================================================================
+    bool ObjectDelta::ApplyDelta(void* object, SerializeContext& sc, const Uuid& classId, const void* delta, size_t deltaSize, ErrorHandler* errorHandler)
+    {
+        ErrorHandler defaultErrorHandler;
+        errorHandler = errorHandler ? errorHandler : &defaultErrorHandler;
+        const unsigned int startErrorCount = errorHandler->GetErrorCount();
+
+        ObjectDeltaInternal::DeltaReader reader(sc, reinterpret_cast<const u8*>(delta), deltaSize, errorHandler);
+        const Uuid deltaClassId = reader.ReadHeader();
+        if (deltaClassId.IsNull())
+        {
+            return false;
+        }
+        if (deltaClassId != classId)
+        {
+            errorHandler->ReportError(VStd::string::format("ObjectDelta: the delta was made for class %s, not %s.",
+                deltaClassId.ToString<VStd::string>().c_str(), classId.ToString<VStd::string>().c_str()).c_str());
+            return false;
+        }
+        const SerializeContext::ClassData* classData = sc.FindClassData(classId);
+        if (!classData || classData->IsDeprecated())
+        {
+            errorHandler->ReportError(VStd::string::format("ObjectDelta: class %s is not reflected.", classId.ToString<VStd::string>().c_str()).c_str());
+            return false;
+        }
+
+        if (HasChanges(delta, deltaSize) && reader.ReadValue(classData, object) && !reader.IsAtEnd())
+        {
+            errorHandler->ReportError("ObjectDelta: unexpected data after the end of the delta.");
+        }
+        return errorHandler->GetErrorCount() == startErrorCount;
+    }
+
+    //=========================================================================
+    // HasChanges
+    //=========================================================================
+    bool ObjectDelta::HasChanges(const void* delta, size_t deltaSize)
+    {
+        return deltaSize >= ObjectDeltaInternal::HeaderSize && reinterpret_cast<const u8*>(delta)[ObjectDeltaInternal::HasChangesOffset] != 0;
+    }
+} // namespace V
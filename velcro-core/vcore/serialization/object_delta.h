@@ -0,0 +1,60 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_DELTA_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_DELTA_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/std/containers/vector.h>
+
+namespace V
+{
+    /**
+     * Binary difference between a reflected object and an older state of it (the baseline).
+     *
+     * Creating a delta walks both instances with the SerializePlan of their type and only writes what changed:
+     *   - fundamental fields as the changed byte range of their run,
+     *   - values with an IDataSerializer as their serialized data,
+     *   - pointed to objects of the same type as a nested delta, anything else as the full ObjectStream of the pointee,
+     *   - containers with indexed access (vector, array, fixed_vector...) as the new size and the dirty element ranges,
+     *     other containers and classes with event handlers as their full ObjectStream when they differ.
+     *
+     * Applying a delta to an object holding the baseline turns it into the object the delta was made from. Both sides
+     * need the same reflection, the delta references members by their position in the plan, not by name. Deltas are
+     * stored in the byte order of the writer and rejected by platforms with a different byte order.
+     */
+    class ObjectDelta
+    {
+    public:
+        using ErrorHandler = SerializeContext::ErrorHandler;
+
+        /// 'VDLT' in little endian.
+        static constexpr u32 Tag = 0x544c4456;
+        static constexpr u8 FormatVersion = 1;
+
+        /// Writes the difference between object and baseline, replacing the content of delta.
+        template<class T>
+        static bool CreateDelta(VStd::vector<char>& delta, const SerializeContext& sc, const T& object, const T& baseline, ErrorHandler* errorHandler = nullptr);
+        static bool CreateDelta(VStd::vector<char>& delta, const SerializeContext& sc, const void* object, const void* baseline, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Applies delta to object, which must hold the baseline the delta was made against.
+        /// On failure the object can be left partially updated.
+        template<class T>
+        static bool ApplyDelta(T& object, SerializeContext& sc, const void* delta, size_t deltaSize, ErrorHandler* errorHandler = nullptr);
+        static bool ApplyDelta(void* object, SerializeContext& sc, const Uuid& classId, const void* delta, size_t deltaSize, ErrorHandler* errorHandler = nullptr);
+
+        /// Returns false if the object was equal to its baseline, applying such a delta doesn't change anything.
+        static bool HasChanges(const void* delta, size_t deltaSize);
+    };
+
+    template<class T>
+    bool ObjectDelta::CreateDelta(VStd::vector<char>& delta, const SerializeContext& sc, const T& object, const T& baseline, ErrorHandler* errorHandler)
+    {
+        return CreateDelta(delta, sc, &object, &baseline, SerializeTypeInfo<T>::GetUuid(), errorHandler);
+    }
+
+    template<class T>
+    bool ObjectDelta::ApplyDelta(T& object, SerializeContext& sc, const void* delta, size_t deltaSize, ErrorHandler* errorHandler)
+    {
+        return ApplyDelta(&object, sc, SerializeTypeInfo<T>::GetUuid(), delta, deltaSize, errorHandler);
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_DELTA_H
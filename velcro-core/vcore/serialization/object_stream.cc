@@ -0,0 +1,1413 @@
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/root_object_arena.h>
+#include <vcore/serialization/dynamic_serializable_field.h>
+#include <vcore/io/generic_streams.h>
+#include <vcore/std/containers/unordered_map.h>
+#include <vcore/std/containers/vector.h>
+
+namespace V
+{
+    namespace ObjectStreamInternal
+    {
+        /// Per element flags, a 0 byte terminates the list of child elements.
+        enum ElementFlags : u8
+        {
+            EF_ELEMENT  = 1 << 0,   ///< Always set so an element never starts with 0.
+            EF_NAME     = 1 << 1,   ///< u32 name CRC follows.
+            EF_VERSION  = 1 << 2,   ///< varint class version follows.
+            EF_DATA     = 1 << 3,   ///< varint data size and the IDataSerializer output follow.
+            EF_BULK     = 1 << 4,   ///< Container elements are stored as one memory block instead of child elements.
+        };
+
+        constexpr u8 EndOfElements = 0;
+        constexpr u8 HeaderFlagBigEndian = 1 << 0;
+        constexpr size_t StreamBufferSize = 64 * 1024;
+
+        static bool IsPlatformBigEndian()
+        {
+            const u16 value = 1;
+            return *reinterpret_cast<const u8*>(&value) == 0;
+        }
+
+        /// Types that can be copied as raw memory. long is left out because its size differs between platforms.
+        static size_t GetBulkCopyableTypeSize(const Uuid& typeId)
+        {
+            static const VStd::pair<Uuid, size_t> bulkTypes[] =
+            {
+                { SerializeTypeInfo<char>::GetUuid(), sizeof(char) },
+                { SerializeTypeInfo<V::s8>::GetUuid(), sizeof(V::s8) },
+                { SerializeTypeInfo<short>::GetUuid(), sizeof(short) },
+                { SerializeTypeInfo<int>::GetUuid(), sizeof(int) },
+                { SerializeTypeInfo<V::s64>::GetUuid(), sizeof(V::s64) },
+                { SerializeTypeInfo<unsigned char>::GetUuid(), sizeof(unsigned char) },
+                { SerializeTypeInfo<unsigned short>::GetUuid(), sizeof(unsigned short) },
+                { SerializeTypeInfo<unsigned int>::GetUuid(), sizeof(unsigned int) },
+                { SerializeTypeInfo<V::u64>::GetUuid(), sizeof(V::u64) },
+                { SerializeTypeInfo<float>::GetUuid(), sizeof(float) },
+                { SerializeTypeInfo<double>::GetUuid(), sizeof(double) },
+                { SerializeTypeInfo<bool>::GetUuid(), sizeof(bool) },
+            };
+            for (const auto& bulkType : bulkTypes)
+            {
+                if (bulkType.first == typeId)
+                {
+                    return bulkType.second;
+                }
+            }
+            return 0;
+        }
+
+        static void SwapElementBytes(void* data, size_t numElements, size_t elementSize)
+        {
+            u8* bytes = reinterpret_cast<u8*>(data);
+            for (size_t i = 0; i < numElements; ++i, bytes += elementSize)
+            {
+                for (size_t low = 0, high = elementSize - 1; low < high; ++low, --high)
+                {
+                    VStd::swap(bytes[low], bytes[high]);
+                }
+            }
+        }
+
+        /// Buffers small writes so the GenericStream is only hit once per StreamBufferSize bytes.
+        class StreamWriter
+        {
+        public:
+            explicit StreamWriter(IO::GenericStream& stream)
+                : m_stream(stream)
+            {
+                m_buffer.resize(StreamBufferSize);
+            }
+
+            void WriteBytes(const void* data, size_t size)
+            {
+                if (m_used + size > StreamBufferSize)
+                {
+                    Flush();
+                    if (size >= StreamBufferSize)
+                    {
+                        WriteToStream(data, size);
+                        return;
+                    }
+                }
+                memcpy(m_buffer.data() + m_used, data, size);
+                m_used += size;
+            }
+
+            void WriteByte(u8 value)
+            {
+                if (m_used == StreamBufferSize)
+                {
+                    Flush();
+                }
+                m_buffer[m_used++] = value;
+            }
+
+            void WriteU32(u32 value)
+            {
+                const u8 bytes[4] = { u8(value), u8(value >> 8), u8(value >> 16), u8(value >> 24) };
+                WriteBytes(bytes, sizeof(bytes));
+            }
+
+            void WriteVarUInt(u64 value)
+            {
+                u8 bytes[10];
+                size_t numBytes = 0;
+                while (value >= 0x80)
+                {
+                    bytes[numBytes++] = u8(value | 0x80);
+                    value >>= 7;
+                }
+                bytes[numBytes++] = u8(value);
+                WriteBytes(bytes, numBytes);
+            }
+
+            void Flush()
+            {
+                if (m_used)
+                {
+                    WriteToStream(m_buffer.data(), m_used);
+                    m_used = 0;
+                }
+            }
+
+            bool HasFailed() const { return m_failed; }
+
+        private:
+            void WriteToStream(const void* data, size_t size)
+            {
+                if (m_stream.Write(size, data) != size)
+                {
+                    m_failed = true;
+                }
+            }
+
+            IO::GenericStream& m_stream;
+            VStd::vector<u8> m_buffer;
+            size_t m_used = 0;
+            bool m_failed = false;
+        };
+
+        /// Buffered reader counterpart of StreamWriter. Any failure is sticky and checked with IsValid.
+        class StreamReader
+        {
+        public:
+            explicit StreamReader(IO::GenericStream& stream)
+                : m_stream(stream)
+            {
+                m_buffer.resize(StreamBufferSize);
+            }
+
+            bool ReadBytes(void* data, size_t size)
+            {
+                u8* out = reinterpret_cast<u8*>(data);
+                while (size > 0)
+                {
+                    if (m_position == m_size)
+                    {
+                        if (size >= StreamBufferSize)
+                        {
+                            // large blocks go straight to their destination
+                            if (m_stream.Read(size, out) != size)
+                            {
+                                m_failed = true;
+                            }
+                            return !m_failed;
+                        }
+                        if (!Refill())
+                        {
+                            return false;
+                        }
+                    }
+                    const size_t numBytes = VStd::min(size, m_size - m_position);
+                    memcpy(out, m_buffer.data() + m_position, numBytes);
+                    m_position += numBytes;
+                    out += numBytes;
+                    size -= numBytes;
+                }
+                return true;
+            }
+
+            bool Skip(u64 size)
+            {
+                while (size > 0)
+                {
+                    if (m_position == m_size && !Refill())
+                    {
+                        return false;
+                    }
+                    const size_t numBytes = static_cast<size_t>(VStd::min<u64>(size, m_size - m_position));
+                    m_position += numBytes;
+                    size -= numBytes;
+                }
+                return true;
+            }
+
+            u8 ReadByte()
+            {
+                if (m_position == m_size && !Refill())
+                {
+                    return 0;
+                }
+                return m_buffer[m_position++];
+            }
+
+            u32 ReadU32()
+            {
+                u8 bytes[4];
+                if (!ReadBytes(bytes, sizeof(bytes)))
+                {
+                    return 0;
+                }
+                return u32(bytes[0]) | (u32(bytes[1]) << 8) | (u32(bytes[2]) << 16) | (u32(bytes[3]) << 24);
+            }
+
+            u64 ReadVarUInt()
+            {
+                u64 value = 0;
+                for (unsigned int shift = 0; shift < 64; shift += 7)
+                {
+                    const u8 byte = ReadByte();
+                    value |= u64(byte & 0x7f) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return value;
+                    }
+                }
+                m_failed = true;
+                return 0;
+            }
+
+            /// Rejects sizes that can't possibly be in the stream, so corrupted data doesn't trigger huge allocations.
+            bool IsPlausibleSize(u64 size)
+            {
+                const u64 length = m_stream.GetLength();
+                if (length != 0 && size > length)
+                {
+                    m_failed = true;
+                }
+                return !m_failed;
+            }
+
+            /// Moves the stream back to the end of the data that was actually consumed.
+            void Release()
+            {
+                if (m_position < m_size && m_stream.CanSeek())
+                {
+                    m_stream.Seek(-static_cast<IO::OffsetType>(m_size - m_position), IO::GenericStream::ST_SEEK_CUR);
+                }
+                m_position = m_size = 0;
+            }
+
+            bool IsValid() const { return !m_failed; }
+
+        private:
+            bool Refill()
+            {
+                m_position = 0;
+                m_size = m_failed ? 0 : static_cast<size_t>(m_stream.Read(StreamBufferSize, m_buffer.data()));
+                if (m_size == 0)
+                {
+                    m_failed = true;
+                }
+                return !m_failed;
+            }
+
+            IO::GenericStream& m_stream;
+            VStd::vector<u8> m_buffer;
+            size_t m_position = 0;
+            size_t m_size = 0;
+            bool m_failed = false;
+        };
+
+        class ObjectStreamImpl
+        {
+        public:
+            using ClassData = SerializeContext::ClassData;
+            using ClassElement = SerializeContext::ClassElement;
+            using DataElementNode = SerializeContext::DataElementNode;
+            using ErrorHandler = SerializeContext::ErrorHandler;
+            using IDataContainer = SerializeContext::IDataContainer;
+
+            ObjectStreamImpl(const SerializeContext* sc, ErrorHandler* errorHandler)
+                : m_context(sc)
+                , m_errorHandler(errorHandler ? errorHandler : &m_defaultErrorHandler)
+            {
+            }
+
+            bool Save(IO::GenericStream& stream, const void* object, const Uuid& classId);
+            bool Load(IO::GenericStream& stream, const Uuid& classId, void* inPlaceObject, void** createdObject);
+            /// Creates the root object in arena instead of through its factory.
+            void SetArena(RootObjectArena* arena) { m_arena = arena; }
+
+        private:
+            /// Container layout information used by the bulk path, cached per container class.
+            struct BulkContainerInfo
+            {
+                const ClassElement* ElementPtr = nullptr;
+                Uuid ElementTypeId = Uuid::CreateNull();
+                size_t ElementSize = 0;
+            };
+
+            struct ElementHeader
+            {
+                u8 Flags = 0;
+                u32 NameCrc = 0;
+                Uuid TypeId = Uuid::CreateNull();
+                unsigned int Version = 0;
+                u64 DataSize = 0;
+            };
+
+            struct LoadParent
+            {
+                void* Ptr;
+                const ClassData* ClassDataPtr;
+                size_t ContainerIndexCounter;
+                size_t NextElementHint; ///< Elements are written in reflection order, so the next match is usually the next element.
+            };
+
+            // saving
+            bool BeginSaveElement(void* ptr, const ClassData* classData, const ClassElement* classElement);
+            bool EndSaveElement();
+            void WriteTypeId(const Uuid& typeId);
+            bool IsBulkContainer(const void* objectPtr, const ClassData* classData, const BulkContainerInfo*& bulkInfo, size_t& numElements, const void*& firstElement);
+
+            // loading
+            bool ReadTypeId(Uuid& typeId);
+            bool ReadElementHeader(u8 flags, ElementHeader& header);
+            bool SkipElementBody(const ElementHeader& header);
+            bool LoadElement(const ElementHeader& header, LoadParent* parent);
+            bool NeedsConversion(const ClassData* classData, unsigned int storedVersion) const;
+            bool LoadElementDirect(const ElementHeader& header, LoadParent* parent, const ClassData* classData);
+            bool LoadElementConverted(const ElementHeader& header, LoadParent* parent, const ClassData* classData);
+            bool LoadChildren(void* objectPtr, const ClassData* classData);
+            bool LoadBulk(void* containerPtr, const ClassData* classData);
+            bool ReadNode(DataElementNode& node, const ElementHeader& header, const ClassData* classData, const ClassData* parentClassData);
+            bool ConvertNode(DataElementNode& node);
+            void ApplyDataPatchUpgrades(DataElementNode& node, const ClassData& classData);
+            void LoadNode(DataElementNode& node, void* objectPtr);
+            const ClassElement* FindClassElement(LoadParent& parent, u32 nameCrc, const ClassData* classData, ClassElement& dynamicElement);
+            bool ResolveDestination(LoadParent* parent, u32 nameCrc, const ClassData* classData, void*& destPtr, void*& reservePtr);
+            const char* FindElementName(const ClassData* parentClassData, u32 nameCrc) const;
+
+            const BulkContainerInfo* GetBulkInfo(const ClassData* classData);
+            void ReportError(const VStd::string& message) { m_errorHandler->ReportError(message.c_str()); }
+            void ReportWarning(const VStd::string& message) { m_errorHandler->ReportWarning(message.c_str()); }
+            SerializeContext* GetMutableContext() const { return const_cast<SerializeContext*>(m_context); }
+
+            const SerializeContext* m_context;
+            ErrorHandler* m_errorHandler;
+            ErrorHandler m_defaultErrorHandler;
+
+            StreamWriter* m_writer = nullptr;
+            StreamReader* m_reader = nullptr;
+            VStd::unordered_map<Uuid, u64> m_writtenTypes;
+            VStd::vector<Uuid> m_readTypes;
+            VStd::unordered_map<const ClassData*, BulkContainerInfo> m_bulkInfos;
+            VStd::vector<bool> m_writtenStack;
+            VStd::vector<char> m_dataBuffer;
+            bool m_swapBulkData = false;
+
+            Uuid m_rootClassId = Uuid::CreateNull();
+            void* m_inPlaceObject = nullptr;
+            void* m_createdObject = nullptr;
+            const ClassData* m_createdClassData = nullptr;
+            RootObjectArena* m_arena = nullptr;
+        };
+
+        //=========================================================================
+        // GetBulkInfo
+        //=========================================================================
+        const ObjectStreamImpl::BulkContainerInfo* ObjectStreamImpl::GetBulkInfo(const ClassData* classData)
+        {
+            auto insertResult = m_bulkInfos.insert_key(classData);
+            BulkContainerInfo& info = insertResult.first->second;
+            if (insertResult.second)
+            {
+                IDataContainer* container = classData->ContainerPtr;
+                if (container && container->CanAccessElementsByIndex() && !container->IsSmartPointer())
+                {
+                    int numTypes = 0;
+                    container->EnumTypes([&info, &numTypes](const Uuid& elementClassId, const ClassElement* genericClassElement)
+                    {
+                        info.ElementTypeId = elementClassId;
+                        info.ElementPtr = genericClassElement;
+                        ++numTypes;
+                        return true;
+                    });
+
+                    const size_t typeSize = GetBulkCopyableTypeSize(info.ElementTypeId);
+                    if (numTypes == 1 && info.ElementPtr && (info.ElementPtr->Flags & ClassElement::FLG_POINTER) == 0 &&
+                        typeSize != 0 && typeSize == info.ElementPtr->DataSize)
+                    {
+                        info.ElementSize = typeSize;
+                    }
+                }
+            }
+            return info.ElementSize != 0 ? &info : nullptr;
+        }
+
+        //=========================================================================
+        // IsBulkContainer
+        //=========================================================================
+        bool ObjectStreamImpl::IsBulkContainer(const void* objectPtr, const ClassData* classData, const BulkContainerInfo*& bulkInfo, size_t& numElements, const void*& firstElement)
+        {
+            bulkInfo = GetBulkInfo(classData);
+            if (!bulkInfo)
+            {
+                return false;
+            }
+
+            void* instance = const_cast<void*>(objectPtr);
+            IDataContainer* container = classData->ContainerPtr;
+            numElements = container->Size(instance);
+            if (numElements == 0)
+            {
+                return false;
+            }
+
+            // only take the block copy when the storage is actually contiguous
+            const char* first = reinterpret_cast<const char*>(container->GetElementByIndex(instance, bulkInfo->ElementPtr, 0));
+            const char* last = reinterpret_cast<const char*>(container->GetElementByIndex(instance, bulkInfo->ElementPtr, numElements - 1));
+            if (!first || !last || static_cast<size_t>(last - first) != (numElements - 1) * bulkInfo->ElementSize)
+            {
+                return false;
+            }
+            firstElement = first;
+            return true;
+        }
+
+        //=========================================================================
+        // WriteTypeId
+        //=========================================================================
+        void ObjectStreamImpl::WriteTypeId(const Uuid& typeId)
+        {
+            // 0 introduces a new type id, anything else is the index of an already written type + 1
+            auto insertResult = m_writtenTypes.insert_key(typeId);
+            if (insertResult.second)
+            {
+                insertResult.first->second = m_writtenTypes.size();
+                m_writer->WriteVarUInt(0);
+                m_writer->WriteBytes(typeId.data, sizeof(typeId.data));
+            }
+            else
+            {
+                m_writer->WriteVarUInt(insertResult.first->second);
+            }
+        }
+
+        //=========================================================================
+        // Save
+        //=========================================================================
+        bool ObjectStreamImpl::Save(IO::GenericStream& stream, const void* object, const Uuid& classId)
+        {
+            if (!object || !m_context->FindClassData(classId))
+            {
+                ReportError(VStd::string::format("ObjectStream can't save type %s, it's not reflected in the serialize context.", classId.ToString<VStd::string>().c_str()));
+                return false;
+            }
+
+            const unsigned int numErrors = m_errorHandler->GetErrorCount();
+
+            StreamWriter writer(stream);
+            m_writer = &writer;
+            writer.WriteU32(ObjectStream::Tag);
+            writer.WriteByte(ObjectStream::FormatVersion);
+            writer.WriteByte(IsPlatformBigEndian() ? HeaderFlagBigEndian : 0);
+
+            SerializeContext::EnumerateInstanceCallContext callContext(
+                [this](void* ptr, const ClassData* classData, const ClassElement* classElement)
+                {
+                    return BeginSaveElement(ptr, classData, classElement);
+                },
+                [this]()
+                {
+                    return EndSaveElement();
+                },
+                m_context,
+                SerializeContext::ENUM_ACCESS_FOR_READ,
+                m_errorHandler);
+
+            m_context->EnumerateInstanceConst(&callContext, object, classId, nullptr, nullptr);
+
+            writer.Flush();
+            m_writer = nullptr;
+            return !writer.HasFailed() && m_errorHandler->GetErrorCount() == numErrors;
+        }
+
+        //=========================================================================
+        // BeginSaveElement
+        //=========================================================================
+        bool ObjectStreamImpl::BeginSaveElement(void* ptr, const ClassData* classData, const ClassElement* classElement)
+        {
+            const void* objectPtr = ptr;
+            if (classElement && (classElement->Flags & ClassElement::FLG_POINTER))
+            {
+                objectPtr = *reinterpret_cast<void* const*>(ptr);
+                if (classElement->VObjectRtti && classData->VObjectRtti)
+                {
+                    objectPtr = classElement->VObjectRtti->Cast(objectPtr, classData->VObjectRtti->GetTypeId());
+                }
+            }
+
+            if (classData->IsDeprecated() || (classElement && classData->DoSave && !classData->DoSave(objectPtr)))
+            {
+                m_writtenStack.push_back(false);
+                return false;
+            }
+
+            u8 flags = EF_ELEMENT;
+            const u32 nameCrc = classElement ? classElement->NameCrc : 0;
+            if (nameCrc)
+            {
+                flags |= EF_NAME;
+            }
+            if (classData->Version)
+            {
+                flags |= EF_VERSION;
+            }
+
+            size_t dataSize = 0;
+            if (classData->SerializerPtr)
+            {
+                m_dataBuffer.clear();
+                IO::ByteContainerStream<VStd::vector<char>> dataStream(&m_dataBuffer);
+                classData->SerializerPtr->Save(objectPtr, dataStream);
+                dataSize = m_dataBuffer.size();
+                if (dataSize)
+                {
+                    flags |= EF_DATA;
+                }
+            }
+
+            const BulkContainerInfo* bulkInfo = nullptr;
+            size_t numBulkElements = 0;
+            const void* firstBulkElement = nullptr;
+            if (classData->ContainerPtr && IsBulkContainer(objectPtr, classData, bulkInfo, numBulkElements, firstBulkElement))
+            {
+                flags |= EF_BULK;
+            }
+
+            m_writer->WriteByte(flags);
+            if (flags & EF_NAME)
+            {
+                m_writer->WriteU32(nameCrc);
+            }
+            WriteTypeId(classData->TypeId);
+            if (flags & EF_VERSION)
+            {
+                m_writer->WriteVarUInt(classData->Version);
+            }
+            if (flags & EF_DATA)
+            {
+                m_writer->WriteVarUInt(dataSize);
+                m_writer->WriteBytes(m_dataBuffer.data(), dataSize);
+            }
+            if (flags & EF_BULK)
+            {
+                m_writer->WriteVarUInt(numBulkElements);
+                m_writer->WriteVarUInt(bulkInfo->ElementSize);
+                WriteTypeId(bulkInfo->ElementTypeId);
+                m_writer->WriteBytes(firstBulkElement, numBulkElements * bulkInfo->ElementSize);
+            }
+
+            m_writtenStack.push_back(true);
+            // the elements of a bulk container are already written
+            return (flags & EF_BULK) == 0;
+        }
+
+        //=========================================================================
+        // EndSaveElement
+        //=========================================================================
+        bool ObjectStreamImpl::EndSaveElement()
+        {
+            if (m_writtenStack.back())
+            {
+                m_writer->WriteByte(EndOfElements);
+            }
+            m_writtenStack.pop_back();
+            return true;
+        }
+
+        //=========================================================================
+        // ReadTypeId
+        //=========================================================================
+        bool ObjectStreamImpl::ReadTypeId(Uuid& typeId)
+        {
+            const u64 typeIndex = m_reader->ReadVarUInt();
+            if (typeIndex == 0)
+            {
+                if (m_reader->ReadBytes(typeId.data, sizeof(typeId.data)))
+                {
+                    m_readTypes.push_back(typeId);
+                }
+            }
+            else if (typeIndex <= m_readTypes.size())
+            {
+                typeId = m_readTypes[typeIndex - 1];
+            }
+            else
+            {
+                ReportError(VStd::string::format("ObjectStream references unknown type index %llu, the stream is corrupted.", static_cast<unsigned long long>(typeIndex)));
+                return false;
+            }
+            return m_reader->IsValid();
+        }
+
+        //=========================================================================
+        // ReadElementHeader
+        //=========================================================================
+        bool ObjectStreamImpl::ReadElementHeader(u8 flags, ElementHeader& header)
+        {
+            header.Flags = flags;
+            header.NameCrc = (flags & EF_NAME) ? m_reader->ReadU32() : 0;
+            if (!ReadTypeId(header.TypeId))
+            {
+                return false;
+            }
+            header.Version = (flags & EF_VERSION) ? static_cast<unsigned int>(m_reader->ReadVarUInt()) : 0;
+            header.DataSize = (flags & EF_DATA) ? m_reader->ReadVarUInt() : 0;
+            return m_reader->IsPlausibleSize(header.DataSize);
+        }
+
+        //=========================================================================
+        // SkipElementBody
+        //=========================================================================
+        bool ObjectStreamImpl::SkipElementBody(const ElementHeader& header)
+        {
+            m_reader->Skip(header.DataSize);
+            if (header.Flags & EF_BULK)
+            {
+                const u64 numElements = m_reader->ReadVarUInt();
+                const u64 elementSize = m_reader->ReadVarUInt();
+                Uuid elementTypeId;
+                if (!ReadTypeId(elementTypeId))
+                {
+                    return false;
+                }
+                m_reader->Skip(numElements * elementSize);
+            }
+
+            for (u8 flags = m_reader->ReadByte(); m_reader->IsValid() && flags != EndOfElements; flags = m_reader->ReadByte())
+            {
+                ElementHeader childHeader;
+                if (!ReadElementHeader(flags, childHeader) || !SkipElementBody(childHeader))
+                {
+                    return false;
+                }
+            }
+            return m_reader->IsValid();
+        }
+
+        //=========================================================================
+        // Load
+        //=========================================================================
+        bool ObjectStreamImpl::Load(IO::GenericStream& stream, const Uuid& classId, void* inPlaceObject, void** createdObject)
+        {
+            const unsigned int numErrors = m_errorHandler->GetErrorCount();
+
+            StreamReader reader(stream);
+            m_reader = &reader;
+            m_rootClassId = classId;
+            m_inPlaceObject = inPlaceObject;
+
+            const u32 tag = reader.ReadU32();
+            const u8 formatVersion = reader.ReadByte();
+            const u8 headerFlags = reader.ReadByte();
+            if (!reader.IsValid() || tag != ObjectStream::Tag || formatVersion > ObjectStream::FormatVersion)
+            {
+                ReportError("Stream is not a supported binary ObjectStream.");
+                m_reader = nullptr;
+                return false;
+            }
+            m_swapBulkData = ((headerFlags & HeaderFlagBigEndian) != 0) != IsPlatformBigEndian();
+
+            bool isValid = false;
+            ElementHeader header;
+            const u8 flags = reader.ReadByte();
+            if (flags != EndOfElements && ReadElementHeader(flags, header))
+            {
+                isValid = LoadElement(header, nullptr) && reader.IsValid();
+            }
+            reader.Release();
+            m_reader = nullptr;
+
+            if (!isValid)
+            {
+                ReportError("ObjectStream is truncated or corrupted.");
+            }
+
+            if (createdObject)
+            {
+                *createdObject = nullptr;
+                if (m_createdObject)
+                {
+                    if (isValid)
+                    {
+                        *createdObject = GetMutableContext()->DownCast(m_createdObject, m_createdClassData->TypeId, classId, m_createdClassData->VObjectRtti);
+                    }
+                    else if (m_arena)
+                    {
+                        m_arena->DestroyObject(m_createdObject);
+                    }
+                    else
+                    {
+                        m_createdClassData->Factory->Destroy(m_createdObject);
+                    }
+                }
+                return *createdObject != nullptr;
+            }
+            return isValid && m_errorHandler->GetErrorCount() == numErrors;
+        }
+
+        //=========================================================================
+        // LoadElement
+        //=========================================================================
+        bool ObjectStreamImpl::LoadElement(const ElementHeader& header, LoadParent* parent)
+        {
+            const ClassData* classData = m_context->FindClassData(header.TypeId, parent ? parent->ClassDataPtr : nullptr, header.NameCrc);
+            if (!classData)
+            {
+                ReportWarning(VStd::string::format("Element 0x%08x of type %s is not reflected and will be skipped.",
+                    header.NameCrc, header.TypeId.ToString<VStd::string>().c_str()));
+                return SkipElementBody(header);
+            }
+
+            if (classData->IsDeprecated() && !classData->Converter)
+            {
+                // deprecated classes are silently dropped
+                return SkipElementBody(header);
+            }
+
+            if (NeedsConversion(classData, header.Version))
+            {
+                return LoadElementConverted(header, parent, classData);
+            }
+            return LoadElementDirect(header, parent, classData);
+        }
+
+        //=========================================================================
+        // NeedsConversion
+        //=========================================================================
+        bool ObjectStreamImpl::NeedsConversion(const ClassData* classData, unsigned int storedVersion) const
+        {
+            if (classData->IsDeprecated())
+            {
+                return true;
+            }
+            if (classData->Version == storedVersion)
+            {
+                return false;
+            }
+            if (classData->Converter)
+            {
+                return true;
+            }
+
+            // Without a converter only upgrades starting between the stored and the current version touch the data.
+            // Anything else was a field being added or removed, which the direct path handles by name as well.
+            for (const auto& fieldUpgrades : classData->DataPatchUpgrader.GetUpgrades())
+            {
+                auto upgradeIt = fieldUpgrades.second.lower_bound(storedVersion);
+                if (upgradeIt != fieldUpgrades.second.end() && upgradeIt->first < classData->Version)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //=========================================================================
+        // LoadElementDirect
+        //=========================================================================
+        bool ObjectStreamImpl::LoadElementDirect(const ElementHeader& header, LoadParent* parent, const ClassData* classData)
+        {
+            void* destPtr = nullptr;
+            void* reservePtr = nullptr;
+            if (!ResolveDestination(parent, header.NameCrc, classData, destPtr, reservePtr))
+            {
+                return SkipElementBody(header);
+            }
+
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteBegin(destPtr);
+            }
+
+            if (header.DataSize)
+            {
+                m_dataBuffer.resize_no_construct(static_cast<size_t>(header.DataSize));
+                if (!m_reader->ReadBytes(m_dataBuffer.data(), m_dataBuffer.size()))
+                {
+                    return false;
+                }
+                if (classData->SerializerPtr)
+                {
+                    IO::ByteContainerStream<VStd::vector<char>> dataStream(&m_dataBuffer);
+                    if (!classData->SerializerPtr->Load(destPtr, dataStream, header.Version))
+                    {
+                        ReportError(VStd::string::format("Failed to load data for element 0x%08x of class %s.", header.NameCrc, classData->Name));
+                    }
+                }
+            }
+
+            // start from an empty container, otherwise the loaded elements are added to the existing ones
+            if (classData->ContainerPtr)
+            {
+                classData->ContainerPtr->ClearElements(destPtr, GetMutableContext());
+            }
+
+            if ((header.Flags & EF_BULK) && !LoadBulk(destPtr, classData))
+            {
+                return false;
+            }
+
+            if (!LoadChildren(destPtr, classData))
+            {
+                return false;
+            }
+
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteEnd(destPtr);
+                classData->EventHandlerPtr->OnLoadedFromObjectStream(destPtr);
+            }
+
+            if (parent && parent->ClassDataPtr->ContainerPtr)
+            {
+                parent->ClassDataPtr->ContainerPtr->StoreElement(parent->Ptr, reservePtr);
+            }
+            return true;
+        }
+
+        //=========================================================================
+        // LoadChildren
+        //=========================================================================
+        bool ObjectStreamImpl::LoadChildren(void* objectPtr, const ClassData* classData)
+        {
+            LoadParent parent{ objectPtr, classData, 0, 0 };
+            for (u8 flags = m_reader->ReadByte(); m_reader->IsValid() && flags != EndOfElements; flags = m_reader->ReadByte())
+            {
+                ElementHeader header;
+                if (!ReadElementHeader(flags, header) || !LoadElement(header, &parent))
+                {
+                    return false;
+                }
+            }
+            return m_reader->IsValid();
+        }
+
+        //=========================================================================
+        // LoadBulk
+        //=========================================================================
+        bool ObjectStreamImpl::LoadBulk(void* containerPtr, const ClassData* classData)
+        {
+            const u64 numElements = m_reader->ReadVarUInt();
+            const u64 elementSize = m_reader->ReadVarUInt();
+            Uuid elementTypeId;
+            if (!ReadTypeId(elementTypeId) || !m_reader->IsPlausibleSize(numElements * elementSize))
+            {
+                return false;
+            }
+
+            const BulkContainerInfo* bulkInfo = GetBulkInfo(classData);
+            if (!bulkInfo || bulkInfo->ElementTypeId != elementTypeId || bulkInfo->ElementSize != elementSize)
+            {
+                ReportError(VStd::string::format("Container %s doesn't store %s elements anymore, %llu elements are skipped.",
+                    classData->Name, elementTypeId.ToString<VStd::string>().c_str(), static_cast<unsigned long long>(numElements)));
+                return m_reader->Skip(numElements * elementSize);
+            }
+
+            // Reserve all elements first, the container storage is final after that and the data can be read in place.
+            IDataContainer* container = classData->ContainerPtr;
+            const bool canAccessByIndex = container->CanAccessElementsByIndex();
+            size_t numReserved = 0;
+            for (; numReserved < numElements; ++numReserved)
+            {
+                void* element = canAccessByIndex && container->Size(containerPtr) > numReserved
+                    ? container->GetElementByIndex(containerPtr, bulkInfo->ElementPtr, numReserved)
+                    : container->ReserveElement(containerPtr, bulkInfo->ElementPtr);
+                if (!element)
+                {
+                    ReportError(VStd::string::format("Failed to reserve element in container %s. The container may be full, %llu elements will not be added.",
+                        classData->Name, static_cast<unsigned long long>(numElements - numReserved)));
+                    break;
+                }
+                container->StoreElement(containerPtr, element);
+            }
+
+            if (numReserved > 0)
+            {
+                char* first = reinterpret_cast<char*>(container->GetElementByIndex(containerPtr, bulkInfo->ElementPtr, 0));
+                char* last = reinterpret_cast<char*>(container->GetElementByIndex(containerPtr, bulkInfo->ElementPtr, numReserved - 1));
+                if (first && last && static_cast<size_t>(last - first) == (numReserved - 1) * bulkInfo->ElementSize)
+                {
+                    if (!m_reader->ReadBytes(first, numReserved * bulkInfo->ElementSize))
+                    {
+                        return false;
+                    }
+                    if (m_swapBulkData)
+                    {
+                        SwapElementBytes(first, numReserved, bulkInfo->ElementSize);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < numReserved; ++i)
+                    {
+                        void* element = container->GetElementByIndex(containerPtr, bulkInfo->ElementPtr, i);
+                        if (!m_reader->ReadBytes(element, bulkInfo->ElementSize))
+                        {
+                            return false;
+                        }
+                        if (m_swapBulkData)
+                        {
+                            SwapElementBytes(element, 1, bulkInfo->ElementSize);
+                        }
+                    }
+                }
+            }
+            return m_reader->Skip((numElements - numReserved) * elementSize);
+        }
+
+        //=========================================================================
+        // LoadElementConverted
+        //=========================================================================
+        bool ObjectStreamImpl::LoadElementConverted(const ElementHeader& header, LoadParent* parent, const ClassData* classData)
+        {
+            DataElementNode node;
+            if (!ReadNode(node, header, classData, parent ? parent->ClassDataPtr : nullptr))
+            {
+                return false;
+            }
+
+            if (!ConvertNode(node) || !node.m_classData)
+            {
+                // the conversion reported why, continue with the siblings
+                return true;
+            }
+
+            void* destPtr = nullptr;
+            void* reservePtr = nullptr;
+            if (ResolveDestination(parent, node.m_element.NameCrc, node.m_classData, destPtr, reservePtr))
+            {
+                LoadNode(node, destPtr);
+                if (parent && parent->ClassDataPtr->ContainerPtr)
+                {
+                    parent->ClassDataPtr->ContainerPtr->StoreElement(parent->Ptr, reservePtr);
+                }
+            }
+            return true;
+        }
+
+        //=========================================================================
+        // ReadNode
+        //=========================================================================
+        bool ObjectStreamImpl::ReadNode(DataElementNode& node, const ElementHeader& header, const ClassData* classData, const ClassData* parentClassData)
+        {
+            SerializeContext::DataElement& element = node.m_element;
+            element.Name = FindElementName(parentClassData, header.NameCrc);
+            element.NameCrc = header.NameCrc;
+            element.Id = header.TypeId;
+            element.Version = header.Version;
+            element.DataCategory = SerializeContext::DataElement::DT_BINARY;
+            element.DataSize = static_cast<size_t>(header.DataSize);
+            element.Buffer.resize_no_construct(element.DataSize);
+            if (element.DataSize && !m_reader->ReadBytes(element.Buffer.data(), element.DataSize))
+            {
+                return false;
+            }
+            element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+            element.StreamPtr = &element.ByteStream;
+            node.m_classData = classData;
+
+            if (header.Flags & EF_BULK)
+            {
+                const u64 numElements = m_reader->ReadVarUInt();
+                const u64 elementSize = m_reader->ReadVarUInt();
+                Uuid elementTypeId;
+                if (!ReadTypeId(elementTypeId) || !m_reader->IsPlausibleSize(numElements * elementSize))
+                {
+                    return false;
+                }
+
+                // Expand the block into regular element nodes so converters see the usual layout.
+                const BulkContainerInfo* bulkInfo = classData ? GetBulkInfo(classData) : nullptr;
+                const ClassData* elementClassData = m_context->FindClassData(elementTypeId);
+                if (!bulkInfo || !elementClassData || !elementClassData->SerializerPtr || GetBulkCopyableTypeSize(elementTypeId) != elementSize)
+                {
+                    ReportWarning(VStd::string::format("Unable to expand %llu stored elements of type %s, they will be skipped.",
+                        static_cast<unsigned long long>(numElements), elementTypeId.ToString<VStd::string>().c_str()));
+                    m_reader->Skip(numElements * elementSize);
+                }
+                else
+                {
+                    node.m_subElements.reserve(static_cast<size_t>(numElements));
+                    for (u64 i = 0; i < numElements; ++i)
+                    {
+                        alignas(8) char value[8];
+                        if (!m_reader->ReadBytes(value, static_cast<size_t>(elementSize)))
+                        {
+                            return false;
+                        }
+                        if (m_swapBulkData)
+                        {
+                            SwapElementBytes(value, 1, static_cast<size_t>(elementSize));
+                        }
+
+                        node.m_subElements.emplace_back();
+                        DataElementNode& child = node.m_subElements.back();
+                        child.m_classData = elementClassData;
+                        child.m_element.Name = bulkInfo->ElementPtr->Name;
+                        child.m_element.NameCrc = bulkInfo->ElementPtr->NameCrc;
+                        child.m_element.Id = elementTypeId;
+                        child.m_element.Version = elementClassData->Version;
+                        child.m_element.DataCategory = SerializeContext::DataElement::DT_BINARY;
+                        child.m_element.DataSize = elementClassData->SerializerPtr->Save(value, child.m_element.ByteStream);
+                        child.m_element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+                        child.m_element.StreamPtr = &child.m_element.ByteStream;
+                    }
+                }
+            }
+
+            for (u8 flags = m_reader->ReadByte(); m_reader->IsValid() && flags != EndOfElements; flags = m_reader->ReadByte())
+            {
+                ElementHeader childHeader;
+                if (!ReadElementHeader(flags, childHeader))
+                {
+                    return false;
+                }
+
+                const ClassData* childClassData = m_context->FindClassData(childHeader.TypeId, classData, childHeader.NameCrc);
+                if (!childClassData)
+                {
+                    ReportWarning(VStd::string::format("Element 0x%08x of type %s is not reflected and will be skipped.",
+                        childHeader.NameCrc, childHeader.TypeId.ToString<VStd::string>().c_str()));
+                    if (!SkipElementBody(childHeader))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                node.m_subElements.emplace_back();
+                if (!ReadNode(node.m_subElements.back(), childHeader, childClassData, classData))
+                {
+                    return false;
+                }
+            }
+            return m_reader->IsValid();
+        }
+
+        //=========================================================================
+        // ConvertNode
+        //=========================================================================
+        bool ObjectStreamImpl::ConvertNode(DataElementNode& node)
+        {
+            const ClassData* classData = node.m_classData;
+            if (!classData)
+            {
+                return false;
+            }
+
+            if (classData->IsDeprecated() || node.m_element.Version != classData->Version)
+            {
+                ApplyDataPatchUpgrades(node, *classData);
+                if (classData->Converter && !classData->Converter(*GetMutableContext(), node))
+                {
+                    ReportError(VStd::string::format("Converting element 0x%08x of class %s from version %u failed.",
+                        node.m_element.NameCrc, classData->Name, node.m_element.Version));
+                    return false;
+                }
+
+                // the converter may have changed the type of the node
+                if (!node.m_classData || node.m_classData->IsDeprecated())
+                {
+                    return false;
+                }
+                node.m_element.Version = node.m_classData->Version;
+            }
+
+            for (int i = 0; i < node.GetNumSubElements();)
+            {
+                DataElementNode& child = node.GetSubElement(i);
+                if (!child.m_classData)
+                {
+                    child.m_classData = m_context->FindClassData(child.m_element.Id, node.m_classData, child.m_element.NameCrc);
+                }
+                if (!ConvertNode(child))
+                {
+                    node.RemoveElement(i);
+                    continue;
+                }
+                ++i;
+            }
+            return true;
+        }
+
+        //=========================================================================
+        // ApplyDataPatchUpgrades
+        //=========================================================================
+        void ObjectStreamImpl::ApplyDataPatchUpgrades(DataElementNode& node, const ClassData& classData)
+        {
+            const SerializeContext::DataPatchFieldUpgrades& upgrades = classData.DataPatchUpgrader.GetUpgrades();
+            if (upgrades.empty())
+            {
+                return;
+            }
+
+            const unsigned int storedVersion = node.m_element.Version;
+            for (int i = 0; i < node.GetNumSubElements(); ++i)
+            {
+                DataElementNode& field = node.GetSubElement(i);
+                auto fieldIt = upgrades.find(V::Crc32(field.GetName()));
+                if (fieldIt == upgrades.end())
+                {
+                    continue;
+                }
+
+                // Walk the upgrades from the stored version towards the current one, each step takes the upgrades
+                // that reach the furthest without passing the current version.
+                const SerializeContext::DataPatchUpgradeMap& versionUpgrades = fieldIt->second;
+                unsigned int version = storedVersion;
+                for (auto it = versionUpgrades.lower_bound(version); it != versionUpgrades.end() && it->first < classData.Version; it = versionUpgrades.lower_bound(version))
+                {
+                    unsigned int toVersion = 0;
+                    for (const SerializeContext::DataPatchUpgrade* upgrade : it->second)
+                    {
+                        if (upgrade->ToVersion() <= classData.Version)
+                        {
+                            toVersion = VStd::max(toVersion, upgrade->ToVersion());
+                        }
+                    }
+                    if (toVersion <= it->first)
+                    {
+                        break;
+                    }
+
+                    for (const SerializeContext::DataPatchUpgrade* upgrade : it->second)
+                    {
+                        if (upgrade->ToVersion() == toVersion)
+                        {
+                            upgrade->Apply(*GetMutableContext(), field);
+                        }
+                    }
+                    version = toVersion;
+                }
+            }
+        }
+
+        //=========================================================================
+        // LoadNode
+        //=========================================================================
+        void ObjectStreamImpl::LoadNode(DataElementNode& node, void* objectPtr)
+        {
+            const ClassData* classData = node.m_classData;
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteBegin(objectPtr);
+            }
+
+            SerializeContext::DataElement& element = node.m_element;
+            if (classData->SerializerPtr && element.DataSize)
+            {
+                element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+                if (!classData->SerializerPtr->Load(objectPtr, element.ByteStream, element.Version, element.DataCategory == SerializeContext::DataElement::DT_BINARY_BE))
+                {
+                    ReportError(VStd::string::format("Failed to load data for element 0x%08x of class %s.", element.NameCrc, classData->Name));
+                }
+            }
+
+            if (classData->ContainerPtr)
+            {
+                classData->ContainerPtr->ClearElements(objectPtr, GetMutableContext());
+            }
+
+            node.GetDataHierarchy(objectPtr, element.Id, m_errorHandler);
+
+            if (classData->EventHandlerPtr)
+            {
+                classData->EventHandlerPtr->OnWriteEnd(objectPtr);
+                classData->EventHandlerPtr->OnLoadedFromObjectStream(objectPtr);
+            }
+        }
+
+        //=========================================================================
+        // FindClassElement
+        //=========================================================================
+        const SerializeContext::ClassElement* ObjectStreamImpl::FindClassElement(LoadParent& parent, u32 nameCrc, const ClassData* classData, ClassElement& dynamicElement)
+        {
+            const ClassData* parentClassData = parent.ClassDataPtr;
+            const ClassElement* classElement = nullptr;
+            if (parentClassData->ContainerPtr)
+            {
+                classElement = parentClassData->ContainerPtr->GetElement(nameCrc);
+            }
+            else if (parentClassData->TypeId == SerializeTypeInfo<DynamicSerializableField>::GetUuid() && nameCrc == static_cast<u32>(V_CRC("m_data", 0x335cc942)))
+            {
+                DynamicSerializableField* dynamicField = reinterpret_cast<DynamicSerializableField*>(parent.Ptr);
+                dynamicField->TypeId = classData->TypeId;
+
+                dynamicElement.Name = "m_data";
+                dynamicElement.NameCrc = nameCrc;
+                dynamicElement.TypeId = classData->TypeId;
+                dynamicElement.DataSize = sizeof(void*);
+                dynamicElement.Offset = reinterpret_cast<size_t>(&(reinterpret_cast<DynamicSerializableField const volatile*>(0)->DataPtr));
+                dynamicElement.VObjectRtti = nullptr;
+                dynamicElement.GenericClassInfoPtr = m_context->FindGenericClassInfo(classData->TypeId);
+                dynamicElement.EditDataPtr = nullptr;
+                dynamicElement.Flags = ClassElement::FLG_DYNAMIC_FIELD | ClassElement::FLG_POINTER;
+                return &dynamicElement;
+            }
+            else
+            {
+                const size_t numElements = parentClassData->Elements.size();
+                for (size_t i = 0; i < numElements; ++i)
+                {
+                    const size_t index = (parent.NextElementHint + i) % numElements;
+                    if (parentClassData->Elements[index].NameCrc == nameCrc)
+                    {
+                        classElement = &parentClassData->Elements[index];
+                        parent.NextElementHint = index + 1;
+                        break;
+                    }
+                }
+            }
+
+            if (!classElement)
+            {
+                return nullptr;
+            }
+
+            // pointers can hold derived types, values must match exactly
+            if (classData->TypeId == classElement->TypeId || classData->TypeId == m_context->GetUnderlyingTypeId(classElement->TypeId))
+            {
+                return classElement;
+            }
+            if ((classElement->Flags & ClassElement::FLG_POINTER) && classData->VObjectRtti && classElement->VObjectRtti &&
+                classData->VObjectRtti->IsTypeOf(classElement->VObjectRtti->GetTypeId()))
+            {
+                return classElement;
+            }
+            return nullptr;
+        }
+
+        //=========================================================================
+        // ResolveDestination
+        //=========================================================================
+        bool ObjectStreamImpl::ResolveDestination(LoadParent* parent, u32 nameCrc, const ClassData* classData, void*& destPtr, void*& reservePtr)
+        {
+            if (!parent)
+            {
+                if (m_inPlaceObject)
+                {
+                    if (classData->TypeId != m_rootClassId)
+                    {
+                        ReportError(VStd::string::format("ObjectStream contains %s, it can't be loaded in place into %s.",
+                            classData->TypeId.ToString<VStd::string>().c_str(), m_rootClassId.ToString<VStd::string>().c_str()));
+                        return false;
+                    }
+                    destPtr = m_inPlaceObject;
+                }
+                else
+                {
+                    if (!classData->Factory || !m_context->CanDowncast(classData->TypeId, m_rootClassId, classData->VObjectRtti))
+                    {
+                        ReportError(VStd::string::format("ObjectStream contains %s, which can't be created as %s.",
+                            classData->Name, m_rootClassId.ToString<VStd::string>().c_str()));
+                        return false;
+                    }
+                    destPtr = m_arena ? m_arena->CreateObject(*classData) : classData->Factory->Create(classData->Name);
+                    m_createdObject = destPtr;
+                    m_createdClassData = classData;
+                }
+                reservePtr = destPtr;
+                return destPtr != nullptr;
+            }
+
+            ClassElement dynamicElement;
+            const ClassElement* classElement = FindClassElement(*parent, nameCrc, classData, dynamicElement);
+            if (!classElement)
+            {
+                ReportWarning(VStd::string::format("Class %s has no element 0x%08x of type %s, the stored value is skipped.",
+                    parent->ClassDataPtr->Name, nameCrc, classData->Name));
+                return false;
+            }
+
+            IDataContainer* container = parent->ClassDataPtr->ContainerPtr;
+            if (container)
+            {
+                if (container->CanAccessElementsByIndex() && container->Size(parent->Ptr) > parent->ContainerIndexCounter)
+                {
+                    destPtr = container->GetElementByIndex(parent->Ptr, classElement, parent->ContainerIndexCounter);
+                }
+                else
+                {
+                    destPtr = container->ReserveElement(parent->Ptr, classElement);
+                }
+                ++parent->ContainerIndexCounter;
+
+                if (!destPtr)
+                {
+                    ReportError(VStd::string::format("Failed to reserve element in container %s. The container may be full, element %u will not be added.",
+                        parent->ClassDataPtr->Name, static_cast<unsigned int>(parent->ContainerIndexCounter - 1)));
+                    return false;
+                }
+            }
+            else
+            {
+                destPtr = reinterpret_cast<char*>(parent->Ptr) + classElement->Offset;
+            }
+
+            reservePtr = destPtr;
+            if (classElement->Flags & ClassElement::FLG_POINTER)
+            {
+                if (!classData->Factory)
+                {
+                    ReportError(VStd::string::format("Unable to create '%s' for element '%s', no factory is provided.", classData->Name, classElement->Name));
+                    if (container)
+                    {
+                        container->FreeReservedElement(parent->Ptr, reservePtr, nullptr);
+                    }
+                    return false;
+                }
+                void* newElement = classData->Factory->Create(classData->Name);
+                *reinterpret_cast<void**>(destPtr) = GetMutableContext()->DownCast(newElement, classData->TypeId, classElement->TypeId, classData->VObjectRtti, classElement->VObjectRtti);
+                destPtr = newElement;
+            }
+            return true;
+        }
+
+        //=========================================================================
+        // FindElementName
+        //=========================================================================
+        const char* ObjectStreamImpl::FindElementName(const ClassData* parentClassData, u32 nameCrc) const
+        {
+            // Only CRCs are stored, borrow the reflected name so converters and error messages have one.
+            if (parentClassData)
+            {
+                if (parentClassData->ContainerPtr)
+                {
+                    if (const ClassElement* classElement = parentClassData->ContainerPtr->GetElement(nameCrc))
+                    {
+                        return classElement->Name;
+                    }
+                }
+                for (const ClassElement& classElement : parentClassData->Elements)
+                {
+                    if (classElement.NameCrc == nameCrc)
+                    {
+                        return classElement.Name;
+                    }
+                }
+            }
+            return "";
+        }
+    } // namespace ObjectStreamInternal
+
+    //=========================================================================
+    // SaveObject
+    //=========================================================================
+    bool ObjectStream::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        ObjectStreamInternal::ObjectStreamImpl impl(&sc, errorHandler);
+        return impl.Save(stream, object, classId);
+    }
+
+    //=========================================================================
+    // LoadObject
+    //=========================================================================
+    void* ObjectStream::LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        void* object = nullptr;
+        ObjectStreamInternal::ObjectStreamImpl impl(&sc, errorHandler);
+        impl.Load(stream, classId, nullptr, &object);
+        return object;
+    }
+
+    //=========================================================================
+    // LoadObject
+    //=========================================================================
+    void* ObjectStream::LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, RootObjectArena& arena, ErrorHandler* errorHandler)
+    {
+        void* object = nullptr;
+        ObjectStreamInternal::ObjectStreamImpl impl(&sc, errorHandler);
+        impl.SetArena(&arena);
+        impl.Load(stream, classId, nullptr, &object);
+        return object;
+    }
+
+    //=========================================================================
+    // LoadObjectInPlace
+    //=========================================================================
+    bool ObjectStream::LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler)
+    {
+        V_Assert(object, "ObjectStream::LoadObjectInPlace - Attempt to load into a nullptr.");
+        if (!object)
+        {
+            return false;
+        }
+        ObjectStreamInternal::ObjectStreamImpl impl(&sc, errorHandler);
+        return impl.Load(stream, classId, object, nullptr);
+    }
+} // namespace V
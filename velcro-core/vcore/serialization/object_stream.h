@@ -0,0 +1,90 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_STREAM_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_STREAM_H
+
+#include <vcore/serialization/serialization_context.h>
+
+namespace V
+{
+    namespace IO
+    {
+        class GenericStream;
+    }
+
+    class RootObjectArena;
+
+    /**
+     * Compact binary stream for objects reflected in a SerializeContext.
+     *
+     * Saving walks the instance with SerializeContext::EnumerateInstanceConst and writes every element as
+     * a flags byte, the CRC32 of its name, a type reference, an optional version and the raw IDataSerializer
+     * output, followed by its children and a 0 terminator. Type ids are stored once and referenced by index
+     * afterwards. Containers of fundamental types with contiguous storage (vector, array, fixed_vector...)
+     * are written as a single memory block instead of one element per value.
+     *
+     * Loading streams the elements straight into the target object. Only elements whose class has a conversion
+     * step for the stored version (a version converter or DataPatchUpgrades starting at or after it) are materialized
+     * as a DataElementNode tree, so those can run on them before the data is applied. Version changes without one
+     * only added or removed fields and are streamed directly as well.
+     * All reads and writes go through a fixed size buffer on top of the supplied IO::GenericStream.
+     */
+    class ObjectStream
+    {
+    public:
+        using ErrorHandler = SerializeContext::ErrorHandler;
+
+        /// 'VOSB' in little endian.
+        static constexpr u32 Tag = 0x42534f56;
+        static constexpr u8 FormatVersion = 1;
+
+        /// Writes object to stream. Returns false if any error was reported or the stream could not be written.
+        template<class T>
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler = nullptr);
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Creates a new object from the stream. The stored type can be classId or any type derived from it.
+        /// Returns null if the stream is invalid or doesn't contain a compatible type.
+        template<class T>
+        static T* LoadObject(IO::GenericStream& stream, SerializeContext& sc, ErrorHandler* errorHandler = nullptr);
+        static void* LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Same as LoadObject, with the root object created in arena. It's destroyed when the arena is reset, objects it points to are still made by their factories.
+        template<class T>
+        static T* LoadObject(IO::GenericStream& stream, SerializeContext& sc, RootObjectArena& arena, ErrorHandler* errorHandler = nullptr);
+        static void* LoadObject(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, RootObjectArena& arena, ErrorHandler* errorHandler = nullptr);
+
+        /// Loads the stream into an existing object, the stored type must match classId.
+        template<class T>
+        static bool LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, T& object, ErrorHandler* errorHandler = nullptr);
+        static bool LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, const Uuid& classId, void* object, ErrorHandler* errorHandler = nullptr);
+    };
+
+    template<class T>
+    bool ObjectStream::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(object, SerializeTypeInfo<T>::GetRttiTypeId(object));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(object);
+        return SaveObject(stream, sc, classPtr, classId, errorHandler);
+    }
+
+    template<class T>
+    T* ObjectStream::LoadObject(IO::GenericStream& stream, SerializeContext& sc, ErrorHandler* errorHandler)
+    {
+        return reinterpret_cast<T*>(LoadObject(stream, sc, SerializeTypeInfo<T>::GetUuid(), errorHandler));
+    }
+
+    template<class T>
+    T* ObjectStream::LoadObject(IO::GenericStream& stream, SerializeContext& sc, RootObjectArena& arena, ErrorHandler* errorHandler)
+    {
+        return reinterpret_cast<T*>(LoadObject(stream, sc, SerializeTypeInfo<T>::GetUuid(), arena, errorHandler));
+    }
+
+    template<class T>
+    bool ObjectStream::LoadObjectInPlace(IO::GenericStream& stream, SerializeContext& sc, T& object, ErrorHandler* errorHandler)
+    {
+        void* classPtr = SerializeTypeInfo<T>::RttiCast(&object, SerializeTypeInfo<T>::GetRttiTypeId(&object));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(&object);
+        return LoadObjectInPlace(stream, sc, classId, classPtr, errorHandler);
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_OBJECT_STREAM_H
@@ -0,0 +1,371 @@
+#include <vcore/serialization/parallel_clone.h>
+#include <vcore/serialization/serialize_plan.h>
+#include <vcore/std/algorithm.h>
+#include <vcore/std/parallel/lock.h>
+
+namespace V
+{
+    //=========================================================================
+    // ParallelCloner
+    //=========================================================================
+    ParallelCloner::ParallelCloner(SerializeContext& sc)
+        : ParallelCloner(sc, Settings())
+    {
+    }
+
+    ParallelCloner::ParallelCloner(SerializeContext& sc, const Settings& settings)
+        : m_context(sc)
+        , m_settings(settings)
+    {
+        u32 threadCount = m_settings.ThreadCount;
+        if (threadCount == 0)
+        {
+            const unsigned hardwareThreads = VStd::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+        m_settings.MinRangeSize = VStd::max<size_t>(m_settings.MinRangeSize, 1);
+
+        m_scratchBuffers.resize(threadCount + 1);
+        m_workers.reserve(threadCount);
+        for (u32 threadIndex = 1; threadIndex <= threadCount; ++threadIndex)
+        {
+            VStd::thread_desc desc;
+            desc.m_name = "Parallel Clone Worker";
+            m_workers.emplace_back(desc, [this, threadIndex]()
+                {
+                    WorkerMain(threadIndex);
+                });
+        }
+    }
+
+    ParallelCloner::~ParallelCloner()
+    {
+        {
+            VStd::lock_guard<VStd::mutex> lock(m_jobMutex);
+            m_isQuitting = true;
+        }
+        m_jobCondition.notify_all();
+        for (VStd::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    //=========================================================================
+    // CloneObject
+    //=========================================================================
+    void* ParallelCloner::CloneObject(const void* ptr, const Uuid& classId)
+    {
+        V_Assert(ptr, "ParallelCloner::CloneObject - Attempt to clone a nullptr.");
+        if (!ptr)
+        {
+            return nullptr;
+        }
+
+        const SerializeContext::ClassData* classData = m_context.FindClassData(classId);
+        if (!classData || !classData->Factory)
+        {
+            return m_context.CloneObject(ptr, classId);
+        }
+
+        void* clonedObj = classData->Factory->Create(classData->Name);
+        CloneValue(clonedObj, ptr, classData, 0);
+        return clonedObj;
+    }
+
+    //=========================================================================
+    // CloneObjectInplace
+    //=========================================================================
+    void ParallelCloner::CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId)
+    {
+        V_Assert(ptr, "ParallelCloner::CloneObjectInplace - Attempt to clone a nullptr.");
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (const SerializeContext::ClassData* classData = m_context.FindClassData(classId))
+        {
+            CloneValue(dest, ptr, classData, 0);
+        }
+        else
+        {
+            m_context.CloneObjectInplace(dest, ptr, classId);
+        }
+    }
+
+    //=========================================================================
+    // CloneValue
+    //=========================================================================
+    bool ParallelCloner::CloneValue(void* dest, const void* source, const SerializeContext::ClassData* classData, u32 threadIndex)
+    {
+        // Only the caller thread splits containers, everything cloned inside a range stays on its thread.
+        const bool canSplit = threadIndex == 0 && !m_isRunningJob;
+
+        if (classData->ContainerPtr)
+        {
+            if (!canSplit || !CloneContainer(dest, source, classData))
+            {
+                m_context.CloneObjectInplace(dest, source, classData->TypeId);
+            }
+            return true;
+        }
+
+        const SerializePlan* plan = m_context.GetSerializePlan(classData->TypeId);
+        if (!plan)
+        {
+            m_context.CloneObjectInplace(dest, source, classData->TypeId);
+            return true;
+        }
+
+        // Same as SerializePlan::Clone, except that containers may be split.
+        for (const SerializePlan::Op& op : plan->GetOps())
+        {
+            if (canSplit && op.Type == SerializePlan::OpType::Generic && op.ClassDataPtr->ContainerPtr)
+            {
+                CloneValue(reinterpret_cast<char*>(dest) + op.Offset, reinterpret_cast<const char*>(source) + op.Offset, op.ClassDataPtr, threadIndex);
+            }
+            else
+            {
+                SerializePlan::CloneOp(m_context, op, dest, source, m_scratchBuffers[threadIndex]);
+            }
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // CloneContainer
+    //=========================================================================
+    bool ParallelCloner::CloneContainer(void* dest, const void* source, const SerializeContext::ClassData* classData)
+    {
+        SerializeContext::IDataContainer* container = classData->ContainerPtr;
+        if (m_workers.empty() || classData->EventHandlerPtr || container->IsSmartPointer() || !container->CanAccessElementsByIndex())
+        {
+            return false;
+        }
+
+        void* sourceContainer = const_cast<void*>(source);
+        const size_t count = container->Size(sourceContainer);
+        if (count < m_settings.MinContainerSize)
+        {
+            return false;
+        }
+
+        const SerializeContext::ClassElement* classElement = GetSingleElement(classData);
+        if (!classElement)
+        {
+            return false;
+        }
+        const SerializeContext::ClassData* elementClassData = classElement->GenericClassInfoPtr
+            ? classElement->GenericClassInfoPtr->GetClassData()
+            : m_context.FindClassData(classElement->TypeId, classData, classElement->NameCrc);
+        if (!elementClassData || elementClassData->IsDeprecated())
+        {
+            return false;
+        }
+
+        // Same as the enumeration path, the destination loses its old elements (and owned pointers) first.
+        // If the resize fails the caller falls back to the serial clone, which clears again.
+        container->ClearElements(dest, &m_context);
+        if (!container->ResizeElements(dest, count))
+        {
+            return false;
+        }
+
+        const bool isPointer = (classElement->Flags & SerializeContext::ClassElement::FLG_POINTER) != 0;
+        const size_t rawSize = isPointer ? 0 : SerializePlan::GetRawCopySize(elementClassData->TypeId);
+        if (rawSize)
+        {
+            // Contiguous storage of fundamental types is copied in large blocks.
+            char* destFirst = reinterpret_cast<char*>(container->GetElementByIndex(dest, classElement, 0));
+            const char* sourceFirst = reinterpret_cast<const char*>(container->GetElementByIndex(sourceContainer, classElement, 0));
+            const char* destLast = reinterpret_cast<const char*>(container->GetElementByIndex(dest, classElement, count - 1));
+            const char* sourceLast = reinterpret_cast<const char*>(container->GetElementByIndex(sourceContainer, classElement, count - 1));
+            const size_t span = (count - 1) * rawSize;
+            if (static_cast<size_t>(destLast - destFirst) == span && static_cast<size_t>(sourceLast - sourceFirst) == span)
+            {
+                ForEachRange(count, [destFirst, sourceFirst, rawSize](size_t begin, size_t end, u32)
+                    {
+                        memcpy(destFirst + begin * rawSize, sourceFirst + begin * rawSize, (end - begin) * rawSize);
+                    });
+                return true;
+            }
+        }
+
+        ForEachRange(count, [&](size_t begin, size_t end, u32 threadIndex)
+            {
+                for (size_t index = begin; index < end; ++index)
+                {
+                    void* destElement = container->GetElementByIndex(dest, classElement, index);
+                    const void* sourceElement = container->GetElementByIndex(sourceContainer, classElement, index);
+                    CloneElement(destElement, sourceElement, classElement, elementClassData, threadIndex);
+                }
+            });
+        return true;
+    }
+
+    //=========================================================================
+    // CloneElement
+    //=========================================================================
+    void ParallelCloner::CloneElement(void* dest, const void* source, const SerializeContext::ClassElement* classElement, const SerializeContext::ClassData* classData, u32 threadIndex)
+    {
+        if (classElement->Flags & SerializeContext::ClassElement::FLG_POINTER)
+        {
+            SerializePlan::Op op;
+            op.Type = SerializePlan::OpType::Pointer;
+            op.ElementSize = 0;
+            op.Offset = 0;
+            op.Size = sizeof(void*);
+            op.ClassDataPtr = classData;
+            op.ElementPtr = classElement;
+            SerializePlan::CloneOp(m_context, op, dest, source, m_scratchBuffers[threadIndex]);
+        }
+        else
+        {
+            CloneValue(dest, source, classData, threadIndex);
+        }
+    }
+
+    //=========================================================================
+    // GetSingleElement
+    //=========================================================================
+    const SerializeContext::ClassElement* ParallelCloner::GetSingleElement(const SerializeContext::ClassData* classData) const
+    {
+        // Containers with more than one element type (pairs, tuples, variants) are never split.
+        const SerializeContext::ClassElement* result = nullptr;
+        size_t numTypes = 0;
+        classData->ContainerPtr->EnumTypes([&result, &numTypes](const Uuid&, const SerializeContext::ClassElement* classElement)
+            {
+                result = classElement;
+                ++numTypes;
+                return true;
+            });
+        return numTypes == 1 ? result : nullptr;
+    }
+
+    //=========================================================================
+    // EnumerateElements
+    //=========================================================================
+    bool ParallelCloner::EnumerateElements(void* container, const SerializeContext::ClassData* classData, const VStd::function<void(void* element, size_t index)>& cb)
+    {
+        SerializeContext::IDataContainer* dataContainer = classData->ContainerPtr;
+        if (!dataContainer || dataContainer->IsSmartPointer() || !dataContainer->CanAccessElementsByIndex())
+        {
+            return false;
+        }
+        const SerializeContext::ClassElement* classElement = GetSingleElement(classData);
+        if (!classElement)
+        {
+            return false;
+        }
+
+        const size_t count = dataContainer->Size(container);
+        const RangeCB rangeCB = [&](size_t begin, size_t end, u32)
+        {
+            for (size_t index = begin; index < end; ++index)
+            {
+                cb(dataContainer->GetElementByIndex(container, classElement, index), index);
+            }
+        };
+        if (count < m_settings.MinContainerSize)
+        {
+            rangeCB(0, count, 0);
+        }
+        else
+        {
+            ForEachRange(count, rangeCB);
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // ForEachRange
+    //=========================================================================
+    void ParallelCloner::ForEachRange(size_t count, const RangeCB& cb)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        V_Assert(!m_isRunningJob, "ParallelCloner::ForEachRange can't be called from inside a range callback.");
+        const size_t numThreads = m_workers.size() + 1;
+        if (m_isRunningJob || numThreads == 1 || count <= m_settings.MinRangeSize)
+        {
+            cb(0, count, 0);
+            return;
+        }
+
+        // A few ranges per thread to even out elements that take longer than others.
+        const size_t rangeSize = VStd::max(m_settings.MinRangeSize, (count + numThreads * 4 - 1) / (numThreads * 4));
+        {
+            VStd::unique_lock<VStd::mutex> lock(m_jobMutex);
+            // workers that woke up late for the previous job may still be looking at its ranges
+            m_doneCondition.wait(lock, [this]() { return m_activeWorkers == 0; });
+            m_rangeCB = &cb;
+            m_count = count;
+            m_rangeSize = rangeSize;
+            m_rangeCount = (count + rangeSize - 1) / rangeSize;
+            m_nextRange.store(0, VStd::memory_order_relaxed);
+            m_completedRanges.store(0, VStd::memory_order_relaxed);
+            ++m_jobId;
+            m_isRunningJob = true;
+        }
+        m_jobCondition.notify_all();
+
+        RunRanges(0);
+
+        {
+            VStd::unique_lock<VStd::mutex> lock(m_jobMutex);
+            m_doneCondition.wait(lock, [this]()
+                {
+                    return m_completedRanges.load(VStd::memory_order_acquire) == m_rangeCount && m_activeWorkers == 0;
+                });
+            m_rangeCB = nullptr;
+            m_isRunningJob = false;
+        }
+    }
+
+    //=========================================================================
+    // RunRanges
+    //=========================================================================
+    void ParallelCloner::RunRanges(u32 threadIndex)
+    {
+        for (size_t range = m_nextRange.fetch_add(1, VStd::memory_order_relaxed); range < m_rangeCount; range = m_nextRange.fetch_add(1, VStd::memory_order_relaxed))
+        {
+            const size_t begin = range * m_rangeSize;
+            const size_t end = VStd::min(begin + m_rangeSize, m_count);
+            (*m_rangeCB)(begin, end, threadIndex);
+            m_completedRanges.fetch_add(1, VStd::memory_order_release);
+        }
+    }
+
+    //=========================================================================
+    // WorkerMain
+    //=========================================================================
+    void ParallelCloner::WorkerMain(u32 threadIndex)
+    {
+        u64 lastJobId = 0;
+        for (;;)
+        {
+            {
+                VStd::unique_lock<VStd::mutex> lock(m_jobMutex);
+                m_jobCondition.wait(lock, [this, lastJobId]() { return m_isQuitting || m_jobId != lastJobId; });
+                if (m_isQuitting)
+                {
+                    return;
+                }
+                lastJobId = m_jobId;
+                ++m_activeWorkers;
+            }
+
+            RunRanges(threadIndex);
+
+            {
+                VStd::lock_guard<VStd::mutex> lock(m_jobMutex);
+                --m_activeWorkers;
+            }
+            m_doneCondition.notify_all();
+        }
+    }
+} // namespace V
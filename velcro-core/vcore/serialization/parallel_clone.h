@@ -0,0 +1,116 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_PARALLEL_CLONE_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_PARALLEL_CLONE_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/functional.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/condition_variable.h>
+#include <vcore/std/parallel/mutex.h>
+#include <vcore/std/parallel/thread.h>
+
+namespace V
+{
+    /**
+     * Opt-in multi-threaded version of SerializeContext::CloneObject for objects holding very large containers.
+     *
+     * Containers that can be accessed by index and resized in one step (VStd::vector, VStd::fixed_vector) with at least
+     * MinContainerSize elements are split into ranges, which the calling thread and the workers clone concurrently.
+     * Each element keeps its index, so the result is identical to the serial clone. Everything else, including the
+     * elements inside a range, is cloned serially through the serialize plans and the enumeration path.
+     *
+     * Every thread has its own scratch buffer, so nothing is shared while cloning beyond the SerializeContext itself.
+     * Event handlers and factories of the element types get called from the workers and must be thread safe, as
+     * already required by IEventHandler. Reflection must not change while a clone is running.
+     *
+     * The workers live as long as the cloner, keep one around for repeated clones (snapshots, checkpoints).
+     * A cloner runs one clone at a time, it's not meant to be called from several threads at once.
+     */
+    class ParallelCloner
+    {
+    public:
+        V_CLASS_ALLOCATOR(ParallelCloner, SystemAllocator, 0);
+
+        struct Settings
+        {
+            u32 ThreadCount = 0;                ///< Number of worker threads, 0 uses one per hardware thread besides the caller.
+            size_t MinContainerSize = 16384;    ///< Smaller containers are cloned on the calling thread.
+            size_t MinRangeSize = 1024;         ///< Minimum number of elements handed to a thread at once.
+        };
+
+        /// Called for the elements [begin, end) of a range, threadIndex is 0 for the caller and 1..ThreadCount for the workers.
+        using RangeCB = VStd::function<void(size_t begin, size_t end, u32 threadIndex)>;
+
+        explicit ParallelCloner(SerializeContext& sc);
+        ParallelCloner(SerializeContext& sc, const Settings& settings);
+        ~ParallelCloner();
+
+        ParallelCloner(const ParallelCloner&) = delete;
+        ParallelCloner& operator=(const ParallelCloner&) = delete;
+
+        template<class T>
+        T* CloneObject(const T* obj);
+        void* CloneObject(const void* ptr, const Uuid& classId);
+
+        template<class T>
+        void CloneObjectInplace(T& dest, const T* obj);
+        void CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId);
+
+        /// Splits [0, count) into ranges and runs cb on them from all threads, returns when every range is done.
+        /// Must not be called from inside cb.
+        void ForEachRange(size_t count, const RangeCB& cb);
+
+        /// Calls cb for every element of a container that can be accessed by index, in parallel for large containers.
+        /// Returns false, without calling cb, if the container doesn't support access by index.
+        bool EnumerateElements(void* container, const SerializeContext::ClassData* classData, const VStd::function<void(void* element, size_t index)>& cb);
+
+        u32 GetThreadCount() const { return static_cast<u32>(m_workers.size()); }
+
+    private:
+        bool CloneValue(void* dest, const void* source, const SerializeContext::ClassData* classData, u32 threadIndex);
+        bool CloneContainer(void* dest, const void* source, const SerializeContext::ClassData* classData);
+        void CloneElement(void* dest, const void* source, const SerializeContext::ClassElement* classElement, const SerializeContext::ClassData* classData, u32 threadIndex);
+        const SerializeContext::ClassElement* GetSingleElement(const SerializeContext::ClassData* classData) const;
+
+        void WorkerMain(u32 threadIndex);
+        void RunRanges(u32 threadIndex);
+
+        SerializeContext& m_context;
+        Settings m_settings;
+        VStd::vector<VStd::thread> m_workers;
+        VStd::vector<VStd::vector<char>> m_scratchBuffers;  ///< One per thread, indexed by thread index.
+
+        VStd::mutex m_jobMutex;
+        VStd::condition_variable m_jobCondition;
+        VStd::condition_variable m_doneCondition;
+        const RangeCB* m_rangeCB = nullptr;
+        size_t m_count = 0;
+        size_t m_rangeSize = 0;
+        size_t m_rangeCount = 0;
+        u64 m_jobId = 0;
+        u32 m_activeWorkers = 0;
+        bool m_isQuitting = false;
+        bool m_isRunningJob = false;
+        VStd::atomic<size_t> m_nextRange{ 0 };
+        VStd::atomic<size_t> m_completedRanges{ 0 };
+    };
+
+    template<class T>
+    T* ParallelCloner::CloneObject(const T* obj)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
+        void* clonedObj = CloneObject(classPtr, classId);
+        return m_context.Cast<T*>(clonedObj, classId);
+    }
+
+    template<class T>
+    void ParallelCloner::CloneObjectInplace(T& dest, const T* obj)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
+        CloneObjectInplace(&dest, classPtr, classId);
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_PARALLEL_CLONE_H
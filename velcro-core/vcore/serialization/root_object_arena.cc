@@ -0,0 +1,185 @@
+#include <vcore/serialization/root_object_arena.h>
+#include <vcore/std/algorithm.h>
+
+namespace V
+{
+    namespace RootObjectArenaInternal
+    {
+        V_FORCE_INLINE char* AlignUp(char* address, size_t alignment)
+        {
+            return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(address) + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+        }
+    } // namespace RootObjectArenaInternal
+
+    //=========================================================================
+    // RootObjectArena
+    //=========================================================================
+    RootObjectArena::RootObjectArena(size_t blockSize)
+        : m_blockSize(VStd::max<size_t>(blockSize, 1024))
+    {
+    }
+
+    //=========================================================================
+    // ~RootObjectArena
+    //=========================================================================
+    RootObjectArena::~RootObjectArena()
+    {
+        Reset();
+        FreeBlocks(m_blocks);
+    }
+
+    //=========================================================================
+    // Allocate
+    //=========================================================================
+    void* RootObjectArena::Allocate(size_t byteSize, size_t alignment)
+    {
+        alignment = VStd::max<size_t>(alignment, 1);
+        V_Assert((alignment & (alignment - 1)) == 0, "RootObjectArena - alignment %zu is not a power of 2", alignment);
+        void* address = AllocateFromBlock(byteSize, alignment);
+        m_allocatedBytes += byteSize;
+        return address;
+    }
+
+    //=========================================================================
+    // AllocateFromBlock
+    //=========================================================================
+    void* RootObjectArena::AllocateFromBlock(size_t byteSize, size_t alignment)
+    {
+        char* address = m_current ? RootObjectArenaInternal::AlignUp(m_current, alignment) : nullptr;
+        if (!address || address + byteSize > m_end)
+        {
+            // oversized requests get a block of their own, the rest of the current one stays unused
+            const size_t blockSize = VStd::max(m_blockSize, BlockHeaderSize + byteSize + alignment);
+            Block* block = reinterpret_cast<Block*>(vmalloc(blockSize, BlockAlignment, V::SystemAllocator, "RootObjectArena"));
+            block->Next = m_blocks;
+            block->Size = blockSize;
+            m_blocks = block;
+            m_current = reinterpret_cast<char*>(block) + BlockHeaderSize;
+            m_end = reinterpret_cast<char*>(block) + blockSize;
+            address = RootObjectArenaInternal::AlignUp(m_current, alignment);
+        }
+        m_current = address + byteSize;
+        return address;
+    }
+
+    //=========================================================================
+    // CreateObject
+    //=========================================================================
+    void* RootObjectArena::CreateObject(const SerializeContext::ClassData& classData)
+    {
+        SerializeContext::IObjectFactory* factory = classData.Factory;
+        if (!factory)
+        {
+            return nullptr;
+        }
+
+        ObjectRecord* record = reinterpret_cast<ObjectRecord*>(AllocateFromBlock(sizeof(ObjectRecord), alignof(ObjectRecord)));
+        record->Factory = factory;
+        record->IsInPlace = factory->GetInstanceSize() != 0;
+        if (record->IsInPlace)
+        {
+            record->Object = factory->CreateAt(Allocate(factory->GetInstanceSize(), factory->GetInstanceAlignment()));
+        }
+        else
+        {
+            record->Object = factory->Create(classData.Name);
+        }
+
+        if (!record->Object)
+        {
+            // the record is reclaimed with the rest of the region
+            return nullptr;
+        }
+        record->Previous = m_lastObject;
+        m_lastObject = record;
+        ++m_numObjects;
+        return record->Object;
+    }
+
+    //=========================================================================
+    // DestroyObject
+    //=========================================================================
+    bool RootObjectArena::DestroyObject(void* object)
+    {
+        for (ObjectRecord* record = m_lastObject; record; record = record->Previous)
+        {
+            if (record->Object == object)
+            {
+                DestroyRecord(*record);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //=========================================================================
+    // OwnsObject
+    //=========================================================================
+    bool RootObjectArena::OwnsObject(const void* object) const
+    {
+        for (const ObjectRecord* record = m_lastObject; record; record = record->Previous)
+        {
+            if (record->Object == object)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //=========================================================================
+    // DestroyRecord
+    //=========================================================================
+    void RootObjectArena::DestroyRecord(ObjectRecord& record)
+    {
+        if (record.IsInPlace)
+        {
+            record.Factory->DestroyAt(record.Object);
+        }
+        else
+        {
+            record.Factory->Destroy(record.Object);
+        }
+        record.Object = nullptr;
+        --m_numObjects;
+    }
+
+    //=========================================================================
+    // Reset
+    //=========================================================================
+    void RootObjectArena::Reset()
+    {
+        // newest first, objects created later may refer to older ones
+        for (ObjectRecord* record = m_lastObject; record; record = record->Previous)
+        {
+            if (record->Object)
+            {
+                DestroyRecord(*record);
+            }
+        }
+        m_lastObject = nullptr;
+        m_allocatedBytes = 0;
+
+        if (m_blocks)
+        {
+            FreeBlocks(m_blocks->Next);
+            m_blocks->Next = nullptr;
+            m_current = reinterpret_cast<char*>(m_blocks) + BlockHeaderSize;
+            m_end = reinterpret_cast<char*>(m_blocks) + m_blocks->Size;
+        }
+    }
+
+    //=========================================================================
+    // FreeBlocks
+    //=========================================================================
+    void RootObjectArena::FreeBlocks(Block* block)
+    {
+        while (block)
+        {
+            Block* next = block->Next;
+            const size_t blockSize = block->Size;
+            vfree(block, V::SystemAllocator, blockSize, BlockAlignment);
+            block = next;
+        }
+    }
+} // namespace V
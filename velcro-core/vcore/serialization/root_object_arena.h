@@ -0,0 +1,92 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_ROOT_OBJECT_ARENA_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_ROOT_OBJECT_ARENA_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/std/containers/vector.h>
+
+namespace V
+{
+    /**
+     * Region for the root objects made by the serializer (the result of CloneObject and LoadObject, the data of a
+     * DynamicSerializableField) and for the scratch buffer those calls would otherwise allocate each time.
+     *
+     * Roots are constructed with IObjectFactory::CreateAt into blocks taken from the SystemAllocator, one bump pointer
+     * per block, and the bookkeeping lives in the same blocks. Reset runs the destructors of the live roots in reverse
+     * order and rewinds the region, so a batch of roots is released in one step and the blocks are reused by the next
+     * batch. Factories that can't construct in place fall back to Create/Destroy, the arena still owns those.
+     *
+     * Only the roots are in the region, the objects under them are not:
+     *  - Pointer members are made by their class factory and released by the destructor of their owner with delete,
+     *    so they have to come from the allocator delete returns them to. Reflected classes don't know whether their
+     *    pointees came from an arena.
+     *  - Container storage comes from the allocator type the container was declared with.
+     * A clone of a class whose members are all values (including nested classes) costs one region allocation, every
+     * pointer member and non empty container under it still allocates on its own.
+     * An arena is not thread safe, use one per thread.
+     */
+    class RootObjectArena
+    {
+    public:
+        V_CLASS_ALLOCATOR(RootObjectArena, SystemAllocator, 0);
+
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit RootObjectArena(size_t blockSize = DefaultBlockSize);
+        ~RootObjectArena();
+
+        RootObjectArena(const RootObjectArena&) = delete;
+        RootObjectArena& operator=(const RootObjectArena&) = delete;
+
+        /// Returns uninitialized memory that stays valid until Reset.
+        void* Allocate(size_t byteSize, size_t alignment);
+
+        /// Creates an instance of the class, owned by the arena. Returns null if the class has no factory.
+        void* CreateObject(const SerializeContext::ClassData& classData);
+        /// Destroys an object made by CreateObject before the arena is reset, its memory is reclaimed by Reset.
+        /// Returns false if the object doesn't belong to the arena.
+        bool DestroyObject(void* object);
+        bool OwnsObject(const void* object) const;
+
+        /// Destroys all live objects and rewinds the region, keeping the first block for the next use.
+        void Reset();
+
+        /// Buffer reused by the serializers for temporary data, instead of one per call.
+        VStd::vector<char>& GetScratchBuffer() { return m_scratchBuffer; }
+
+        size_t GetNumObjects() const { return m_numObjects; }
+        size_t GetAllocatedBytes() const { return m_allocatedBytes; }
+
+    private:
+        struct Block
+        {
+            Block* Next;
+            size_t Size;
+        };
+
+        static constexpr size_t BlockAlignment = 16;
+        static constexpr size_t BlockHeaderSize = (sizeof(Block) + BlockAlignment - 1) & ~(BlockAlignment - 1);
+
+        struct ObjectRecord
+        {
+            ObjectRecord* Previous;
+            void* Object;
+            SerializeContext::IObjectFactory* Factory;
+            bool IsInPlace;     ///< Constructed with CreateAt, otherwise made by Create and freed with Destroy.
+        };
+
+        void* AllocateFromBlock(size_t byteSize, size_t alignment);
+        void DestroyRecord(ObjectRecord& record);
+        void FreeBlocks(Block* block);
+
+        size_t m_blockSize;
+        Block* m_blocks = nullptr;          ///< Current block first.
+        char* m_current = nullptr;
+        char* m_end = nullptr;
+        ObjectRecord* m_lastObject = nullptr;
+        size_t m_numObjects = 0;
+        size_t m_allocatedBytes = 0;
+        VStd::vector<char> m_scratchBuffer;
+    };
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_ROOT_OBJECT_ARENA_H
@@ -1,5 +1,9 @@
 #include <vcore/serialization/serialization_context.h>
 #include <vcore/serialization/dynamic_serializable_field.h>
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/serialize_plan.h>
+#include <vcore/serialization/class_data_index.h>
+#include <vcore/serialization/root_object_arena.h>
 
 #include <vcore/std/containers/variant.h>
 #include <vcore/std/functional.h>
@@ -418,11 +422,12 @@ namespace V
 
             MathReflect(this);
 
-            Class<DataOverlayToken>()->
-                Field("Uri", &DataOverlayToken::DataUri);
-            Class<DataOverlayInfo>()->
-                Field("ProviderId", &DataOverlayInfo::ProviderId)->
-                Field("DataToken", &DataOverlayInfo::DataToken);
+            // DataOverlay 尚未移植
+            //Class<DataOverlayToken>()->
+            //    Field("Uri", &DataOverlayToken::DataUri);
+            //Class<DataOverlayInfo>()->
+            //    Field("ProviderId", &DataOverlayInfo::ProviderId)->
+            //    Field("DataToken", &DataOverlayInfo::DataToken);
 
             Class<DynamicSerializableField>()->
                 Field("TypeId", &DynamicSerializableField::TypeId);
@@ -432,15 +437,17 @@ namespace V
             Class<VStd::monostate>();
         }
 
-        if (createEditContext)
-        {
-            CreateEditContext();
-        }
+        // EditContext 尚未移植
+        V_UNUSED(createEditContext);
+        //if (createEditContext)
+        //{
+        //    CreateEditContext();
+        //}
 
-        if (registerIntegralTypes)
-        {
-            Internal::ReflectAny(this);
-        }
+        //if (registerIntegralTypes)
+        //{
+        //    Internal::ReflectAny(this);
+        //}
     }
 
      //=========================================================================
@@ -448,7 +455,6 @@ namespace V
     //=========================================================================
     SerializeContext::~SerializeContext()
     {
-        DestroyEditContext();
         decltype(m_perModuleSet) moduleSet = VStd::move(m_perModuleSet);
         for(PerModuleGenericClassInfo* module : moduleSet)
         {
@@ -461,40 +467,6 @@ namespace V
         GetCurrentSerializeContextModule().UnregisterSerializeContext(this);
     }
 
-    //=========================================================================
-    // CreateEditContext
-    //=========================================================================
-    EditContext* SerializeContext::CreateEditContext()
-    {
-        if (m_editContext == nullptr)
-        {
-            m_editContext = vnew EditContext(*this);
-        }
-
-        return m_editContext;
-    }
-
-    //=========================================================================
-    // DestroyEditContext
-    //=========================================================================
-    void SerializeContext::DestroyEditContext()
-    {
-        if (m_editContext)
-        {
-            delete m_editContext;
-            m_editContext = nullptr;
-        }
-    }
-
-    //=========================================================================
-    // GetEditContext
-    // [11/8/2012]
-    //=========================================================================
-    EditContext* SerializeContext::GetEditContext() const
-    {
-        return m_editContext;
-    }
-
     auto SerializeContext::RegisterType(const V::TypeId& typeId, V::SerializeContext::ClassData&& classData, CreateAnyFunc createAnyFunc) -> ClassBuilder
     {
         auto [typeToClassIter, inserted] = m_uuidMap.try_emplace(typeId, VStd::move(classData));
@@ -511,7 +483,7 @@ namespace V
             ClassData& classData = typeToClassIter->second;
             RemoveClassData(&classData);
 
-            auto [classNameRangeFirst, classNameRangeLast] = m_classNameToUuid.equal_range(Crc32(classData.m_name));
+            auto [classNameRangeFirst, classNameRangeLast] = m_classNameToUuid.equal_range(Crc32(classData.Name));
             while (classNameRangeFirst != classNameRangeLast)
             {
                 if (classNameRangeFirst->second == typeId)
@@ -536,6 +508,8 @@ namespace V
     //=========================================================================
     void SerializeContext::ClassDeprecate(const char* name, const V::Uuid& typeUuid, VersionConverter converter)
     {
+        InvalidateReflectionCaches();
+
         if (IsRemovingReflection())
         {
             m_uuidMap.erase(typeUuid);
@@ -574,76 +548,173 @@ namespace V
         return retVal;
     }
 
+    //=========================================================================
+    // FindClassDataInParent
+    //=========================================================================
+    static const SerializeContext::ClassData* FindClassDataInParent(const Uuid& classId, const SerializeContext::ClassData* parent, u32 elementNameCrc)
+    {
+        // this is not a registered type try to find it in the parent scope by name and check / type and flags
+        if (parent->ContainerPtr)
+        {
+            const SerializeContext::ClassElement* classElement = parent->ContainerPtr->GetElement(elementNameCrc);
+            if (classElement && classElement->GenericClassInfoPtr)
+            {
+                if (classElement->GenericClassInfoPtr->CanStoreType(classId))
+                {
+                    return classElement->GenericClassInfoPtr->GetClassData();
+                }
+            }
+        }
+        else if (elementNameCrc)
+        {
+            for (size_t i = 0; i < parent->Elements.size(); ++i)
+            {
+                const SerializeContext::ClassElement& classElement = parent->Elements[i];
+                if (classElement.NameCrc == elementNameCrc && classElement.GenericClassInfoPtr)
+                {
+                    if (classElement.GenericClassInfoPtr->CanStoreType(classId))
+                    {
+                        return classElement.GenericClassInfoPtr->GetClassData();
+                    }
+                    break;
+                }
+            }
+        }
+        return nullptr;
+    }
+
     //=========================================================================
     // FindClassData
     //=========================================================================
     const SerializeContext::ClassData*
     SerializeContext::FindClassData(const Uuid& classId, const SerializeContext::ClassData* parent, u32 elementNameCrc) const
     {
+        if (m_classDataIndex)
+        {
+            const ClassDataIndex::Entry* entry = m_classDataIndex->Find(classId);
+            if (entry && entry->ClassDataPtr)
+            {
+                return entry->ClassDataPtr;
+            }
+
+            const ClassData* cd = parent ? FindClassDataInParent(classId, parent, elementNameCrc) : nullptr;
+            return cd ? cd : (entry ? entry->FallbackPtr : nullptr);
+        }
+
         SerializeContext::IdToClassMap::const_iterator it = m_uuidMap.find(classId);
         const SerializeContext::ClassData* cd = it != m_uuidMap.end() ? &it->second : nullptr;
 
         if (!cd)
         {
-            // this is not a registered type try to find it in the parent scope by name and check / type and flags
             if (parent)
             {
-                if (parent->ContainerPtr)
-                {
-                    const SerializeContext::ClassElement* classElement = parent->ContainerPtr->GetElement(elementNameCrc);
-                    if (classElement && classElement->GenericClassInfoPtr)
-                    {
-                        if (classElement->GenericClassInfoPtr->CanStoreType(classId))
-                        {
-                            cd = classElement->GenericClassInfoPtr->GetClassData();
-                        }
-                    }
-                }
-                else if (elementNameCrc)
-                {
-                    for (size_t i = 0; i < parent->Elements.size(); ++i)
-                    {
-                        const SerializeContext::ClassElement& classElement = parent->Elements[i];
-                        if (classElement.NameCrc == elementNameCrc && classElement.GenericClassInfoPtr)
-                        {
-                            if (classElement.GenericClassInfoPtr->CanStoreType(classId))
-                            {
-                                cd = classElement.GenericClassInfoPtr->GetClassData();
-                            }
-                            break;
-                        }
-                    }
-                }
+                cd = FindClassDataInParent(classId, parent, elementNameCrc);
             }
 
-            /* If the ClassData could not be found in the normal UuidMap, then the GenericUuid map will be searched.
-             The GenericUuid map contains a mapping of Uuids to ClassData from which registered GenericClassInfo
-             when reflecting
-             */
             if (!cd)
             {
-                auto genericClassInfo = FindGenericClassInfo(classId);
-                if (genericClassInfo)
-                {
-                    cd = genericClassInfo->GetClassData();
-                }
+                cd = FindFallbackClassData(classId);
             }
+        }
 
-            // The supplied Uuid will be searched in the enum -> underlying type map to fallback to using the integral type for enum fields reflected to a class
-            // but not being explicitly reflected to the SerializeContext using the EnumBuilder
-            if (!cd)
+        return cd;
+    }
+
+    //=========================================================================
+    // FindFallbackClassData
+    //=========================================================================
+    const SerializeContext::ClassData* SerializeContext::FindFallbackClassData(const Uuid& classId) const
+    {
+        /* If the ClassData could not be found in the normal UuidMap, then the GenericUuid map will be searched.
+         The GenericUuid map contains a mapping of Uuids to ClassData from which registered GenericClassInfo
+         when reflecting
+         */
+        if (GenericClassInfo* genericClassInfo = FindGenericClassInfo(classId))
+        {
+            if (const ClassData* cd = genericClassInfo->GetClassData())
             {
-                auto enumToUnderlyingTypeIdIter = m_enumTypeIdToUnderlyingTypeIdMap.find(classId);
-                if (enumToUnderlyingTypeIdIter != m_enumTypeIdToUnderlyingTypeIdMap.end())
-                {
-                    const V::TypeId& underlyingTypeId = enumToUnderlyingTypeIdIter->second;
-                    auto underlyingTypeIter = m_uuidMap.find(underlyingTypeId);
-                    cd = underlyingTypeIter != m_uuidMap.end() ? &underlyingTypeIter->second : nullptr;
-                }
+                return cd;
             }
         }
 
-        return cd;
+        // The supplied Uuid will be searched in the enum -> underlying type map to fallback to using the integral type for enum fields reflected to a class
+        // but not being explicitly reflected to the SerializeContext using the EnumBuilder
+        auto enumToUnderlyingTypeIdIter = m_enumTypeIdToUnderlyingTypeIdMap.find(classId);
+        if (enumToUnderlyingTypeIdIter != m_enumTypeIdToUnderlyingTypeIdMap.end())
+        {
+            const V::TypeId& underlyingTypeId = enumToUnderlyingTypeIdIter->second;
+            auto underlyingTypeIter = m_uuidMap.find(underlyingTypeId);
+            return underlyingTypeIter != m_uuidMap.end() ? &underlyingTypeIter->second : nullptr;
+        }
+
+        return nullptr;
+    }
+
+    //=========================================================================
+    // FreezeClassIndex
+    //=========================================================================
+    void SerializeContext::FreezeClassIndex()
+    {
+        VStd::vector<ClassDataIndex::Entry> entries;
+        entries.reserve(m_uuidMap.size() + m_uuidGenericMap.size() + m_legacySpecializeTypeIdToTypeIdMap.size() + m_enumTypeIdToUnderlyingTypeIdMap.size());
+        VStd::unordered_set<Uuid> indexedIds;
+        auto addEntry = [this, &entries, &indexedIds](const Uuid& classId)
+        {
+            if (indexedIds.insert(classId).second)
+            {
+                auto classIt = m_uuidMap.find(classId);
+                const ClassData* cd = classIt != m_uuidMap.end() ? &classIt->second : nullptr;
+                entries.push_back({ classId, cd, FindFallbackClassData(classId) });
+            }
+        };
+
+        // every id FindClassData can resolve without a parent scope
+        for (const auto& uuidToClassPair : m_uuidMap)
+        {
+            addEntry(uuidToClassPair.first);
+        }
+        for (const auto& uuidToGenericPair : m_uuidGenericMap)
+        {
+            addEntry(uuidToGenericPair.first);
+        }
+        for (const auto& legacyToTypeIdPair : m_legacySpecializeTypeIdToTypeIdMap)
+        {
+            addEntry(legacyToTypeIdPair.first);
+        }
+        for (const auto& enumToUnderlyingPair : m_enumTypeIdToUnderlyingTypeIdMap)
+        {
+            addEntry(enumToUnderlyingPair.first);
+        }
+
+        m_classDataIndex = VStd::make_unique<ClassDataIndex>(VStd::move(entries));
+
+        ForEachReflectedClassData([](ClassData& classData)
+        {
+            classData.FrozenAttributes.Build(classData.Attributes);
+            for (ClassElement& element : classData.Elements)
+            {
+                element.FrozenAttributes.Build(element.Attributes);
+            }
+        });
+    }
+
+    //=========================================================================
+    // ForEachReflectedClassData
+    //=========================================================================
+    template<class Function>
+    void SerializeContext::ForEachReflectedClassData(Function function)
+    {
+        for (auto& uuidToClassPair : m_uuidMap)
+        {
+            function(uuidToClassPair.second);
+        }
+        for (auto& uuidToGenericPair : m_uuidGenericMap)
+        {
+            if (ClassData* genericClassData = uuidToGenericPair.second->GetClassData())
+            {
+                function(*genericClassData);
+            }
+        }
     }
 
      //=========================================================================
@@ -701,6 +772,7 @@ namespace V
 
             if (scGenericInfoFoundIt == scGenericClassInfoRange.second)
             {
+                InvalidateReflectionCaches();
                 m_uuidGenericMap.emplace(classId, genericClassInfo);
                 m_uuidAnyCreationMap.emplace(classId, createAnyFunc);
                 m_classNameToUuid.emplace(genericClassInfo->GetClassData()->Name, classId);
@@ -1591,6 +1663,8 @@ namespace V
     // ClassBuilder::~ClassBuilder
     //=========================================================================
     SerializeContext::ClassBuilder::~ClassBuilder() {
+        // fields, base classes and versions may have changed while the builder was alive
+        m_context->InvalidateReflectionCaches();
 #if defined(V_ENABLE_TRACING)
         if (!m_context->IsRemovingReflection()) {
             if (m_classData->second.SerializerPtr) {
@@ -1950,6 +2024,7 @@ namespace V
 
         void*               Ptr;
         ObjectParentStack   ParentStack;
+        RootObjectArena*    Arena = nullptr;    ///< Creates the root object when set.
     };
 
     //=========================================================================
@@ -1958,8 +2033,24 @@ namespace V
     void* SerializeContext::CloneObject(const void* ptr, const Uuid& classId)
     {
         VStd::vector<char> scratchBuffer;
+        return CloneObjectInternal(ptr, classId, nullptr, scratchBuffer);
+    }
 
+    //=========================================================================
+    // CloneObject
+    //=========================================================================
+    void* SerializeContext::CloneObject(const void* ptr, const Uuid& classId, RootObjectArena& arena)
+    {
+        return CloneObjectInternal(ptr, classId, &arena, arena.GetScratchBuffer());
+    }
+
+    //=========================================================================
+    // CloneObjectInternal
+    //=========================================================================
+    void* SerializeContext::CloneObjectInternal(const void* ptr, const Uuid& classId, RootObjectArena* arena, VStd::vector<char>& scratchBuffer)
+    {
         ObjectCloneData cloneData;
+        cloneData.Arena = arena;
         ErrorHandler m_errorLogger;
 
         V_Assert(ptr, "SerializeContext::CloneObject - Attempt to clone a nullptr.");
@@ -1969,6 +2060,15 @@ namespace V
             return nullptr;
         }
 
+        if (const SerializePlan* plan = GetSerializePlan(classId))
+        {
+            const ClassData* classData = plan->GetClassData();
+            V_Assert(classData->Factory != nullptr, "We are attempting to create '%s', but no factory is provided!", classData->Name);
+            void* clonedObj = arena ? arena->CreateObject(*classData) : classData->Factory->Create(classData->Name);
+            plan->Clone(*this, clonedObj, ptr, scratchBuffer);
+            return clonedObj;
+        }
+
         EnumerateInstanceCallContext callContext(
             VStd::bind(&SerializeContext::BeginCloneElement, this, VStd::placeholders::_1, VStd::placeholders::_2, VStd::placeholders::_3, &cloneData, &m_errorLogger, &scratchBuffer),
             VStd::bind(&SerializeContext::EndCloneElement, this, &cloneData),
@@ -1993,30 +2093,119 @@ namespace V
     void SerializeContext::CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId)
     {
         VStd::vector<char> scratchBuffer;
+        CloneObjectInplaceInternal(dest, ptr, classId, scratchBuffer);
+    }
 
+    //=========================================================================
+    // CloneObjectInplace
+    //=========================================================================
+    void SerializeContext::CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId, RootObjectArena& arena)
+    {
+        CloneObjectInplaceInternal(dest, ptr, classId, arena.GetScratchBuffer());
+    }
+
+    //=========================================================================
+    // CloneObjectInplaceInternal
+    //=========================================================================
+    void SerializeContext::CloneObjectInplaceInternal(void* dest, const void* ptr, const Uuid& classId, VStd::vector<char>& scratchBuffer)
+    {
         ObjectCloneData cloneData;
         cloneData.Ptr = dest;
         ErrorHandler errorLogger;
 
         V_Assert(ptr, "SerializeContext::CloneObjectInplace - Attempt to clone a nullptr.");
 
-        if (ptr)
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (const SerializePlan* plan = GetSerializePlan(classId))
         {
-            EnumerateInstanceCallContext callContext(
+            plan->Clone(*this, dest, ptr, scratchBuffer);
+            return;
+        }
+
+        EnumerateInstanceCallContext callContext(
             VStd::bind(&SerializeContext::BeginCloneElementInplace, this, dest, VStd::placeholders::_1, VStd::placeholders::_2, VStd::placeholders::_3, &cloneData, &errorLogger, &scratchBuffer),
-                VStd::bind(&SerializeContext::EndCloneElement, this, &cloneData),
-                this,
-                SerializeContext::ENUM_ACCESS_FOR_READ,
-                &errorLogger);
-
-            EnumerateInstance(
-                &callContext
-                , const_cast<void*>(ptr)
-                , classId
-                , nullptr
-                , nullptr
-            );
+            VStd::bind(&SerializeContext::EndCloneElement, this, &cloneData),
+            this,
+            SerializeContext::ENUM_ACCESS_FOR_READ,
+            &errorLogger);
+
+        EnumerateInstance(
+            &callContext
+            , const_cast<void*>(ptr)
+            , classId
+            , nullptr
+            , nullptr
+        );
+    }
+
+    //=========================================================================
+    // GetSerializePlan
+    //=========================================================================
+    const SerializePlan* SerializeContext::GetSerializePlan(const Uuid& classId) const
+    {
+        {
+            VStd::shared_lock<VStd::shared_mutex> lock(m_serializePlanMutex);
+            auto planIt = m_serializePlans.find(classId);
+            if (planIt != m_serializePlans.end())
+            {
+                return planIt->second.get();
+            }
         }
+
+        VStd::unique_lock<VStd::shared_mutex> lock(m_serializePlanMutex);
+        auto insertResult = m_serializePlans.insert_key(classId);
+        if (insertResult.second)
+        {
+            // types that can't be planned are stored as null so they are only compiled once
+            if (const ClassData* classData = FindClassData(classId))
+            {
+                insertResult.first->second = SerializePlan::Compile(*this, classData);
+            }
+        }
+        return insertResult.first->second.get();
+    }
+
+    //=========================================================================
+    // CompareObjects
+    //=========================================================================
+    bool SerializeContext::CompareObjects(const void* lhs, const void* rhs, const Uuid& classId) const
+    {
+        if (!lhs || !rhs)
+        {
+            return lhs == rhs;
+        }
+        if (const SerializePlan* plan = GetSerializePlan(classId))
+        {
+            return plan->Compare(*this, lhs, rhs);
+        }
+        return SerializePlan::CompareSerialized(*this, lhs, rhs, classId);
+    }
+
+    //=========================================================================
+    // InvalidateReflectionCaches
+    //=========================================================================
+    void SerializeContext::InvalidateReflectionCaches()
+    {
+        // attributes are only frozen together with the index, skip the walk while reflection is still going on
+        if (m_classDataIndex)
+        {
+            m_classDataIndex.reset();
+            ForEachReflectedClassData([](ClassData& classData)
+            {
+                classData.FrozenAttributes.Clear();
+                for (ClassElement& element : classData.Elements)
+                {
+                    element.FrozenAttributes.Clear();
+                }
+            });
+        }
+
+        VStd::unique_lock<VStd::shared_mutex> lock(m_serializePlanMutex);
+        m_serializePlans.clear();
     }
 
     V::SerializeContext::DataPatchUpgrade::DataPatchUpgrade(VStd::string_view fieldName, unsigned int fromVersion, unsigned int toVersion)
@@ -2186,7 +2375,7 @@ namespace V
         {
             // Since this is the root element, we will need to allocate it using the creator provided
             V_Assert(classData->Factory != nullptr, "We are attempting to create '%s', but no factory is provided! Either provide factory or change data member '%s' to value not pointer!", classData->Name, elementData->Name);
-            cloneData->Ptr = classData->Factory->Create(classData->Name);
+            cloneData->Ptr = cloneData->Arena ? cloneData->Arena->CreateObject(*classData) : classData->Factory->Create(classData->Name);
         }
 
         return BeginCloneElementInplace(cloneData->Ptr, ptr, classData, elementData, data, errorHandler, scratchBuffer);
@@ -2298,21 +2487,13 @@ namespace V
 
         if (classData->SerializerPtr)
         {
-            if (classData->TypeId == GetAssetClassId())
-            {
-                // Optimized clone path for asset references.
-                static_cast<AssetSerializer*>(classData->SerializerPtr.get())->Clone(srcPtr, destPtr);
-            }
-            else
-            {
-                scratchBuffer->clear();
-                IO::ByteContainerStream<VStd::vector<char>> stream(scratchBuffer);
+            scratchBuffer->clear();
+            IO::ByteContainerStream<VStd::vector<char>> stream(scratchBuffer);
 
-                classData->SerializerPtr->Save(srcPtr, stream);
-                stream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+            classData->SerializerPtr->Save(srcPtr, stream);
+            stream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
 
-                classData->SerializerPtr->Load(destPtr, stream, classData->Version);
-            }
+            classData->SerializerPtr->Load(destPtr, stream, classData->Version);
         }
 
         // If it is a container, clear it before loading the child
@@ -2531,6 +2712,7 @@ namespace V
     void SerializeContext::ClassData::ClearAttributes()
     {
         Attributes.clear();
+        FrozenAttributes.Clear();
 
         for (ClassElement& classElement : Elements)
         {
@@ -2573,6 +2755,10 @@ namespace V
 
     Attribute* SerializeContext::ClassData::FindAttribute(AttributeId attributeId) const
     {
+        if (FrozenAttributes.IsBuilt())
+        {
+            return FrozenAttributes.Find(attributeId);
+        }
         for (const V::AttributeSharedPair& attributePair : Attributes)
         {
             if (attributePair.first == attributeId)
@@ -2698,10 +2884,14 @@ namespace V
     //=========================================================================
     void SerializeContext::RemoveClassData(ClassData* classData)
     {
-        if (m_editContext)
-        {
-            m_editContext->RemoveClassData(classData);
-        }
+        InvalidateReflectionCaches();
+        V_UNUSED(classData);
+
+        // EditContext 尚未移植
+        //if (m_editContext)
+        //{
+        //    m_editContext->RemoveClassData(classData);
+        //}
     }
 
     void SerializeContext::RemoveGenericClassInfo(GenericClassInfo* genericClassInfo)
@@ -2887,6 +3077,7 @@ namespace V
     void SerializeContext::ClassElement::ClearAttributes()
     {
         Attributes.clear();
+        FrozenAttributes.Clear();
     }
 
     //=========================================================================
@@ -2895,6 +3086,10 @@ namespace V
 
     Attribute* SerializeContext::ClassElement::FindAttribute(AttributeId attributeId) const
     {
+        if (FrozenAttributes.IsBuilt())
+        {
+            return FrozenAttributes.Find(attributeId);
+        }
         for (const AttributeSharedPair& attributePair : Attributes)
         {
             if (attributePair.first == attributeId)
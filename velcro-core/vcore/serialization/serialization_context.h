@@ -22,10 +22,13 @@
 #include <vcore/std/typetraits/is_base_of.h>
 #include <vcore/std/any.h>
 #include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/shared_mutex.h>
 
 #include <vcore/std/functional.h>
+#include <vcore/std/smart_ptr/unique_ptr.h>
 
 #include <vcore/vobject/reflect_context.h>
+#include <vcore/vobject/attribute_lookup.h>
 
 #include <vcore/math/crc.h>
 #include <vcore/io/byte_container_stream.h>
@@ -37,6 +40,9 @@
 namespace V {
     class EditContext;
     class ObjectStream;
+    class SerializePlan;
+    class ClassDataIndex;
+    class RootObjectArena;
     class GenericClassInfo;
     struct DataPatchNodeInfo;
 
@@ -241,6 +247,23 @@ namespace V {
         void CloneObjectInplace(T& dest, const T* obj);
         void CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId);
 
+        /// 同上, 但副本的根对象在 arena 中创建(见 RootObjectArena), arena 重置时销毁. 临时数据使用 arena 的缓冲区而不是每次调用分配一个.
+        /// 只有根对象在 arena 中: 副本的指针成员仍由各自的工厂创建并由其所有者 delete, 容器的存储仍使用容器自己的分配器.
+        template<class T>
+        T* CloneObject(const T* obj, RootObjectArena& arena);
+        void* CloneObject(const void* ptr, const Uuid& classId, RootObjectArena& arena);
+
+        template<class T>
+        void CloneObjectInplace(T& dest, const T* obj, RootObjectArena& arena);
+        void CloneObjectInplace(void* dest, const void* ptr, const Uuid& classId, RootObjectArena& arena);
+
+        /// 返回 classId 的预编译计划(首次使用时编译), 用于克隆和比较.
+        /// 容器, 带事件处理程序的类等始终走枚举路径的类型返回 nullptr. 反射发生变化时计划失效.
+        const SerializePlan* GetSerializePlan(const Uuid& classId) const;
+
+        /// 逐成员比较 classId 的两个实例, 没有计划的成员按其序列化数据进行比较.
+        bool CompareObjects(const void* lhs, const void* rhs, const Uuid& classId) const;
+
 
         // 此处前面列出的类型将具有更高的优先级
         enum DataPatchUpgradeType
@@ -501,6 +524,7 @@ namespace V {
             };
             AttributeOwnership AttrOwnership = AttributeOwnership::Parent;
             int                Flags;
+            AttributeLookup    FrozenAttributes;    ///< Sorted copy of Attributes, built by SerializeContext::FreezeClassIndex.
         };
         typedef VStd::vector<ClassElement> ClassElementArray;
 
@@ -560,6 +584,8 @@ namespace V {
             /// 而 V::AllocatorInstance<V::SystemAllocator>::Get 返回一个 V::SystemAllocator&, 虽然它继承自 IAllocatorAllocate, 
             /// 但它不像函数指针那样工作不支持协变返回类型.
             VStd::vector<AttributeSharedPair, VStdFunctorAllocator> Attributes{VStdFunctorAllocator(&GetSystemAllocator) };
+            /// Sorted copy of Attributes used by FindAttribute, built by SerializeContext::FreezeClassIndex.
+            AttributeLookup FrozenAttributes;
 
         private:
             static IAllocatorAllocate& GetSystemAllocator()
@@ -584,6 +610,16 @@ namespace V {
             {
                 Destroy(const_cast<void*>(ptr));
             }
+
+            /// Size and alignment of an instance, 0 if the factory can't construct into memory provided by the caller.
+            virtual size_t GetInstanceSize() const { return 0; }
+            virtual size_t GetInstanceAlignment() const { return 0; }
+
+            /// Constructs an instance at address, which has room for GetInstanceSize bytes. Used by RootObjectArena.
+            virtual void* CreateAt(void* address) { (void)address; return nullptr; }
+
+            /// Runs the destructor of an instance made by CreateAt, the memory belongs to the caller.
+            virtual void  DestroyAt(void* ptr) { (void)ptr; }
         };
 
         /// @brief 数据序列化接口. 应针对最低级别的数据实施. 
@@ -721,6 +757,9 @@ namespace V {
             virtual void*   GetElementByIndex(void* instance, const ClassElement* classElement, size_t index) = 0;
             /// Store the element that was reserved before (called post loading)
             virtual void    StoreElement(void* instance, void* element) = 0;
+            /// Resize a container that can be accessed by index to count default constructed elements, which are stored already.
+            /// Lets elements be filled by index in any order. Returns false if the container doesn't support it.
+            virtual bool    ResizeElements(void* instance, size_t count) { (void)instance; (void)count; return false; }
             /// Remove element in the container. Returns true if the element was removed, otherwise false. If deletePointerDataContext is NOT null, this indicated that you want the remove function to delete/destroy any Elements that are pointer!
             virtual bool    RemoveElement(void* instance, const void* element, SerializeContext* deletePointerDataContext) = 0;
             /**
@@ -942,6 +981,11 @@ namespace V {
           /// Find a class data (stored information) based on a class ID and possible parent class data.
         const ClassData* FindClassData(const Uuid& classId, const SerializeContext::ClassData* parent = nullptr, u32 elementNameCrc = 0) const;
 
+        /// Builds a read only index of all reflected types, used by FindClassData from then on, and freezes the attributes
+        /// of classes and their elements for FindAttribute. Call it once reflection is complete, any later reflection change
+        /// drops both and lookups go through the maps and arrays until it's frozen again.
+        void FreezeClassIndex();
+
         /// Find a class data (stored information) based on a class name
         VStd::vector<V::Uuid> FindClassId(const V::Crc32& classNameCrc) const;
 
@@ -988,6 +1032,13 @@ namespace V {
 
         /// Remove class data
         void RemoveClassData(ClassData* classData);
+        /// Drops the compiled serialize plans, the frozen class index and frozen attributes, called whenever reflection changes.
+        void InvalidateReflectionCaches();
+        /// Calls function with the ClassData of every reflected class and generic class info.
+        template<class Function>
+        void ForEachReflectedClassData(Function function);
+        /// FindClassData for ids that are not reflected classes: generic class infos and enum fields.
+        const ClassData* FindFallbackClassData(const Uuid& classId) const;
         /// Removes the GenericClassInfo from the GenericClassInfoMap
         void RemoveGenericClassInfo(GenericClassInfo* genericClassInfo);
 
@@ -998,6 +1049,8 @@ namespace V {
         void AddClassData(ClassData* classData);
 
         /// Object cloning callbacks.
+        void* CloneObjectInternal(const void* ptr, const Uuid& classId, RootObjectArena* arena, VStd::vector<char>& scratchBuffer);
+        void CloneObjectInplaceInternal(void* dest, const void* ptr, const Uuid& classId, VStd::vector<char>& scratchBuffer);
         bool BeginCloneElement(void* ptr, const ClassData* classData, const ClassElement* elementData, void* stackData, ErrorHandler* errorHandler, VStd::vector<char>* scratchBuffer);
         bool BeginCloneElementInplace(void* rootDestPtr, void* ptr, const ClassData* classData, const ClassElement* elementData, void* stackData, ErrorHandler* errorHandler, VStd::vector<char>* scratchBuffer);
         bool EndCloneElement(void* stackData);
@@ -1061,7 +1114,7 @@ namespace V {
             template<typename SerializerImplementation>
             ClassBuilder* Serializer()
             {
-                return Serializer(&Serialize::StaticInstance<SerializerImplementation>::s_instance);
+                return Serializer(&Serialize::StaticInstance<SerializerImplementation>::_instance);
             }
 
             /// @brief 对于空的类类型, 我们希望序列化器在加载时创建, 但没有子元素.
@@ -1076,7 +1129,7 @@ namespace V {
             template<typename EventHandlerImplementation>
             ClassBuilder* EventHandler()
             {
-                return EventHandler(&Serialize::StaticInstance<EventHandlerImplementation>::s_instance);
+                return EventHandler(&Serialize::StaticInstance<EventHandlerImplementation>::_instance);
             }
 
             /// 添加 DataContainer 结构，用于以自定义方式操作包含的数据
@@ -1087,7 +1140,7 @@ namespace V {
             template<typename DataContainerType>
             ClassBuilder* DataContainer()
             {
-                return DataContainer(&Serialize::StaticInstance<DataContainerType>::s_instance);
+                return DataContainer(&Serialize::StaticInstance<DataContainerType>::_instance);
             }
 
             /// @brief 设置类持久 ID 函数 getter. 当我们将类存储在容器中时使用, 因此我们可以识别元素以覆盖
@@ -1200,6 +1253,10 @@ namespace V {
         VStd::unordered_map<TypeId, TypeId> m_enumTypeIdToUnderlyingTypeIdMap;    ///< Uuid 用于跟踪枚举类型对应的底层类型 id，该枚举类型反映为 SerializeContext 中的字段
         VStd::vector<VStd::unique_ptr<IDataContainer>> m_dataContainers;          ///< 照顾所有相关 IDataContainer 的生命周期
 
+        mutable VStd::shared_mutex m_serializePlanMutex;                                      ///< 保护 m_serializePlans
+        mutable VStd::unordered_map<Uuid, VStd::unique_ptr<SerializePlan>> m_serializePlans;  ///< 已编译的计划, 无法编译的类型存 nullptr. 反射变化时清空
+        VStd::unique_ptr<ClassDataIndex> m_classDataIndex;                                    ///< FreezeClassIndex 构建的只读索引, 反射变化时清空
+
         class PerModuleGenericClassInfo;
         VStd::unordered_set<PerModuleGenericClassInfo*>  m_perModuleSet; ///< Stores the static PerModuleGenericClass structures keeps track of reflected GenericClassInfo per module
 
@@ -1314,7 +1371,7 @@ namespace V {
                 {
                 case VStd::any::Action::Reserve:
                 {
-                    if (dest->get_type_info().m_useHeap)
+                    if (dest->get_type_info().UseHeap)
                     {
                         // Allocate space for object on heap
                         // This takes advantage of the fact that the pointer for an any is stored at offset 0
@@ -1356,7 +1413,7 @@ namespace V {
                 case VStd::any::Action::Destroy:
                 {
                     // Clear memory
-                    if (dest->get_type_info().m_useHeap)
+                    if (dest->get_type_info().UseHeap)
                     {
                         DeAllocate<ValueType>(VStd::any_cast<void>(dest));
                     }
@@ -1369,10 +1426,10 @@ namespace V {
         static VStd::any CreateAny(SerializeContext* serializeContext)
         {
             VStd::any::type_info typeinfo;
-            typeinfo.m_id = vobject_rtti_typeid<ValueType>();
-            typeinfo.m_handler = NonCopyableAnyHandler(serializeContext);
-            typeinfo.m_isPointer = VStd::is_pointer<ValueType>::value;
-            typeinfo.m_useHeap = VStd::GetMax(sizeof(ValueType), VStd::alignment_of<ValueType>::value) > VStd::Internal::ANY_SBO_BUF_SIZE;
+            typeinfo.ID = vobject_rtti_typeid<ValueType>();
+            typeinfo.Handler = NonCopyableAnyHandler(serializeContext);
+            typeinfo.IsPointer = VStd::is_pointer<ValueType>::value;
+            typeinfo.UseHeap = VStd::GetMax(sizeof(ValueType), VStd::alignment_of<ValueType>::value) > VStd::Internal::ANY_SBO_BUF_SIZE;
             if constexpr (VStd::is_default_constructible_v<ValueType>)
             {
                 return serializeContext ? VStd::any(typeinfo, VStd::in_place_type_t<ValueType>{}) : VStd::any();
@@ -1463,7 +1520,7 @@ namespace V {
 
         static void RttiEnumHierarchy(RTTI_EnumCallback callback, void* userData, const VStd::true_type& /*HasVObjectRtti<ValueType>*/)
         {
-            return V::RttiEnumHierarchy<ValueType>(callback, userData);
+            return V::rtti_enum_hierarchy<ValueType>(callback, userData);
         }
         static void RttiEnumHierarchy(RTTI_EnumCallback /*callback*/, void* /*userData*/, const VStd::false_type& /*!HasVObjectRtti<ValueType>*/)
         {
@@ -1534,6 +1591,22 @@ namespace V {
             {
                 delete reinterpret_cast<T*>(ptr);
             }
+            size_t GetInstanceSize() const override
+            {
+                return sizeof(T);
+            }
+            size_t GetInstanceAlignment() const override
+            {
+                return VStd::alignment_of<T>::value;
+            }
+            void* CreateAt(void* address) override
+            {
+                return new(address) T;
+            }
+            void DestroyAt(void* ptr) override
+            {
+                reinterpret_cast<T*>(ptr)->~T();
+            }
         };
 
         /// Default instance for classes without AZ_CLASS_ALLOCATOR (can't use aznew) defined.
@@ -1550,6 +1623,22 @@ namespace V {
                 reinterpret_cast<T*>(ptr)->~T();
                 vfree(ptr,V::SystemAllocator, sizeof(T), VStd::alignment_of<T>::value);
             }
+            size_t GetInstanceSize() const override
+            {
+                return sizeof(T);
+            }
+            size_t GetInstanceAlignment() const override
+            {
+                return VStd::alignment_of<T>::value;
+            }
+            void* CreateAt(void* address) override
+            {
+                return new(address) T;
+            }
+            void DestroyAt(void* ptr) override
+            {
+                reinterpret_cast<T*>(ptr)->~T();
+            }
         };
 
         /// Default instance for abstract classes. We can't instantiate abstract classes, but we have this function for assert!
@@ -1578,7 +1667,7 @@ namespace V {
         template<class T, class C>
         struct ElementInfo<T C::*>
         {
-            typedef typename VStd::RemoveEnum<T>::type ElementType;
+            typedef typename VStd::remove_enum<T>::type ElementType;
             typedef C ClassType;
             typedef T Type;
             typedef typename VStd::remove_pointer<ElementType>::type ValueType;
@@ -1612,7 +1701,8 @@ namespace V {
 
         void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
         const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
-        return EnumerateInstance(classPtr, classId, beginElemCB, endElemCB, accessFlags, nullptr, nullptr, errorHandler);
+        EnumerateInstanceCallContext callContext(beginElemCB, endElemCB, this, accessFlags, errorHandler);
+        return EnumerateInstance(&callContext, classPtr, classId, nullptr, nullptr);
     }
 
     template<class T>
@@ -1622,7 +1712,8 @@ namespace V {
 
         const void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
         const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
-        return EnumerateInstanceConst(classPtr, classId, beginElemCB, endElemCB, accessFlags, nullptr, nullptr, errorHandler);
+        EnumerateInstanceCallContext callContext(beginElemCB, endElemCB, this, accessFlags, errorHandler);
+        return EnumerateInstanceConst(&callContext, classPtr, classId, nullptr, nullptr);
     }
 
     //=========================================================================
@@ -1650,6 +1741,25 @@ namespace V {
         CloneObjectInplace(&dest, classPtr, classId);
     }
 
+    // CloneObject
+    template<class T>
+    T* SerializeContext::CloneObject(const T* obj, RootObjectArena& arena)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
+        void* clonedObj = CloneObject(classPtr, classId, arena);
+        return Cast<T*>(clonedObj, classId);
+    }
+
+    // CloneObjectInplace
+    template<class T>
+    void SerializeContext::CloneObjectInplace(T& dest, const T* obj, RootObjectArena& arena)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(obj, SerializeTypeInfo<T>::GetRttiTypeId(obj));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(obj);
+        CloneObjectInplace(&dest, classPtr, classId, arena);
+    }
+
     //=========================================================================
     // EnumerateDerived
     //=========================================================================
@@ -1706,7 +1816,7 @@ namespace V {
     SerializeContext::ClassBuilder
     SerializeContext::Class()
     {
-        return Class<T, TBaseClasses...>(&Serialize::StaticInstance<Serialize::InstanceFactory<T> >::s_instance);
+        return Class<T, TBaseClasses...>(&Serialize::StaticInstance<Serialize::InstanceFactory<T> >::_instance);
     }
 
     //=========================================================================
@@ -1765,7 +1875,7 @@ namespace V {
     template<class ClassType, class FieldType>
     SerializeContext::ClassBuilder* SerializeContext::ClassBuilder::Field(const char* name, FieldType ClassType::* member, VStd::initializer_list<AttributePair> attributes)
     {
-        using UnderlyingType = VStd::RemoveEnumT<FieldType>;
+        using UnderlyingType = VStd::remove_enum_t<FieldType>;
         using ValueType = VStd::remove_pointer_t<FieldType>;
 
         if (m_context->IsRemovingReflection())
@@ -1794,8 +1904,8 @@ namespace V {
         // Therefore in order to remain backwards compatible the SerializeGenericTypeInfo<ValueType>::GetClassTypeId specialization
         // is used for all cases except when the ValueType is an enum type.
         // In that case VObject is used directly to retrieve the actual Id that the enum specializes
-        constV::TypeId& fieldTypeId = VStd::is_enum<ValueType>::value ? VObject<ValueType>::Id() : SerializeGenericTypeInfo<ValueType>::GetClassTypeId();
-        constV::TypeId& underlyingTypeId = VObject<UnderlyingType>::Id();
+        const V::TypeId& fieldTypeId = VStd::is_enum<ValueType>::value ? VObject<ValueType>::Id() : SerializeGenericTypeInfo<ValueType>::GetClassTypeId();
+        const V::TypeId& underlyingTypeId = VObject<UnderlyingType>::Id();
 
         m_classData->second.Elements.emplace_back();
         ClassElement& ed = m_classData->second.Elements.back();
@@ -1809,7 +1919,7 @@ namespace V {
         ed.EditDataPtr = nullptr;
         ed.VObjectRtti = GetRttiHelper<ValueType>();
 
-        ed.m_genericClassInfo = SerializeGenericTypeInfo<ValueType>::GetGenericInfo();
+        ed.GenericClassInfoPtr = SerializeGenericTypeInfo<ValueType>::GetGenericInfo();
         if (!fieldTypeId.IsNull())
         {
             ed.TypeId = fieldTypeId;
@@ -1833,7 +1943,7 @@ namespace V {
             ed.Attributes.emplace_back(attributePair.first, attributePair.second);
         }
 
-        if (ed.m_genericClassInfo)
+        if (ed.GenericClassInfoPtr)
         {
             ed.GenericClassInfoPtr->Reflect(m_context);
         }
@@ -1942,7 +2052,7 @@ namespace V {
     bool SerializeContext::DataElementNode::GetData(T& value, ErrorHandler* errorHandler)
     {
         const Uuid& classTypeId = SerializeGenericTypeInfo<T>::GetClassTypeId();
-        const Uuid& underlyingTypeId = SerializeGenericTypeInfo<VStd::RemoveEnumT<T>>::GetClassTypeId();
+        const Uuid& underlyingTypeId = SerializeGenericTypeInfo<VStd::remove_enum_t<T>>::GetClassTypeId();
         GenericClassInfo* genericInfo = SerializeGenericTypeInfo<T>::GetGenericInfo();
         const bool genericClassStoresType = genericInfo && genericInfo->CanStoreType(m_element.Id);
         const bool typeIdsMatch = classTypeId == m_element.Id || underlyingTypeId == m_element.Id;
@@ -1974,12 +2084,12 @@ namespace V {
                         text.resize_no_construct(m_element.DataSize);
                         m_element.ByteStream.Read(text.size(), reinterpret_cast<void*>(text.data()));
                         m_element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
-                        m_element.DataSize = classData->m_serializer->TextToData(text.c_str(), m_element.Version, m_element.ByteStream);
+                        m_element.DataSize = classData->SerializerPtr->TextToData(text.c_str(), m_element.Version, m_element.ByteStream);
                         m_element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
                         m_element.DataCategory = DataElement::DT_BINARY;
                     }
 
-                    bool isLoaded = classData->SerializerPtr->Load(&value, m_element.ByteStream, m_element.Version, m_element.DataType == DataElement::DT_BINARY_BE);
+                    bool isLoaded = classData->SerializerPtr->Load(&value, m_element.ByteStream, m_element.Version, m_element.DataCategory == DataElement::DT_BINARY_BE);
                     m_element.ByteStream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN); // reset stream position
                     return isLoaded;
                 }
@@ -2151,7 +2261,7 @@ namespace V {
         m_element.Id = SerializeGenericTypeInfo<T>::GetClassTypeId();
         m_element.DataSize = 0;
         m_element.Buffer.clear();
-        m_element.Stream = &m_element.ByteStream;
+        m_element.StreamPtr = &m_element.ByteStream;
 
         GenericClassInfo* genericClassInfo = SerializeGenericTypeInfo<T>::GetGenericInfo();
         if (genericClassInfo)
@@ -2194,16 +2304,16 @@ namespace V {
         GenericClassInfo* genericClassInfo = SerializeGenericTypeInfo<T>::GetGenericInfo();
         if (genericClassInfo)
         {
-            node.ClassDataPtr = genericClassInfo->GetClassData();
+            node.m_classData = genericClassInfo->GetClassData();
         }
         else
         {
             // if we are NOT a generic container
-            node.m_classData = sc.FindClassData(node.m_element.m_id);
+            node.m_classData = sc.FindClassData(node.m_element.Id);
             V_Assert(node.m_classData, "You are adding element to an unregistered class!");
         }
 
-        node.m_element.m_version = node.m_classData->m_version;
+        node.m_element.Version = node.m_classData->Version;
 
         m_subElements.push_back(node);
         return static_cast<int>(m_subElements.size() - 1);
@@ -2287,7 +2397,7 @@ namespace V {
     {
         // Detect the scenario when an enum type doesn't specialize VObject
         // The underlying type Uuid is returned instead
-        return VStd::is_enum<ValueType>::value && VObject<ValueType>::Uuid().IsNull() ? VObject<VStd::RemoveEnumT<ValueType>>::Uuid() : VObject<ValueType>::Uuid();
+        return VStd::is_enum<ValueType>::value && VObject<ValueType>::Id().IsNull() ? VObject<VStd::remove_enum_t<ValueType>>::Id() : VObject<ValueType>::Id();
     };
 
     /**
@@ -2335,7 +2445,7 @@ namespace V {
         using GenericClassInfoType = typename SerializeGenericTypeInfo<T>::ClassInfoType;
         static_assert(VStd::is_base_of<V::GenericClassInfo, GenericClassInfoType>::value, "GenericClassInfoType must be be derived fromV::GenericClassInfo");
 
-        constV::TypeId& canonicalTypeId = VObject<T>::Id();
+        const V::TypeId& canonicalTypeId = VObject<T>::Id();
         auto findIt = m_moduleLocalGenericClassInfos.find(canonicalTypeId);
         if (findIt != m_moduleLocalGenericClassInfos.end())
         {
@@ -2375,7 +2485,7 @@ namespace V {
             moduleAllocator.DeAllocate(attribute);
         };
 
-        return AttributePtr{ static_cast<ContainerType*>(rawMemory), VStd::move(attributeDeleter), AZStdIAllocator(&moduleAllocator) };
+        return AttributePtr{ static_cast<ContainerType*>(rawMemory), VStd::move(attributeDeleter), VStdIAllocator(&moduleAllocator) };
     }
 } // namespace V
 
@@ -0,0 +1,375 @@
+#include <vcore/serialization/serialize_plan.h>
+#include <vcore/serialization/object_stream.h>
+#include <vcore/serialization/dynamic_serializable_field.h>
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/std/sort.h>
+
+namespace V
+{
+    //=========================================================================
+    // GetRawCopySize
+    //=========================================================================
+    size_t SerializePlan::GetRawCopySize(const Uuid& typeId, bool* isFloatingPoint)
+    {
+        // Plans never leave the process, so unlike the ObjectStream bulk types long is fine here.
+        struct RawType
+        {
+            Uuid TypeId;
+            size_t Size;
+            bool IsFloatingPoint;
+        };
+        static const RawType rawTypes[] =
+        {
+            { SerializeTypeInfo<char>::GetUuid(), sizeof(char), false },
+            { SerializeTypeInfo<V::s8>::GetUuid(), sizeof(V::s8), false },
+            { SerializeTypeInfo<short>::GetUuid(), sizeof(short), false },
+            { SerializeTypeInfo<int>::GetUuid(), sizeof(int), false },
+            { SerializeTypeInfo<long>::GetUuid(), sizeof(long), false },
+            { SerializeTypeInfo<V::s64>::GetUuid(), sizeof(V::s64), false },
+            { SerializeTypeInfo<unsigned char>::GetUuid(), sizeof(unsigned char), false },
+            { SerializeTypeInfo<unsigned short>::GetUuid(), sizeof(unsigned short), false },
+            { SerializeTypeInfo<unsigned int>::GetUuid(), sizeof(unsigned int), false },
+            { SerializeTypeInfo<unsigned long>::GetUuid(), sizeof(unsigned long), false },
+            { SerializeTypeInfo<V::u64>::GetUuid(), sizeof(V::u64), false },
+            { SerializeTypeInfo<bool>::GetUuid(), sizeof(bool), false },
+            { SerializeTypeInfo<float>::GetUuid(), sizeof(float), true },
+            { SerializeTypeInfo<double>::GetUuid(), sizeof(double), true },
+        };
+        for (const RawType& rawType : rawTypes)
+        {
+            if (rawType.TypeId == typeId)
+            {
+                if (isFloatingPoint)
+                {
+                    *isFloatingPoint = rawType.IsFloatingPoint;
+                }
+                return rawType.Size;
+            }
+        }
+        return 0;
+    }
+
+    //=========================================================================
+    // IsGeneric
+    //=========================================================================
+    bool SerializePlan::IsGeneric(const SerializeContext::ClassData* classData)
+    {
+        // Event handlers must see the whole object written and containers need the reserve/store protocol,
+        // both are left to the enumeration based clone.
+        return classData->EventHandlerPtr || classData->ContainerPtr || classData->TypeId == SerializeTypeInfo<DynamicSerializableField>::GetUuid();
+    }
+
+    //=========================================================================
+    // Compile
+    //=========================================================================
+    VStd::unique_ptr<SerializePlan> SerializePlan::Compile(const SerializeContext& sc, const SerializeContext::ClassData* classData)
+    {
+        if (!classData || classData->IsDeprecated() || IsGeneric(classData))
+        {
+            return nullptr;
+        }
+
+        VStd::unique_ptr<SerializePlan> plan(vnew SerializePlan);
+        plan->m_classData = classData;
+
+        VStd::vector<Op> ops;
+        AddValue(sc, classData, 0, ops);
+
+        // insertion_sort is stable, base classes and members reflected at the same offset keep their order.
+        VStd::insertion_sort(ops.begin(), ops.end(), [](const Op& lhs, const Op& rhs) { return lhs.Offset < rhs.Offset; });
+
+        plan->m_ops.reserve(ops.size());
+        for (const Op& op : ops)
+        {
+            if (!plan->m_ops.empty())
+            {
+                // Only merge fields that touch, a gap may hold members which are not reflected.
+                Op& last = plan->m_ops.back();
+                const bool isAdjacent = last.Offset + last.Size == op.Offset;
+                if (isAdjacent && last.Type == OpType::CopyRun && op.Type == OpType::CopyRun)
+                {
+                    last.Size += op.Size;
+                    continue;
+                }
+                if (isAdjacent && last.Type == OpType::FloatRun && op.Type == OpType::FloatRun && last.ClassDataPtr == op.ClassDataPtr)
+                {
+                    last.Size += op.Size;
+                    continue;
+                }
+            }
+            plan->m_ops.push_back(op);
+        }
+        return plan;
+    }
+
+    //=========================================================================
+    // AddValue
+    //=========================================================================
+    void SerializePlan::AddValue(const SerializeContext& sc, const SerializeContext::ClassData* classData, size_t offset, VStd::vector<Op>& ops)
+    {
+        Op op;
+        op.Offset = offset;
+        op.Size = 0;
+        op.ElementSize = 0;
+        op.ClassDataPtr = classData;
+        op.ElementPtr = nullptr;
+
+        if (IsGeneric(classData))
+        {
+            op.Type = OpType::Generic;
+            ops.push_back(op);
+        }
+        else if (classData->SerializerPtr)
+        {
+            bool isFloatingPoint = false;
+            const size_t rawSize = GetRawCopySize(classData->TypeId, &isFloatingPoint);
+            if (rawSize)
+            {
+                op.Type = isFloatingPoint ? OpType::FloatRun : OpType::CopyRun;
+                op.Size = rawSize;
+                op.ElementSize = static_cast<u32>(rawSize);
+            }
+            else
+            {
+                op.Type = OpType::Serializer;
+            }
+            ops.push_back(op);
+        }
+        else
+        {
+            AddMembers(sc, classData, offset, ops);
+        }
+    }
+
+    //=========================================================================
+    // AddMembers
+    //=========================================================================
+    void SerializePlan::AddMembers(const SerializeContext& sc, const SerializeContext::ClassData* classData, size_t offset, VStd::vector<Op>& ops)
+    {
+        for (const SerializeContext::ClassElement& element : classData->Elements)
+        {
+            const SerializeContext::ClassData* elementClass = element.GenericClassInfoPtr
+                ? element.GenericClassInfoPtr->GetClassData()
+                : sc.FindClassData(element.TypeId, classData, element.NameCrc);
+            if (!elementClass || elementClass->IsDeprecated())
+            {
+                // the enumeration path skips these as well
+                continue;
+            }
+
+            if (element.Flags & SerializeContext::ClassElement::FLG_POINTER)
+            {
+                Op op;
+                op.Type = OpType::Pointer;
+                op.Offset = offset + element.Offset;
+                op.Size = sizeof(void*);
+                op.ElementSize = 0;
+                op.ClassDataPtr = elementClass;
+                op.ElementPtr = &element;
+                ops.push_back(op);
+            }
+            else
+            {
+                AddValue(sc, elementClass, offset + element.Offset, ops);
+            }
+        }
+    }
+
+    //=========================================================================
+    // Clone
+    //=========================================================================
+    void SerializePlan::Clone(SerializeContext& sc, void* dest, const void* source, VStd::vector<char>& scratchBuffer) const
+    {
+        for (const Op& op : m_ops)
+        {
+            CloneOp(sc, op, dest, source, scratchBuffer);
+        }
+    }
+
+    //=========================================================================
+    // CloneOp
+    //=========================================================================
+    void SerializePlan::CloneOp(SerializeContext& sc, const Op& op, void* dest, const void* source, VStd::vector<char>& scratchBuffer)
+    {
+        void* destPtr = reinterpret_cast<char*>(dest) + op.Offset;
+        const void* sourcePtr = reinterpret_cast<const char*>(source) + op.Offset;
+        switch (op.Type)
+        {
+        case OpType::CopyRun:
+        case OpType::FloatRun:
+            memcpy(destPtr, sourcePtr, op.Size);
+            break;
+        case OpType::Serializer:
+        {
+            scratchBuffer.clear();
+            IO::ByteContainerStream<VStd::vector<char>> stream(&scratchBuffer);
+            op.ClassDataPtr->SerializerPtr->Save(sourcePtr, stream);
+            stream.Seek(0, IO::GenericStream::ST_SEEK_BEGIN);
+            op.ClassDataPtr->SerializerPtr->Load(destPtr, stream, op.ClassDataPtr->Version);
+            op.ClassDataPtr->SerializerPtr->PostClone(destPtr);
+            break;
+        }
+        case OpType::Pointer:
+            ClonePointer(sc, op, destPtr, sourcePtr, scratchBuffer);
+            break;
+        case OpType::Generic:
+            sc.CloneObjectInplace(destPtr, sourcePtr, op.ClassDataPtr->TypeId);
+            break;
+        }
+    }
+
+    //=========================================================================
+    // ClonePointer
+    //=========================================================================
+    void SerializePlan::ClonePointer(SerializeContext& sc, const Op& op, void* dest, const void* source, VStd::vector<char>& scratchBuffer)
+    {
+        const void* sourceObject = *reinterpret_cast<const void* const*>(source);
+        if (!sourceObject)
+        {
+            // like the enumeration path, a null source leaves the destination pointer untouched
+            return;
+        }
+
+        const SerializeContext::ClassElement* element = op.ElementPtr;
+        const SerializeContext::ClassData* classData = op.ClassDataPtr;
+        if (element->VObjectRtti)
+        {
+            const Uuid& actualClassId = element->VObjectRtti->GetActualUuid(sourceObject);
+            if (actualClassId != classData->TypeId)
+            {
+                classData = sc.FindClassData(actualClassId);
+                if (!classData || classData->IsDeprecated())
+                {
+                    return;
+                }
+            }
+            if (classData->VObjectRtti)
+            {
+                sourceObject = element->VObjectRtti->Cast(sourceObject, classData->VObjectRtti->GetTypeId());
+            }
+        }
+
+        V_Assert(classData->Factory != nullptr, "We are attempting to create '%s', but no factory is provided! Either provide a factory or change data member '%s' to value not pointer!", classData->Name, element->Name);
+        void* newObject = classData->Factory->Create(classData->Name);
+        if (const SerializePlan* plan = sc.GetSerializePlan(classData->TypeId))
+        {
+            plan->Clone(sc, newObject, sourceObject, scratchBuffer);
+        }
+        else
+        {
+            sc.CloneObjectInplace(newObject, sourceObject, classData->TypeId);
+        }
+        *reinterpret_cast<void**>(dest) = sc.DownCast(newObject, classData->TypeId, element->TypeId, classData->VObjectRtti, element->VObjectRtti);
+    }
+
+    //=========================================================================
+    // Compare
+    //=========================================================================
+    bool SerializePlan::Compare(const SerializeContext& sc, const void* lhs, const void* rhs) const
+    {
+        const char* lhsBytes = reinterpret_cast<const char*>(lhs);
+        const char* rhsBytes = reinterpret_cast<const char*>(rhs);
+        for (const Op& op : m_ops)
+        {
+            const void* lhsPtr = lhsBytes + op.Offset;
+            const void* rhsPtr = rhsBytes + op.Offset;
+            switch (op.Type)
+            {
+            case OpType::CopyRun:
+                if (memcmp(lhsPtr, rhsPtr, op.Size) != 0)
+                {
+                    return false;
+                }
+                break;
+            case OpType::FloatRun:
+                // compared one by one, the serializer decides how -0.0 and NaN compare
+                for (size_t offset = 0; offset < op.Size; offset += op.ElementSize)
+                {
+                    if (!op.ClassDataPtr->SerializerPtr->CompareValueData(lhsBytes + op.Offset + offset, rhsBytes + op.Offset + offset))
+                    {
+                        return false;
+                    }
+                }
+                break;
+            case OpType::Serializer:
+                if (!op.ClassDataPtr->SerializerPtr->CompareValueData(lhsPtr, rhsPtr))
+                {
+                    return false;
+                }
+                break;
+            case OpType::Pointer:
+                if (!ComparePointer(sc, op, lhsPtr, rhsPtr))
+                {
+                    return false;
+                }
+                break;
+            case OpType::Generic:
+                if (!CompareSerialized(sc, lhsPtr, rhsPtr, op.ClassDataPtr->TypeId))
+                {
+                    return false;
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    //=========================================================================
+    // ComparePointer
+    //=========================================================================
+    bool SerializePlan::ComparePointer(const SerializeContext& sc, const Op& op, const void* lhs, const void* rhs)
+    {
+        const void* lhsObject = *reinterpret_cast<const void* const*>(lhs);
+        const void* rhsObject = *reinterpret_cast<const void* const*>(rhs);
+        if (!lhsObject || !rhsObject)
+        {
+            return lhsObject == rhsObject;
+        }
+
+        const SerializeContext::ClassElement* element = op.ElementPtr;
+        const SerializeContext::ClassData* classData = op.ClassDataPtr;
+        if (element->VObjectRtti)
+        {
+            const Uuid& lhsClassId = element->VObjectRtti->GetActualUuid(lhsObject);
+            if (lhsClassId != element->VObjectRtti->GetActualUuid(rhsObject))
+            {
+                return false;
+            }
+            if (lhsClassId != classData->TypeId)
+            {
+                classData = sc.FindClassData(lhsClassId);
+                if (!classData)
+                {
+                    return false;
+                }
+            }
+            if (classData->VObjectRtti)
+            {
+                lhsObject = element->VObjectRtti->Cast(lhsObject, classData->VObjectRtti->GetTypeId());
+                rhsObject = element->VObjectRtti->Cast(rhsObject, classData->VObjectRtti->GetTypeId());
+            }
+        }
+
+        if (const SerializePlan* plan = sc.GetSerializePlan(classData->TypeId))
+        {
+            return plan->Compare(sc, lhsObject, rhsObject);
+        }
+        return CompareSerialized(sc, lhsObject, rhsObject, classData->TypeId);
+    }
+
+    //=========================================================================
+    // CompareSerialized
+    //=========================================================================
+    bool SerializePlan::CompareSerialized(const SerializeContext& sc, const void* lhs, const void* rhs, const Uuid& classId)
+    {
+        VStd::vector<u8> lhsData;
+        IO::ByteContainerStream<VStd::vector<u8>> lhsStream(&lhsData);
+        ObjectStream::SaveObject(lhsStream, sc, lhs, classId);
+
+        VStd::vector<u8> rhsData;
+        IO::ByteContainerStream<VStd::vector<u8>> rhsStream(&rhsData);
+        ObjectStream::SaveObject(rhsStream, sc, rhs, classId);
+
+        return lhsData.size() == rhsData.size() && memcmp(lhsData.data(), rhsData.data(), lhsData.size()) == 0;
+    }
+} // namespace V
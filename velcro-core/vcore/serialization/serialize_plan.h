@@ -0,0 +1,75 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_SERIALIZE_PLAN_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_SERIALIZE_PLAN_H
+
+#include <vcore/serialization/serialization_context.h>
+
+namespace V
+{
+    /**
+     * Flat, precompiled description of how to clone and compare one reflected type.
+     *
+     * Compiling walks the ClassData once: value members and base classes are flattened to their offset in the
+     * outermost object and adjacent fundamental fields are merged into single memory runs. Executing the plan
+     * is a loop over that array, without FindClassData lookups or enumeration callbacks.
+     * Members that need the complete serialization rules (containers, classes with event handlers) are kept
+     * as generic ops and go through the regular SerializeContext path.
+     *
+     * Plans are compiled and owned by SerializeContext::GetSerializePlan and dropped whenever reflection changes.
+     */
+    class SerializePlan
+    {
+    public:
+        V_CLASS_ALLOCATOR(SerializePlan, SystemAllocator, 0);
+
+        enum class OpType : u8
+        {
+            CopyRun,    ///< Adjacent integral and bool fields, copied and compared as raw memory.
+            FloatRun,   ///< Adjacent fields of the same floating point type, compared with the type's serializer.
+            Serializer, ///< Value with an IDataSerializer, copied through its binary representation.
+            Pointer,    ///< Owned pointer, the pointee is created and cloned by its actual type.
+            Generic,    ///< Anything else, handled by the enumeration based clone.
+        };
+
+        struct Op
+        {
+            OpType Type;
+            u32 ElementSize;    ///< Size of one value of a run.
+            size_t Offset;      ///< Offset from the start of the planned object.
+            size_t Size;        ///< Size in bytes of a run.
+            const SerializeContext::ClassData* ClassDataPtr;
+            const SerializeContext::ClassElement* ElementPtr;   ///< Reflected element of pointer ops.
+        };
+
+        /// Builds the plan for classData, returns null when the type has to use the enumeration path as a whole.
+        static VStd::unique_ptr<SerializePlan> Compile(const SerializeContext& sc, const SerializeContext::ClassData* classData);
+
+        /// Size of types that can be copied as raw memory within the process, 0 for all other types.
+        static size_t GetRawCopySize(const Uuid& typeId, bool* isFloatingPoint = nullptr);
+
+        /// Compares two instances by their binary ObjectStream representation, the fallback for types without a plan.
+        static bool CompareSerialized(const SerializeContext& sc, const void* lhs, const void* rhs, const Uuid& classId);
+
+        const SerializeContext::ClassData* GetClassData() const { return m_classData; }
+        const VStd::vector<Op>& GetOps() const { return m_ops; }
+
+        /// Copies the reflected members of source into dest, which must be a constructed instance.
+        void Clone(SerializeContext& sc, void* dest, const void* source, VStd::vector<char>& scratchBuffer) const;
+        /// Executes a single op, dest and source point to the planned objects. Used by callers that schedule ops themselves.
+        static void CloneOp(SerializeContext& sc, const Op& op, void* dest, const void* source, VStd::vector<char>& scratchBuffer);
+        /// Returns true if all reflected members of lhs and rhs are equal.
+        bool Compare(const SerializeContext& sc, const void* lhs, const void* rhs) const;
+
+    private:
+        static void AddValue(const SerializeContext& sc, const SerializeContext::ClassData* classData, size_t offset, VStd::vector<Op>& ops);
+        static void AddMembers(const SerializeContext& sc, const SerializeContext::ClassData* classData, size_t offset, VStd::vector<Op>& ops);
+        static bool IsGeneric(const SerializeContext::ClassData* classData);
+
+        static void ClonePointer(SerializeContext& sc, const Op& op, void* dest, const void* source, VStd::vector<char>& scratchBuffer);
+        static bool ComparePointer(const SerializeContext& sc, const Op& op, const void* lhs, const void* rhs);
+
+        const SerializeContext::ClassData* m_classData = nullptr;
+        VStd::vector<Op> m_ops;
+    };
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_SERIALIZE_PLAN_H
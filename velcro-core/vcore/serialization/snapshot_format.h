@@ -0,0 +1,104 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_FORMAT_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_FORMAT_H
+
+#include <vcore/base.h>
+
+namespace V
+{
+    /**
+     * On disk layout of snapshots written by SnapshotWriter and mapped by SnapshotReader.
+     *
+     * A snapshot is a single position independent image: every reference is an offset from the start of the image,
+     * so the file can be mapped anywhere and read in place. Each reflected type gets a fixed size record layout,
+     * described by the type table at the end of the image. Values are stored in slots whose form depends on the kind
+     * of their type:
+     *   - Raw:     fundamental types, stored in place at their natural alignment.
+     *   - String:  VStd::string, an ArrayRef to null terminated characters.
+     *   - Blob:    other types with an IDataSerializer, an ArrayRef to the bytes written by IDataSerializer::Save.
+     *   - Class:   reflected classes and fixed containers (pairs, tuples), a record with one slot per field.
+     *   - Array:   sequence and associative containers, an ArrayRef to consecutive element slots. Arrays of raw
+     *              types are plain aligned POD arrays.
+     * Pointers and smart pointers are an ObjectRef to a separately stored slot of the actual type of the pointee.
+     *
+     * Everything is stored in the byte order of the writer, readers reject images with a different byte order.
+     */
+    namespace SnapshotFormat
+    {
+        static constexpr u32 Magic = 0x504e5356; // "VSNP"
+        static constexpr u16 CurrentVersion = 1;
+        static constexpr u16 ByteOrderMark = 0x0102;
+        static constexpr u32 InvalidIndex = 0xffffffff;
+
+        enum class Kind : u8
+        {
+            Raw,
+            String,
+            Blob,
+            Class,
+            Array,
+        };
+
+        struct Header
+        {
+            u32 MagicNumber;
+            u16 Version;
+            u16 ByteOrder;
+            u64 ImageSize;
+            u64 TypesOffset;    ///< Array of TypeCount TypeRecords.
+            u64 FieldsOffset;   ///< Array of FieldCount FieldRecords, referenced by the types.
+            u32 TypeCount;
+            u32 FieldCount;
+            u64 RootOffset;     ///< Slot of the root object.
+            u32 RootTypeIndex;
+            u32 Reserved;
+        };
+
+        /// Reference to Count consecutive items (characters, bytes or element slots).
+        struct ArrayRef
+        {
+            u64 Offset;
+            u64 Count;
+        };
+
+        /// Reference to a separately stored slot, Offset 0 is a null pointer.
+        struct ObjectRef
+        {
+            u64 Offset;
+            u32 TypeIndex;
+            u32 Reserved;
+        };
+
+        struct TypeRecord
+        {
+            u8 TypeId[16];
+            u64 NameOffset;         ///< Null terminated type name.
+            u32 SlotSize;           ///< Size of a value slot of this type, also the stride of arrays of it.
+            u32 SlotAlignment;
+            u32 Version;
+            u32 FirstField;         ///< Class: index of the first field in the field table.
+            u32 FieldCount;         ///< Class: number of fields.
+            u32 ElementTypeIndex;   ///< Array: type of the elements.
+            Kind TypeKind;
+            u8 IsElementPointer;    ///< Array: elements are stored as ObjectRefs.
+            u8 Reserved[6];
+        };
+
+        struct FieldRecord
+        {
+            u32 NameCrc;
+            u32 Offset;             ///< Offset of the slot in the record of the owning class.
+            u32 TypeIndex;
+            u8 IsPointer;           ///< The slot holds an ObjectRef.
+            u8 IsBaseClass;
+            u8 Reserved[2];
+        };
+
+        static_assert(sizeof(Header) == 56, "Snapshot header layout changed");
+        static_assert(sizeof(ArrayRef) == 16, "Snapshot ArrayRef layout changed");
+        static_assert(sizeof(ObjectRef) == 16, "Snapshot ObjectRef layout changed");
+        static_assert(sizeof(TypeRecord) == 56, "Snapshot TypeRecord layout changed");
+        static_assert(sizeof(FieldRecord) == 16, "Snapshot FieldRecord layout changed");
+    } // namespace SnapshotFormat
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_FORMAT_H
@@ -0,0 +1,526 @@
+#include <vcore/serialization/snapshot_reader.h>
+#include <vcore/io/generic_streams.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/std/utils.h>
+
+namespace V
+{
+    using namespace SnapshotFormat;
+
+    namespace SnapshotReaderInternal
+    {
+        /// A class can't contain itself by value, so a cycle through inline class fields means a corrupt image. It
+        /// would make FindField recurse forever. The walk is iterative so deep nesting can't overflow the stack either.
+        static bool HasInlineCycle(const TypeRecord* types, u32 typeCount, const FieldRecord* fields)
+        {
+            enum : u8 { Unvisited, InProgress, Done };
+            VStd::vector<u8> state(typeCount, Unvisited);
+            // type index and the next of its fields to visit
+            VStd::vector<VStd::pair<u32, u32>> stack;
+            for (u32 rootIndex = 0; rootIndex < typeCount; ++rootIndex)
+            {
+                if (state[rootIndex] != Unvisited)
+                {
+                    continue;
+                }
+                state[rootIndex] = InProgress;
+                stack.emplace_back(rootIndex, 0u);
+                while (!stack.empty())
+                {
+                    const TypeRecord& type = types[stack.back().first];
+                    const u32 fieldCount = type.TypeKind == Kind::Class ? type.FieldCount : 0;
+                    if (stack.back().second == fieldCount)
+                    {
+                        state[stack.back().first] = Done;
+                        stack.pop_back();
+                        continue;
+                    }
+                    const FieldRecord& field = fields[type.FirstField + stack.back().second++];
+                    if (field.IsPointer)
+                    {
+                        continue;
+                    }
+                    if (state[field.TypeIndex] == InProgress)
+                    {
+                        return true;
+                    }
+                    if (state[field.TypeIndex] == Unvisited)
+                    {
+                        state[field.TypeIndex] = InProgress;
+                        stack.emplace_back(field.TypeIndex, 0u);
+                    }
+                }
+            }
+            return false;
+        }
+    } // namespace SnapshotReaderInternal
+
+    //=========================================================================
+    // SnapshotValue
+    //=========================================================================
+    SnapshotValue::SnapshotValue(const SnapshotReader* reader, const u8* data, u32 typeIndex)
+        : m_reader(reader)
+        , m_data(data)
+        , m_typeIndex(typeIndex)
+    {
+    }
+
+    const TypeRecord* SnapshotValue::GetType() const
+    {
+        return m_data ? m_reader->GetType(m_typeIndex) : nullptr;
+    }
+
+    Kind SnapshotValue::GetKind() const
+    {
+        const TypeRecord* type = GetType();
+        return type ? type->TypeKind : Kind::Class;
+    }
+
+    Uuid SnapshotValue::GetTypeId() const
+    {
+        Uuid typeId = Uuid::CreateNull();
+        if (const TypeRecord* type = GetType())
+        {
+            memcpy(typeId.data, type->TypeId, sizeof(type->TypeId));
+        }
+        return typeId;
+    }
+
+    const char* SnapshotValue::GetTypeName() const
+    {
+        const TypeRecord* type = GetType();
+        return type ? reinterpret_cast<const char*>(m_reader->GetData(type->NameOffset, 1)) : "";
+    }
+
+    unsigned int SnapshotValue::GetVersion() const
+    {
+        const TypeRecord* type = GetType();
+        return type ? type->Version : 0;
+    }
+
+    //=========================================================================
+    // Raw, String and Blob values
+    //=========================================================================
+    const u8* SnapshotValue::GetRawData(const Uuid& typeId, size_t size) const
+    {
+        const TypeRecord* type = GetType();
+        if (!type || type->TypeKind != Kind::Raw || type->SlotSize != size || memcmp(type->TypeId, typeId.data, sizeof(type->TypeId)) != 0)
+        {
+            return nullptr;
+        }
+        return m_data;
+    }
+
+    VStd::string_view SnapshotValue::GetString() const
+    {
+        const TypeRecord* type = GetType();
+        if (!type || type->TypeKind != Kind::String)
+        {
+            return VStd::string_view();
+        }
+        const ArrayRef& text = *reinterpret_cast<const ArrayRef*>(m_data);
+        const u8* characters = text.Count < ~0ull ? m_reader->GetData(text.Offset, text.Count + 1) : nullptr;
+        return characters ? VStd::string_view(reinterpret_cast<const char*>(characters), static_cast<size_t>(text.Count)) : VStd::string_view();
+    }
+
+    const u8* SnapshotValue::GetBlob(size_t& size) const
+    {
+        size = 0;
+        const TypeRecord* type = GetType();
+        if (!type || type->TypeKind != Kind::Blob)
+        {
+            return nullptr;
+        }
+        const ArrayRef& blob = *reinterpret_cast<const ArrayRef*>(m_data);
+        const u8* data = m_reader->GetData(blob.Offset, blob.Count);
+        if (data)
+        {
+            size = static_cast<size_t>(blob.Count);
+        }
+        return data;
+    }
+
+    bool SnapshotValue::LoadValue(void* object, const Uuid& typeId, size_t size, const SerializeContext& sc) const
+    {
+        const TypeRecord* type = GetType();
+        if (!type || memcmp(type->TypeId, typeId.data, sizeof(type->TypeId)) != 0)
+        {
+            return false;
+        }
+
+        switch (type->TypeKind)
+        {
+        case Kind::Raw:
+            if (type->SlotSize != size)
+            {
+                return false;
+            }
+            memcpy(object, m_data, size);
+            return true;
+        case Kind::String:
+        {
+            // the kind comes from the image, only the type id tells that object really is a string
+            if (typeId != SerializeTypeInfo<VStd::string>::GetUuid() || size != sizeof(VStd::string))
+            {
+                return false;
+            }
+            const VStd::string_view text = GetString();
+            reinterpret_cast<VStd::string*>(object)->assign(text.data(), text.size());
+            return true;
+        }
+        case Kind::Blob:
+        {
+            const SerializeContext::ClassData* classData = sc.FindClassData(typeId);
+            size_t size = 0;
+            const u8* data = GetBlob(size);
+            if (!classData || !classData->SerializerPtr || (!data && size))
+            {
+                return false;
+            }
+            IO::MemoryStream stream(data, size);
+            return classData->SerializerPtr->Load(object, stream, type->Version);
+        }
+        default:
+            return false;
+        }
+    }
+
+    //=========================================================================
+    // Class values
+    //=========================================================================
+    u32 SnapshotValue::GetNumFields() const
+    {
+        const TypeRecord* type = GetType();
+        return type && type->TypeKind == Kind::Class ? type->FieldCount : 0;
+    }
+
+    u32 SnapshotValue::GetFieldNameCrc(u32 fieldIndex) const
+    {
+        if (fieldIndex >= GetNumFields())
+        {
+            return 0;
+        }
+        return m_reader->GetField(GetType()->FirstField + fieldIndex)->NameCrc;
+    }
+
+    bool SnapshotValue::IsBaseClassField(u32 fieldIndex) const
+    {
+        if (fieldIndex >= GetNumFields())
+        {
+            return false;
+        }
+        return m_reader->GetField(GetType()->FirstField + fieldIndex)->IsBaseClass != 0;
+    }
+
+    SnapshotValue SnapshotValue::GetField(u32 fieldIndex) const
+    {
+        if (fieldIndex >= GetNumFields())
+        {
+            return SnapshotValue();
+        }
+        const FieldRecord* field = m_reader->GetField(GetType()->FirstField + fieldIndex);
+        return GetSlot(m_data + field->Offset, field->TypeIndex, field->IsPointer != 0);
+    }
+
+    SnapshotValue SnapshotValue::FindField(u32 nameCrc) const
+    {
+        const u32 numFields = GetNumFields();
+        for (u32 fieldIndex = 0; fieldIndex < numFields; ++fieldIndex)
+        {
+            if (GetFieldNameCrc(fieldIndex) == nameCrc)
+            {
+                return GetField(fieldIndex);
+            }
+        }
+        for (u32 fieldIndex = 0; fieldIndex < numFields; ++fieldIndex)
+        {
+            if (IsBaseClassField(fieldIndex))
+            {
+                SnapshotValue field = GetField(fieldIndex).FindField(nameCrc);
+                if (field.IsValid())
+                {
+                    return field;
+                }
+            }
+        }
+        return SnapshotValue();
+    }
+
+    //=========================================================================
+    // Array values
+    //=========================================================================
+    size_t SnapshotValue::GetSize() const
+    {
+        const TypeRecord* type = GetType();
+        if (!type || type->TypeKind != Kind::Array)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(reinterpret_cast<const ArrayRef*>(m_data)->Count);
+    }
+
+    SnapshotValue SnapshotValue::GetElement(size_t index) const
+    {
+        if (index >= GetSize())
+        {
+            return SnapshotValue();
+        }
+        const TypeRecord* type = GetType();
+        const bool isPointer = type->IsElementPointer != 0;
+        const u64 stride = m_reader->GetSlotSize(type->ElementTypeIndex, isPointer);
+        const ArrayRef& elements = *reinterpret_cast<const ArrayRef*>(m_data);
+        // checking the elements up to index also rules out index * stride overflowing
+        const u8* data = m_reader->GetSlots(elements.Offset, type->ElementTypeIndex, isPointer, static_cast<u64>(index) + 1);
+        return data ? GetSlot(data + index * stride, type->ElementTypeIndex, isPointer) : SnapshotValue();
+    }
+
+    const u8* SnapshotValue::GetArrayData(const Uuid& typeId, size_t size) const
+    {
+        const TypeRecord* type = GetType();
+        if (!type || type->TypeKind != Kind::Array || type->IsElementPointer)
+        {
+            return nullptr;
+        }
+        const TypeRecord* elementType = m_reader->GetType(type->ElementTypeIndex);
+        if (elementType->TypeKind != Kind::Raw || elementType->SlotSize != size || memcmp(elementType->TypeId, typeId.data, sizeof(elementType->TypeId)) != 0)
+        {
+            return nullptr;
+        }
+        const ArrayRef& elements = *reinterpret_cast<const ArrayRef*>(m_data);
+        return m_reader->GetSlots(elements.Offset, type->ElementTypeIndex, false, elements.Count);
+    }
+
+    //=========================================================================
+    // GetSlot
+    //=========================================================================
+    SnapshotValue SnapshotValue::GetSlot(const u8* slot, u32 typeIndex, bool isPointer) const
+    {
+        if (!isPointer)
+        {
+            return SnapshotValue(m_reader, slot, typeIndex);
+        }
+
+        const ObjectRef& object = *reinterpret_cast<const ObjectRef*>(slot);
+        if (object.Offset == 0 || object.TypeIndex >= m_reader->GetNumTypes())
+        {
+            return SnapshotValue();
+        }
+        const u8* data = m_reader->GetSlots(object.Offset, object.TypeIndex, false);
+        return data ? SnapshotValue(m_reader, data, object.TypeIndex) : SnapshotValue();
+    }
+
+    //=========================================================================
+    // SnapshotReader
+    //=========================================================================
+    bool SnapshotReader::Open(const char* filePath)
+    {
+        Close();
+        if (!m_file.Open(filePath))
+        {
+            return false;
+        }
+        m_image = m_file.Data();
+        m_imageSize = m_file.Size();
+        if (!Validate())
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool SnapshotReader::OpenMemory(const void* image, size_t imageSize)
+    {
+        Close();
+        // slots are aligned relative to the start of the image
+        V_Assert((reinterpret_cast<uintptr_t>(image) & 15) == 0, "Snapshot images must be 16 byte aligned in memory.");
+        if (!image || (reinterpret_cast<uintptr_t>(image) & 15) != 0)
+        {
+            return false;
+        }
+        m_image = reinterpret_cast<const u8*>(image);
+        m_imageSize = imageSize;
+        if (!Validate())
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void SnapshotReader::Close()
+    {
+        m_file.Close();
+        m_image = nullptr;
+        m_imageSize = 0;
+        m_header = nullptr;
+        m_types = nullptr;
+        m_fields = nullptr;
+    }
+
+    SnapshotValue SnapshotReader::GetRoot() const
+    {
+        if (!m_header)
+        {
+            return SnapshotValue();
+        }
+        return SnapshotValue(this, m_image + m_header->RootOffset, m_header->RootTypeIndex);
+    }
+
+    const TypeRecord* SnapshotReader::GetType(u32 typeIndex) const
+    {
+        return m_header && typeIndex < m_header->TypeCount ? m_types + typeIndex : nullptr;
+    }
+
+    const FieldRecord* SnapshotReader::GetField(u32 fieldIndex) const
+    {
+        return m_header && fieldIndex < m_header->FieldCount ? m_fields + fieldIndex : nullptr;
+    }
+
+    u32 SnapshotReader::FindType(const Uuid& typeId) const
+    {
+        for (u32 typeIndex = 0; typeIndex < GetNumTypes(); ++typeIndex)
+        {
+            if (memcmp(m_types[typeIndex].TypeId, typeId.data, sizeof(m_types[typeIndex].TypeId)) == 0)
+            {
+                return typeIndex;
+            }
+        }
+        return InvalidIndex;
+    }
+
+    const u8* SnapshotReader::GetData(u64 offset, u64 size) const
+    {
+        if (offset > m_imageSize || size > m_imageSize - offset)
+        {
+            return nullptr;
+        }
+        return m_image + offset;
+    }
+
+    const u8* SnapshotReader::GetSlots(u64 offset, u32 typeIndex, bool isPointer, u64 count) const
+    {
+        const u64 slotSize = GetSlotSize(typeIndex, isPointer);
+        if ((offset % GetSlotAlignment(typeIndex, isPointer)) != 0 || (slotSize && count > ~0ull / slotSize))
+        {
+            return nullptr;
+        }
+        return GetData(offset, count * slotSize);
+    }
+
+    u32 SnapshotReader::GetSlotSize(u32 typeIndex, bool isPointer) const
+    {
+        return isPointer ? static_cast<u32>(sizeof(ObjectRef)) : m_types[typeIndex].SlotSize;
+    }
+
+    u32 SnapshotReader::GetSlotAlignment(u32 typeIndex, bool isPointer) const
+    {
+        return isPointer ? static_cast<u32>(alignof(ObjectRef)) : m_types[typeIndex].SlotAlignment;
+    }
+
+    //=========================================================================
+    // Validate
+    //=========================================================================
+    bool SnapshotReader::Validate()
+    {
+        if (m_imageSize < sizeof(Header))
+        {
+            return false;
+        }
+        const Header* header = reinterpret_cast<const Header*>(m_image);
+        if (header->MagicNumber != Magic || header->Version != CurrentVersion || header->ByteOrder != ByteOrderMark || header->ImageSize > m_imageSize)
+        {
+            return false;
+        }
+        if ((header->TypesOffset % alignof(TypeRecord)) != 0 || (header->FieldsOffset % alignof(FieldRecord)) != 0 ||
+            !GetData(header->TypesOffset, static_cast<u64>(header->TypeCount) * sizeof(TypeRecord)) ||
+            !GetData(header->FieldsOffset, static_cast<u64>(header->FieldCount) * sizeof(FieldRecord)))
+        {
+            return false;
+        }
+        const TypeRecord* types = reinterpret_cast<const TypeRecord*>(m_image + header->TypesOffset);
+        const FieldRecord* fields = reinterpret_cast<const FieldRecord*>(m_image + header->FieldsOffset);
+
+        // Only the tables are checked here, they are small compared to the data and every view relies on them.
+        for (u32 typeIndex = 0; typeIndex < header->TypeCount; ++typeIndex)
+        {
+            const TypeRecord& type = types[typeIndex];
+            if (type.TypeKind > Kind::Array || type.SlotAlignment == 0 || type.SlotAlignment > 16 || (type.SlotAlignment & (type.SlotAlignment - 1)) != 0 ||
+                (type.SlotSize % type.SlotAlignment) != 0 || type.NameOffset >= m_imageSize ||
+                !memchr(m_image + type.NameOffset, 0, static_cast<size_t>(m_imageSize - type.NameOffset)))
+            {
+                return false;
+            }
+
+            switch (type.TypeKind)
+            {
+            case Kind::Raw:
+                // raw values are read in place, so they have to be naturally aligned
+                if (type.SlotSize == 0 || type.SlotSize > 8 || type.SlotAlignment != type.SlotSize)
+                {
+                    return false;
+                }
+                break;
+            case Kind::String:
+            case Kind::Blob:
+                if (type.SlotSize != sizeof(ArrayRef) || type.SlotAlignment < alignof(ArrayRef))
+                {
+                    return false;
+                }
+                break;
+            case Kind::Array:
+                if (type.SlotSize != sizeof(ArrayRef) || type.SlotAlignment < alignof(ArrayRef) || type.ElementTypeIndex >= header->TypeCount)
+                {
+                    return false;
+                }
+                break;
+            case Kind::Class:
+                if (type.FirstField > header->FieldCount || type.FieldCount > header->FieldCount - type.FirstField)
+                {
+                    return false;
+                }
+                for (u32 fieldIndex = type.FirstField; fieldIndex < type.FirstField + type.FieldCount; ++fieldIndex)
+                {
+                    const FieldRecord& field = fields[fieldIndex];
+                    if (field.TypeIndex >= header->TypeCount)
+                    {
+                        return false;
+                    }
+                    const u64 fieldSize = field.IsPointer ? sizeof(ObjectRef) : types[field.TypeIndex].SlotSize;
+                    if (field.Offset > type.SlotSize || fieldSize > type.SlotSize - field.Offset)
+                    {
+                        return false;
+                    }
+                    // an aligned record then has aligned fields
+                    const u32 fieldAlignment = field.IsPointer ? static_cast<u32>(alignof(ObjectRef)) : types[field.TypeIndex].SlotAlignment;
+                    if (fieldAlignment > type.SlotAlignment || (field.Offset % fieldAlignment) != 0)
+                    {
+                        return false;
+                    }
+                    // FindField walks into base classes, they have to be embedded classes
+                    if (field.IsBaseClass && (field.IsPointer || types[field.TypeIndex].TypeKind != Kind::Class))
+                    {
+                        return false;
+                    }
+                }
+                break;
+            }
+        }
+
+        if (SnapshotReaderInternal::HasInlineCycle(types, header->TypeCount, fields))
+        {
+            return false;
+        }
+
+        if (header->RootTypeIndex >= header->TypeCount || (header->RootOffset % types[header->RootTypeIndex].SlotAlignment) != 0 ||
+            !GetData(header->RootOffset, types[header->RootTypeIndex].SlotSize))
+        {
+            return false;
+        }
+
+        m_header = header;
+        m_types = types;
+        m_fields = fields;
+        return true;
+    }
+} // namespace V
@@ -0,0 +1,149 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_READER_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_READER_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/serialization/snapshot_format.h>
+#include <vcore/io/mapped_file.h>
+#include <vcore/math/crc.h>
+#include <vcore/std/string/string_view.h>
+
+namespace V
+{
+    class SnapshotReader;
+
+    /**
+     * Read only view of one value inside a snapshot. Views point straight into the image, nothing is copied
+     * or allocated, and they stay valid as long as the SnapshotReader they came from keeps the image open.
+     * Accessors for the wrong kind of value return an empty result instead of failing.
+     */
+    class SnapshotValue
+    {
+    public:
+        SnapshotValue() = default;
+        SnapshotValue(const SnapshotReader* reader, const u8* data, u32 typeIndex);
+
+        /// False for null pointers, missing fields and out of range elements.
+        bool IsValid() const { return m_data != nullptr; }
+        SnapshotFormat::Kind GetKind() const;
+        Uuid GetTypeId() const;
+        const char* GetTypeName() const;
+        /// Version of the reflected type when the snapshot was written.
+        unsigned int GetVersion() const;
+
+        /// Raw values: pointer to the value inside the image, null if T is not the stored type.
+        template<class T>
+        const T* GetRaw() const;
+
+        /// String values.
+        VStd::string_view GetString() const;
+
+        /// Blob values, the bytes written by the IDataSerializer of the type.
+        const u8* GetBlob(size_t& size) const;
+        /// Loads a raw, string or blob value into object, false if T is not the stored type.
+        template<class T>
+        bool LoadValue(T& object, const SerializeContext& sc) const;
+        /// Loads a raw, string or blob value into object, which is a typeId of size bytes. False if typeId is not
+        /// the stored type.
+        bool LoadValue(void* object, const Uuid& typeId, size_t size, const SerializeContext& sc) const;
+
+        /// Class values: fields in reflection order, base classes are fields flagged as such.
+        u32 GetNumFields() const;
+        u32 GetFieldNameCrc(u32 fieldIndex) const;
+        bool IsBaseClassField(u32 fieldIndex) const;
+        SnapshotValue GetField(u32 fieldIndex) const;
+        /// Finds a field by name, searching the fields of base classes too. Pointer fields are followed.
+        SnapshotValue FindField(u32 nameCrc) const;
+        SnapshotValue FindField(VStd::string_view name) const { return FindField(static_cast<u32>(Crc32(name))); }
+
+        /// Array values.
+        size_t GetSize() const;
+        /// Pointer elements are followed, null pointers give an invalid value.
+        SnapshotValue GetElement(size_t index) const;
+        /// Arrays of raw values: the elements as a plain array inside the image, null if T is not the element type.
+        template<class T>
+        const T* GetArrayData() const;
+
+    private:
+        const u8* GetRawData(const Uuid& typeId, size_t size) const;
+        const u8* GetArrayData(const Uuid& typeId, size_t size) const;
+        SnapshotValue GetSlot(const u8* slot, u32 typeIndex, bool isPointer) const;
+        const SnapshotFormat::TypeRecord* GetType() const;
+
+        const SnapshotReader* m_reader = nullptr;
+        const u8* m_data = nullptr;
+        u32 m_typeIndex = SnapshotFormat::InvalidIndex;
+    };
+
+    /**
+     * Maps a snapshot written by SnapshotWriter and gives access to it through SnapshotValue views.
+     *
+     * Opening checks the header and the type table only, the data itself is used in place without parsing.
+     * References are bounds checked when they are followed, so damaged images produce invalid views rather than
+     * reads outside of the mapping.
+     */
+    class SnapshotReader
+    {
+    public:
+        V_CLASS_ALLOCATOR(SnapshotReader, SystemAllocator, 0);
+
+        SnapshotReader() = default;
+        ~SnapshotReader() = default;
+
+        /// Maps the file at filePath. The operating system pages the data in as it's accessed.
+        bool Open(const char* filePath);
+        /// Uses an image already in memory, which must stay alive and unchanged while the reader is open.
+        bool OpenMemory(const void* image, size_t imageSize);
+        void Close();
+        bool IsOpen() const { return m_header != nullptr; }
+
+        SnapshotValue GetRoot() const;
+
+        u32 GetNumTypes() const { return m_header ? m_header->TypeCount : 0; }
+        const SnapshotFormat::TypeRecord* GetType(u32 typeIndex) const;
+        const SnapshotFormat::FieldRecord* GetField(u32 fieldIndex) const;
+        /// Returns the index of typeId in the type table or SnapshotFormat::InvalidIndex.
+        u32 FindType(const Uuid& typeId) const;
+
+        /// Returns the data at offset if [offset, offset + size) lies inside the image, otherwise null.
+        const u8* GetData(u64 offset, u64 size) const;
+        /// Returns count consecutive slots holding typeIndex at offset if they lie inside the image and offset
+        /// respects the slot alignment, otherwise null.
+        const u8* GetSlots(u64 offset, u32 typeIndex, bool isPointer, u64 count = 1) const;
+        /// Size of a slot holding typeIndex.
+        u32 GetSlotSize(u32 typeIndex, bool isPointer) const;
+        u32 GetSlotAlignment(u32 typeIndex, bool isPointer) const;
+
+    private:
+        SnapshotReader(const SnapshotReader&) = delete;
+        SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+        bool Validate();
+
+        IO::MappedFile m_file;
+        const u8* m_image = nullptr;
+        u64 m_imageSize = 0;
+        const SnapshotFormat::Header* m_header = nullptr;
+        const SnapshotFormat::TypeRecord* m_types = nullptr;
+        const SnapshotFormat::FieldRecord* m_fields = nullptr;
+    };
+
+    template<class T>
+    const T* SnapshotValue::GetRaw() const
+    {
+        return reinterpret_cast<const T*>(GetRawData(SerializeTypeInfo<T>::GetUuid(), sizeof(T)));
+    }
+
+    template<class T>
+    bool SnapshotValue::LoadValue(T& object, const SerializeContext& sc) const
+    {
+        return LoadValue(&object, SerializeTypeInfo<T>::GetUuid(), sizeof(T), sc);
+    }
+
+    template<class T>
+    const T* SnapshotValue::GetArrayData() const
+    {
+        return reinterpret_cast<const T*>(GetArrayData(SerializeTypeInfo<T>::GetUuid(), sizeof(T)));
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_READER_H
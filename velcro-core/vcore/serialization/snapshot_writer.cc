@@ -0,0 +1,658 @@
+#include <vcore/serialization/snapshot_writer.h>
+#include <vcore/serialization/dynamic_serializable_field.h>
+#include <vcore/io/byte_container_stream.h>
+#include <vcore/io/generic_streams.h>
+#include <vcore/std/containers/unordered_map.h>
+
+namespace V
+{
+    namespace SnapshotInternal
+    {
+        using ClassData = SerializeContext::ClassData;
+        using ClassElement = SerializeContext::ClassElement;
+        using ErrorHandler = SerializeContext::ErrorHandler;
+        using namespace SnapshotFormat;
+
+        /// Types stored in place. long is left out because its size differs between platforms.
+        static u32 GetRawTypeSize(const Uuid& typeId)
+        {
+            static const VStd::pair<Uuid, u32> rawTypes[] =
+            {
+                { SerializeTypeInfo<char>::GetUuid(), sizeof(char) },
+                { SerializeTypeInfo<V::s8>::GetUuid(), sizeof(V::s8) },
+                { SerializeTypeInfo<short>::GetUuid(), sizeof(short) },
+                { SerializeTypeInfo<int>::GetUuid(), sizeof(int) },
+                { SerializeTypeInfo<V::s64>::GetUuid(), sizeof(V::s64) },
+                { SerializeTypeInfo<unsigned char>::GetUuid(), sizeof(unsigned char) },
+                { SerializeTypeInfo<unsigned short>::GetUuid(), sizeof(unsigned short) },
+                { SerializeTypeInfo<unsigned int>::GetUuid(), sizeof(unsigned int) },
+                { SerializeTypeInfo<V::u64>::GetUuid(), sizeof(V::u64) },
+                { SerializeTypeInfo<float>::GetUuid(), sizeof(float) },
+                { SerializeTypeInfo<double>::GetUuid(), sizeof(double) },
+                { SerializeTypeInfo<bool>::GetUuid(), sizeof(bool) },
+            };
+            for (const auto& rawType : rawTypes)
+            {
+                if (rawType.first == typeId)
+                {
+                    return rawType.second;
+                }
+            }
+            return 0;
+        }
+
+        static u64 AlignUp(u64 value, u64 alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        class SnapshotWriterImpl
+        {
+        public:
+            SnapshotWriterImpl(VStd::vector<char>& image, const SerializeContext& sc, ErrorHandler* errorHandler)
+                : m_image(image)
+                , m_context(sc)
+                , m_errorHandler(errorHandler)
+            {
+            }
+
+            bool Write(const void* object, const Uuid& classId);
+
+        private:
+            /// How a field or array element is stored.
+            struct Slot
+            {
+                u32 TypeIndex = InvalidIndex;
+                bool IsPointer = false;
+                const ClassData* SmartPointerClass = nullptr;   ///< The pointer is read through this smart pointer container.
+            };
+
+            struct Field
+            {
+                Slot FieldSlot;
+                const ClassElement* Element;    ///< Source member, or the container element of tuples.
+                u32 Offset;
+            };
+
+            struct TypeLayout
+            {
+                const ClassData* ClassDataPtr = nullptr;
+                Kind TypeKind = Kind::Class;
+                u32 SlotSize = 0;
+                u32 SlotAlignment = 1;
+                bool IsTuple = false;           ///< Class layout of a container, one field per element type.
+                bool IsBuilding = false;
+                bool IsComplete = false;
+                VStd::vector<Field> Fields;
+                Slot ElementSlot;               ///< Arrays only.
+                const ClassElement* Element = nullptr;  ///< Arrays only, the generic element of the container.
+            };
+
+            u32 GetTypeIndex(const ClassData* classData);
+            void EnsureLayout(u32 typeIndex);
+            void BuildLayout(u32 typeIndex);
+            bool ResolveSlot(const ClassElement* element, const ClassData* elementClassData, Slot& slot);
+            const ClassData* GetElementClassData(const ClassElement* element, const Uuid& typeId, const ClassData* parent) const;
+            u32 GetSlotSize(const Slot& slot) const;
+            u32 GetSlotAlignment(const Slot& slot) const;
+
+            u64 Allocate(u64 size, u64 alignment);
+            u64 WriteBytes(const void* data, u64 size, bool isTerminated);
+            void WriteSlot(u64 slotOffset, const void* objectPtr, u32 typeIndex);
+            void WriteValue(u64 slotOffset, const void* valuePtr, const Slot& slot, const ClassElement* element);
+            void WritePointer(u64 slotOffset, const void* pointerAddress, u32 declaredTypeIndex, const ClassElement* element);
+            void WriteArray(u64 slotOffset, const void* containerPtr, u32 typeIndex);
+            void WriteTypeTable();
+
+            template<class T>
+            T* At(u64 offset) { return reinterpret_cast<T*>(m_image.data() + offset); }
+
+            void ReportError(const VStd::string& message) { m_errorHandler->ReportError(message.c_str()); }
+            void ReportWarning(const VStd::string& message) { m_errorHandler->ReportWarning(message.c_str()); }
+
+            VStd::vector<char>& m_image;
+            const SerializeContext& m_context;
+            ErrorHandler* m_errorHandler;
+            VStd::vector<TypeLayout> m_types;
+            VStd::unordered_map<const ClassData*, u32> m_typeIndices;
+            VStd::unordered_map<const void*, ObjectRef> m_writtenObjects;  ///< Pointees already stored, by address.
+            VStd::vector<char> m_scratchBuffer;
+        };
+
+        //=========================================================================
+        // Write
+        //=========================================================================
+        bool SnapshotWriterImpl::Write(const void* object, const Uuid& classId)
+        {
+            const unsigned int numErrors = m_errorHandler->GetErrorCount();
+
+            const ClassData* classData = m_context.FindClassData(classId);
+            if (!classData)
+            {
+                ReportError(VStd::string::format("Snapshot can't save type %s, it's not reflected in the serialize context.", classId.ToString<VStd::string>().c_str()));
+                return false;
+            }
+
+            m_image.clear();
+            Allocate(sizeof(Header), alignof(Header));
+
+            const u32 rootTypeIndex = GetTypeIndex(classData);
+            EnsureLayout(rootTypeIndex);
+            const u64 rootOffset = Allocate(m_types[rootTypeIndex].SlotSize, m_types[rootTypeIndex].SlotAlignment);
+            WriteSlot(rootOffset, object, rootTypeIndex);
+
+            WriteTypeTable();
+
+            Header* header = At<Header>(0);
+            header->MagicNumber = Magic;
+            header->Version = CurrentVersion;
+            header->ByteOrder = ByteOrderMark;
+            header->ImageSize = m_image.size();
+            header->RootOffset = rootOffset;
+            header->RootTypeIndex = rootTypeIndex;
+            return m_errorHandler->GetErrorCount() == numErrors;
+        }
+
+        //=========================================================================
+        // GetTypeIndex
+        //=========================================================================
+        u32 SnapshotWriterImpl::GetTypeIndex(const ClassData* classData)
+        {
+            auto insertResult = m_typeIndices.insert_key(classData);
+            if (!insertResult.second)
+            {
+                return insertResult.first->second;
+            }
+
+            // Only the index is assigned here. Pointers and arrays don't depend on the layout of their targets,
+            // so those are built on first use, which allows types to reach themselves through them.
+            const u32 typeIndex = static_cast<u32>(m_types.size());
+            insertResult.first->second = typeIndex;
+            m_types.emplace_back();
+            m_types.back().ClassDataPtr = classData;
+            return typeIndex;
+        }
+
+        //=========================================================================
+        // EnsureLayout
+        //=========================================================================
+        void SnapshotWriterImpl::EnsureLayout(u32 typeIndex)
+        {
+            if (!m_types[typeIndex].IsComplete && !m_types[typeIndex].IsBuilding)
+            {
+                m_types[typeIndex].IsBuilding = true;
+                BuildLayout(typeIndex);
+            }
+        }
+
+        //=========================================================================
+        // BuildLayout
+        //=========================================================================
+        void SnapshotWriterImpl::BuildLayout(u32 typeIndex)
+        {
+            // m_types grows while the fields are resolved, so the layout is assembled locally.
+            TypeLayout layout;
+            layout.ClassDataPtr = m_types[typeIndex].ClassDataPtr;
+            const ClassData* classData = layout.ClassDataPtr;
+
+            if (classData->SerializerPtr)
+            {
+                const u32 rawSize = GetRawTypeSize(classData->TypeId);
+                if (rawSize)
+                {
+                    layout.TypeKind = Kind::Raw;
+                    layout.SlotSize = rawSize;
+                    layout.SlotAlignment = rawSize;
+                }
+                else
+                {
+                    layout.TypeKind = classData->TypeId == SerializeTypeInfo<VStd::string>::GetUuid() ? Kind::String : Kind::Blob;
+                    layout.SlotSize = sizeof(ArrayRef);
+                    layout.SlotAlignment = alignof(ArrayRef);
+                }
+            }
+            else if (classData->ContainerPtr)
+            {
+                VStd::vector<const ClassElement*> elements;
+                classData->ContainerPtr->EnumTypes([&elements](const Uuid&, const ClassElement* classElement)
+                {
+                    elements.push_back(classElement);
+                    return true;
+                });
+
+                if (elements.size() == 1)
+                {
+                    layout.TypeKind = Kind::Array;
+                    layout.SlotSize = sizeof(ArrayRef);
+                    layout.SlotAlignment = alignof(ArrayRef);
+                    layout.Element = elements[0];
+                    const ClassData* elementClassData = GetElementClassData(elements[0], elements[0]->TypeId, classData);
+                    if (!elementClassData || !ResolveSlot(elements[0], elementClassData, layout.ElementSlot))
+                    {
+                        ReportError(VStd::string::format("Element type of container %s is not reflected, it can't be stored in a snapshot.", classData->Name));
+                        layout.TypeKind = Kind::Class;
+                        layout.SlotSize = 0;
+                        layout.SlotAlignment = 1;
+                    }
+                }
+                else
+                {
+                    if (elements.empty())
+                    {
+                        ReportWarning(VStd::string::format("Container %s has no fixed element types, its content is not stored in snapshots.", classData->Name));
+                    }
+                    layout.IsTuple = true;
+                    for (const ClassElement* element : elements)
+                    {
+                        Field field;
+                        field.Element = element;
+                        field.Offset = 0;
+                        const ClassData* elementClassData = GetElementClassData(element, element->TypeId, classData);
+                        if (!elementClassData || !ResolveSlot(element, elementClassData, field.FieldSlot))
+                        {
+                            ReportError(VStd::string::format("Element '%s' of container %s is not reflected, it can't be stored in a snapshot.", element->Name, classData->Name));
+                            continue;
+                        }
+                        layout.Fields.push_back(field);
+                    }
+                }
+            }
+            else
+            {
+                if (classData->TypeId == SerializeTypeInfo<DynamicSerializableField>::GetUuid())
+                {
+                    ReportWarning("The data of DynamicSerializableField has no fixed type and is not stored in snapshots.");
+                }
+                for (const ClassElement& element : classData->Elements)
+                {
+                    const ClassData* elementClassData = GetElementClassData(&element, element.TypeId, classData);
+                    if (!elementClassData || elementClassData->IsDeprecated())
+                    {
+                        // same as the other serializers, fields of unknown or deprecated types are skipped
+                        continue;
+                    }
+                    Field field;
+                    field.Element = &element;
+                    field.Offset = 0;
+                    if (ResolveSlot(&element, elementClassData, field.FieldSlot))
+                    {
+                        layout.Fields.push_back(field);
+                    }
+                }
+            }
+
+            if (layout.TypeKind == Kind::Class)
+            {
+                u64 cursor = 0;
+                for (Field& field : layout.Fields)
+                {
+                    if (!field.FieldSlot.IsPointer)
+                    {
+                        EnsureLayout(field.FieldSlot.TypeIndex);
+                    }
+                    if (!field.FieldSlot.IsPointer && !m_types[field.FieldSlot.TypeIndex].IsComplete)
+                    {
+                        ReportError(VStd::string::format("%s contains itself by value, it can't be laid out.", classData->Name));
+                        continue;
+                    }
+                    const u32 alignment = GetSlotAlignment(field.FieldSlot);
+                    cursor = AlignUp(cursor, alignment);
+                    field.Offset = static_cast<u32>(cursor);
+                    cursor += GetSlotSize(field.FieldSlot);
+                    layout.SlotAlignment = VStd::max(layout.SlotAlignment, alignment);
+                }
+                layout.SlotSize = static_cast<u32>(AlignUp(cursor, layout.SlotAlignment));
+            }
+
+            layout.IsComplete = true;
+            m_types[typeIndex] = VStd::move(layout);
+        }
+
+        //=========================================================================
+        // ResolveSlot
+        //=========================================================================
+        bool SnapshotWriterImpl::ResolveSlot(const ClassElement* element, const ClassData* elementClassData, Slot& slot)
+        {
+            if (elementClassData->ContainerPtr && elementClassData->ContainerPtr->IsSmartPointer())
+            {
+                // smart pointers are stored like raw pointers to their pointee
+                const ClassElement* pointee = nullptr;
+                elementClassData->ContainerPtr->EnumTypes([&pointee](const Uuid&, const ClassElement* classElement)
+                {
+                    pointee = classElement;
+                    return false;
+                });
+                const ClassData* pointeeClassData = pointee ? GetElementClassData(pointee, pointee->TypeId, elementClassData) : nullptr;
+                if (!pointeeClassData)
+                {
+                    return false;
+                }
+                slot.TypeIndex = GetTypeIndex(pointeeClassData);
+                slot.IsPointer = true;
+                slot.SmartPointerClass = elementClassData;
+                return true;
+            }
+
+            slot.TypeIndex = GetTypeIndex(elementClassData);
+            slot.IsPointer = (element->Flags & ClassElement::FLG_POINTER) != 0;
+            slot.SmartPointerClass = nullptr;
+            return true;
+        }
+
+        const SerializeContext::ClassData* SnapshotWriterImpl::GetElementClassData(const ClassElement* element, const Uuid& typeId, const ClassData* parent) const
+        {
+            if (element && element->GenericClassInfoPtr)
+            {
+                return element->GenericClassInfoPtr->GetClassData();
+            }
+            return m_context.FindClassData(typeId, parent, element ? element->NameCrc : 0);
+        }
+
+        u32 SnapshotWriterImpl::GetSlotSize(const Slot& slot) const
+        {
+            return slot.IsPointer ? static_cast<u32>(sizeof(ObjectRef)) : m_types[slot.TypeIndex].SlotSize;
+        }
+
+        u32 SnapshotWriterImpl::GetSlotAlignment(const Slot& slot) const
+        {
+            return slot.IsPointer ? static_cast<u32>(alignof(ObjectRef)) : m_types[slot.TypeIndex].SlotAlignment;
+        }
+
+        //=========================================================================
+        // Allocate
+        //=========================================================================
+        u64 SnapshotWriterImpl::Allocate(u64 size, u64 alignment)
+        {
+            // new space is zeroed, which is a null ObjectRef and an empty ArrayRef
+            const u64 offset = AlignUp(m_image.size(), alignment);
+            m_image.resize(static_cast<size_t>(offset + size), 0);
+            return offset;
+        }
+
+        u64 SnapshotWriterImpl::WriteBytes(const void* data, u64 size, bool isTerminated)
+        {
+            const u64 offset = Allocate(size + (isTerminated ? 1 : 0), 1);
+            if (size)
+            {
+                memcpy(At<char>(offset), data, static_cast<size_t>(size));
+            }
+            return offset;
+        }
+
+        //=========================================================================
+        // WriteSlot
+        //=========================================================================
+        void SnapshotWriterImpl::WriteSlot(u64 slotOffset, const void* objectPtr, u32 typeIndex)
+        {
+            // Writing children grows the image, the slot is only ever addressed by its offset.
+            EnsureLayout(typeIndex);
+            const TypeLayout& layout = m_types[typeIndex];
+            const ClassData* classData = layout.ClassDataPtr;
+            switch (layout.TypeKind)
+            {
+            case Kind::Raw:
+                memcpy(At<char>(slotOffset), objectPtr, layout.SlotSize);
+                break;
+            case Kind::String:
+            {
+                const VStd::string& text = *reinterpret_cast<const VStd::string*>(objectPtr);
+                const u64 textOffset = WriteBytes(text.data(), text.size(), true);
+                *At<ArrayRef>(slotOffset) = { textOffset, text.size() };
+                break;
+            }
+            case Kind::Blob:
+            {
+                m_scratchBuffer.clear();
+                IO::ByteContainerStream<VStd::vector<char>> stream(&m_scratchBuffer);
+                classData->SerializerPtr->Save(objectPtr, stream);
+                const u64 dataOffset = WriteBytes(m_scratchBuffer.data(), m_scratchBuffer.size(), false);
+                *At<ArrayRef>(slotOffset) = { dataOffset, m_scratchBuffer.size() };
+                break;
+            }
+            case Kind::Array:
+                WriteArray(slotOffset, objectPtr, typeIndex);
+                break;
+            case Kind::Class:
+            {
+                if (classData->EventHandlerPtr)
+                {
+                    classData->EventHandlerPtr->OnReadBegin(const_cast<void*>(objectPtr));
+                }
+                if (layout.IsTuple)
+                {
+                    size_t fieldIndex = 0;
+                    classData->ContainerPtr->EnumElements(const_cast<void*>(objectPtr), [&](void* elementPtr, const Uuid&, const ClassData*, const ClassElement* element)
+                    {
+                        if (fieldIndex < m_types[typeIndex].Fields.size())
+                        {
+                            const Field field = m_types[typeIndex].Fields[fieldIndex++];
+                            WriteValue(slotOffset + field.Offset, elementPtr, field.FieldSlot, element);
+                        }
+                        return true;
+                    });
+                }
+                else
+                {
+                    for (size_t fieldIndex = 0; fieldIndex < m_types[typeIndex].Fields.size(); ++fieldIndex)
+                    {
+                        const Field field = m_types[typeIndex].Fields[fieldIndex];
+                        const void* fieldPtr = reinterpret_cast<const char*>(objectPtr) + field.Element->Offset;
+                        WriteValue(slotOffset + field.Offset, fieldPtr, field.FieldSlot, field.Element);
+                    }
+                }
+                if (classData->EventHandlerPtr)
+                {
+                    classData->EventHandlerPtr->OnReadEnd(const_cast<void*>(objectPtr));
+                }
+                break;
+            }
+            }
+        }
+
+        //=========================================================================
+        // WriteValue
+        //=========================================================================
+        void SnapshotWriterImpl::WriteValue(u64 slotOffset, const void* valuePtr, const Slot& slot, const ClassElement* element)
+        {
+            if (!slot.IsPointer)
+            {
+                WriteSlot(slotOffset, valuePtr, slot.TypeIndex);
+            }
+            else if (slot.SmartPointerClass)
+            {
+                slot.SmartPointerClass->ContainerPtr->EnumElements(const_cast<void*>(valuePtr), [&](void* pointerAddress, const Uuid&, const ClassData*, const ClassElement* pointeeElement)
+                {
+                    WritePointer(slotOffset, pointerAddress, slot.TypeIndex, pointeeElement);
+                    return false;
+                });
+            }
+            else
+            {
+                WritePointer(slotOffset, valuePtr, slot.TypeIndex, element);
+            }
+        }
+
+        //=========================================================================
+        // WritePointer
+        //=========================================================================
+        void SnapshotWriterImpl::WritePointer(u64 slotOffset, const void* pointerAddress, u32 declaredTypeIndex, const ClassElement* element)
+        {
+            const void* object = *reinterpret_cast<const void* const*>(pointerAddress);
+            if (!object)
+            {
+                return;
+            }
+
+            const ClassData* classData = m_types[declaredTypeIndex].ClassDataPtr;
+            if (element && element->VObjectRtti)
+            {
+                const Uuid& actualClassId = element->VObjectRtti->GetActualUuid(object);
+                if (actualClassId != classData->TypeId)
+                {
+                    classData = m_context.FindClassData(actualClassId);
+                    if (!classData)
+                    {
+                        ReportError(VStd::string::format("Element '%s' points to type %s, which is not reflected.", element->Name, actualClassId.ToString<VStd::string>().c_str()));
+                        return;
+                    }
+                }
+                if (classData->VObjectRtti)
+                {
+                    object = element->VObjectRtti->Cast(object, classData->VObjectRtti->GetTypeId());
+                }
+            }
+            const u32 typeIndex = GetTypeIndex(classData);
+            EnsureLayout(typeIndex);
+
+            auto insertResult = m_writtenObjects.insert_key(object);
+            if (!insertResult.second && insertResult.first->second.TypeIndex == typeIndex)
+            {
+                *At<ObjectRef>(slotOffset) = insertResult.first->second;
+                return;
+            }
+
+            // registered before writing, so cycles end up pointing at the slot being written
+            const u64 objectOffset = Allocate(m_types[typeIndex].SlotSize, m_types[typeIndex].SlotAlignment);
+            const ObjectRef objectRef = { objectOffset, typeIndex, 0 };
+            insertResult.first->second = objectRef;
+            *At<ObjectRef>(slotOffset) = objectRef;
+            WriteSlot(objectOffset, object, typeIndex);
+        }
+
+        //=========================================================================
+        // WriteArray
+        //=========================================================================
+        void SnapshotWriterImpl::WriteArray(u64 slotOffset, const void* containerPtr, u32 typeIndex)
+        {
+            void* instance = const_cast<void*>(containerPtr);
+            SerializeContext::IDataContainer* container = m_types[typeIndex].ClassDataPtr->ContainerPtr;
+            const Slot elementSlot = m_types[typeIndex].ElementSlot;
+            const size_t count = container->Size(instance);
+            if (count == 0 || elementSlot.TypeIndex == InvalidIndex)
+            {
+                return;
+            }
+            if (!elementSlot.IsPointer)
+            {
+                EnsureLayout(elementSlot.TypeIndex);
+            }
+            const bool isRawElement = !elementSlot.IsPointer && m_types[elementSlot.TypeIndex].TypeKind == Kind::Raw;
+
+            const u64 stride = GetSlotSize(elementSlot);
+            const u64 elementsOffset = Allocate(stride * count, GetSlotAlignment(elementSlot));
+            *At<ArrayRef>(slotOffset) = { elementsOffset, count };
+
+            if (isRawElement && container->CanAccessElementsByIndex())
+            {
+                // contiguous POD storage goes in with a single copy
+                const ClassElement* element = m_types[typeIndex].Element;
+                const char* first = reinterpret_cast<const char*>(container->GetElementByIndex(instance, element, 0));
+                const char* last = reinterpret_cast<const char*>(container->GetElementByIndex(instance, element, count - 1));
+                if (first && last && static_cast<u64>(last - first) == (count - 1) * stride)
+                {
+                    memcpy(At<char>(elementsOffset), first, static_cast<size_t>(count * stride));
+                    return;
+                }
+            }
+
+            size_t index = 0;
+            container->EnumElements(instance, [&](void* elementPtr, const Uuid&, const ClassData*, const ClassElement* element)
+            {
+                if (index == count)
+                {
+                    return false;
+                }
+                WriteValue(elementsOffset + index * stride, elementPtr, elementSlot, element);
+                ++index;
+                return true;
+            });
+        }
+
+        //=========================================================================
+        // WriteTypeTable
+        //=========================================================================
+        void SnapshotWriterImpl::WriteTypeTable()
+        {
+            // types that were only referenced by null pointers or empty arrays still get a complete entry
+            for (u32 typeIndex = 0; typeIndex < m_types.size(); ++typeIndex)
+            {
+                EnsureLayout(typeIndex);
+            }
+
+            VStd::vector<u64> nameOffsets;
+            nameOffsets.reserve(m_types.size());
+            size_t fieldCount = 0;
+            for (const TypeLayout& layout : m_types)
+            {
+                const char* name = layout.ClassDataPtr->Name ? layout.ClassDataPtr->Name : "";
+                nameOffsets.push_back(WriteBytes(name, strlen(name), true));
+                fieldCount += layout.Fields.size();
+            }
+
+            const u64 typesOffset = Allocate(sizeof(TypeRecord) * m_types.size(), alignof(TypeRecord));
+            const u64 fieldsOffset = Allocate(sizeof(FieldRecord) * fieldCount, alignof(FieldRecord));
+
+            u32 firstField = 0;
+            for (size_t typeIndex = 0; typeIndex < m_types.size(); ++typeIndex)
+            {
+                const TypeLayout& layout = m_types[typeIndex];
+                TypeRecord* record = At<TypeRecord>(typesOffset) + typeIndex;
+                memcpy(record->TypeId, layout.ClassDataPtr->TypeId.data, sizeof(record->TypeId));
+                record->NameOffset = nameOffsets[typeIndex];
+                record->SlotSize = layout.SlotSize;
+                record->SlotAlignment = layout.SlotAlignment;
+                record->Version = layout.ClassDataPtr->Version;
+                record->FirstField = firstField;
+                record->FieldCount = static_cast<u32>(layout.Fields.size());
+                record->ElementTypeIndex = layout.ElementSlot.TypeIndex;
+                record->TypeKind = layout.TypeKind;
+                record->IsElementPointer = layout.ElementSlot.IsPointer ? 1 : 0;
+
+                for (const Field& field : layout.Fields)
+                {
+                    FieldRecord* fieldRecord = At<FieldRecord>(fieldsOffset) + firstField++;
+                    fieldRecord->NameCrc = field.Element->NameCrc;
+                    fieldRecord->Offset = field.Offset;
+                    fieldRecord->TypeIndex = field.FieldSlot.TypeIndex;
+                    fieldRecord->IsPointer = field.FieldSlot.IsPointer ? 1 : 0;
+                    fieldRecord->IsBaseClass = (field.Element->Flags & ClassElement::FLG_BASE_CLASS) ? 1 : 0;
+                }
+            }
+
+            Header* header = At<Header>(0);
+            header->TypesOffset = typesOffset;
+            header->FieldsOffset = fieldsOffset;
+            header->TypeCount = static_cast<u32>(m_types.size());
+            header->FieldCount = static_cast<u32>(fieldCount);
+        }
+    } // namespace SnapshotInternal
+
+    //=========================================================================
+    // WriteImage
+    //=========================================================================
+    bool SnapshotWriter::WriteImage(VStd::vector<char>& image, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        V_Assert(object, "SnapshotWriter::WriteImage - Attempt to save a nullptr.");
+        if (!object)
+        {
+            return false;
+        }
+
+        ErrorHandler defaultErrorHandler;
+        SnapshotInternal::SnapshotWriterImpl writer(image, sc, errorHandler ? errorHandler : &defaultErrorHandler);
+        return writer.Write(object, classId);
+    }
+
+    //=========================================================================
+    // SaveObject
+    //=========================================================================
+    bool SnapshotWriter::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler)
+    {
+        VStd::vector<char> image;
+        if (!WriteImage(image, sc, object, classId, errorHandler))
+        {
+            return false;
+        }
+        return stream.Write(image.size(), image.data()) == image.size();
+    }
+} // namespace V
@@ -0,0 +1,44 @@
+#ifndef V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_WRITER_H
+#define V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_WRITER_H
+
+#include <vcore/serialization/serialization_context.h>
+#include <vcore/serialization/snapshot_format.h>
+#include <vcore/std/containers/vector.h>
+
+namespace V
+{
+    namespace IO
+    {
+        class GenericStream;
+    }
+
+    /**
+     * Writes reflected objects as relocatable snapshot images, see SnapshotFormat for the layout.
+     *
+     * The record layout of each type is derived from its ClassData. Objects reached through several pointers are
+     * stored once, so shared data and pointer cycles are preserved. Types without a fixed set of element types
+     * (VStd::any) and the data of DynamicSerializableField can't be laid out and are reported as warnings.
+     */
+    class SnapshotWriter
+    {
+    public:
+        using ErrorHandler = SerializeContext::ErrorHandler;
+
+        template<class T>
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler = nullptr);
+        static bool SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+
+        /// Builds the image in memory, replacing the content of image.
+        static bool WriteImage(VStd::vector<char>& image, const SerializeContext& sc, const void* object, const Uuid& classId, ErrorHandler* errorHandler = nullptr);
+    };
+
+    template<class T>
+    bool SnapshotWriter::SaveObject(IO::GenericStream& stream, const SerializeContext& sc, const T* object, ErrorHandler* errorHandler)
+    {
+        const void* classPtr = SerializeTypeInfo<T>::RttiCast(object, SerializeTypeInfo<T>::GetRttiTypeId(object));
+        const Uuid& classId = SerializeTypeInfo<T>::GetUuid(object);
+        return SaveObject(stream, sc, classPtr, classId, errorHandler);
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_SERIALIZATION_SNAPSHOT_WRITER_H
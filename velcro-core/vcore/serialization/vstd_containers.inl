@@ -7,7 +7,7 @@
 #include <vcore/std/smart_ptr/unique_ptr.h>
 #include <vcore/std/tuple.h>
 
-#include <vcore/IO/generic_streams.h>
+#include <vcore/io/generic_streams.h>
 
 namespace VStd
 {
@@ -150,16 +150,16 @@ namespace V
 
             VStdBasicContainer()
             {
-                m_classElement.m_name = GetDefaultElementName();
-                m_classElement.m_nameCrc = GetDefaultElementNameCrc();
-                m_classElement.m_offset = 0xbad0ffe0; // bad offset mark
+                m_classElement.Name = GetDefaultElementName();
+                m_classElement.NameCrc = GetDefaultElementNameCrc();
+                m_classElement.Offset = 0xbad0ffe0; // bad offset mark
                 SetupClassElementFromType<ValueType>(m_classElement);
             }
 
             /// Returns the element generic (offsets are mostly invalid 0xbad0ffe0, there are exceptions). Null if element with this name can't be found.
             const SerializeContext::ClassElement* GetElement(u32 elementNameCrc) const override
             {
-                if (elementNameCrc == m_classElement.m_nameCrc)
+                if (elementNameCrc == m_classElement.NameCrc)
                 {
                     return &m_classElement;
                 }
@@ -168,7 +168,7 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                if (dataElement.m_nameCrc == m_classElement.m_nameCrc)
+                if (dataElement.NameCrc == m_classElement.NameCrc)
                 {
                     classElement = m_classElement;
                     return true;
@@ -186,7 +186,7 @@ namespace V
                 for (; it != end; ++it)
                 {
                     ValueType* valuePtr = &*it;
-                    if (!cb(valuePtr, m_classElement.m_typeId, m_classElement.m_genericClassInfo ? m_classElement.m_genericClassInfo->GetClassData() : nullptr, &m_classElement))
+                    if (!cb(valuePtr, m_classElement.TypeId, m_classElement.GenericClassInfoPtr ? m_classElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_classElement))
                     {
                         break;
                     }
@@ -195,7 +195,7 @@ namespace V
 
             void EnumTypes(const ElementTypeCB& cb) override
             {
-                cb(m_classElement.m_typeId, &m_classElement);
+                cb(m_classElement.TypeId, &m_classElement);
             }
 
             /// Return number of elements in the container.
@@ -294,7 +294,7 @@ namespace V
                     {
                         if (elements[i - 1] >= elements[i])
                         {
-                            AZ_TracePrintf("Serialization", "RemoveElements for VStd::vector will perform optimally when the elements (addresses) are sorted in accending order!");
+                            V_TracePrintf("Serialization", "RemoveElements for VStd::vector will perform optimally when the elements (addresses) are sorted in accending order!");
                             numElements = i;
                         }
                     }
@@ -355,6 +355,13 @@ namespace V
                 }
                 return nullptr;
             }
+
+            /// Resize to count default constructed elements.
+            bool ResizeElements(void* instance, size_t count) override
+            {
+                reinterpret_cast<T*>(instance)->resize(count);
+                return true;
+            }
         };
         template<class T, bool IsStableIterators, size_t N>
         class VStdFixedCapacityRandomAccessContainer
@@ -386,6 +393,17 @@ namespace V
                 }
                 return nullptr;
             }
+
+            /// Resize to count default constructed elements, fails if count exceeds the capacity.
+            bool    ResizeElements(void* instance, size_t count) override
+            {
+                if (count > N)
+                {
+                    return false;
+                }
+                reinterpret_cast<T*>(instance)->resize(count);
+                return true;
+            }
         };
 
         class VStdArrayEvents : public SerializeContext::IEventHandler
@@ -417,16 +435,16 @@ namespace V
 
             VStdArrayContainer()
             {
-                m_classElement.m_name = GetDefaultElementName();
-                m_classElement.m_nameCrc = GetDefaultElementNameCrc();
-                m_classElement.m_offset = 0xbad0ffe0; // bad offset mark
+                m_classElement.Name = GetDefaultElementName();
+                m_classElement.NameCrc = GetDefaultElementNameCrc();
+                m_classElement.Offset = 0xbad0ffe0; // bad offset mark
                 SetupClassElementFromType<ValueType>(m_classElement);
             }
 
             /// Returns the element generic (offsets are mostly invalid 0xbad0ffe0, there are exceptions). Null if element with this name can't be found.
             const SerializeContext::ClassElement* GetElement(u32 elementNameCrc) const override
             {
-                if (elementNameCrc == m_classElement.m_nameCrc)
+                if (elementNameCrc == m_classElement.NameCrc)
                 {
                     return &m_classElement;
                 }
@@ -435,7 +453,7 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                if (dataElement.m_nameCrc == m_classElement.m_nameCrc)
+                if (dataElement.NameCrc == m_classElement.NameCrc)
                 {
                     classElement = m_classElement;
                     return true;
@@ -454,7 +472,7 @@ namespace V
                 {
                     ValueType* valuePtr = &*it;
 
-                    if (!cb(valuePtr, m_classElement.m_typeId, m_classElement.m_genericClassInfo ? m_classElement.m_genericClassInfo->GetClassData() : nullptr, &m_classElement))
+                    if (!cb(valuePtr, m_classElement.TypeId, m_classElement.GenericClassInfoPtr ? m_classElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_classElement))
                     {
                         break;
                     }
@@ -463,7 +481,7 @@ namespace V
 
             void EnumTypes(const ElementTypeCB& cb) override
             {
-                cb(m_classElement.m_typeId, &m_classElement);
+                cb(m_classElement.TypeId, &m_classElement);
             }
 
             /// Return number of elements in the container.
@@ -501,13 +519,13 @@ namespace V
             {
                 (void)classElement;
                 GenericClassInfo* containerClassInfo = SerializeGenericTypeInfo<ContainerType>::GetGenericInfo();
-                const bool eventHandlerAvailable = containerClassInfo && containerClassInfo->GetClassData() && containerClassInfo->GetClassData()->m_eventHandler;
+                const bool eventHandlerAvailable = containerClassInfo && containerClassInfo->GetClassData() && containerClassInfo->GetClassData()->EventHandlerPtr;
                 if (!eventHandlerAvailable)
                 {
                     return nullptr;
                 }
 
-                VStdArrayEvents* eventHandler = reinterpret_cast<VStdArrayEvents*>(containerClassInfo->GetClassData()->m_eventHandler);
+                VStdArrayEvents* eventHandler = reinterpret_cast<VStdArrayEvents*>(containerClassInfo->GetClassData()->EventHandlerPtr);
                 size_t index = eventHandler->GetIndex();
                 ContainerType* arrayPtr = reinterpret_cast<ContainerType*>(instance);
                 if (index < N)
@@ -517,7 +535,7 @@ namespace V
                 }
                 else
                 {
-                    AZ_Warning("Serialization", false, "Unable to reserve an element for VStd::array because all %i slots are in use.", N);
+                    V_Warning("Serialization", false, "Unable to reserve an element for VStd::array because all %i slots are in use.", N);
                 }
                 return nullptr;
             }
@@ -553,7 +571,7 @@ namespace V
                 ptrdiff_t arrayIndex = reinterpret_cast<const ValueType*>(element) - arrayPtr->data();
                 if (arrayIndex < 0 || arrayIndex >= static_cast<ptrdiff_t>(arrayPtr->size()))
                 {
-                    AZ_Error("Serialization", false, "Supplied element to remove memory address of 0x%p falls outside of address of VStd::array range of [0x%p, 0x%p]",
+                    V_Error("Serialization", false, "Supplied element to remove memory address of 0x%p falls outside of address of VStd::array range of [0x%p, 0x%p]",
                         element, arrayPtr->data(), arrayPtr->data() + arrayPtr->size());
                     return false;
                 }
@@ -565,10 +583,10 @@ namespace V
                 
                 // If the element that's removed is the last added element, decrement the insertion counter.
                 GenericClassInfo* containerClassInfo = SerializeGenericTypeInfo<ContainerType>::GetGenericInfo();
-                const bool eventHandlerAvailable = containerClassInfo && containerClassInfo->GetClassData() && containerClassInfo->GetClassData()->m_eventHandler;
+                const bool eventHandlerAvailable = containerClassInfo && containerClassInfo->GetClassData() && containerClassInfo->GetClassData()->EventHandlerPtr;
                 if (eventHandlerAvailable)
                 {
-                    VStdArrayEvents* eventHandler = reinterpret_cast<VStdArrayEvents*>(containerClassInfo->GetClassData()->m_eventHandler);
+                    VStdArrayEvents* eventHandler = reinterpret_cast<VStdArrayEvents*>(containerClassInfo->GetClassData()->EventHandlerPtr);
                     if (static_cast<ptrdiff_t>(eventHandler->GetIndex()) == arrayIndex + 1)
                     {
                         eventHandler->Decrement();
@@ -631,13 +649,13 @@ namespace V
         public:
             VStdAssociativeContainer()
             {
-                m_classElement.m_name = GetDefaultElementName();
-                m_classElement.m_nameCrc = GetDefaultElementNameCrc();
-                m_classElement.m_offset = 0xbad0ffe0; // bad offset mark
+                m_classElement.Name = GetDefaultElementName();
+                m_classElement.NameCrc = GetDefaultElementNameCrc();
+                m_classElement.Offset = 0xbad0ffe0; // bad offset mark
                 SetupClassElementFromType<ValueType>(m_classElement);
                 // Associative containers usually do a hash insert, default value will cause a collision.
                 // If we want we can check for multi_set, multi_map, but that may be too much for now.
-                m_classElement.m_flags |= SerializeContext::ClassElement::FLG_NO_DEFAULT_VALUE;
+                m_classElement.Flags |= SerializeContext::ClassElement::FLG_NO_DEFAULT_VALUE;
 
                 // Register our key type within an lvalue to rvalue wrapper as an attribute
                 V::TypeId uuid = vobject_rtti_typeid<WrappedKeyType>();
@@ -667,7 +685,7 @@ namespace V
             /// Returns the element generic (offsets are mostly invalid 0xbad0ffe0, there are exceptions). Null if element with this name can't be found.
             const SerializeContext::ClassElement* GetElement(u32 elementNameCrc) const override
             {
-                if (elementNameCrc == m_classElement.m_nameCrc)
+                if (elementNameCrc == m_classElement.NameCrc)
                 {
                     return &m_classElement;
                 }
@@ -676,7 +694,7 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                if (dataElement.m_nameCrc == m_classElement.m_nameCrc)
+                if (dataElement.NameCrc == m_classElement.NameCrc)
                 {
                     classElement = m_classElement;
                     return true;
@@ -694,7 +712,7 @@ namespace V
                 for (; it != end; ++it)
                 {
                     ValueType* valuePtr = &*it;
-                    if (!cb(valuePtr, m_classElement.m_typeId, m_classElement.m_genericClassInfo ? m_classElement.m_genericClassInfo->GetClassData() : nullptr, &m_classElement))
+                    if (!cb(valuePtr, m_classElement.TypeId, m_classElement.GenericClassInfoPtr ? m_classElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_classElement))
                     {
                         break;
                     }
@@ -703,7 +721,7 @@ namespace V
 
             void EnumTypes(const ElementTypeCB& cb) override
             {
-                cb(m_classElement.m_typeId, &m_classElement);
+                cb(m_classElement.TypeId, &m_classElement);
             }
 
             /// Return number of elements in the container.
@@ -895,25 +913,25 @@ namespace V
             VStdPairContainer()
             {
                 // FIXME: We should properly fill in all the other fields as well.
-                m_value1ClassElement.m_name = "value1";
-                m_value1ClassElement.m_nameCrc = V_CRC("value1", 0xa2756c5a);
-                m_value1ClassElement.m_offset = 0;
+                m_value1ClassElement.Name = "value1";
+                m_value1ClassElement.NameCrc = V_CRC("value1", 0xa2756c5a);
+                m_value1ClassElement.Offset = 0;
                 SetupClassElementFromType<T1>(m_value1ClassElement);
 
-                m_value2ClassElement.m_name = "value2";
-                m_value2ClassElement.m_nameCrc = V_CRC("value2", 0x3b7c3de0);
-                m_value2ClassElement.m_offset = sizeof(T1);
+                m_value2ClassElement.Name = "value2";
+                m_value2ClassElement.NameCrc = V_CRC("value2", 0x3b7c3de0);
+                m_value2ClassElement.Offset = sizeof(T1);
                 SetupClassElementFromType<T2>(m_value2ClassElement);
             }
 
             /// Returns the element generic (offsets are mostly invalid 0xbad0ffe0, there are exceptions). Null if element with this name can't be found.
             const SerializeContext::ClassElement* GetElement(u32 elementNameCrc) const override
             {
-                if (elementNameCrc == m_value1ClassElement.m_nameCrc)
+                if (elementNameCrc == m_value1ClassElement.NameCrc)
                 {
                     return &m_value1ClassElement;
                 }
-                if (elementNameCrc == m_value2ClassElement.m_nameCrc)
+                if (elementNameCrc == m_value2ClassElement.NameCrc)
                 {
                     return &m_value2ClassElement;
                 }
@@ -922,12 +940,12 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                if (dataElement.m_nameCrc == m_value1ClassElement.m_nameCrc)
+                if (dataElement.NameCrc == m_value1ClassElement.NameCrc)
                 {
                     classElement = m_value1ClassElement;
                     return true;
                 }
-                else if (dataElement.m_nameCrc == m_value2ClassElement.m_nameCrc)
+                else if (dataElement.NameCrc == m_value2ClassElement.NameCrc)
                 {
                     classElement = m_value2ClassElement;
                     return true;
@@ -943,16 +961,16 @@ namespace V
                 T1* value1Ptr = &pairPtr->first;
                 T2* value2Ptr = &pairPtr->second;
 
-                if (cb(value1Ptr, m_value1ClassElement.m_typeId, m_value1ClassElement.m_genericClassInfo ? m_value1ClassElement.m_genericClassInfo->GetClassData() : nullptr, &m_value1ClassElement))
+                if (cb(value1Ptr, m_value1ClassElement.TypeId, m_value1ClassElement.GenericClassInfoPtr ? m_value1ClassElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_value1ClassElement))
                 {
-                    cb(value2Ptr, m_value2ClassElement.m_typeId, m_value2ClassElement.m_genericClassInfo ? m_value2ClassElement.m_genericClassInfo->GetClassData() : nullptr, &m_value2ClassElement);
+                    cb(value2Ptr, m_value2ClassElement.TypeId, m_value2ClassElement.GenericClassInfoPtr ? m_value2ClassElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_value2ClassElement);
                 }
             }
 
             void EnumTypes(const ElementTypeCB& cb) override
             {
-                cb(m_value1ClassElement.m_typeId, &m_value1ClassElement);
-                cb(m_value2ClassElement.m_typeId, &m_value2ClassElement);
+                cb(m_value1ClassElement.TypeId, &m_value1ClassElement);
+                cb(m_value2ClassElement.TypeId, &m_value2ClassElement);
             }
 
             /// Return number of elements in the container.
@@ -989,11 +1007,11 @@ namespace V
             void*   ReserveElement(void* instance, const SerializeContext::ClassElement* classElement) override
             {
                 PairType* pairPtr = reinterpret_cast<PairType*>(instance);
-                if (classElement->m_nameCrc == m_value1ClassElement.m_nameCrc)
+                if (classElement->NameCrc == m_value1ClassElement.NameCrc)
                 {
                     return &pairPtr->first;
                 }
-                if (classElement->m_nameCrc == m_value2ClassElement.m_nameCrc)
+                if (classElement->NameCrc == m_value2ClassElement.NameCrc)
                 {
                     return &pairPtr->second;
                 }
@@ -1122,7 +1140,7 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                return GetElementTuple(classElement, dataElement.m_nameCrc, VStd::make_index_sequence<s_tupleSize>{});
+                return GetElementTuple(classElement, dataElement.NameCrc, VStd::make_index_sequence<s_tupleSize>{});
             }
 
             /// Enumerate elements in the array
@@ -1298,7 +1316,7 @@ namespace V
                 template<size_t Index>
                 bool ReserveElementTuple(TupleType& tupleRef, const SerializeContext::ClassElement* classElement, void*& reserveElement)
                 {
-                    if (!reserveElement && m_valueClassElements[Index].m_nameCrc == classElement->m_nameCrc)
+                    if (!reserveElement && m_valueClassElements[Index].m_nameCrc == classElement->NameCrc)
                     {
                         reserveElement = &VStd::get<Index>(tupleRef);
                         return true;
@@ -1378,16 +1396,16 @@ namespace V
         public:
             VRValueContainer()
             {
-                m_valueClassElement.m_name = "value";
-                m_valueClassElement.m_nameCrc = V_CRC("value", 0x1d775834);
-                m_valueClassElement.m_offset = 0;
+                m_valueClassElement.Name = "value";
+                m_valueClassElement.NameCrc = V_CRC("value", 0x1d775834);
+                m_valueClassElement.Offset = 0;
                 SetupClassElementFromType<T>(m_valueClassElement);
             }
 
             /// Returns the element generic (offsets are mostly invalid 0xbad0ffe0, there are exceptions). Null if element with this name can't be found.
             const SerializeContext::ClassElement* GetElement(u32 elementNameCrc) const override
             {
-                if (elementNameCrc == m_valueClassElement.m_nameCrc)
+                if (elementNameCrc == m_valueClassElement.NameCrc)
                 {
                     return &m_valueClassElement;
                 }
@@ -1396,7 +1414,7 @@ namespace V
 
             bool GetElement(SerializeContext::ClassElement& classElement, const SerializeContext::DataElement& dataElement) const override
             {
-                if (dataElement.m_nameCrc == m_valueClassElement.m_nameCrc)
+                if (dataElement.NameCrc == m_valueClassElement.NameCrc)
                 {
                     classElement = m_valueClassElement;
                     return true;
@@ -1408,12 +1426,12 @@ namespace V
             void EnumElements(void* instance, const ElementCB& cb) override
             {
                 WrapperType* wrapperPtr = reinterpret_cast<WrapperType*>(instance);
-                cb(&wrapperPtr->m_data, m_valueClassElement.m_typeId, m_valueClassElement.m_genericClassInfo ? m_valueClassElement.m_genericClassInfo->GetClassData() : nullptr, &m_valueClassElement);
+                cb(&wrapperPtr->m_data, m_valueClassElement.TypeId, m_valueClassElement.GenericClassInfoPtr ? m_valueClassElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_valueClassElement);
             }
 
             void EnumTypes(const ElementTypeCB& cb) override
             {
-                cb(m_valueClassElement.m_typeId, &m_valueClassElement);
+                cb(m_valueClassElement.TypeId, &m_valueClassElement);
             }
 
             /// Return number of elements in the container.
@@ -1465,7 +1483,7 @@ namespace V
             void*   ReserveElement(void* instance, const SerializeContext::ClassElement* classElement) override
             {
                 WrapperType* wrapperPtr = reinterpret_cast<WrapperType*>(instance);
-                if (classElement->m_nameCrc == m_valueClassElement.m_nameCrc)
+                if (classElement->NameCrc == m_valueClassElement.NameCrc)
                 {
                     return &wrapperPtr->m_data;
                 }
@@ -1586,7 +1604,7 @@ namespace V
                 // HACK HACK HACK!!!
                 // We assume that the data pointer is at offset 0 inside the smart pointer!!!
                 typename T::element_type * *valuePtr = reinterpret_cast<typename T::element_type**>(smartPtr);
-                cb(valuePtr, m_classElement.TypeId, m_classElement.GenericClassInfoPtr ? m_classElement.m_genericClassInfo->GetClassData() : nullptr, &m_classElement);
+                cb(valuePtr, m_classElement.TypeId, m_classElement.GenericClassInfoPtr ? m_classElement.GenericClassInfoPtr->GetClassData() : nullptr, &m_classElement);
             }
 
             void EnumTypes(const ElementTypeCB& cb) override
@@ -2392,7 +2410,7 @@ namespace V
             GenericClassInfoArray()
                 : m_classData{ SerializeContext::ClassData::Create<ContainerType>("VStd::array", GetSpecializedTypeId(), Internal::NullFactory::GetInstance(), nullptr, &m_containerStorage) }
             {
-                m_classData.m_eventHandler = &m_eventHandler;
+                m_classData.EventHandlerPtr = &m_eventHandler;
             }
 
             SerializeContext::ClassData* GetClassData() override
@@ -2746,7 +2764,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             void Reflect(SerializeContext* serializeContext) override
@@ -3319,7 +3337,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             const Uuid& GetLegacySpecializedTypeId() const override
@@ -3348,7 +3366,7 @@ namespace V
 
         static const Uuid& GetClassTypeId()
         {
-            return GetGenericInfo()->GetClassData()->m_typeId;
+            return GetGenericInfo()->GetClassData()->TypeId;
         }
     };
 
@@ -3391,7 +3409,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             void Reflect(SerializeContext* serializeContext) override
@@ -3457,7 +3475,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             void Reflect(SerializeContext* serializeContext) override
@@ -3524,7 +3542,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             const Uuid& GetLegacySpecializedTypeId() const override
@@ -3605,7 +3623,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             const Uuid& GetLegacySpecializedTypeId() const override
@@ -3686,7 +3704,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             const Uuid& GetLegacySpecializedTypeId() const override
@@ -3767,7 +3785,7 @@ namespace V
 
             const Uuid& GetGenericTypeId() const override
             {
-                return TYPEINFO_Uuid();
+                return VOBJECT_Id();
             }
 
             void Reflect(SerializeContext* serializeContext) override
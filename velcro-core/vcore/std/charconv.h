@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) Contributors to the VelcroFramework.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#ifndef V_FRAMEWORK_CORE_STD_CHARCONV_H
+#define V_FRAMEWORK_CORE_STD_CHARCONV_H
+
+#include <vcore/std/base.h>
+#include <vcore/std/typetraits/conditional.h>
+#include <vcore/std/typetraits/is_integral.h>
+#include <vcore/std/typetraits/is_same.h>
+#include <vcore/std/typetraits/is_signed.h>
+#include <vcore/std/typetraits/is_unsigned.h>
+#include <vcore/std/typetraits/remove_cv.h>
+
+#include <stdint.h>
+#include <system_error>
+
+namespace VStd
+{
+    // C++17 <charconv>, locale independent and non allocating number conversions.
+    // Integers are formatted two digits at a time, floating point values are formatted with the shortest
+    // representation that reads back to the same value (Ryu), or exactly rounded to a precision, and parsed with the
+    // Eisel-Lemire algorithm.
+    using errc = std::errc;
+
+    enum class chars_format
+    {
+        scientific = 0x1,
+        fixed = 0x2,
+        hex = 0x4,
+        general = fixed | scientific
+    };
+
+    struct to_chars_result
+    {
+        char* ptr;
+        errc ec;
+
+        friend bool operator==(const to_chars_result& lhs, const to_chars_result& rhs) { return lhs.ptr == rhs.ptr && lhs.ec == rhs.ec; }
+        friend bool operator!=(const to_chars_result& lhs, const to_chars_result& rhs) { return !(lhs == rhs); }
+    };
+
+    struct from_chars_result
+    {
+        const char* ptr;
+        errc ec;
+
+        friend bool operator==(const from_chars_result& lhs, const from_chars_result& rhs) { return lhs.ptr == rhs.ptr && lhs.ec == rhs.ec; }
+        friend bool operator!=(const from_chars_result& lhs, const from_chars_result& rhs) { return !(lhs == rhs); }
+    };
+
+    namespace Internal
+    {
+        inline constexpr char charconv_digit_pairs[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        inline constexpr char charconv_digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+        template<class T>
+        inline constexpr bool is_charconv_integer_v = is_integral_v<T> && !is_same_v<remove_cv_t<T>, bool>;
+
+        template<class UInt>
+        constexpr int charconv_count_digits(UInt value)
+        {
+            int count = 1;
+            for (;;)
+            {
+                if (value < 10u)
+                {
+                    return count;
+                }
+                if (value < 100u)
+                {
+                    return count + 1;
+                }
+                if (value < 1000u)
+                {
+                    return count + 2;
+                }
+                if (value < 10000u)
+                {
+                    return count + 3;
+                }
+                value /= 10000u;
+                count += 4;
+            }
+        }
+
+        /// Writes the decimal digits of value so they end right before end.
+        template<class UInt>
+        inline void charconv_write_decimal(char* end, UInt value)
+        {
+            while (value >= 100u)
+            {
+                const unsigned int pair = static_cast<unsigned int>(value % 100u) * 2;
+                value /= 100u;
+                *--end = charconv_digit_pairs[pair + 1];
+                *--end = charconv_digit_pairs[pair];
+            }
+            if (value >= 10u)
+            {
+                const unsigned int pair = static_cast<unsigned int>(value) * 2;
+                *--end = charconv_digit_pairs[pair + 1];
+                *--end = charconv_digit_pairs[pair];
+            }
+            else
+            {
+                *--end = static_cast<char>('0' + value);
+            }
+        }
+
+        template<class UInt>
+        inline to_chars_result charconv_to_chars_unsigned(char* first, char* last, UInt value, int base)
+        {
+            if (base == 10)
+            {
+                const int numDigits = charconv_count_digits(value);
+                if (last - first < numDigits)
+                {
+                    return { last, errc::value_too_large };
+                }
+                charconv_write_decimal(first + numDigits, value);
+                return { first + numDigits, errc{} };
+            }
+
+            char buffer[sizeof(UInt) * 8];
+            char* begin = buffer + sizeof(buffer);
+            do
+            {
+                *--begin = charconv_digits[value % static_cast<unsigned int>(base)];
+                value /= static_cast<unsigned int>(base);
+            } while (value);
+
+            const ptrdiff_t numDigits = buffer + sizeof(buffer) - begin;
+            if (last - first < numDigits)
+            {
+                return { last, errc::value_too_large };
+            }
+            for (; begin != buffer + sizeof(buffer); ++begin)
+            {
+                *first++ = *begin;
+            }
+            return { first, errc{} };
+        }
+
+        /// Value of a digit in bases up to 36, or 255.
+        constexpr unsigned int charconv_digit_value(char c)
+        {
+            const unsigned int digit = static_cast<unsigned char>(c) - static_cast<unsigned int>('0');
+            if (digit < 10)
+            {
+                return digit;
+            }
+            const unsigned int letter = (static_cast<unsigned char>(c) | 0x20u) - static_cast<unsigned int>('a');
+            return letter < 26 ? letter + 10 : 255;
+        }
+
+        template<class UInt>
+        inline from_chars_result charconv_from_chars_unsigned(const char* first, const char* last, UInt& value, int base)
+        {
+            const UInt maxValue = static_cast<UInt>(-1);
+            const UInt maxQuotient = maxValue / static_cast<UInt>(base);
+            const unsigned int maxRemainder = static_cast<unsigned int>(maxValue % static_cast<UInt>(base));
+
+            UInt result = 0;
+            bool overflow = false;
+            const char* current = first;
+            for (; current != last; ++current)
+            {
+                const unsigned int digit = base == 10
+                    ? static_cast<unsigned char>(*current) - static_cast<unsigned int>('0')
+                    : charconv_digit_value(*current);
+                if (digit >= static_cast<unsigned int>(base))
+                {
+                    break;
+                }
+                if (result < maxQuotient || (result == maxQuotient && digit <= maxRemainder))
+                {
+                    result = static_cast<UInt>(result * static_cast<UInt>(base) + digit);
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+
+            if (current == first)
+            {
+                return { first, errc::invalid_argument };
+            }
+            if (overflow)
+            {
+                return { current, errc::result_out_of_range };
+            }
+            value = result;
+            return { current, errc{} };
+        }
+    } // namespace Internal
+
+    //! Formats an integer in base 2 to 36, lower case letters for digits above 9.
+    //! Returns value_too_large and last when the range is too small.
+    template<class Integer, class = enable_if_t<Internal::is_charconv_integer_v<Integer>>>
+    inline to_chars_result to_chars(char* first, char* last, Integer value, int base = 10)
+    {
+        using UInt = make_unsigned_t<Integer>;
+        using Wide = conditional_t<(sizeof(UInt) <= sizeof(uint32_t)), uint32_t, uint64_t>;
+
+        Wide magnitude = static_cast<UInt>(value);
+        if constexpr (is_signed_v<Integer>)
+        {
+            if (value < 0)
+            {
+                if (first == last)
+                {
+                    return { last, errc::value_too_large };
+                }
+                *first++ = '-';
+                magnitude = static_cast<UInt>(UInt(0) - static_cast<UInt>(value));
+            }
+        }
+        return Internal::charconv_to_chars_unsigned(first, last, magnitude, base);
+    }
+
+    to_chars_result to_chars(char* first, char* last, bool value, int base = 10) = delete;
+
+    //! Shortest representation that from_chars reads back to the same value, in fixed or scientific notation,
+    //! whichever is shorter (fixed on a tie).
+    to_chars_result to_chars(char* first, char* last, float value);
+    to_chars_result to_chars(char* first, char* last, double value);
+    //! Shortest representation in the given format. general uses fixed notation for exponents in [-4, 6) like %g,
+    //! hex doesn't write the 0x prefix.
+    to_chars_result to_chars(char* first, char* last, float value, chars_format format);
+    to_chars_result to_chars(char* first, char* last, double value, chars_format format);
+    //! Correctly rounded to precision like printf: digits after the decimal point for fixed (%f) and scientific (%e),
+    //! significant digits for general (%g, without trailing zeros) and hex digits for hex (%a, no 0x prefix).
+    //! A negative precision means 6, or the shortest exact digits for hex.
+    to_chars_result to_chars(char* first, char* last, float value, chars_format format, int precision);
+    to_chars_result to_chars(char* first, char* last, double value, chars_format format, int precision);
+
+    //! Parses an integer in base 2 to 36. Accepts a '-' sign for signed types only, no white space, '+' or base prefixes.
+    //! Returns invalid_argument if there are no digits and result_out_of_range if the value doesn't fit,
+    //! value is only written on success.
+    template<class Integer, class = enable_if_t<Internal::is_charconv_integer_v<Integer>>>
+    inline from_chars_result from_chars(const char* first, const char* last, Integer& value, int base = 10)
+    {
+        using UInt = make_unsigned_t<Integer>;
+
+        if constexpr (is_signed_v<Integer>)
+        {
+            const bool isNegative = first != last && *first == '-';
+            UInt magnitude = 0;
+            from_chars_result result = Internal::charconv_from_chars_unsigned(first + isNegative, last, magnitude, base);
+            if (result.ec == errc::invalid_argument)
+            {
+                return { first, errc::invalid_argument };
+            }
+            if (result.ec == errc{})
+            {
+                const UInt maxMagnitude = static_cast<UInt>(static_cast<UInt>(-1) >> 1) + isNegative;
+                if (magnitude > maxMagnitude)
+                {
+                    result.ec = errc::result_out_of_range;
+                }
+                else
+                {
+                    value = static_cast<Integer>(isNegative ? static_cast<UInt>(UInt(0) - magnitude) : magnitude);
+                }
+            }
+            return result;
+        }
+        else
+        {
+            return Internal::charconv_from_chars_unsigned(first, last, value, base);
+        }
+    }
+
+    //! Parses a floating point number like strtod in the "C" locale, without leading white space, '+' or 0x prefix.
+    //! fixed doesn't accept an exponent, scientific requires one and hex reads hex digits with an optional p exponent.
+    //! Values that overflow or underflow to zero return result_out_of_range, value is only written on success.
+    from_chars_result from_chars(const char* first, const char* last, float& value, chars_format format = chars_format::general);
+    from_chars_result from_chars(const char* first, const char* last, double& value, chars_format format = chars_format::general);
+} // namespace VStd
+
+#endif // V_FRAMEWORK_CORE_STD_CHARCONV_H
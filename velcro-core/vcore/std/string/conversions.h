@@ -8,6 +8,7 @@
 #ifndef V_FRAMEWORK_CORE_STD_STRING_CONVERSIONS_H
 #define V_FRAMEWORK_CORE_STD_STRING_CONVERSIONS_H
 
+#include <vcore/std/charconv.h>
 #include <vcore/std/string/string.h>
 #include <vcore/std/string/fixed_string.h>
 
@@ -16,6 +17,7 @@
 
 //////////////////////////////////////////////////////////////////////////
 // utf8 cpp lib
+#include <vcore/std/string/utf8/transcode.h>
 #include <vcore/std/string/utf8/unchecked.h>
 //////////////////////////////////////////////////////////////////////////
 
@@ -34,102 +36,191 @@ namespace VStd
         {
             static_assert(Size == size_t{ 2 } || Size == size_t{ 4 }, "only wchar_t types of size 2 or 4 can be converted to utf8");
 
-            template<class Allocator>
-            static inline void to_string(VStd::basic_string<string::value_type, string::traits_type, Allocator>& dest, VStd::wstring_view src)
+            using utf_char_type = VStd::conditional_t<Size == 2, char16_t, char32_t>;
+
+            static inline const utf_char_type* as_utf(const wchar_t* str)
+            {
+                return reinterpret_cast<const utf_char_type*>(str);
+            }
+
+            static inline utf_char_type* as_utf(wchar_t* str)
+            {
+                return reinterpret_cast<utf_char_type*>(str);
+            }
+
+            static inline size_t convert_to_utf8(VStd::wstring_view src, char* dest, size_t destSize)
             {
                 if constexpr (Size == 2)
                 {
-                    Utf8::Unchecked::utf16to8(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
+                    return Utf8::convert_utf16_to_utf8(as_utf(src.data()), src.size(), dest, destSize);
                 }
-                else if constexpr (Size == 4)
+                else
                 {
-                    Utf8::Unchecked::utf32to8(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
+                    return Utf8::convert_utf32_to_utf8(as_utf(src.data()), src.size(), dest, destSize);
                 }
             }
 
-            template<size_t MaxElementCount>
-            static inline void to_string(VStd::basic_fixed_string<string::value_type, MaxElementCount, string::traits_type>& dest, VStd::wstring_view src)
+            static inline size_t convert_from_utf8(VStd::string_view src, wchar_t* dest, size_t destSize)
             {
                 if constexpr (Size == 2)
                 {
-                    Utf8::Unchecked::utf16to8(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
+                    return Utf8::convert_utf8_to_utf16(src.data(), src.size(), as_utf(dest), destSize);
                 }
-                else if constexpr (Size == 4)
+                else
                 {
-                    Utf8::Unchecked::utf32to8(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
+                    return Utf8::convert_utf8_to_utf32(src.data(), src.size(), as_utf(dest), destSize);
                 }
             }
 
-            static inline char* to_string(char* dest, size_t destSize, VStd::wstring_view src)
+            static inline size_t to_wstring_length(VStd::string_view src)
             {
                 if constexpr (Size == 2)
                 {
-                    return Utf8::Unchecked::utf16to8(src.begin(), src.end(), dest, destSize);
+                    return Utf8::utf16_length_from_utf8(src.data(), src.size());
                 }
-                else if constexpr (Size == 4)
+                else
                 {
-                    return Utf8::Unchecked::utf32to8(src.begin(), src.end(), dest, destSize);
+                    return Utf8::utf32_length_from_utf8(src.data(), src.size());
                 }
             }
 
+            // The string forms append to dest, they size it for the whole conversion and trim it to what was written
+            template<class StringType>
+            static inline void append_utf8(StringType& dest, VStd::wstring_view src)
+            {
+                const size_t offset = dest.size();
+                const size_t length = VStd::min<size_t>(to_string_length(src), dest.max_size() - offset);
+                dest.resize_no_construct(offset + length);
+                dest.resize_no_construct(offset + convert_to_utf8(src, dest.data() + offset, length));
+            }
+
+            template<class StringType>
+            static inline void append_wide(StringType& dest, VStd::string_view src)
+            {
+                const size_t offset = dest.size();
+                const size_t length = VStd::min<size_t>(to_wstring_length(src), dest.max_size() - offset);
+                dest.resize_no_construct(offset + length);
+                dest.resize_no_construct(offset + convert_from_utf8(src, dest.data() + offset, length));
+            }
+
+            template<class Allocator>
+            static inline void to_string(VStd::basic_string<string::value_type, string::traits_type, Allocator>& dest, VStd::wstring_view src)
+            {
+                append_utf8(dest, src);
+            }
+
+            template<size_t MaxElementCount>
+            static inline void to_string(VStd::basic_fixed_string<string::value_type, MaxElementCount, string::traits_type>& dest, VStd::wstring_view src)
+            {
+                append_utf8(dest, src);
+            }
+
+            static inline char* to_string(char* dest, size_t destSize, VStd::wstring_view src)
+            {
+                return dest + convert_to_utf8(src, dest, destSize);
+            }
+
             static inline size_t to_string_length(VStd::wstring_view src)
             {
                 if constexpr (Size == 2)
                 {
-                    return Utf8::Unchecked::utf16ToUtf8BytesRequired(src.begin(), src.end());
+                    return Utf8::utf8_length_from_utf16(as_utf(src.data()), src.size());
                 }
-                else if constexpr (Size == 4)
+                else
                 {
-                    return Utf8::Unchecked::utf32ToUtf8BytesRequired(src.begin(), src.end());
+                    return Utf8::utf8_length_from_utf32(as_utf(src.data()), src.size());
                 }
             }
 
             template<class Allocator>
             static inline void to_wstring(VStd::basic_string<wstring::value_type, wstring::traits_type, Allocator>& dest, VStd::string_view src)
             {
-                if constexpr (Size == 2)
-                {
-                    Utf8::Unchecked::utf8to16(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
-                }
-                else if constexpr (Size == 4)
-                {
-                    Utf8::Unchecked::utf8to32(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
-                }
+                append_wide(dest, src);
             }
 
             template<size_t MaxElementCount>
             static inline void to_wstring(VStd::basic_fixed_string<wstring::value_type, MaxElementCount, wstring::traits_type>& dest, VStd::string_view src)
             {
-                if constexpr (Size == 2)
-                {
-                    Utf8::Unchecked::utf8to16(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
-                }
-                else if constexpr (Size == 4)
-                {
-                    Utf8::Unchecked::utf8to32(src.begin(), src.end(), VStd::back_inserter(dest), dest.max_size());
-                }
+                append_wide(dest, src);
             }
 
             static inline wchar_t* to_wstring(wchar_t* dest, size_t destSize, VStd::string_view src)
             {
-                if constexpr (Size == 2)
-                {
-                    return Utf8::Unchecked::utf8to16(src.begin(), src.end(), dest, destSize);
-                }
-                else if constexpr (Size == 4)
-                {
-                    return Utf8::Unchecked::utf8to32(src.begin(), src.end(), dest, destSize);
-                }
+                return dest + convert_from_utf8(src, dest, destSize);
             }
         };
     }
+    namespace Internal
+    {
+        /// Start of the text from_chars should see, after the white space and '+' sign strtol would skip.
+        inline const char* skip_number_prefix(const char* str)
+        {
+            while (isspace(static_cast<unsigned char>(*str)))
+            {
+                ++str;
+            }
+            if (str[0] == '+' && str[1] != '-')
+            {
+                ++str;
+            }
+            return str;
+        }
+
+        /// Base 10 through from_chars. Returns false for anything strtol should handle instead
+        /// (no digits, out of range, unsigned types with a '-' sign), so errors keep the C library behavior.
+        template<class Integer>
+        inline bool sto_from_chars(const char* str, VStd::size_t length, VStd::size_t* idx, int base, Integer& result)
+        {
+            if (base != 10)
+            {
+                return false;
+            }
+            const from_chars_result parsed = from_chars(skip_number_prefix(str), str + length, result);
+            if (parsed.ec != errc{})
+            {
+                return false;
+            }
+            if (idx)
+            {
+                *idx = parsed.ptr - str;
+            }
+            return true;
+        }
+
+        /// from_chars for decimal text, hex floats and errors are left to strtod.
+        template<class Float>
+        inline bool sto_from_chars(const char* str, VStd::size_t length, VStd::size_t* idx, Float& result)
+        {
+            const char* first = skip_number_prefix(str);
+            const char* digits = first + (*first == '-');
+            if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))
+            {
+                return false;
+            }
+            const from_chars_result parsed = from_chars(first, str + length, result);
+            if (parsed.ec != errc{})
+            {
+                return false;
+            }
+            if (idx)
+            {
+                *idx = parsed.ptr - str;
+            }
+            return true;
+        }
+    }
     // 21.5: numeric conversions
     template<class Allocator>
     int stoi(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, VStd::size_t* idx = 0, int base = 10)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        int result = (int)strtol(sChar, &ptr, base);
+        int result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, base, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = (int)strtol(sChar, &ptr, base);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -139,9 +230,14 @@ namespace VStd
     template<class Allocator>
     long stol(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, VStd::size_t* idx = 0, int base = 10)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        long result = strtol(sChar, &ptr, base);
+        long result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, base, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = strtol(sChar, &ptr, base);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -151,9 +247,14 @@ namespace VStd
     template<class Allocator>
     unsigned long stoul(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, VStd::size_t* idx = 0, int base = 10)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        unsigned long result = strtoul(sChar, &ptr, base);
+        unsigned long result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, base, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = strtoul(sChar, &ptr, base);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -163,9 +264,14 @@ namespace VStd
     template<class Allocator>
     long long stoll(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, size_t* idx = 0, int base = 10)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        long long result = strtoll(sChar, &ptr, base);
+        long long result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, base, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = strtoll(sChar, &ptr, base);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -175,9 +281,14 @@ namespace VStd
     template<class Allocator>
     unsigned long long stoull(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, size_t* idx = 0, int base = 10)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        unsigned long long result = strtoull(sChar, &ptr, base);
+        unsigned long long result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, base, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = strtoull(sChar, &ptr, base);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -188,9 +299,14 @@ namespace VStd
     template<class Allocator>
     float stof(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, VStd::size_t* idx = 0)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        float result = (float)strtod(sChar, &ptr);
+        float result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = (float)strtod(sChar, &ptr);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -200,9 +316,14 @@ namespace VStd
     template<class Allocator>
     double stod(const VStd::basic_string<VStd::string::value_type, VStd::string::traits_type, Allocator>& str, VStd::size_t* idx = 0)
     {
-        char* ptr;
         const char* sChar = str.c_str();
-        double result = strtod(sChar, &ptr);
+        double result;
+        if (Internal::sto_from_chars(sChar, str.size(), idx, result))
+        {
+            return result;
+        }
+        char* ptr;
+        result = strtod(sChar, &ptr);
         if (idx)
         {
             *idx = ptr - sChar;
@@ -227,57 +348,51 @@ namespace VStd
     void to_string(Str& str, int value)
     {
         char buf[16];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%d", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, unsigned int value)
     {
         char buf[16];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%u", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, float value)
     {
+        // like %f, the shortest round trip digits are available through to_chars without a precision
         char buf[64];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%f", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value, chars_format::fixed, 6).ptr);
     }
     template<class Str>
     void to_string(Str& str, double value)
     {
-        char buf[64];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%f", value);
-        str = buf;
+        // like %f, the shortest round trip digits are available through to_chars without a precision
+        char buf[400];
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value, chars_format::fixed, 6).ptr);
     }
     template<class Str>
     void to_string(Str& str, long value)
     {
         char buf[32];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%ld", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, unsigned long value)
     {
         char buf[32];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%lu", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, long long value)
     {
         char buf[32];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%lld", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, unsigned long long value)
     {
         char buf[32];
-        v_snprintf(buf, V_ARRAY_SIZE(buf), "%llu", value);
-        str = buf;
+        str.assign(buf, to_chars(buf, buf + V_ARRAY_SIZE(buf), value).ptr);
     }
     template<class Str>
     void to_string(Str& str, long double value)
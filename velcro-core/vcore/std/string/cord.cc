@@ -0,0 +1,575 @@
+#include <vcore/std/string/cord.h>
+#include <vcore/std/algorithm.h>
+#include <vcore/memory/memory.h>
+#include <vcore/memory/system_allocator.h>
+
+#include <string.h>
+
+namespace VStd
+{
+    namespace
+    {
+        using Internal::cord_node;
+        using Internal::cord_flat;
+        using Internal::cord_substring;
+        using Internal::cord_concat;
+
+        // Smallest chunk allocated for an append, so that the first short appends have room to grow in place.
+        constexpr size_t MinAppendCapacity = 64;
+
+        void InitNode(cord_node* node, cord_node::kind kind, uint8_t height, size_t length)
+        {
+            new (&node->m_refCount) VStd::atomic<uint32_t>(1);
+            node->m_kind = kind;
+            node->m_height = height;
+            node->m_length = length;
+        }
+
+        cord_flat* NewFlat(string_view str, size_t capacity)
+        {
+            V_Assert(capacity >= str.size(), "Flat cord chunk is too small");
+            cord_flat* flat = reinterpret_cast<cord_flat*>(vmalloc(sizeof(cord_flat) + capacity, alignof(cord_flat), V::SystemAllocator, "VStd::cord"));
+            InitNode(flat, cord_node::kind::flat, 0, str.size());
+            flat->m_capacity = capacity;
+            if (!str.empty())
+            {
+                ::memcpy(flat->data(), str.data(), str.size());
+            }
+            return flat;
+        }
+
+        void Ref(cord_node* node)
+        {
+            node->m_refCount.fetch_add(1, VStd::memory_order_relaxed);
+        }
+
+        // Frees the node itself, the caller has taken over or released the references it holds.
+        void FreeNode(cord_node* node)
+        {
+            node->m_refCount.~atomic();
+            vfree(node, V::SystemAllocator);
+        }
+
+        void Unref(cord_node* node)
+        {
+            while (node && node->m_refCount.fetch_sub(1, VStd::memory_order_acq_rel) == 1)
+            {
+                cord_node* next = nullptr;
+                if (node->m_kind == cord_node::kind::concat)
+                {
+                    // The height is bounded so recursing on one side is fine, the other side is released by the loop
+                    cord_concat* concat = static_cast<cord_concat*>(node);
+                    Unref(concat->m_left);
+                    next = concat->m_right;
+                }
+                else if (node->m_kind == cord_node::kind::substring)
+                {
+                    next = static_cast<cord_substring*>(node)->m_child;
+                }
+                FreeNode(node);
+                node = next;
+            }
+        }
+
+        // Takes over the references to left and right.
+        cord_node* NewConcat(cord_node* left, cord_node* right)
+        {
+            const uint8_t height = static_cast<uint8_t>(VStd::max(left->m_height, right->m_height) + 1);
+            V_Assert(height < cord::max_height, "Cord tree is too high");
+            cord_concat* concat = reinterpret_cast<cord_concat*>(vmalloc(sizeof(cord_concat), alignof(cord_concat), V::SystemAllocator, "VStd::cord"));
+            InitNode(concat, cord_node::kind::concat, height, left->m_length + right->m_length);
+            concat->m_left = left;
+            concat->m_right = right;
+            return concat;
+        }
+
+        // Takes over a reference to child.
+        cord_node* NewSubstring(cord_flat* child, size_t offset, size_t length)
+        {
+            cord_substring* substring = reinterpret_cast<cord_substring*>(vmalloc(sizeof(cord_substring), alignof(cord_substring), V::SystemAllocator, "VStd::cord"));
+            InitNode(substring, cord_node::kind::substring, 0, length);
+            substring->m_child = child;
+            substring->m_offset = offset;
+            return substring;
+        }
+
+        // Gives references to the children of a concat node in exchange for the reference to the node. A node that
+        // isn't shared hands its references over, otherwise the children are referenced again.
+        void Expose(cord_node* node, cord_node*& left, cord_node*& right)
+        {
+            cord_concat* concat = static_cast<cord_concat*>(node);
+            left = concat->m_left;
+            right = concat->m_right;
+            if (concat->m_refCount.load(VStd::memory_order_acquire) == 1)
+            {
+                FreeNode(concat);
+            }
+            else
+            {
+                Ref(left);
+                Ref(right);
+                Unref(concat);
+            }
+        }
+
+        // (a, (b, c)) -> ((a, b), c)
+        cord_node* RotateLeft(cord_node* node)
+        {
+            cord_node *a, *bc, *b, *c;
+            Expose(node, a, bc);
+            Expose(bc, b, c);
+            return NewConcat(NewConcat(a, b), c);
+        }
+
+        // ((a, b), c) -> (a, (b, c))
+        cord_node* RotateRight(cord_node* node)
+        {
+            cord_node *ab, *a, *b, *c;
+            Expose(node, ab, c);
+            Expose(ab, a, b);
+            return NewConcat(a, NewConcat(b, c));
+        }
+
+        // The join of AVL trees (Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered Sets") without the middle
+        // key. Both take over the references to the trees and create O(|height(left) - height(right)|) nodes.
+
+        // left is more than one level higher than right.
+        cord_node* JoinRight(cord_node* left, cord_node* right)
+        {
+            cord_node *l, *c;
+            Expose(left, l, c);
+            if (c->m_height <= right->m_height + 1)
+            {
+                cord_node* joined = NewConcat(c, right);
+                if (joined->m_height <= l->m_height + 1)
+                {
+                    return NewConcat(l, joined);
+                }
+                return RotateLeft(NewConcat(l, RotateRight(joined)));
+            }
+
+            cord_node* joined = JoinRight(c, right);
+            cord_node* result = NewConcat(l, joined);
+            return joined->m_height <= l->m_height + 1 ? result : RotateLeft(result);
+        }
+
+        // right is more than one level higher than left.
+        cord_node* JoinLeft(cord_node* left, cord_node* right)
+        {
+            cord_node *c, *r;
+            Expose(right, c, r);
+            if (c->m_height <= left->m_height + 1)
+            {
+                cord_node* joined = NewConcat(left, c);
+                if (joined->m_height <= r->m_height + 1)
+                {
+                    return NewConcat(joined, r);
+                }
+                return RotateRight(NewConcat(RotateLeft(joined), r));
+            }
+
+            cord_node* joined = JoinLeft(left, c);
+            cord_node* result = NewConcat(joined, r);
+            return joined->m_height <= r->m_height + 1 ? result : RotateRight(result);
+        }
+
+        cord_node* Join(cord_node* left, cord_node* right)
+        {
+            if (!left)
+            {
+                return right;
+            }
+            if (!right)
+            {
+                return left;
+            }
+            if (left->m_height > right->m_height + 1)
+            {
+                return JoinRight(left, right);
+            }
+            if (right->m_height > left->m_height + 1)
+            {
+                return JoinLeft(left, right);
+            }
+            return NewConcat(left, right);
+        }
+
+        // Returns a new reference to the characters [pos, pos + length) of node, null if length is 0.
+        cord_node* Slice(cord_node* node, size_t pos, size_t length)
+        {
+            if (length == 0)
+            {
+                return nullptr;
+            }
+            if (pos == 0 && length == node->m_length)
+            {
+                Ref(node);
+                return node;
+            }
+
+            switch (node->m_kind)
+            {
+            case cord_node::kind::concat:
+            {
+                cord_concat* concat = static_cast<cord_concat*>(node);
+                const size_t leftLength = concat->m_left->m_length;
+                if (pos + length <= leftLength)
+                {
+                    return Slice(concat->m_left, pos, length);
+                }
+                if (pos >= leftLength)
+                {
+                    return Slice(concat->m_right, pos - leftLength, length);
+                }
+                return Join(Slice(concat->m_left, pos, leftLength - pos), Slice(concat->m_right, 0, pos + length - leftLength));
+            }
+            default:
+            {
+                const string_view chars = Internal::cord_leaf_view(node).substr(pos, length);
+                if (length <= cord::max_copied_substring)
+                {
+                    return NewFlat(chars, length);
+                }
+                cord_flat* child = node->m_kind == cord_node::kind::flat ? static_cast<cord_flat*>(node) : static_cast<cord_substring*>(node)->m_child;
+                Ref(child);
+                return NewSubstring(child, chars.data() - child->data(), length);
+            }
+            }
+        }
+
+        // Copies as much of str as fits into the spare capacity of the last chunk of root, if root and every node
+        // on the way to the last chunk are not shared. Returns the number of characters copied.
+        size_t AppendInPlace(cord_node* root, string_view str)
+        {
+            cord_node* path[cord::max_height];
+            size_t depth = 0;
+            cord_node* node = root;
+            for (;;)
+            {
+                if (node->m_refCount.load(VStd::memory_order_acquire) != 1)
+                {
+                    return 0;
+                }
+                path[depth++] = node;
+                if (node->m_kind != cord_node::kind::concat)
+                {
+                    break;
+                }
+                node = static_cast<cord_concat*>(node)->m_right;
+            }
+
+            if (node->m_kind != cord_node::kind::flat)
+            {
+                return 0;
+            }
+            cord_flat* flat = static_cast<cord_flat*>(node);
+            const size_t count = VStd::min(flat->m_capacity - flat->m_length, str.size());
+            if (count == 0)
+            {
+                return 0;
+            }
+            ::memcpy(flat->data() + flat->m_length, str.data(), count);
+            for (size_t i = 0; i < depth; ++i)
+            {
+                path[i]->m_length += count;
+            }
+            return count;
+        }
+    }
+
+    cord::cord(string_view str)
+    {
+        if (!str.empty())
+        {
+            m_root = NewFlat(str, str.size());
+        }
+    }
+
+    cord::cord(const cord& rhs)
+        : m_root(rhs.m_root)
+    {
+        if (m_root)
+        {
+            Ref(m_root);
+        }
+    }
+
+    cord::~cord()
+    {
+        Unref(m_root);
+    }
+
+    cord& cord::operator=(const cord& rhs)
+    {
+        if (m_root != rhs.m_root)
+        {
+            if (rhs.m_root)
+            {
+                Ref(rhs.m_root);
+            }
+            Unref(m_root);
+            m_root = rhs.m_root;
+        }
+        return *this;
+    }
+
+    cord& cord::operator=(cord&& rhs)
+    {
+        if (this != &rhs)
+        {
+            Unref(m_root);
+            m_root = rhs.m_root;
+            rhs.m_root = nullptr;
+        }
+        return *this;
+    }
+
+    cord& cord::operator=(string_view str)
+    {
+        cord_node* root = str.empty() ? nullptr : NewFlat(str, str.size());
+        Unref(m_root);
+        m_root = root;
+        return *this;
+    }
+
+    void cord::clear()
+    {
+        Unref(m_root);
+        m_root = nullptr;
+    }
+
+    char cord::operator[](size_type pos) const
+    {
+        V_Assert(pos < size(), "cord index is out of range");
+        const cord_node* node = m_root;
+        while (node->m_kind == cord_node::kind::concat)
+        {
+            const cord_concat* concat = static_cast<const cord_concat*>(node);
+            if (pos < concat->m_left->m_length)
+            {
+                node = concat->m_left;
+            }
+            else
+            {
+                pos -= concat->m_left->m_length;
+                node = concat->m_right;
+            }
+        }
+        return Internal::cord_leaf_view(node)[pos];
+    }
+
+    cord& cord::append(string_view str)
+    {
+        if (str.empty())
+        {
+            return *this;
+        }
+        if (m_root)
+        {
+            str.remove_prefix(AppendInPlace(m_root, str));
+            if (str.empty())
+            {
+                return *this;
+            }
+        }
+
+        // Leave room for the appends that follow, more the larger the cord already is
+        const size_t capacity = VStd::max(str.size(), VStd::min(max_flat_length, VStd::max(MinAppendCapacity, size())));
+        m_root = Join(m_root, NewFlat(str, capacity));
+        return *this;
+    }
+
+    cord& cord::append(const cord& str)
+    {
+        if (str.size() <= max_copied_substring)
+        {
+            // Copying short cords keeps the chunks of this cord large
+            char buffer[max_copied_substring];
+            return append(string_view(buffer, str.copy(buffer, str.size())));
+        }
+        Ref(str.m_root);
+        m_root = Join(m_root, str.m_root);
+        return *this;
+    }
+
+    cord& cord::append(cord&& str)
+    {
+        if (str.size() <= max_copied_substring)
+        {
+            return append(static_cast<const cord&>(str));
+        }
+        cord_node* root = str.m_root;
+        str.m_root = nullptr;
+        m_root = Join(m_root, root);
+        return *this;
+    }
+
+    cord& cord::append(size_type count, char ch)
+    {
+        char buffer[256];
+        ::memset(buffer, ch, VStd::min(count, sizeof(buffer)));
+        while (count > 0)
+        {
+            const size_type chunk = VStd::min(count, sizeof(buffer));
+            append(string_view(buffer, chunk));
+            count -= chunk;
+        }
+        return *this;
+    }
+
+    cord& cord::prepend(string_view str)
+    {
+        if (!str.empty())
+        {
+            m_root = Join(NewFlat(str, str.size()), m_root);
+        }
+        return *this;
+    }
+
+    cord& cord::prepend(const cord& str)
+    {
+        if (str.m_root)
+        {
+            Ref(str.m_root);
+            m_root = Join(str.m_root, m_root);
+        }
+        return *this;
+    }
+
+    cord cord::substr(size_type pos, size_type count) const
+    {
+        pos = VStd::min(pos, size());
+        count = VStd::min(count, size() - pos);
+        return cord(m_root ? Slice(m_root, pos, count) : nullptr);
+    }
+
+    cord::size_type cord::chunk_count() const
+    {
+        size_type count = 0;
+        for (chunk_iterator it = chunk_begin(); it != chunk_end(); ++it)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    string_view cord::flatten()
+    {
+        if (!m_root)
+        {
+            return string_view();
+        }
+        if (m_root->m_kind != cord_node::kind::concat)
+        {
+            return Internal::cord_leaf_view(m_root);
+        }
+
+        cord_flat* flat = NewFlat(string_view(), size());
+        copy(flat->data(), size());
+        flat->m_length = size();
+        Unref(m_root);
+        m_root = flat;
+        return string_view(flat->data(), flat->m_length);
+    }
+
+    cord::size_type cord::copy(char* dest, size_type count, size_type pos) const
+    {
+        V_Assert(pos <= size(), "cord::copy position is out of range");
+        count = VStd::min(count, size() - pos);
+        size_type copied = 0;
+        for (chunk_iterator it = chunk_begin(); it != chunk_end() && copied < count; ++it)
+        {
+            string_view chunk = *it;
+            if (pos >= chunk.size())
+            {
+                pos -= chunk.size();
+                continue;
+            }
+            chunk = chunk.substr(pos, count - copied);
+            pos = 0;
+            ::memcpy(dest + copied, chunk.data(), chunk.size());
+            copied += chunk.size();
+        }
+        return copied;
+    }
+
+    VStd::string cord::to_string() const
+    {
+        VStd::string result;
+        result.resize_no_construct(size());
+        copy(result.data(), size());
+        return result;
+    }
+
+    int cord::compare(const cord& rhs) const
+    {
+        chunk_iterator lhsIt = chunk_begin();
+        chunk_iterator rhsIt = rhs.chunk_begin();
+        string_view lhsChunk = *lhsIt;
+        string_view rhsChunk = *rhsIt;
+        for (;;)
+        {
+            if (lhsChunk.empty() && lhsIt != chunk_end())
+            {
+                lhsChunk = *++lhsIt;
+                continue;
+            }
+            if (rhsChunk.empty() && rhsIt != rhs.chunk_end())
+            {
+                rhsChunk = *++rhsIt;
+                continue;
+            }
+            if (lhsChunk.empty() || rhsChunk.empty())
+            {
+                // One of the cords has ended
+                return lhsChunk.empty() ? (rhsChunk.empty() ? 0 : -1) : 1;
+            }
+
+            const size_t count = VStd::min(lhsChunk.size(), rhsChunk.size());
+            const int result = ::memcmp(lhsChunk.data(), rhsChunk.data(), count);
+            if (result != 0)
+            {
+                return result;
+            }
+            lhsChunk.remove_prefix(count);
+            rhsChunk.remove_prefix(count);
+        }
+    }
+
+    int cord::compare(string_view rhs) const
+    {
+        for (chunk_iterator it = chunk_begin(); it != chunk_end(); ++it)
+        {
+            const size_t count = VStd::min(it->size(), rhs.size());
+            const int result = ::memcmp(it->data(), rhs.data(), count);
+            if (result != 0)
+            {
+                return result;
+            }
+            if (count < it->size())
+            {
+                return 1;
+            }
+            rhs.remove_prefix(count);
+        }
+        return rhs.empty() ? 0 : -1;
+    }
+
+    bool cord::starts_with(string_view prefix) const
+    {
+        if (prefix.size() > size())
+        {
+            return false;
+        }
+        for (chunk_iterator it = chunk_begin(); !prefix.empty(); ++it)
+        {
+            const size_t count = VStd::min(it->size(), prefix.size());
+            if (::memcmp(it->data(), prefix.data(), count) != 0)
+            {
+                return false;
+            }
+            prefix.remove_prefix(count);
+        }
+        return true;
+    }
+} // namespace VStd
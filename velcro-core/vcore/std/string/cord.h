@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) Contributors to the VelcroFramework.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#ifndef V_FRAMEWORK_CORE_STD_STRING_CORD_H
+#define V_FRAMEWORK_CORE_STD_STRING_CORD_H
+
+#include <vcore/std/base.h>
+#include <vcore/std/iterator.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/string/string.h>
+#include <vcore/std/string/string_view.h>
+
+namespace VStd
+{
+    namespace Internal
+    {
+        /// Immutable node of a cord, shared between cords with an atomic count. A node with a count of 1 belongs to a
+        /// single cord, which may append to it in place.
+        struct cord_node
+        {
+            enum class kind : uint8_t
+            {
+                flat,       ///< Owns its characters, which follow the node in the same allocation.
+                substring,  ///< A range of a flat node.
+                concat      ///< Two child nodes.
+            };
+
+            VStd::atomic<uint32_t> m_refCount;
+            kind m_kind;
+            /// 0 for flat and substring nodes, 1 + the height of the taller child for concat nodes.
+            uint8_t m_height;
+            size_t m_length;
+        };
+
+        struct cord_flat : cord_node
+        {
+            size_t m_capacity;
+
+            char* data()
+            {
+                return reinterpret_cast<char*>(this + 1);
+            }
+            const char* data() const
+            {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+
+        struct cord_substring : cord_node
+        {
+            cord_flat* m_child;
+            size_t m_offset;
+        };
+
+        struct cord_concat : cord_node
+        {
+            cord_node* m_left;
+            cord_node* m_right;
+        };
+
+        /// Characters of a flat or substring node.
+        inline string_view cord_leaf_view(const cord_node* node)
+        {
+            if (node->m_kind == cord_node::kind::flat)
+            {
+                return string_view(static_cast<const cord_flat*>(node)->data(), node->m_length);
+            }
+            const cord_substring* substring = static_cast<const cord_substring*>(node);
+            return string_view(substring->m_child->data() + substring->m_offset, node->m_length);
+        }
+    }
+
+    /**
+     * A string stored as a tree of ref-counted chunks, for building large strings out of many pieces.
+     *
+     * Appending a cord or taking a substr shares the chunks instead of copying the characters and takes O(log n) node
+     * allocations: the tree is kept height balanced (as an AVL tree) by the concatenation. Small appends are copied into
+     * the spare capacity of the last chunk when no other cord shares it, so a response built from many short writes
+     * ends up in a few large chunks.
+     *
+     * The characters are not contiguous. Use the chunk iterators (for example to fill the iovec array of writev) or
+     * copy them out, flatten() collapses the cord into a single chunk when a contiguous view is needed.
+     *
+     * Cords are values: copies share nodes, which are never modified while shared, so different cords can be used
+     * from different threads. A single cord is not thread safe.
+     */
+    class cord
+    {
+    public:
+        using value_type = char;
+        using size_type = size_t;
+        using traits_type = char_traits<char>;
+
+        static constexpr size_type npos = size_type(-1);
+
+        /// Chunks that are not shared may grow in place up to this many characters.
+        static constexpr size_type max_flat_length = 4096 - sizeof(Internal::cord_flat);
+        /// Substrings up to this length are copied instead of sharing (and keeping alive) the chunk they come from.
+        static constexpr size_type max_copied_substring = 64;
+        /// Upper bound of the tree height, the AVL balance keeps it under 1.45 * log2 of the number of chunks.
+        static constexpr size_type max_height = 64;
+
+        /// Forward iterator over the chunks of a cord, the cord must outlive it and not change while it is used.
+        class chunk_iterator
+        {
+        public:
+            using iterator_category = forward_iterator_tag;
+            using value_type = string_view;
+            using difference_type = ptrdiff_t;
+            using pointer = const string_view*;
+            using reference = const string_view&;
+
+            chunk_iterator() = default;
+
+            reference operator*() const
+            {
+                return m_chunk;
+            }
+            pointer operator->() const
+            {
+                return &m_chunk;
+            }
+
+            chunk_iterator& operator++()
+            {
+                if (m_depth == 0)
+                {
+                    m_leaf = nullptr;
+                    m_chunk = string_view();
+                }
+                else
+                {
+                    descend(m_stack[--m_depth]);
+                }
+                return *this;
+            }
+            chunk_iterator operator++(int)
+            {
+                chunk_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const chunk_iterator& rhs) const
+            {
+                return m_leaf == rhs.m_leaf && m_depth == rhs.m_depth;
+            }
+            bool operator!=(const chunk_iterator& rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            friend class cord;
+
+            explicit chunk_iterator(const Internal::cord_node* root)
+            {
+                if (root)
+                {
+                    descend(root);
+                }
+            }
+
+            // Goes to the leftmost leaf of node, keeping the right children that are still to be visited.
+            void descend(const Internal::cord_node* node)
+            {
+                while (node->m_kind == Internal::cord_node::kind::concat)
+                {
+                    const Internal::cord_concat* concat = static_cast<const Internal::cord_concat*>(node);
+                    m_stack[m_depth++] = concat->m_right;
+                    node = concat->m_left;
+                }
+                m_leaf = node;
+                m_chunk = Internal::cord_leaf_view(node);
+            }
+
+            const Internal::cord_node* m_stack[max_height];
+            size_type m_depth = 0;
+            const Internal::cord_node* m_leaf = nullptr;
+            string_view m_chunk;
+        };
+
+        /// Range of the chunks of a cord, for range based for loops.
+        struct chunk_range
+        {
+            chunk_iterator begin() const
+            {
+                return m_begin;
+            }
+            chunk_iterator end() const
+            {
+                return chunk_iterator();
+            }
+
+            chunk_iterator m_begin;
+        };
+
+        cord() = default;
+        explicit cord(string_view str);
+        cord(const cord& rhs);
+        cord(cord&& rhs)
+            : m_root(rhs.m_root)
+        {
+            rhs.m_root = nullptr;
+        }
+        ~cord();
+
+        cord& operator=(const cord& rhs);
+        cord& operator=(cord&& rhs);
+        cord& operator=(string_view str);
+
+        size_type size() const
+        {
+            return m_root ? m_root->m_length : 0;
+        }
+        size_type length() const
+        {
+            return size();
+        }
+        bool empty() const
+        {
+            return m_root == nullptr;
+        }
+        void clear();
+
+        /// Returns the character at pos, in O(log n).
+        char operator[](size_type pos) const;
+
+        cord& append(string_view str);
+        cord& append(const cord& str);
+        cord& append(cord&& str);
+        cord& append(size_type count, char ch);
+        cord& prepend(string_view str);
+        cord& prepend(const cord& str);
+
+        cord& operator+=(string_view str)
+        {
+            return append(str);
+        }
+        cord& operator+=(const cord& str)
+        {
+            return append(str);
+        }
+        cord& operator+=(cord&& str)
+        {
+            return append(VStd::move(str));
+        }
+        cord& operator+=(char ch)
+        {
+            return append(1, ch);
+        }
+
+        /// Returns the characters [pos, pos + count), sharing the chunks of this cord. pos past the end is clamped.
+        cord substr(size_type pos = 0, size_type count = npos) const;
+
+        chunk_iterator chunk_begin() const
+        {
+            return chunk_iterator(m_root);
+        }
+        chunk_iterator chunk_end() const
+        {
+            return chunk_iterator();
+        }
+        chunk_range chunks() const
+        {
+            return chunk_range{ chunk_begin() };
+        }
+        size_type chunk_count() const;
+
+        /// Calls f(string_view) for each chunk, in order.
+        template<class Function>
+        void for_each_chunk(Function&& f) const
+        {
+            for (chunk_iterator it = chunk_begin(); it != chunk_end(); ++it)
+            {
+                f(*it);
+            }
+        }
+
+        /// Returns the cord as a single contiguous view, copying the chunks into one if there are several.
+        /// The view is invalidated by any change to the cord.
+        string_view flatten();
+
+        /// Copies up to count characters starting at pos to dest, as basic_string::copy does. Returns the number of
+        /// characters copied, no null terminator is written.
+        size_type copy(char* dest, size_type count, size_type pos = 0) const;
+
+        VStd::string to_string() const;
+
+        int compare(const cord& rhs) const;
+        int compare(string_view rhs) const;
+
+        bool starts_with(string_view prefix) const;
+
+    private:
+        explicit cord(Internal::cord_node* root)
+            : m_root(root)
+        {}
+
+        Internal::cord_node* m_root = nullptr;
+    };
+
+    inline bool operator==(const cord& lhs, const cord& rhs)
+    {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+    inline bool operator!=(const cord& lhs, const cord& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    inline bool operator<(const cord& lhs, const cord& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+    inline bool operator==(const cord& lhs, string_view rhs)
+    {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+    inline bool operator==(string_view lhs, const cord& rhs)
+    {
+        return rhs == lhs;
+    }
+    inline bool operator!=(const cord& lhs, string_view rhs)
+    {
+        return !(lhs == rhs);
+    }
+    inline bool operator!=(string_view lhs, const cord& rhs)
+    {
+        return !(rhs == lhs);
+    }
+
+    inline cord operator+(const cord& lhs, const cord& rhs)
+    {
+        cord result(lhs);
+        result.append(rhs);
+        return result;
+    }
+    inline cord operator+(cord&& lhs, const cord& rhs)
+    {
+        lhs.append(rhs);
+        return VStd::move(lhs);
+    }
+    inline cord operator+(cord&& lhs, string_view rhs)
+    {
+        lhs.append(rhs);
+        return VStd::move(lhs);
+    }
+} // namespace VStd
+
+#endif // V_FRAMEWORK_CORE_STD_STRING_CORD_H
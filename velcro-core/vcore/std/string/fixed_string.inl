@@ -1676,7 +1676,7 @@ namespace VStd
     {
         inline constexpr size_t operator()(const basic_fixed_string<Element, MaxElementCount, Traits>& value) const
         {
-            return hash_string(value.begin(), value.length());
+            return hash_string_default(value.data(), value.length());
         }
     };
 } // namespace VStd
@@ -13,9 +13,14 @@
 #include <vcore/std/iterator.h>
 #include <vcore/std/string/string.h>
 #include <vcore/std/string/conversions.h>
+#include <vcore/std/string/regex_automaton.h>
 #include <vcore/std/utils.h>
 #include <vcore/std/exceptions.h>
 #include <vcore/std/containers/vector.h>
+#include <vcore/std/typetraits/is_pointer.h>
+#include <vcore/std/typetraits/is_same.h>
+#include <vcore/std/typetraits/remove_cv.h>
+#include <vcore/std/typetraits/remove_pointer.h>
 #include <vcore/memory/system_allocator.h>
 
 #include <limits>
@@ -1105,13 +1110,20 @@ namespace VStd
             , Loops(0)
             , Marks(0)
             , Refs(0)
+            , Automaton(nullptr)
         {
         }
 
+        ~RootNode()
+        {
+            delete Automaton;
+        }
+
         regex_constants::syntax_option_type flags;
         unsigned int Loops;
         unsigned int Marks;
         unsigned int Refs;
+        RegexAutomaton* Automaton;  // DFA/NFA form of char patterns without back references or assertions, or null
     };
 
     class NodeEndGroup
@@ -1642,6 +1654,9 @@ namespace VStd
         LF_no_subs = 0x80000000     // subexpression matches not recorded
     };
 
+    template<class RegExTraits>
+    class AutomatonCompiler;
+
     // TEMPLATE CLASS basic_regex
     template<class Element, class RegExTraits = regex_traits<Element> >
     class basic_regex
@@ -1899,6 +1914,13 @@ namespace VStd
             m_error = nullptr; // clear last parse error
             Parser<ForwardIterator, Element, RegExTraits> parser(m_traits, first, last, flags, this);
             RootNode* rootNode = parser.Compile();
+            if constexpr (is_same_v<Element, char>)
+            {
+                if (rootNode != nullptr && m_error == nullptr)
+                {
+                    rootNode->Automaton = AutomatonCompiler<RegExTraits>(m_traits, rootNode->flags).Compile(rootNode);
+                }
+            }
             Reset(rootNode);
         }
 
@@ -2029,6 +2051,90 @@ namespace VStd
 
     #undef V_REGEX_ISDIGIT
 
+    // match or search with the automaton of the expression, isHandled is false if the Matcher has to do it:
+    // wide characters, iterators that aren't pointers, partial and non null matches, match_not_bow and match_not_bol
+    // (the Matcher applies them again at each position it retries a search from) and POSIX longest matches with sub matches
+    template<class BidirectionalIterator, class Allocator, class Element, class RegExTraits, class Iterator>
+    inline bool AutomatonMatch(Iterator first, Iterator last, match_results<BidirectionalIterator, Allocator>* m_matches, const basic_regex<Element, RegExTraits>& regEx, regex_constants::match_flag_type flags, bool isFull, bool& isHandled)
+    {
+        isHandled = false;
+        if constexpr (is_same_v<Element, char> && is_pointer_v<Iterator> && is_same_v<remove_cv_t<remove_pointer_t<Iterator>>, char>)
+        {
+            using namespace regex_constants;
+            const RootNode* rootNode = regEx.Get();
+            const RegexAutomaton* automaton = rootNode->Automaton;
+            const bool isLongest = (rootNode->Flags & NFLG_longest) && !(flags & match_any);
+            if (automaton == nullptr
+                || (flags & (match_partial | match_not_null | match_not_null1 | match_not_bow))
+                || (flags & (match_not_bol | match_prev_avail)) == match_not_bol
+                || (isLongest && m_matches))
+            {
+                return false;
+            }
+
+            uint32_t automatonFlags = RegexAutomaton::MatchNone;
+            automatonFlags |= (flags & match_not_eol) ? RegexAutomaton::MatchNotEol : 0;
+            automatonFlags |= (flags & match_not_eow) ? RegexAutomaton::MatchNotEow : 0;
+            automatonFlags |= (flags & match_prev_avail) ? RegexAutomaton::MatchPrevAvail : 0;
+            automatonFlags |= (flags & match_continuous) ? RegexAutomaton::MatchContinuous : 0;
+            automatonFlags |= isFull ? RegexAutomaton::MatchFull : 0;
+            isHandled = true;
+            if (!m_matches)
+            {
+                return automaton->Search(first, last, automatonFlags, nullptr);
+            }
+
+            const unsigned int numGroups = automaton->GetNumGroups();
+            vector<const char*> captures(numGroups * 2);
+            if (!automaton->Search(first, last, automatonFlags, captures.data()))
+            {
+                return false;
+            }
+
+            // same results as Matcher::Match
+            m_matches->Resize(numGroups);
+            for (unsigned int index = 0; index < numGroups; ++index)
+            {
+                if (captures[index * 2 + 1])
+                {
+                    m_matches->at(index).matched = true;
+                    m_matches->at(index).first = first + (captures[index * 2] - first);
+                    m_matches->at(index).second = first + (captures[index * 2 + 1] - first);
+                }
+                else
+                {
+                    m_matches->at(index).matched = false;
+                    m_matches->at(index).first = last;
+                    m_matches->at(index).second = last;
+                }
+            }
+            m_matches->m_original = first;
+            m_matches->Prefix().matched = true;
+            m_matches->Prefix().first = first;
+            m_matches->Prefix().second = m_matches->at(0).first;
+
+            m_matches->Suffix().matched = true;
+            m_matches->Suffix().first = m_matches->at(0).second;
+            m_matches->Suffix().second = last;
+
+            m_matches->Null().first = last;
+            m_matches->Null().second = last;
+
+            m_matches->m_isReady = true;
+            return true;
+        }
+        else
+        {
+            (void)first;
+            (void)last;
+            (void)m_matches;
+            (void)regEx;
+            (void)flags;
+            (void)isFull;
+            return false;
+        }
+    }
+
     // try to match regular expression to target text
     template<class BidirectionalIterator, class Allocator, class Element, class RegExTraits, class Iterator>
     inline bool RegexMatch(Iterator first, Iterator last,   match_results<BidirectionalIterator, Allocator>* m_matches, const basic_regex<Element, RegExTraits>& regEx, regex_constants::match_flag_type flags, bool isFull)
@@ -2037,6 +2143,12 @@ namespace VStd
         {
             return (false);
         }
+        bool isHandled;
+        const bool isMatched = AutomatonMatch(first, last, m_matches, regEx, flags, isFull, isHandled);
+        if (isHandled)
+        {
+            return isMatched;
+        }
         Matcher<BidirectionalIterator, Element, RegExTraits, Iterator> matcher(first, last, regEx._Get_traits(), regEx.Get(), regEx.mark_count() + 1, regEx.Flags(), flags);
         return (matcher.Match(m_matches, isFull));
     }
@@ -2095,6 +2207,19 @@ namespace VStd
         {
             return false;
         }
+        bool isHandled;
+        if (AutomatonMatch(first, last, m_matches, regEx, flags, false, isHandled))
+        {
+            if (m_matches)
+            {
+                m_matches->m_original = original;
+            }
+            return true;
+        }
+        if (isHandled)
+        {
+            return false;
+        }
         bool _Found = false;
         Iterator begin = first;
         Matcher<BidirectionalIterator, Element, RegExTraits, Iterator> matcher(first, last, regEx._Get_traits(), regEx.Get(), regEx.mark_count() + 1, regEx.Flags(), flags);
@@ -3345,6 +3470,296 @@ namespace VStd
         return (first);
     }
 
+    template<class RegExTraits>
+    class AutomatonCompiler
+    {   // lowers the node list of a regular pattern to a RegexAutomaton program
+    public:
+        typedef typename RegExTraits::char_type Element;
+        typedef RegexAutomaton::ByteSet ByteSet;
+
+        AutomatonCompiler(const RegExTraits& traits, regex_constants::syntax_option_type sflags)
+            : m_traits(traits)
+            , m_sflags(sflags)
+            , m_automaton(nullptr)
+        {
+        }
+
+        // returns the automaton or null if the pattern isn't regular or too large
+        RegexAutomaton* Compile(RootNode* root)
+        {
+            m_automaton = new RegexAutomaton(root->Marks);
+            if (!CompileSequence(root, nullptr) || !m_automaton->Finalize())
+            {
+                delete m_automaton;
+                return nullptr;
+            }
+            return m_automaton;
+        }
+
+    private:
+        bool CompileSequence(NodeBase* node, NodeBase* stop)
+        {   // emit [node, stop)
+            for (; node != stop && node != nullptr; node = node->Next)
+            {
+                if (m_automaton->IsTooLarge())
+                {
+                    return false;
+                }
+                switch (node->Kind)
+                {
+                case NT_begin:    // the whole match is group 0
+                    m_automaton->EmitCaptureBegin(0);
+                    break;
+
+                case NT_nop:
+                case NT_group:
+                case NT_end_group:
+                    break;
+
+                case NT_bol:
+                    m_automaton->EmitAssert(RegexAutomaton::OpCode::AssertBol);
+                    break;
+
+                case NT_eol:
+                    m_automaton->EmitAssert(RegexAutomaton::OpCode::AssertEol);
+                    break;
+
+                case NT_wbound:
+                    m_automaton->EmitAssert((node->Flags & NFLG_negate) ? RegexAutomaton::OpCode::NotWordBoundary : RegexAutomaton::OpCode::WordBoundary);
+                    break;
+
+                case NT_dot:
+                {
+                    ByteSet bytes;
+                    for (int byte = 0; byte < 256; ++byte)
+                    {
+                        if (byte != Meta_nl && byte != Meta_cr)
+                        {
+                            bytes.Set(static_cast<uint8_t>(byte));
+                        }
+                    }
+                    m_automaton->EmitByteSet(bytes);
+                    break;
+                }
+
+                case NT_str:
+                {
+                    NodeString<Element>* string = (NodeString<Element>*)node;
+                    if (string->Data.Size() == 0)
+                    {   // the Matcher fails on empty strings
+                        m_automaton->EmitByteSet(ByteSet());
+                    }
+                    for (int index = 0; index < string->Data.Size(); ++index)
+                    {
+                        m_automaton->EmitByteSet(StringBytes(string->Data.at(index)));
+                    }
+                    break;
+                }
+
+                case NT_class:
+                {
+                    NodeClass<Element, RegExTraits>* bracket = (NodeClass<Element, RegExTraits>*)node;
+                    if (bracket->Coll)
+                    {   // collating elements match several characters
+                        return false;
+                    }
+                    m_automaton->EmitByteSet(ClassBytes(bracket));
+                    break;
+                }
+
+                case NT_capture:
+                    m_automaton->EmitCaptureBegin(((NodeCapture*)node)->Index);
+                    break;
+
+                case NT_end_capture:
+                    m_automaton->EmitCaptureEnd(((NodeCapture*)((NodeEndGroup*)node)->Back)->Index);
+                    break;
+
+                case NT_if:
+                    if (!CompileAlternatives((NodeIf*)node))
+                    {
+                        return false;
+                    }
+                    node = ((NodeIf*)node)->Endif;
+                    break;
+
+                case NT_rep:
+                    if (!CompileRepetition((NodeRepetition*)node))
+                    {
+                        return false;
+                    }
+                    node = ((NodeRepetition*)node)->EndRep;
+                    break;
+
+                case NT_end:
+                    m_automaton->EmitCaptureEnd(0);
+                    m_automaton->EmitMatch();
+                    break;
+
+                default:    // back references and assertions
+                    return false;
+                }
+            }
+            return !m_automaton->IsTooLarge();
+        }
+
+        bool CompileAlternatives(NodeIf* node)
+        {   // leftmost alternative first, like _Do_if
+            VStd::vector<uint32_t> jumps;
+            for (NodeIf* current = node; current != nullptr; current = current->Child)
+            {
+                const uint32_t split = current->Child ? m_automaton->EmitSplit(0, 0) : RegexAutomaton::InvalidIndex;
+                if (!CompileSequence(current->Next, node->Endif))
+                {
+                    return false;
+                }
+                if (current->Child)
+                {
+                    jumps.push_back(m_automaton->EmitJump(0));
+                    m_automaton->PatchTargets(split, split + 1, m_automaton->GetProgramSize());
+                }
+            }
+            for (uint32_t jump : jumps)
+            {
+                m_automaton->PatchTargets(jump, m_automaton->GetProgramSize());
+            }
+            return true;
+        }
+
+        bool CompileRepetition(NodeRepetition* node)
+        {   // the mandatory iterations, then a loop or the optional ones
+            const bool isGreedy = (node->Flags & NFLG_greedy) != 0;
+            for (int index = 0; index < node->Min; ++index)
+            {
+                if (!CompileSequence(node->Next, node->EndRep))
+                {
+                    return false;
+                }
+            }
+
+            if (node->Max < 0)
+            {   // the loop closes with a split so an iteration can end where it started, like _Do_rep
+                const uint32_t loop = m_automaton->EmitSplit(0, 0);
+                if (!CompileSequence(node->Next, node->EndRep))
+                {
+                    return false;
+                }
+                const uint32_t back = m_automaton->EmitSplit(0, 0);
+                const uint32_t exit = m_automaton->GetProgramSize();
+                if (isGreedy)
+                {
+                    m_automaton->PatchTargets(loop, loop + 1, exit);
+                    m_automaton->PatchTargets(back, loop, exit);
+                }
+                else
+                {
+                    m_automaton->PatchTargets(loop, exit, loop + 1);
+                    m_automaton->PatchTargets(back, exit, loop);
+                }
+                return true;
+            }
+
+            VStd::vector<uint32_t> splits;
+            for (int index = node->Min; index < node->Max; ++index)
+            {
+                splits.push_back(m_automaton->EmitSplit(0, 0));
+                if (!CompileSequence(node->Next, node->EndRep))
+                {
+                    return false;
+                }
+            }
+            const uint32_t exit = m_automaton->GetProgramSize();
+            for (uint32_t split : splits)
+            {
+                if (isGreedy)
+                {
+                    m_automaton->PatchTargets(split, split + 1, exit);
+                }
+                else
+                {
+                    m_automaton->PatchTargets(split, exit, split + 1);
+                }
+            }
+            return true;
+        }
+
+        ByteSet StringBytes(Element ch) const
+        {   // bytes _Compare accepts for ch
+            ByteSet bytes;
+            for (int byte = 0; byte < 256; ++byte)
+            {
+                const Element element = (Element)byte;
+                bool isEqual;
+                if (m_sflags & regex_constants::collate)
+                {
+                    isEqual = m_traits.translate(element) == m_traits.translate(ch);
+                }
+                else if (m_sflags & regex_constants::icase)
+                {
+                    isEqual = m_traits.translate_nocase(element) == m_traits.translate_nocase(ch);
+                }
+                else
+                {
+                    isEqual = element == ch;
+                }
+                if (isEqual)
+                {
+                    bytes.Set(static_cast<uint8_t>(byte));
+                }
+            }
+            return bytes;
+        }
+
+        ByteSet ClassBytes(const NodeClass<Element, RegExTraits>* node) const
+        {   // bytes _Do_class accepts, in the same order of lookups
+            ByteSet bytes;
+            for (int byte = 0; byte < 256; ++byte)
+            {
+                Element ch = (Element)byte;
+                if (m_sflags & regex_constants::icase)
+                {
+                    ch = m_traits.translate_nocase(ch);
+                }
+                bool isFound;
+                if (node->Ranges && _Lookup_range((Element)(m_sflags & regex_constants::collate ? (int)m_traits.translate(ch) : (int)ch), node->Ranges))
+                {
+                    isFound = true;
+                }
+                else if (0 <= static_cast<int>(ch) && static_cast<int>(ch) < BITMAP_max)
+                {
+                    isFound = node->Small && node->Small->Find(ch);
+                }
+                else if (node->Large && VStd::find(node->Large->String(), node->Large->String() + node->Large->Size(), ch) != node->Large->String() + node->Large->Size())
+                {
+                    isFound = true;
+                }
+                else if (node->_Classes != 0 && m_traits.isctype(ch, node->_Classes))
+                {
+                    isFound = true;
+                }
+                else if (node->Equiv && _Lookup_equiv(ch, node->Equiv, m_traits))
+                {
+                    isFound = true;
+                }
+                else
+                {
+                    isFound = false;
+                }
+                if (isFound != ((node->Flags & NFLG_negate) != 0))
+                {
+                    bytes.Set(static_cast<uint8_t>(byte));
+                }
+            }
+            return bytes;
+        }
+
+        const RegExTraits& m_traits;
+        regex_constants::syntax_option_type m_sflags;
+        RegexAutomaton* m_automaton;
+
+        AutomatonCompiler& operator=(const AutomatonCompiler&);
+    };
+
     template<class BidirectionalIterator, class Element, class RegExTraits, class Iterator>
     inline bool Matcher<BidirectionalIterator, Element, RegExTraits, Iterator>::_Do_class(NodeBase* _Nx)
     {   // apply bracket expression
@@ -0,0 +1,943 @@
+#include <vcore/std/string/regex_automaton.h>
+#include <vcore/std/algorithm.h>
+#include <vcore/std/hash.h>
+#include <vcore/std/containers/unordered_map.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/parallel/lock.h>
+#include <vcore/std/parallel/mutex.h>
+#include <vcore/memory/memory.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/vcore_traits_platform.h>
+
+#include <string.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace VStd
+{
+    namespace RegexAutomatonInternal
+    {
+        /// Upper bound of the interned kernel program counters, on top of the state budget.
+        static constexpr size_t MaxKernelData = 1024 * 1024;
+
+        enum StateFlags : uint8_t
+        {
+            // Part of the state identity
+            StatePrevWord = 0x01,       ///< The previous byte is a word character
+            StateBolOk = 0x02,          ///< '^' holds before the next byte
+            StateNotEol = 0x04,         ///< match_not_eol
+            StateMatched = 0x08,        ///< The program reached Match before the last byte
+            StateIdentityMask = 0x0f,
+
+            StateStartOnly = 0x10,      ///< Unanchored state without threads, only a new match can start
+            StateDead = 0x20            ///< Anchored state without threads
+        };
+
+        enum EndMatchFlags : uint8_t
+        {
+            EndMatchKnown = 0x01,
+            EndMatchResult = 0x02,
+            EndMatchNotEowShift = 2     ///< Same bits for match_not_eow
+        };
+
+        struct KernelHash
+        {
+            size_t operator()(const VStd::vector<uint32_t>& kernel) const
+            {
+                return VStd::hash_range(kernel.begin(), kernel.end());
+            }
+        };
+    } // namespace RegexAutomatonInternal
+
+    using namespace RegexAutomatonInternal;
+
+    /// Assertion inputs at a text position.
+    struct RegexAutomaton::Context
+    {
+        bool AtBol;
+        bool AtEol;
+        bool PrevWord;
+        bool NextWord;
+        bool NotEow;
+
+        bool IsWordBoundary() const { return !NotEow && PrevWord != NextWord; }
+    };
+
+    //=========================================================================
+    // DfaCache
+    //=========================================================================
+
+    /**
+     * DFA states of one search mode. A state is the sorted set of program counters that resume after the last byte
+     * (the kernel) and the StateFlags of the context before the next byte. The closure of the kernel is only taken
+     * when a transition is computed, once the next byte, and so the result of the assertions, is known.
+     *
+     * States live in chunks that are never moved, searches read the transitions without locking. Transitions are
+     * -1 until computed and are published after the state they point to, computing them takes the mutex.
+     */
+    class RegexAutomaton::DfaCache
+    {
+    public:
+        V_CLASS_ALLOCATOR(DfaCache, V::SystemAllocator, 0);
+
+        static constexpr int32_t UnknownState = -1;
+        static constexpr uint32_t ChunkSize = 64;
+        static constexpr uint32_t MaxStates = 2048;
+        static constexpr uint32_t NumStartStates = 8;
+
+        struct Chunk
+        {
+            V_CLASS_ALLOCATOR(Chunk, V::SystemAllocator, 0);
+
+            VStd::atomic<int32_t>* Transitions;     ///< ChunkSize * number of byte classes
+            uint8_t Flags[ChunkSize];
+            VStd::atomic<uint8_t> EndMatch[ChunkSize];
+        };
+
+        DfaCache(const RegexAutomaton& owner, bool isAnchored)
+            : m_owner(owner)
+            , m_isAnchored(isAnchored)
+            , m_numClasses(owner.m_numByteClasses)
+        {
+            for (VStd::atomic<Chunk*>& chunk : m_chunks)
+            {
+                chunk.store(nullptr, VStd::memory_order_relaxed);
+            }
+            for (VStd::atomic<int32_t>& startState : m_startStates)
+            {
+                startState.store(UnknownState, VStd::memory_order_relaxed);
+            }
+            m_visited.resize(owner.m_program.size(), 0);
+        }
+
+        ~DfaCache()
+        {
+            for (VStd::atomic<Chunk*>& chunkPtr : m_chunks)
+            {
+                Chunk* chunk = chunkPtr.load(VStd::memory_order_relaxed);
+                if (chunk)
+                {
+                    vfree(chunk->Transitions);
+                    delete chunk;
+                }
+            }
+        }
+
+        V_FORCE_INLINE uint8_t GetFlags(int32_t state) const
+        {
+            return m_chunks[state / ChunkSize].load(VStd::memory_order_acquire)->Flags[state % ChunkSize];
+        }
+
+        /// Next state after a byte of byteClass, UnknownState if the state budget is used up.
+        V_FORCE_INLINE int32_t GetTransition(int32_t state, uint32_t byteClass)
+        {
+            const Chunk* chunk = m_chunks[state / ChunkSize].load(VStd::memory_order_acquire);
+            const int32_t next = chunk->Transitions[(state % ChunkSize) * m_numClasses + byteClass].load(VStd::memory_order_acquire);
+            return next != UnknownState ? next : ComputeTransition(state, byteClass);
+        }
+
+        /// State at a text position, startFlags are the identity StateFlags without StateMatched.
+        int32_t GetStartState(uint32_t startFlags)
+        {
+            const int32_t state = m_startStates[startFlags].load(VStd::memory_order_acquire);
+            if (state != UnknownState)
+            {
+                return state;
+            }
+
+            VStd::lock_guard<VStd::mutex> lock(m_mutex);
+            m_kernel.clear();
+            if (m_isAnchored)
+            {
+                m_kernel.push_back(0);
+            }
+            const int32_t newState = InternState(static_cast<uint8_t>(startFlags));
+            if (newState != UnknownState)
+            {
+                m_startStates[startFlags].store(newState, VStd::memory_order_release);
+            }
+            return newState;
+        }
+
+        /// Whether the program matches at the end of the text from state.
+        bool MatchesAtEnd(int32_t state, bool notEow)
+        {
+            Chunk* chunk = m_chunks[state / ChunkSize].load(VStd::memory_order_acquire);
+            const uint32_t shift = notEow ? EndMatchNotEowShift : 0;
+            const uint8_t known = chunk->EndMatch[state % ChunkSize].load(VStd::memory_order_acquire) >> shift;
+            if (known & EndMatchKnown)
+            {
+                return (known & EndMatchResult) != 0;
+            }
+
+            VStd::lock_guard<VStd::mutex> lock(m_mutex);
+            const uint8_t flags = chunk->Flags[state % ChunkSize];
+            Context context;
+            context.AtBol = (flags & StateBolOk) != 0;
+            context.AtEol = (flags & StateNotEol) == 0;
+            context.PrevWord = (flags & StatePrevWord) != 0;
+            context.NextWord = false;
+            context.NotEow = notEow;
+            const bool isMatch = Closure(state, context);
+            chunk->EndMatch[state % ChunkSize].fetch_or(static_cast<uint8_t>((EndMatchKnown | (isMatch ? EndMatchResult : 0)) << shift), VStd::memory_order_release);
+            return isMatch;
+        }
+
+    private:
+        int32_t ComputeTransition(int32_t state, uint32_t byteClass)
+        {
+            VStd::lock_guard<VStd::mutex> lock(m_mutex);
+            Chunk* chunk = m_chunks[state / ChunkSize].load(VStd::memory_order_relaxed);
+            VStd::atomic<int32_t>& transition = chunk->Transitions[(state % ChunkSize) * m_numClasses + byteClass];
+            const int32_t known = transition.load(VStd::memory_order_relaxed);
+            if (known != UnknownState)
+            {
+                return known;
+            }
+
+            const uint8_t byte = m_owner.m_classRepresentatives[byteClass];
+            const bool isWordByte = m_owner.IsWordByte(byte);
+            const uint8_t flags = chunk->Flags[state % ChunkSize];
+            Context context;
+            context.AtBol = (flags & StateBolOk) != 0;
+            context.AtEol = (flags & StateNotEol) == 0 && byte == '\n';
+            context.PrevWord = (flags & StatePrevWord) != 0;
+            context.NextWord = isWordByte;
+            context.NotEow = false;
+            const bool isMatch = Closure(state, context);
+
+            m_kernel.clear();
+            for (uint32_t pc : m_consumers)
+            {
+                if (m_owner.m_byteSets[m_owner.m_program[pc].X].Contains(byte))
+                {
+                    m_kernel.push_back(pc + 1);
+                }
+            }
+            VStd::sort(m_kernel.begin(), m_kernel.end());
+            m_kernel.erase(VStd::unique(m_kernel.begin(), m_kernel.end()), m_kernel.end());
+
+            const uint8_t nextFlags = static_cast<uint8_t>((isWordByte ? StatePrevWord : 0)
+                | (byte == '\n' ? StateBolOk : 0)
+                | (flags & StateNotEol)
+                | (isMatch ? StateMatched : 0));
+            const int32_t next = InternState(nextFlags);
+            if (next != UnknownState)
+            {
+                transition.store(next, VStd::memory_order_release);
+            }
+            return next;
+        }
+
+        /// Follows the non consuming instructions from the kernel (and the start of the program when unanchored).
+        /// Collects the ByteSet instructions in m_consumers and returns whether Match is reachable.
+        bool Closure(int32_t state, const Context& context)
+        {
+            return Closure(m_kernelData.data() + m_kernelOffsets[state], m_kernelOffsets[state + 1] - m_kernelOffsets[state], context);
+        }
+
+        bool Closure(const uint32_t* kernel, size_t kernelSize, const Context& context)
+        {
+            if (++m_generation == 0)
+            {
+                VStd::fill(m_visited.begin(), m_visited.end(), 0u);
+                m_generation = 1;
+            }
+
+            m_consumers.clear();
+            m_stack.clear();
+            if (!m_isAnchored)
+            {
+                m_stack.push_back(0);
+            }
+            for (size_t i = kernelSize; i-- > 0;)
+            {
+                m_stack.push_back(kernel[i]);
+            }
+
+            bool isMatch = false;
+            while (!m_stack.empty())
+            {
+                uint32_t pc = m_stack.back();
+                m_stack.pop_back();
+                for (;;)
+                {
+                    if (m_visited[pc] == m_generation)
+                    {
+                        break;
+                    }
+                    m_visited[pc] = m_generation;
+
+                    const Instruction& instruction = m_owner.m_program[pc];
+                    bool isFollowed = true;
+                    switch (instruction.Op)
+                    {
+                    case OpCode::ByteSet:
+                        m_consumers.push_back(pc);
+                        isFollowed = false;
+                        break;
+                    case OpCode::Match:
+                        isMatch = true;
+                        isFollowed = false;
+                        break;
+                    case OpCode::Split:
+                        m_stack.push_back(instruction.Y);
+                        pc = instruction.X;
+                        continue;
+                    case OpCode::Jump:
+                        pc = instruction.X;
+                        continue;
+                    case OpCode::CaptureBegin:
+                    case OpCode::CaptureEnd:
+                        break;
+                    case OpCode::AssertBol:
+                        isFollowed = context.AtBol;
+                        break;
+                    case OpCode::AssertEol:
+                        isFollowed = context.AtEol;
+                        break;
+                    case OpCode::WordBoundary:
+                        isFollowed = context.IsWordBoundary();
+                        break;
+                    case OpCode::NotWordBoundary:
+                        isFollowed = !context.IsWordBoundary();
+                        break;
+                    }
+                    if (!isFollowed)
+                    {
+                        break;
+                    }
+                    ++pc;
+                }
+            }
+            return isMatch;
+        }
+
+        /// Returns the state of m_kernel and flags, adds it if it's new. UnknownState once the budget is used up.
+        int32_t InternState(uint8_t flags)
+        {
+            m_kernel.push_back(flags);
+            auto found = m_stateIds.find(m_kernel);
+            if (found != m_stateIds.end())
+            {
+                m_kernel.pop_back();
+                return found->second;
+            }
+            if (m_numStates == MaxStates || m_kernelData.size() + m_kernel.size() > MaxKernelData)
+            {
+                m_kernel.pop_back();
+                return UnknownState;
+            }
+
+            const int32_t state = static_cast<int32_t>(m_numStates++);
+            Chunk* chunk = m_chunks[state / ChunkSize].load(VStd::memory_order_relaxed);
+            if (!chunk)
+            {
+                chunk = vnew Chunk;
+                const size_t numTransitions = size_t(ChunkSize) * m_numClasses;
+                chunk->Transitions = reinterpret_cast<VStd::atomic<int32_t>*>(vmalloc(numTransitions * sizeof(VStd::atomic<int32_t>), alignof(VStd::atomic<int32_t>)));
+                for (size_t i = 0; i < numTransitions; ++i)
+                {
+                    new (&chunk->Transitions[i]) VStd::atomic<int32_t>(UnknownState);
+                }
+                for (VStd::atomic<uint8_t>& endMatch : chunk->EndMatch)
+                {
+                    endMatch.store(0, VStd::memory_order_relaxed);
+                }
+                m_chunks[state / ChunkSize].store(chunk, VStd::memory_order_release);
+            }
+
+            const bool isEmpty = m_kernel.size() == 1;
+            uint8_t stateFlags = flags;
+            if (isEmpty && !(flags & StateMatched))
+            {
+                stateFlags |= m_isAnchored ? StateDead : StateStartOnly;
+            }
+            chunk->Flags[state % ChunkSize] = stateFlags;
+
+            m_stateIds.emplace(m_kernel, state);
+            m_kernel.pop_back();
+            m_kernelData.insert(m_kernelData.end(), m_kernel.begin(), m_kernel.end());
+            m_kernelOffsets.push_back(static_cast<uint32_t>(m_kernelData.size()));
+            return state;
+        }
+
+        const RegexAutomaton& m_owner;
+        const bool m_isAnchored;
+        const uint32_t m_numClasses;
+
+        VStd::atomic<Chunk*> m_chunks[MaxStates / ChunkSize];
+        VStd::atomic<int32_t> m_startStates[NumStartStates];
+
+        // Guarded by m_mutex
+        VStd::mutex m_mutex;
+        uint32_t m_numStates = 0;
+        VStd::unordered_map<VStd::vector<uint32_t>, int32_t, KernelHash> m_stateIds;
+        VStd::vector<uint32_t> m_kernelData;
+        VStd::vector<uint32_t> m_kernelOffsets = { 0 };  ///< Kernel of each state in m_kernelData
+        VStd::vector<uint32_t> m_kernel;
+        VStd::vector<uint32_t> m_consumers;
+        VStd::vector<uint32_t> m_stack;
+        VStd::vector<uint32_t> m_visited;
+        uint32_t m_generation = 0;
+    };
+
+    //=========================================================================
+    // Pike VM
+    //=========================================================================
+
+    /// Threads of the Pike VM at one text position in priority order, at most one per instruction.
+    struct RegexAutomaton::ThreadList
+    {
+        struct Thread
+        {
+            uint32_t Pc;
+            uint32_t SlotOffset;
+        };
+
+        explicit ThreadList(size_t programSize)
+            : Sparse(programSize, 0)
+            , Dense(programSize, 0)
+        {
+        }
+
+        bool Contains(uint32_t pc) const    { return Sparse[pc] < Size && Dense[Sparse[pc]] == pc; }
+        void Insert(uint32_t pc)            { Sparse[pc] = Size; Dense[Size++] = pc; }
+
+        void AddThread(uint32_t pc, const char* const* slots, uint32_t numSlots)
+        {
+            Threads.push_back({ pc, static_cast<uint32_t>(Slots.size()) });
+            Slots.insert(Slots.end(), slots, slots + numSlots);
+        }
+
+        void Clear()
+        {
+            Size = 0;
+            Threads.clear();
+            Slots.clear();
+        }
+
+        VStd::vector<uint32_t> Sparse;
+        VStd::vector<uint32_t> Dense;
+        uint32_t Size = 0;
+        VStd::vector<Thread> Threads;       ///< ByteSet and Match instructions, they own capture slots
+        VStd::vector<const char*> Slots;
+    };
+
+    /// Scratch memory of AddThread.
+    struct RegexAutomaton::PikeScratch
+    {
+        /// Explores Pc when Slot is InvalidIndex, otherwise restores Slot to Value.
+        struct Job
+        {
+            uint32_t Pc;
+            uint32_t Slot;
+            const char* Value;
+        };
+
+        VStd::vector<Job> Stack;
+        VStd::vector<const char*> Slots;    ///< Slots of the thread being added
+    };
+
+    void RegexAutomaton::AddThread(ThreadList& list, uint32_t startPc, const char* position, const Context& context, PikeScratch& scratch) const
+    {
+        const uint32_t numSlots = static_cast<uint32_t>(scratch.Slots.size());
+        scratch.Stack.push_back({ startPc, InvalidIndex, nullptr });
+        while (!scratch.Stack.empty())
+        {
+            const PikeScratch::Job job = scratch.Stack.back();
+            scratch.Stack.pop_back();
+            if (job.Slot != InvalidIndex)
+            {
+                scratch.Slots[job.Slot] = job.Value;
+                continue;
+            }
+
+            uint32_t pc = job.Pc;
+            for (;;)
+            {
+                if (list.Contains(pc))
+                {
+                    break;
+                }
+                list.Insert(pc);
+
+                const Instruction& instruction = m_program[pc];
+                bool isFollowed = true;
+                switch (instruction.Op)
+                {
+                case OpCode::ByteSet:
+                case OpCode::Match:
+                    list.AddThread(pc, scratch.Slots.data(), numSlots);
+                    isFollowed = false;
+                    break;
+                case OpCode::Split:
+                    scratch.Stack.push_back({ instruction.Y, InvalidIndex, nullptr });
+                    pc = instruction.X;
+                    continue;
+                case OpCode::Jump:
+                    pc = instruction.X;
+                    continue;
+                case OpCode::CaptureBegin:
+                    if (numSlots)
+                    {
+                        // Like the backtracking matcher, starting a group invalidates the groups after it
+                        const uint32_t group = instruction.X;
+                        scratch.Stack.push_back({ 0, group * 2, scratch.Slots[group * 2] });
+                        scratch.Slots[group * 2] = position;
+                        for (uint32_t slot = group * 2 + 3; slot < numSlots; slot += 2)
+                        {
+                            if (scratch.Slots[slot])
+                            {
+                                scratch.Stack.push_back({ 0, slot, scratch.Slots[slot] });
+                                scratch.Slots[slot] = nullptr;
+                            }
+                        }
+                    }
+                    break;
+                case OpCode::CaptureEnd:
+                    if (numSlots)
+                    {
+                        const uint32_t slot = instruction.X * 2 + 1;
+                        scratch.Stack.push_back({ 0, slot, scratch.Slots[slot] });
+                        scratch.Slots[slot] = position;
+                    }
+                    break;
+                case OpCode::AssertBol:
+                    isFollowed = context.AtBol;
+                    break;
+                case OpCode::AssertEol:
+                    isFollowed = context.AtEol;
+                    break;
+                case OpCode::WordBoundary:
+                    isFollowed = context.IsWordBoundary();
+                    break;
+                case OpCode::NotWordBoundary:
+                    isFollowed = !context.IsWordBoundary();
+                    break;
+                }
+                if (!isFollowed)
+                {
+                    break;
+                }
+                ++pc;
+            }
+        }
+    }
+
+    bool RegexAutomaton::PikeSearch(const char* first, const char* last, uint32_t flags, const char** captures) const
+    {
+        const bool isAnchored = (flags & (MatchContinuous | MatchFull)) != 0;
+        const bool isFull = (flags & MatchFull) != 0;
+        const uint32_t numSlots = captures ? m_numGroups * 2 : 0;
+
+        ThreadList lists[2] = { ThreadList(m_program.size()), ThreadList(m_program.size()) };
+        ThreadList* current = &lists[0];
+        ThreadList* next = &lists[1];
+        PikeScratch scratch;
+        scratch.Slots.resize(numSlots, nullptr);
+        VStd::vector<const char*> matchSlots(numSlots, nullptr);
+        bool isMatched = false;
+
+        const char* position = first;
+        Context context = MakeContext(position, first, last, flags);
+        for (;;)
+        {
+            if (!isMatched && (!isAnchored || position == first))
+            {
+                if (current->Threads.empty() && !isAnchored && !m_literalPrefix.empty())
+                {
+                    const char* found = FindLiteralPrefix(position, last);
+                    if (!found)
+                    {
+                        break;
+                    }
+                    if (found != position)
+                    {
+                        position = found;
+                        context = MakeContext(position, first, last, flags);
+                    }
+                }
+                // A match starting here has the lowest priority
+                VStd::fill(scratch.Slots.begin(), scratch.Slots.end(), nullptr);
+                AddThread(*current, 0, position, context, scratch);
+            }
+            const bool isAtEnd = position == last;
+            if (current->Threads.empty())
+            {
+                if (isMatched || isAnchored || isAtEnd)
+                {
+                    break;
+                }
+                current->Clear();
+                ++position;
+                context = MakeContext(position, first, last, flags);
+                continue;
+            }
+
+            Context nextContext = context;
+            if (!isAtEnd)
+            {
+                nextContext = MakeContext(position + 1, first, last, flags);
+            }
+
+            next->Clear();
+            for (const ThreadList::Thread& thread : current->Threads)
+            {
+                const Instruction& instruction = m_program[thread.Pc];
+                if (instruction.Op == OpCode::Match)
+                {
+                    if (isFull && !isAtEnd)
+                    {
+                        continue;
+                    }
+                    if (!captures)
+                    {
+                        return true;
+                    }
+                    // Threads with a lower priority can't change the match
+                    isMatched = true;
+                    VStd::copy(current->Slots.begin() + thread.SlotOffset, current->Slots.begin() + thread.SlotOffset + numSlots, matchSlots.begin());
+                    break;
+                }
+                if (!isAtEnd && m_byteSets[instruction.X].Contains(static_cast<uint8_t>(*position)))
+                {
+                    VStd::copy(current->Slots.begin() + thread.SlotOffset, current->Slots.begin() + thread.SlotOffset + numSlots, scratch.Slots.begin());
+                    AddThread(*next, thread.Pc + 1, position + 1, nextContext, scratch);
+                }
+            }
+            VStd::swap(current, next);
+            if (isAtEnd)
+            {
+                break;
+            }
+            ++position;
+            context = nextContext;
+        }
+
+        if (isMatched)
+        {
+            for (uint32_t group = 0; group < m_numGroups; ++group)
+            {
+                const bool isGroupMatched = matchSlots[group * 2 + 1] != nullptr;
+                captures[group * 2] = isGroupMatched ? matchSlots[group * 2] : nullptr;
+                captures[group * 2 + 1] = isGroupMatched ? matchSlots[group * 2 + 1] : nullptr;
+            }
+        }
+        return isMatched;
+    }
+
+    //=========================================================================
+    // Search
+    //=========================================================================
+
+    RegexAutomaton::Context RegexAutomaton::MakeContext(const char* position, const char* first, const char* last, uint32_t flags) const
+    {
+        const bool hasPrevious = position != first || (flags & MatchPrevAvail);
+        Context context;
+        context.AtBol = !hasPrevious || position[-1] == '\n';
+        context.AtEol = !(flags & MatchNotEol) && (position == last || *position == '\n');
+        context.PrevWord = hasPrevious && IsWordByte(static_cast<uint8_t>(position[-1]));
+        context.NextWord = position != last && IsWordByte(static_cast<uint8_t>(*position));
+        context.NotEow = position == last && (flags & MatchNotEow);
+        return context;
+    }
+
+    const char* RegexAutomaton::FindLiteralPrefix(const char* first, const char* last) const
+    {
+        const size_t literalSize = m_literalPrefix.size();
+        const char* literal = m_literalPrefix.data();
+        if (static_cast<size_t>(last - first) < literalSize)
+        {
+            return nullptr;
+        }
+        if (literalSize == 1)
+        {
+            return static_cast<const char*>(memchr(first, literal[0], last - first));
+        }
+
+        const char* candidate = first;
+        const char* lastCandidate = last - literalSize;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        // Compares the first and last literal bytes at 16 positions at once, then verifies the candidates
+        const __m128i firstBlock = _mm_set1_epi8(literal[0]);
+        const __m128i lastBlock = _mm_set1_epi8(literal[literalSize - 1]);
+        for (; candidate + 16 <= lastCandidate + 1; candidate += 16)
+        {
+            const __m128i firstBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate));
+            const __m128i lastBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate + literalSize - 1));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(firstBytes, firstBlock), _mm_cmpeq_epi8(lastBytes, lastBlock))));
+            while (mask)
+            {
+                const char* match = candidate + v_ctz_u32(mask);
+                if (memcmp(match + 1, literal + 1, literalSize - 2) == 0)
+                {
+                    return match;
+                }
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; candidate <= lastCandidate; ++candidate)
+        {
+            candidate = static_cast<const char*>(memchr(candidate, literal[0], lastCandidate - candidate + 1));
+            if (!candidate)
+            {
+                return nullptr;
+            }
+            if (memcmp(candidate + 1, literal + 1, literalSize - 1) == 0)
+            {
+                return candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    RegexAutomaton::SearchResult RegexAutomaton::DfaSearch(const char* first, const char* last, uint32_t flags) const
+    {
+        const bool isAnchored = (flags & (MatchContinuous | MatchFull)) != 0;
+        const bool isFull = (flags & MatchFull) != 0;
+        const uint32_t notEolFlag = (flags & MatchNotEol) ? StateNotEol : 0;
+        DfaCache& dfa = *m_dfa[isAnchored];
+
+        const Context startContext = MakeContext(first, first, last, flags);
+        int32_t state = dfa.GetStartState((startContext.AtBol ? StateBolOk : 0) | (startContext.PrevWord ? StatePrevWord : 0) | notEolFlag);
+        if (state == DfaCache::UnknownState)
+        {
+            return OutOfStates;
+        }
+
+        const char* position = first;
+        for (;;)
+        {
+            const uint8_t stateFlags = dfa.GetFlags(state);
+            if ((stateFlags & StateMatched) && !isFull)
+            {
+                return Matched;
+            }
+            if (stateFlags & StateDead)
+            {
+                return NoMatch;
+            }
+            if (position == last)
+            {
+                break;
+            }
+            if ((stateFlags & StateStartOnly) && !m_literalPrefix.empty())
+            {
+                const char* found = FindLiteralPrefix(position, last);
+                if (!found)
+                {
+                    return NoMatch;
+                }
+                if (found != position)
+                {
+                    position = found;
+                    const uint8_t previous = static_cast<uint8_t>(position[-1]);
+                    state = dfa.GetStartState((previous == '\n' ? StateBolOk : 0) | (IsWordByte(previous) ? StatePrevWord : 0) | notEolFlag);
+                    if (state == DfaCache::UnknownState)
+                    {
+                        return OutOfStates;
+                    }
+                }
+            }
+
+            state = dfa.GetTransition(state, m_byteClasses[static_cast<uint8_t>(*position)]);
+            if (state == DfaCache::UnknownState)
+            {
+                return OutOfStates;
+            }
+            ++position;
+        }
+        return dfa.MatchesAtEnd(state, (flags & MatchNotEow) != 0) ? Matched : NoMatch;
+    }
+
+    bool RegexAutomaton::Search(const char* first, const char* last, uint32_t flags, const char** captures) const
+    {
+        const SearchResult result = DfaSearch(first, last, flags);
+        if (result == NoMatch)
+        {
+            return false;
+        }
+        if (result == Matched && !captures)
+        {
+            return true;
+        }
+        return PikeSearch(first, last, flags, captures);
+    }
+
+    //=========================================================================
+    // Construction
+    //=========================================================================
+
+    RegexAutomaton::RegexAutomaton(uint32_t numGroups)
+        : m_numGroups(numGroups)
+    {
+        for (uint32_t byte = 0; byte < 256; ++byte)
+        {
+            if ((byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') || byte == '_')
+            {
+                m_wordBytes.Set(static_cast<uint8_t>(byte));
+            }
+        }
+    }
+
+    RegexAutomaton::~RegexAutomaton()
+    {
+        delete m_dfa[0];
+        delete m_dfa[1];
+    }
+
+    uint32_t RegexAutomaton::Emit(OpCode op, uint32_t x, uint32_t y)
+    {
+        if (m_program.size() >= MaxInstructions)
+        {
+            m_isTooLarge = true;
+            return InvalidIndex;
+        }
+        m_program.push_back({ op, x, y });
+        return static_cast<uint32_t>(m_program.size() - 1);
+    }
+
+    uint32_t RegexAutomaton::EmitByteSet(const ByteSet& bytes)
+    {
+        const uint32_t pc = Emit(OpCode::ByteSet, static_cast<uint32_t>(m_byteSets.size()), 0);
+        if (pc != InvalidIndex)
+        {
+            m_byteSets.push_back(bytes);
+        }
+        return pc;
+    }
+
+    uint32_t RegexAutomaton::EmitSplit(uint32_t preferred, uint32_t other)  { return Emit(OpCode::Split, preferred, other); }
+    uint32_t RegexAutomaton::EmitJump(uint32_t target)                      { return Emit(OpCode::Jump, target, 0); }
+    uint32_t RegexAutomaton::EmitCaptureBegin(uint32_t group)               { return Emit(OpCode::CaptureBegin, group, 0); }
+    uint32_t RegexAutomaton::EmitCaptureEnd(uint32_t group)                 { return Emit(OpCode::CaptureEnd, group, 0); }
+    uint32_t RegexAutomaton::EmitAssert(OpCode op)                          { return Emit(op, 0, 0); }
+    uint32_t RegexAutomaton::EmitMatch()                                    { return Emit(OpCode::Match, 0, 0); }
+
+    void RegexAutomaton::PatchTargets(uint32_t pc, uint32_t x, uint32_t y)
+    {
+        if (pc != InvalidIndex)
+        {
+            m_program[pc].X = x;
+            m_program[pc].Y = y;
+        }
+    }
+
+    bool RegexAutomaton::Finalize()
+    {
+        if (m_isTooLarge || m_program.empty())
+        {
+            return false;
+        }
+        const uint32_t programSize = GetProgramSize();
+        for (const Instruction& instruction : m_program)
+        {
+            const bool isTargetValid = instruction.Op == OpCode::Split ? instruction.X < programSize && instruction.Y < programSize
+                : instruction.Op == OpCode::Jump ? instruction.X < programSize
+                : instruction.Op == OpCode::CaptureBegin || instruction.Op == OpCode::CaptureEnd ? instruction.X < m_numGroups
+                : true;
+            if (!isTargetValid || (instruction.Op != OpCode::Match && &instruction == &m_program.back()))
+            {
+                return false;
+            }
+        }
+
+        ComputeByteClasses();
+        ComputeLiteralPrefix();
+        m_dfa[0] = vnew DfaCache(*this, false);
+        m_dfa[1] = vnew DfaCache(*this, true);
+        return true;
+    }
+
+    void RegexAutomaton::ComputeByteClasses()
+    {
+        // Refines the partition of the bytes with each set, bytes in the same class take the same transitions.
+        // '\n' and the word characters change the result of the assertions.
+        ByteSet newLine;
+        newLine.Set('\n');
+
+        uint32_t numClasses = 1;
+        auto refine = [this, &numClasses](const ByteSet& bytes)
+        {
+            int16_t remap[256][2];
+            memset(remap, 0xff, sizeof(remap));
+            uint32_t newNumClasses = 0;
+            for (uint32_t byte = 0; byte < 256; ++byte)
+            {
+                int16_t& newClass = remap[m_byteClasses[byte]][bytes.Contains(static_cast<uint8_t>(byte))];
+                if (newClass < 0)
+                {
+                    newClass = static_cast<int16_t>(newNumClasses++);
+                }
+                m_byteClasses[byte] = static_cast<uint8_t>(newClass);
+            }
+            numClasses = newNumClasses;
+        };
+
+        refine(newLine);
+        refine(m_wordBytes);
+        for (const ByteSet& bytes : m_byteSets)
+        {
+            if (numClasses == 256)
+            {
+                break;
+            }
+            refine(bytes);
+        }
+
+        m_numByteClasses = numClasses;
+        for (uint32_t byte = 256; byte-- > 0;)
+        {
+            m_classRepresentatives[m_byteClasses[byte]] = static_cast<uint8_t>(byte);
+        }
+    }
+
+    void RegexAutomaton::ComputeLiteralPrefix()
+    {
+        // Follows the instructions every match goes through until the first choice
+        static constexpr size_t MaxLiteralSize = 64;
+        uint32_t pc = 0;
+        for (uint32_t steps = 0; steps < MaxInstructions && m_literalPrefix.size() < MaxLiteralSize; ++steps)
+        {
+            const Instruction& instruction = m_program[pc];
+            if (instruction.Op == OpCode::Jump)
+            {
+                pc = instruction.X;
+                continue;
+            }
+            if (instruction.Op == OpCode::ByteSet)
+            {
+                const ByteSet& bytes = m_byteSets[instruction.X];
+                int byte = -1;
+                for (uint32_t word = 0; word < 4; ++word)
+                {
+                    const uint64_t bits = bytes.Bits[word];
+                    if (bits == 0)
+                    {
+                        continue;
+                    }
+                    if ((bits & (bits - 1)) != 0 || byte >= 0)
+                    {
+                        return;
+                    }
+                    byte = static_cast<int>(word * 64 + v_ctz_u64(bits));
+                }
+                if (byte < 0)
+                {
+                    return;
+                }
+                m_literalPrefix.push_back(static_cast<char>(byte));
+            }
+            else if (instruction.Op == OpCode::Split || instruction.Op == OpCode::Match)
+            {
+                return;
+            }
+            ++pc;
+        }
+    }
+} // namespace VStd
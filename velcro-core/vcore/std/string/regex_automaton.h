@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Contributors to the VelcroFramework.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#ifndef V_FRAMEWORK_CORE_STD_STRING_REGEX_AUTOMATON_H
+#define V_FRAMEWORK_CORE_STD_STRING_REGEX_AUTOMATON_H
+
+#include <vcore/std/base.h>
+#include <vcore/std/containers/vector.h>
+#include <vcore/memory/system_allocator.h>
+
+namespace VStd
+{
+    /**
+     * Automaton matcher for the regular subset of the regex grammar: characters, classes, '.', '^', '$', \b, \B,
+     * alternatives, groups and repetitions. Back references and look ahead assertions are not regular, patterns
+     * that use them are left to the backtracking Matcher (see basic_regex).
+     *
+     * The pattern is compiled to a Thompson NFA program over bytes. regex_match/regex_search without sub matches run
+     * a DFA whose states are built lazily the first time a transition is taken, so matching is linear in the text and
+     * there are no exponential cases. When sub matches are needed the DFA rejects texts without a match and a Pike VM,
+     * which simulates the NFA with one thread per instruction, finds the leftmost match and its captures with the
+     * leftmost first priorities of ECMAScript: earlier alternatives first, greedy repetitions as long as possible.
+     * Searches skip to the occurrences of the literal prefix of the pattern with a SIMD scan, if it has one.
+     *
+     * Matching is thread safe, threads share the DFA states. The DFA has a state budget, once it is used up the
+     * searches that need new states fall back to the Pike VM.
+     */
+    class RegexAutomaton
+    {
+    public:
+        V_CLASS_ALLOCATOR(RegexAutomaton, V::SystemAllocator, 0);
+
+        /// Upper bound of the program size, bounded repetitions are expanded so x{1000}{1000} is rejected.
+        static constexpr uint32_t MaxInstructions = 16 * 1024;
+        static constexpr uint32_t InvalidIndex = 0xffffffff;
+
+        enum class OpCode : uint8_t
+        {
+            ByteSet,            ///< Consume one byte in m_byteSets[X]
+            Split,              ///< Continue at X, then at Y with lower priority
+            Jump,               ///< Continue at X
+            CaptureBegin,       ///< Start group X, the groups after it are reset
+            CaptureEnd,         ///< End group X
+            AssertBol,          ///< Beginning of text or after '\n'
+            AssertEol,          ///< End of text or before '\n'
+            WordBoundary,
+            NotWordBoundary,
+            Match
+        };
+
+        struct Instruction
+        {
+            OpCode Op;
+            uint32_t X;
+            uint32_t Y;
+        };
+
+        /// 256 bit set of the bytes an instruction accepts.
+        struct ByteSet
+        {
+            uint64_t Bits[4] = {};
+
+            void Set(uint8_t byte)                  { Bits[byte >> 6] |= uint64_t(1) << (byte & 63); }
+            bool Contains(uint8_t byte) const       { return (Bits[byte >> 6] >> (byte & 63)) & 1; }
+            bool operator==(const ByteSet& rhs) const
+            {
+                return Bits[0] == rhs.Bits[0] && Bits[1] == rhs.Bits[1] && Bits[2] == rhs.Bits[2] && Bits[3] == rhs.Bits[3];
+            }
+        };
+
+        /// Match options, mirror regex_constants::match_flag_type. match_not_bol and match_not_bow are not supported,
+        /// the backtracking matcher applies them at each position it retries the search from.
+        enum MatchFlags : uint32_t
+        {
+            MatchNone = 0,
+            MatchNotEol = 0x01,
+            MatchNotEow = 0x02,
+            MatchPrevAvail = 0x04,
+            MatchContinuous = 0x08,     ///< Only matches starting at first
+            MatchFull = 0x10            ///< Only matches spanning [first, last), regex_match
+        };
+
+        explicit RegexAutomaton(uint32_t numGroups);
+        ~RegexAutomaton();
+
+        RegexAutomaton(const RegexAutomaton&) = delete;
+        RegexAutomaton& operator=(const RegexAutomaton&) = delete;
+
+        //////////////////////////////////////////////////////////////////////////
+        // Program construction. The program starts at instruction 0 and ends with Match, a non consuming instruction
+        // continues at the next one. Each Emit returns the index of the new instruction, or InvalidIndex once the
+        // program is larger than MaxInstructions.
+        uint32_t EmitByteSet(const ByteSet& bytes);
+        uint32_t EmitSplit(uint32_t preferred, uint32_t other);
+        uint32_t EmitJump(uint32_t target);
+        uint32_t EmitCaptureBegin(uint32_t group);
+        uint32_t EmitCaptureEnd(uint32_t group);
+        uint32_t EmitAssert(OpCode op);
+        uint32_t EmitMatch();
+
+        /// Index of the next instruction.
+        uint32_t GetProgramSize() const         { return static_cast<uint32_t>(m_program.size()); }
+        bool IsTooLarge() const                 { return m_isTooLarge; }
+        /// Sets the targets of a Split or Jump emitted before them, ignores InvalidIndex.
+        void PatchTargets(uint32_t pc, uint32_t x, uint32_t y = 0);
+
+        /// Prepares the program for matching once it is complete, returns false if it can't be used.
+        bool Finalize();
+        //////////////////////////////////////////////////////////////////////////
+
+        uint32_t GetNumGroups() const           { return m_numGroups; }
+
+        /**
+         * Looks for a match in [first, last). first[-1] is read with MatchPrevAvail.
+         * captures is null when only the result matters, otherwise it receives the begin and end of each group,
+         * 2 * GetNumGroups() pointers, null for the groups that didn't participate.
+         */
+        bool Search(const char* first, const char* last, uint32_t flags, const char** captures) const;
+
+    private:
+        struct Context;
+        struct ThreadList;
+        struct PikeScratch;
+        class DfaCache;
+
+        enum SearchResult
+        {
+            NoMatch,
+            Matched,
+            OutOfStates     ///< The DFA ran out of its state budget, use the Pike VM
+        };
+
+        bool IsWordByte(uint8_t byte) const     { return m_wordBytes.Contains(byte); }
+        Context MakeContext(const char* position, const char* first, const char* last, uint32_t flags) const;
+        const char* FindLiteralPrefix(const char* first, const char* last) const;
+
+        SearchResult DfaSearch(const char* first, const char* last, uint32_t flags) const;
+        bool PikeSearch(const char* first, const char* last, uint32_t flags, const char** captures) const;
+        void AddThread(ThreadList& list, uint32_t startPc, const char* position, const Context& context, PikeScratch& scratch) const;
+
+        uint32_t Emit(OpCode op, uint32_t x, uint32_t y);
+        void ComputeByteClasses();
+        void ComputeLiteralPrefix();
+
+        VStd::vector<Instruction> m_program;
+        VStd::vector<ByteSet> m_byteSets;
+        uint32_t m_numGroups;
+        bool m_isTooLarge = false;
+
+        ByteSet m_wordBytes;
+        uint8_t m_byteClasses[256] = {};            ///< Bytes the program can't tell apart share a class
+        uint32_t m_numByteClasses = 0;
+        uint8_t m_classRepresentatives[256] = {};   ///< A byte of each class
+        VStd::vector<char> m_literalPrefix;         ///< Bytes every match starts with
+
+        DfaCache* m_dfa[2] = {};                    ///< States of the unanchored and the anchored searches
+    };
+} // namespace VStd
+
+#endif // V_FRAMEWORK_CORE_STD_STRING_REGEX_AUTOMATON_H
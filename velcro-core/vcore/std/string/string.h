@@ -2013,7 +2013,7 @@ namespace VStd
         typedef VStd::size_t                           result_type;
         inline result_type operator()(const argument_type& value) const
         {
-            return hash_string(value.begin(), value.length());
+            return hash_string_default(value.data(), value.length());
         }
     };
 
@@ -12,6 +12,14 @@
 #include <vcore/std/iterator.h>
 #include <vcore/std/limits.h>
 #include <vcore/casting/numeric_cast.h>
+#include <vcore/std/typetraits/is_constant_evaluated.h>
+#include <vcore/std/typetraits/is_unsigned.h>
+
+#include <string.h>
+
+#if defined(V_COMPILER_MSVC) && defined(_M_X64)
+#   include <intrin.h>
+#endif
 
 namespace VStd {
     namespace StringInternal {
@@ -883,6 +891,159 @@ namespace VStd {
         return hash;
     }
 
+    namespace StringInternal
+    {
+        // wyhash (final version 4) by Wang Yi, released into the public domain. https://github.com/wangyi-fudan/wyhash
+        // The input is read as little endian bytes, 8 at a time.
+        constexpr uint64_t wyhash_secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+        /// 64x64 to 128 bit multiply, a gets the low and b the high half.
+        constexpr void wyhash_multiply(uint64_t& a, uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t product = a;
+            product *= b;
+            a = static_cast<uint64_t>(product);
+            b = static_cast<uint64_t>(product >> 64);
+#else
+#   if defined(V_COMPILER_MSVC) && defined(_M_X64)
+            if (!VStd::is_constant_evaluated())
+            {
+                a = _umul128(a, b, &b);
+                return;
+            }
+#   endif
+            const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+            const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const uint64_t t = rl + (rm0 << 32);
+            uint64_t carry = t < rl ? 1 : 0;
+            const uint64_t lo = t + (rm1 << 32);
+            carry += lo < t ? 1 : 0;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+        }
+
+        constexpr uint64_t wyhash_mix(uint64_t a, uint64_t b)
+        {
+            wyhash_multiply(a, b);
+            return a ^ b;
+        }
+
+        /// Reads raw memory, only used at run time.
+        struct wyhash_byte_reader
+        {
+            const unsigned char* m_data;
+
+            uint64_t byte(size_t offset) const { return m_data[offset]; }
+            uint64_t read4(size_t offset) const { uint32_t value; memcpy(&value, m_data + offset, sizeof(value)); return value; }
+            uint64_t read8(size_t offset) const { uint64_t value; memcpy(&value, m_data + offset, sizeof(value)); return value; }
+        };
+
+        /// Reads the bytes of the elements one by one, in little endian order, so strings can be hashed in constant expressions.
+        template<class Element>
+        struct wyhash_element_reader
+        {
+            const Element* m_data;
+
+            constexpr uint64_t byte(size_t offset) const
+            {
+                using unit_type = make_unsigned_t<Element>;
+                return static_cast<uint8_t>(static_cast<unit_type>(m_data[offset / sizeof(Element)]) >> (8 * (offset % sizeof(Element))));
+            }
+            constexpr uint64_t read4(size_t offset) const
+            {
+                return byte(offset) | (byte(offset + 1) << 8) | (byte(offset + 2) << 16) | (byte(offset + 3) << 24);
+            }
+            constexpr uint64_t read8(size_t offset) const
+            {
+                return read4(offset) | (read4(offset + 4) << 32);
+            }
+        };
+
+        template<class Reader>
+        constexpr uint64_t wyhash(const Reader& reader, size_t length, uint64_t seed)
+        {
+            seed ^= wyhash_mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+            uint64_t a = 0;
+            uint64_t b = 0;
+            if (length <= 16)
+            {
+                if (length >= 4)
+                {
+                    const size_t middle = (length >> 3) << 2;
+                    a = (reader.read4(0) << 32) | reader.read4(middle);
+                    b = (reader.read4(length - 4) << 32) | reader.read4(length - 4 - middle);
+                }
+                else if (length > 0)
+                {
+                    a = (reader.byte(0) << 16) | (reader.byte(length >> 1) << 8) | reader.byte(length - 1);
+                }
+            }
+            else
+            {
+                size_t offset = 0;
+                size_t remaining = length;
+                if (remaining > 48)
+                {
+                    uint64_t seed1 = seed;
+                    uint64_t seed2 = seed;
+                    do
+                    {
+                        seed = wyhash_mix(reader.read8(offset) ^ wyhash_secret[1], reader.read8(offset + 8) ^ seed);
+                        seed1 = wyhash_mix(reader.read8(offset + 16) ^ wyhash_secret[2], reader.read8(offset + 24) ^ seed1);
+                        seed2 = wyhash_mix(reader.read8(offset + 32) ^ wyhash_secret[3], reader.read8(offset + 40) ^ seed2);
+                        offset += 48;
+                        remaining -= 48;
+                    } while (remaining > 48);
+                    seed ^= seed1 ^ seed2;
+                }
+                while (remaining > 16)
+                {
+                    seed = wyhash_mix(reader.read8(offset) ^ wyhash_secret[1], reader.read8(offset + 8) ^ seed);
+                    offset += 16;
+                    remaining -= 16;
+                }
+                a = reader.read8(offset + remaining - 16);
+                b = reader.read8(offset + remaining - 8);
+            }
+            a ^= wyhash_secret[1];
+            b ^= seed;
+            wyhash_multiply(a, b);
+            return wyhash_mix(a ^ wyhash_secret[0] ^ length, b ^ wyhash_secret[1]);
+        }
+    }
+
+    /// Hashes a block of memory 8 bytes at a time (wyhash), for run time use.
+    inline size_t hash_bytes(const void* data, size_t size, uint64_t seed = 0)
+    {
+        return static_cast<size_t>(StringInternal::wyhash(StringInternal::wyhash_byte_reader{ static_cast<const unsigned char*>(data) }, size, seed));
+    }
+
+    /// Word at a time string hash, much faster than hash_string on anything longer than a few characters.
+    /// Gives the same value at compile time and at run time, where it hashes the string memory with hash_bytes.
+    template<class Element>
+    constexpr size_t hash_string_fast(const Element* data, size_t length, uint64_t seed = 0)
+    {
+        if (!VStd::is_constant_evaluated())
+        {
+            return hash_bytes(data, length * sizeof(Element), seed);
+        }
+        return static_cast<size_t>(StringInternal::wyhash(StringInternal::wyhash_element_reader<Element>{ data }, length * sizeof(Element), seed));
+    }
+
+    /// String hash used by VStd::hash for all string types. Define VSTD_STRING_HASH_FNV1A to use hash_string instead,
+    /// when hashes have to match the ones of older builds.
+    template<class Element>
+    constexpr size_t hash_string_default(const Element* data, size_t length)
+    {
+#if defined(VSTD_STRING_HASH_FNV1A)
+        return hash_string(data, length);
+#else
+        return hash_string_fast(data, length);
+#endif
+    }
+
     template<class T>
     struct hash;
     template<class Element, class Traits>
@@ -891,7 +1052,7 @@ namespace VStd {
         constexpr size_t operator()(const basic_string_view<Element, Traits>& value) const
         {
             // from the string class
-            return hash_string(value.begin(), value.length());
+            return hash_string_default(value.data(), value.length());
         }
     };
 
@@ -28,6 +28,8 @@ DEALINGS IN THE SOFTWARE.
 #define V_FRAMEWORK_CORE_STD_STRING_UTF8_CORE_H
 
 #include <vcore/std/iterator.h>
+#include <vcore/std/typetraits/is_pointer.h>
+#include <vcore/std/string/utf8/transcode.h>
 
 namespace Utf8
 {
@@ -319,6 +321,12 @@ namespace Utf8
     template <typename octet_iterator>
     octet_iterator find_invalid(octet_iterator start, octet_iterator end)
     {
+        if constexpr (VStd::is_pointer_v<octet_iterator> && sizeof(*start) == 1)
+        {
+            // contiguous bytes go through the vectorized validator
+            const char* data = reinterpret_cast<const char*>(start);
+            return start + Utf8::valid_length(data, static_cast<size_t>(end - start));
+        }
         octet_iterator result = start;
         while (result != end)
         {
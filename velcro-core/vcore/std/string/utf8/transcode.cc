@@ -0,0 +1,658 @@
+#include <vcore/std/string/utf8/transcode.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/platform.h>
+#include <vcore/vcore_traits_platform.h>
+
+#include <string.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#   include <tmmintrin.h>
+#   include <immintrin.h>
+#endif
+
+#if defined(V_COMPILER_MSVC)
+#   define V_UTF8_TARGET(features)
+#else
+#   define V_UTF8_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace Utf8
+{
+    namespace TranscodeInternal
+    {
+        static constexpr char32_t ReplacementCharacter = 0xfffd;
+
+        //=========================================================================
+        // Scalar
+        //=========================================================================
+        V_FORCE_INLINE bool IsTrail(uint8_t byte)
+        {
+            return (byte & 0xc0) == 0x80;
+        }
+
+        /// Length of the valid sequence at the start of data, 0 if it isn't one. size is at least 1.
+        V_FORCE_INLINE size_t SequenceLength(const uint8_t* data, size_t size)
+        {
+            const uint8_t lead = data[0];
+            if (lead < 0x80)
+            {
+                return 1;
+            }
+            if (lead < 0xc2)
+            {
+                return 0;   // continuation byte or overlong 2 byte sequence
+            }
+            if (lead < 0xe0)
+            {
+                return size >= 2 && IsTrail(data[1]) ? 2 : 0;
+            }
+            if (lead < 0xf0)
+            {
+                if (size < 3 || !IsTrail(data[1]) || !IsTrail(data[2])
+                    || (lead == 0xe0 && data[1] < 0xa0)         // overlong
+                    || (lead == 0xed && data[1] >= 0xa0))       // surrogate
+                {
+                    return 0;
+                }
+                return 3;
+            }
+            if (lead < 0xf5)
+            {
+                if (size < 4 || !IsTrail(data[1]) || !IsTrail(data[2]) || !IsTrail(data[3])
+                    || (lead == 0xf0 && data[1] < 0x90)         // overlong
+                    || (lead == 0xf4 && data[1] >= 0x90))       // past U+10FFFF
+                {
+                    return 0;
+                }
+                return 4;
+            }
+            return 0;
+        }
+
+        /// Decodes the sequence at the start of data, or returns U+FFFD and a length of 1 if it isn't valid.
+        V_FORCE_INLINE char32_t DecodeSequence(const uint8_t* data, size_t size, size_t& length)
+        {
+            length = SequenceLength(data, size);
+            switch (length)
+            {
+            case 1:
+                return data[0];
+            case 2:
+                return ((data[0] & 0x1fu) << 6) | (data[1] & 0x3fu);
+            case 3:
+                return ((data[0] & 0x0fu) << 12) | ((data[1] & 0x3fu) << 6) | (data[2] & 0x3fu);
+            case 4:
+                return ((data[0] & 0x07u) << 18) | ((data[1] & 0x3fu) << 12) | ((data[2] & 0x3fu) << 6) | (data[3] & 0x3fu);
+            default:
+                length = 1;
+                return ReplacementCharacter;
+            }
+        }
+
+        /// Decodes the code point at the start of data, a lead surrogate followed by a trail surrogate makes one.
+        V_FORCE_INLINE char32_t DecodeUtf16(const char16_t* data, size_t size, size_t& length)
+        {
+            const char32_t unit = data[0];
+            if (unit >= 0xd800 && unit <= 0xdbff && size >= 2 && data[1] >= 0xdc00 && data[1] <= 0xdfff)
+            {
+                length = 2;
+                return 0x10000 + ((unit - 0xd800) << 10) + (data[1] - 0xdc00u);
+            }
+            length = 1;
+            return unit;
+        }
+
+        V_FORCE_INLINE size_t Utf8Length(char32_t codePoint)
+        {
+            return codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+        }
+
+        /// Writes the UTF-8 form of codePoint, at most U+10FFFF.
+        V_FORCE_INLINE char* EncodeUtf8(char32_t codePoint, char* dest)
+        {
+            if (codePoint < 0x80)
+            {
+                *dest++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                *dest++ = static_cast<char>(0xc0 | (codePoint >> 6));
+                *dest++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *dest++ = static_cast<char>(0xe0 | (codePoint >> 12));
+                *dest++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                *dest++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else
+            {
+                *dest++ = static_cast<char>(0xf0 | (codePoint >> 18));
+                *dest++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+                *dest++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                *dest++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            return dest;
+        }
+
+        /// Validates data from offset, which starts a sequence, 8 bytes at a time over ASCII.
+        static size_t ValidLengthScalar(const uint8_t* data, size_t size, size_t offset)
+        {
+            while (offset < size)
+            {
+                if (offset + 8 <= size)
+                {
+                    uint64_t word;
+                    memcpy(&word, data + offset, sizeof(word));
+                    if ((word & 0x8080808080808080ull) == 0)
+                    {
+                        offset += 8;
+                        continue;
+                    }
+                }
+                const size_t length = SequenceLength(data + offset, size - offset);
+                if (length == 0)
+                {
+                    return offset;
+                }
+                offset += length;
+            }
+            return size;
+        }
+
+        /// Start of the sequence that offset falls in or follows, when every sequence before it is valid.
+        V_FORCE_INLINE size_t SequenceStart(const uint8_t* data, size_t offset)
+        {
+            for (size_t back = 1; back <= 3 && back <= offset; ++back)
+            {
+                const uint8_t byte = data[offset - back];
+                if (!IsTrail(byte))
+                {
+                    return byte >= 0xc0 ? offset - back : offset;
+                }
+            }
+            return offset;
+        }
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        //=========================================================================
+        // Lookup tables
+        //=========================================================================
+        // Each error class is a bit, a pair of bytes is invalid when the three tables indexed by the high nibble of
+        // the first byte, its low nibble and the high nibble of the second byte share a bit. TwoConts is expected
+        // exactly where the byte is the third or fourth of a sequence.
+        enum : uint8_t
+        {
+            TooShort = 1 << 0,      // lead byte not followed by a continuation byte
+            TooLong = 1 << 1,       // continuation byte after an ASCII byte
+            Overlong3 = 1 << 2,     // 11100000 100_____
+            TooLarge = 1 << 3,      // past U+10FFFF
+            Surrogate = 1 << 4,     // 11101101 101_____
+            Overlong2 = 1 << 5,     // 1100000_ 10______
+            TooLarge1000 = 1 << 6,  // 11110101 1000____ and up
+            Overlong4 = 1 << 6,     // 11110000 1000____
+            TwoConts = 1 << 7,      // 10______ 10______
+            Carry = TooShort | TooLong | TwoConts
+        };
+
+        alignas(16) static const uint8_t Byte1HighTable[16] =
+        {
+            // 0_______ ASCII
+            TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+            // 10______ continuation
+            TwoConts, TwoConts, TwoConts, TwoConts,
+            // 1100____ 2 byte lead
+            TooShort | Overlong2,
+            // 1101____ 2 byte lead
+            TooShort,
+            // 1110____ 3 byte lead
+            TooShort | Overlong3 | Surrogate,
+            // 1111____ 4 byte lead
+            TooShort | TooLarge | TooLarge1000 | Overlong4
+        };
+
+        alignas(16) static const uint8_t Byte1LowTable[16] =
+        {
+            Carry | Overlong3 | Overlong2 | Overlong4,          // ____0000
+            Carry | Overlong2,                                  // ____0001
+            Carry,                                              // ____0010
+            Carry,                                              // ____0011
+            Carry | TooLarge,                                   // ____0100
+            Carry | TooLarge | TooLarge1000,                    // ____0101
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000,                    // ____1___
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000 | Surrogate,        // ____1101
+            Carry | TooLarge | TooLarge1000,
+            Carry | TooLarge | TooLarge1000
+        };
+
+        alignas(16) static const uint8_t Byte2HighTable[16] =
+        {
+            // 0_______ ASCII
+            TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+            // 1000____
+            TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4,
+            // 1001____
+            TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge,
+            // 101_____
+            TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+            TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+            // 11______ lead
+            TooShort, TooShort, TooShort, TooShort
+        };
+
+        /// Bytes that still need continuation bytes when they are among the last three of a block.
+        alignas(16) static const uint8_t IncompleteMax[32] =
+        {
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1
+        };
+
+        //=========================================================================
+        // SSSE3 validation
+        //=========================================================================
+        V_UTF8_TARGET("ssse3") V_FORCE_INLINE __m128i CheckBlockSsse3(__m128i input, __m128i previous)
+        {
+            const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+            const __m128i prev1 = _mm_alignr_epi8(input, previous, 16 - 1);
+            const __m128i byte1High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1HighTable)),
+                _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask));
+            const __m128i byte1Low = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1LowTable)),
+                _mm_and_si128(prev1, nibbleMask));
+            const __m128i byte2High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte2HighTable)),
+                _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+            const __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+            // the third and fourth bytes of a sequence must be continuation bytes and nothing else may be two in a row
+            const __m128i isThird = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 16 - 2), _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+            const __m128i isFourth = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 16 - 3), _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+            const __m128i must23 = _mm_and_si128(_mm_or_si128(isThird, isFourth), _mm_set1_epi8(static_cast<char>(0x80)));
+            return _mm_xor_si128(must23, special);
+        }
+
+        V_UTF8_TARGET("ssse3") static size_t ValidLengthSsse3(const uint8_t* data, size_t size)
+        {
+            const __m128i incompleteMax = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IncompleteMax + 16));
+            __m128i previous = _mm_setzero_si128();
+            __m128i previousIncomplete = _mm_setzero_si128();
+            size_t offset = 0;
+            for (; offset + 16 <= size; offset += 16)
+            {
+                const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                __m128i error;
+                if (_mm_movemask_epi8(input) == 0)
+                {
+                    error = previousIncomplete;
+                    previousIncomplete = _mm_setzero_si128();
+                }
+                else
+                {
+                    error = _mm_or_si128(CheckBlockSsse3(input, previous), previousIncomplete);
+                    previousIncomplete = _mm_subs_epu8(input, incompleteMax);
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+                {
+                    break;
+                }
+                previous = input;
+            }
+            // the error or the tail is in a sequence that starts at most 3 bytes before offset
+            return ValidLengthScalar(data, size, SequenceStart(data, offset));
+        }
+
+        //=========================================================================
+        // AVX2 validation
+        //=========================================================================
+        V_UTF8_TARGET("avx2") V_FORCE_INLINE __m256i CheckBlockAvx2(__m256i input, __m256i previous)
+        {
+            const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+            // bytes 16 to 31 of previous then 0 to 15 of input, alignr works on 128 bit lanes
+            const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 16 - 1);
+            const __m256i byte1High = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1HighTable))),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask));
+            const __m256i byte1Low = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte1LowTable))),
+                _mm256_and_si256(prev1, nibbleMask));
+            const __m256i byte2High = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Byte2HighTable))),
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+            const __m256i isThird = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 16 - 2), _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+            const __m256i isFourth = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 16 - 3), _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+            const __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+            return _mm256_xor_si256(must23, special);
+        }
+
+        V_UTF8_TARGET("avx2") static size_t ValidLengthAvx2(const uint8_t* data, size_t size)
+        {
+            const __m256i incompleteMax = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(IncompleteMax));
+            __m256i previous = _mm256_setzero_si256();
+            __m256i previousIncomplete = _mm256_setzero_si256();
+            size_t offset = 0;
+            for (; offset + 32 <= size; offset += 32)
+            {
+                const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                __m256i error;
+                if (_mm256_movemask_epi8(input) == 0)
+                {
+                    error = previousIncomplete;
+                    previousIncomplete = _mm256_setzero_si256();
+                }
+                else
+                {
+                    error = _mm256_or_si256(CheckBlockAvx2(input, previous), previousIncomplete);
+                    previousIncomplete = _mm256_subs_epu8(input, incompleteMax);
+                }
+                if (!_mm256_testz_si256(error, error))
+                {
+                    break;
+                }
+                previous = input;
+            }
+            return ValidLengthScalar(data, size, SequenceStart(data, offset));
+        }
+#endif // V_TRAIT_USE_PLATFORM_SIMD_SSE
+    } // namespace TranscodeInternal
+
+    using namespace TranscodeInternal;
+
+    //=========================================================================
+    // Validation
+    //=========================================================================
+    size_t ascii_length(const char* data, size_t size)
+    {
+        size_t offset = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        for (; offset + 16 <= size; offset += 16)
+        {
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset))));
+            if (mask)
+            {
+                return offset + v_ctz_u32(mask);
+            }
+        }
+#endif
+        while (offset < size && static_cast<uint8_t>(data[offset]) < 0x80)
+        {
+            ++offset;
+        }
+        return offset;
+    }
+
+    size_t valid_length(const char* data, size_t size)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 64 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            return ValidLengthAvx2(bytes, size);
+        }
+        if (size >= 32 && V::Platform::GetCpuFeatures().HasSsse3)
+        {
+            return ValidLengthSsse3(bytes, size);
+        }
+#endif
+        return ValidLengthScalar(bytes, size, 0);
+    }
+
+    //=========================================================================
+    // Lengths
+    //=========================================================================
+    /// UTF-16 units (or code points when isUtf32) of data, where each byte that doesn't start a sequence counts for one.
+    static size_t CodeUnitsFromUtf8(const char* data, size_t size, bool isUtf32)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+        size_t numUnits = 0;
+        if (Utf8::valid_length(data, size) == size)
+        {
+            // one unit for each byte that isn't a continuation byte and a second one for the 4 byte leads
+            size_t offset = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            for (; offset + 16 <= size; offset += 16)
+            {
+                const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+                const uint32_t continuations = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(input, _mm_set1_epi8(-64))));
+                numUnits += 16 - v_popcnt_u32(continuations);
+                if (!isUtf32)
+                {
+                    const __m128i fourByteLeads = _mm_cmpeq_epi8(_mm_max_epu8(input, _mm_set1_epi8(static_cast<char>(0xf0))), input);
+                    numUnits += v_popcnt_u32(static_cast<uint32_t>(_mm_movemask_epi8(fourByteLeads)));
+                }
+            }
+#endif
+            for (; offset < size; ++offset)
+            {
+                numUnits += !IsTrail(bytes[offset]) + (!isUtf32 && bytes[offset] >= 0xf0);
+            }
+            return numUnits;
+        }
+
+        size_t offset = 0;
+        while (offset < size)
+        {
+            size_t length;
+            const char32_t codePoint = DecodeSequence(bytes + offset, size - offset, length);
+            numUnits += (!isUtf32 && codePoint > 0xffff) ? 2 : 1;
+            offset += length;
+        }
+        return numUnits;
+    }
+
+    size_t utf16_length_from_utf8(const char* data, size_t size)
+    {
+        return CodeUnitsFromUtf8(data, size, false);
+    }
+
+    size_t utf32_length_from_utf8(const char* data, size_t size)
+    {
+        return CodeUnitsFromUtf8(data, size, true);
+    }
+
+    size_t utf8_length_from_utf16(const char16_t* data, size_t size)
+    {
+        size_t numBytes = 0;
+        size_t offset = 0;
+        while (offset < size)
+        {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (offset + 8 <= size)
+            {
+                // one byte per unit, plus one from 0x80 and one more from 0x800 when there are no surrogates
+                const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                const __m128i high = _mm_and_si128(input, _mm_set1_epi16(static_cast<short>(0xf800)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_set1_epi16(static_cast<short>(0xd800)))) == 0)
+                {
+                    const __m128i zero = _mm_setzero_si128();
+                    const uint32_t below80 = static_cast<uint32_t>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi16(_mm_and_si128(input, _mm_set1_epi16(static_cast<short>(0xff80))), zero)));
+                    const uint32_t below800 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)));
+                    numBytes += 8 + (32 - v_popcnt_u32(below80) - v_popcnt_u32(below800)) / 2;
+                    offset += 8;
+                    continue;
+                }
+            }
+#endif
+            size_t length;
+            numBytes += Utf8Length(DecodeUtf16(data + offset, size - offset, length));
+            offset += length;
+        }
+        return numBytes;
+    }
+
+    size_t utf8_length_from_utf32(const char32_t* data, size_t size)
+    {
+        size_t numBytes = 0;
+        for (size_t offset = 0; offset < size; ++offset)
+        {
+            const char32_t codePoint = data[offset] > 0x10ffff ? ReplacementCharacter : data[offset];
+            numBytes += Utf8Length(codePoint);
+        }
+        return numBytes;
+    }
+
+    //=========================================================================
+    // Conversions
+    //=========================================================================
+    template<class Unit>
+    static size_t ConvertFromUtf8(const char* source, size_t sourceSize, Unit* dest, size_t destSize)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(source);
+        size_t offset = 0;
+        size_t numWritten = 0;
+        while (offset < sourceSize)
+        {
+            size_t blockEnd = offset + 1;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (offset + 16 <= sourceSize && numWritten + 16 <= destSize)
+            {
+                const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+                if (_mm_movemask_epi8(input) == 0)
+                {
+                    // widen 16 ASCII characters
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i low = _mm_unpacklo_epi8(input, zero);
+                    const __m128i high = _mm_unpackhi_epi8(input, zero);
+                    __m128i* output = reinterpret_cast<__m128i*>(dest + numWritten);
+                    if constexpr (sizeof(Unit) == 2)
+                    {
+                        _mm_storeu_si128(output, low);
+                        _mm_storeu_si128(output + 1, high);
+                    }
+                    else
+                    {
+                        _mm_storeu_si128(output, _mm_unpacklo_epi16(low, zero));
+                        _mm_storeu_si128(output + 1, _mm_unpackhi_epi16(low, zero));
+                        _mm_storeu_si128(output + 2, _mm_unpacklo_epi16(high, zero));
+                        _mm_storeu_si128(output + 3, _mm_unpackhi_epi16(high, zero));
+                    }
+                    offset += 16;
+                    numWritten += 16;
+                    continue;
+                }
+                // decode the rest of the block one code point at a time before looking for ASCII again
+                blockEnd = offset + 16;
+            }
+#endif
+            while (offset < blockEnd && offset < sourceSize)
+            {
+                size_t length;
+                const char32_t codePoint = DecodeSequence(bytes + offset, sourceSize - offset, length);
+                if constexpr (sizeof(Unit) == 2)
+                {
+                    if (codePoint > 0xffff)
+                    {
+                        if (numWritten + 2 > destSize)
+                        {
+                            return numWritten;
+                        }
+                        dest[numWritten++] = static_cast<Unit>(0xd800 + ((codePoint - 0x10000) >> 10));
+                        dest[numWritten++] = static_cast<Unit>(0xdc00 + (codePoint & 0x3ff));
+                        offset += length;
+                        continue;
+                    }
+                }
+                if (numWritten == destSize)
+                {
+                    return numWritten;
+                }
+                dest[numWritten++] = static_cast<Unit>(codePoint);
+                offset += length;
+            }
+        }
+        return numWritten;
+    }
+
+    size_t convert_utf8_to_utf16(const char* source, size_t sourceSize, char16_t* dest, size_t destSize)
+    {
+        return ConvertFromUtf8(source, sourceSize, dest, destSize);
+    }
+
+    size_t convert_utf8_to_utf32(const char* source, size_t sourceSize, char32_t* dest, size_t destSize)
+    {
+        return ConvertFromUtf8(source, sourceSize, dest, destSize);
+    }
+
+    size_t convert_utf16_to_utf8(const char16_t* source, size_t sourceSize, char* dest, size_t destSize)
+    {
+        size_t offset = 0;
+        size_t numWritten = 0;
+        while (offset < sourceSize)
+        {
+            size_t blockEnd = offset + 1;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (offset + 8 <= sourceSize && numWritten + 8 <= destSize)
+            {
+                const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+                const __m128i nonAscii = _mm_and_si128(input, _mm_set1_epi16(static_cast<short>(0xff80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xffff)
+                {
+                    // narrow 8 ASCII characters
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + numWritten), _mm_packus_epi16(input, input));
+                    offset += 8;
+                    numWritten += 8;
+                    continue;
+                }
+                blockEnd = offset + 8;
+            }
+#endif
+            while (offset < blockEnd && offset < sourceSize)
+            {
+                size_t length;
+                const char32_t codePoint = DecodeUtf16(source + offset, sourceSize - offset, length);
+                if (numWritten + Utf8Length(codePoint) > destSize)
+                {
+                    return numWritten;
+                }
+                numWritten = static_cast<size_t>(EncodeUtf8(codePoint, dest + numWritten) - dest);
+                offset += length;
+            }
+        }
+        return numWritten;
+    }
+
+    size_t convert_utf32_to_utf8(const char32_t* source, size_t sourceSize, char* dest, size_t destSize)
+    {
+        size_t offset = 0;
+        size_t numWritten = 0;
+        while (offset < sourceSize)
+        {
+            size_t blockEnd = offset + 1;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+            if (offset + 8 <= sourceSize && numWritten + 8 <= destSize)
+            {
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset + 4));
+                const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi32(static_cast<int>(0xffffff80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(nonAscii, _mm_setzero_si128())) == 0xffff)
+                {
+                    const __m128i units = _mm_packs_epi32(low, high);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + numWritten), _mm_packus_epi16(units, units));
+                    offset += 8;
+                    numWritten += 8;
+                    continue;
+                }
+                blockEnd = offset + 8;
+            }
+#endif
+            for (; offset < blockEnd && offset < sourceSize; ++offset)
+            {
+                const char32_t codePoint = source[offset] > 0x10ffff ? ReplacementCharacter : source[offset];
+                if (numWritten + Utf8Length(codePoint) > destSize)
+                {
+                    return numWritten;
+                }
+                numWritten = static_cast<size_t>(EncodeUtf8(codePoint, dest + numWritten) - dest);
+            }
+        }
+        return numWritten;
+    }
+} // namespace Utf8
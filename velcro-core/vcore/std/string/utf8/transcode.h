@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Contributors to the VelcroFramework.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#ifndef V_FRAMEWORK_CORE_STD_STRING_UTF8_TRANSCODE_H
+#define V_FRAMEWORK_CORE_STD_STRING_UTF8_TRANSCODE_H
+
+#include <vcore/std/base.h>
+
+namespace Utf8
+{
+    /**
+     * Validation and transcoding of contiguous buffers, the iterator based functions of core.h and unchecked.h
+     * forward here when they are given pointers.
+     *
+     * Validation checks 16 or 32 bytes at once with the lookup tables of Keiser and Lemire ("Validating UTF-8 In Less
+     * Than One Instruction Per Byte") when the CPU has SSSE3 or AVX2. Transcoding widens and narrows runs of ASCII 16
+     * characters at a time and decodes the other code points one by one.
+     *
+     * The rules are the ones of Utf8::is_valid: no stray continuation bytes, truncated or overlong sequences,
+     * surrogates or code points past U+10FFFF. Conversions write U+FFFD for each byte of invalid UTF-8 that doesn't
+     * start a valid sequence and for UTF-32 values past U+10FFFF, UTF-16 surrogates that aren't paired are encoded
+     * on their own. They stop before the first code point that doesn't fit in destSize units and return the number
+     * of units written, the *_length functions return the size of the whole conversion.
+     */
+
+    //! Number of leading bytes that are 7-bit ASCII.
+    size_t ascii_length(const char* data, size_t size);
+    //! Offset of the first byte that doesn't start a valid sequence, size if data is valid UTF-8.
+    size_t valid_length(const char* data, size_t size);
+
+    inline bool is_valid_utf8(const char* data, size_t size)
+    {
+        return Utf8::valid_length(data, size) == size;
+    }
+
+    size_t utf16_length_from_utf8(const char* data, size_t size);
+    size_t utf32_length_from_utf8(const char* data, size_t size);
+    size_t utf8_length_from_utf16(const char16_t* data, size_t size);
+    size_t utf8_length_from_utf32(const char32_t* data, size_t size);
+
+    size_t convert_utf8_to_utf16(const char* source, size_t sourceSize, char16_t* dest, size_t destSize);
+    size_t convert_utf8_to_utf32(const char* source, size_t sourceSize, char32_t* dest, size_t destSize);
+    size_t convert_utf16_to_utf8(const char16_t* source, size_t sourceSize, char* dest, size_t destSize);
+    size_t convert_utf32_to_utf8(const char32_t* source, size_t sourceSize, char* dest, size_t destSize);
+} // namespace Utf8
+
+#endif // V_FRAMEWORK_CORE_STD_STRING_UTF8_TRANSCODE_H
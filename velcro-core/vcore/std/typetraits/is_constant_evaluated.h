@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Contributors to the VelcroFramework.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#ifndef V_FRAMEWORK_CORE_STD_TYPETRAITS_IS_CONSTANT_EVALUATED_H
+#define V_FRAMEWORK_CORE_STD_TYPETRAITS_IS_CONSTANT_EVALUATED_H
+
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#       define VSTD_HAS_IS_CONSTANT_EVALUATED 1
+#   endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#   define VSTD_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+namespace VStd {
+    // C++20 std::is_constant_evaluated, through the compiler builtin that is available in C++17 mode.
+    // https://en.cppreference.com/w/cpp/types/is_constant_evaluated
+    // Without the builtin it always returns true, so constexpr functions keep to their constant evaluation path.
+    // Only use it to pick between implementations that give the same results.
+    constexpr bool is_constant_evaluated() noexcept
+    {
+#if VSTD_HAS_IS_CONSTANT_EVALUATED
+        return __builtin_is_constant_evaluated();
+#else
+        return true;
+#endif
+    }
+}
+
+#endif // V_FRAMEWORK_CORE_STD_TYPETRAITS_IS_CONSTANT_EVALUATED_H
@@ -9,10 +9,23 @@
 #include <vcore/memory/memory.h>
 #include <vcore/memory/osallocator.h>
 #include <vcore/memory/system_allocator.h>
+#include <vcore/platform.h>
 #include <vcore/io/path/path.h>
 #include <vcore/string_func/string_func.h>
 #include <vcore/vcore_traits_platform.h>
 #include <vcore/math/crc.h>
+#include <vcore/math/math_intrinsics.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#   include <immintrin.h>
+#endif
+
+#if defined(V_COMPILER_MSVC)
+#   define V_STRING_FUNC_TARGET(features)
+#else
+#   define V_STRING_FUNC_TARGET(features) __attribute__((target(features)))
+#endif
 
 namespace V::StringFunc::Internal
 {
@@ -407,6 +420,813 @@ namespace V::StringFunc::Internal
         return Strip(inout, { &stripCharacter, 1 }, bCaseSensitive, bStripBeginning, bStripEnding);
     }
 
+    //=========================================================================
+    // ASCII case folding
+    //=========================================================================
+    constexpr uint8_t FoldCase(uint8_t c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c + ('a' - 'A')) : c;
+    }
+
+    static bool EqualNoCaseScalar(const char* inA, const char* inB, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (FoldCase(static_cast<uint8_t>(inA[i])) != FoldCase(static_cast<uint8_t>(inB[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns the index of the highest set bit, without relying on lzcnt being supported by the cpu.
+    V_FORCE_INLINE uint32_t HighestBit(uint32_t mask)
+    {
+        while (mask & (mask - 1))
+        {
+            mask &= mask - 1;
+        }
+        return v_ctz_u32(mask);
+    }
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+    //=========================================================================
+    // SSE2 kernels
+    //=========================================================================
+    /// Sets the 0x20 bit of the bytes in 'A'-'Z'. Moves 'A' to -128 so a single signed compare finds the range.
+    V_FORCE_INLINE __m128i FoldCase(__m128i value)
+    {
+        const __m128i shifted = _mm_add_epi8(value, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+        const __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+        return _mm_or_si128(value, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+    }
+
+    V_FORCE_INLINE uint32_t MatchMask(__m128i block, const char* characters, size_t numCharacters)
+    {
+        __m128i matches = _mm_cmpeq_epi8(block, _mm_set1_epi8(characters[0]));
+        for (size_t i = 1; i < numCharacters; ++i)
+        {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(characters[i])));
+        }
+        return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+    }
+
+    /// size must be at least 16, the last block overlaps the previous one rather than falling back to bytes.
+    static size_t FindFirstOfSse2(const char* data, size_t size, const char* characters, size_t numCharacters)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const uint32_t mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), characters, numCharacters);
+            if (mask)
+            {
+                return i + v_ctz_u32(mask);
+            }
+        }
+        if (i < size)
+        {
+            const size_t last = size - 16;
+            const uint32_t mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + last)), characters, numCharacters)
+                >> (i - last);
+            if (mask)
+            {
+                return i + v_ctz_u32(mask);
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    /// size must be at least 16, scans from the end.
+    static size_t FindLastOfSse2(const char* data, size_t size, const char* characters, size_t numCharacters)
+    {
+        size_t end = size;
+        for (; end >= 16; end -= 16)
+        {
+            const uint32_t mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end - 16)), characters, numCharacters);
+            if (mask)
+            {
+                return end - 16 + HighestBit(mask);
+            }
+        }
+        if (end)
+        {
+            const uint32_t mask = MatchMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), characters, numCharacters)
+                & ((1u << end) - 1);
+            if (mask)
+            {
+                return HighestBit(mask);
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    static bool EqualNoCaseSse2(const char* inA, const char* inB, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i a = FoldCase(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inA + i)));
+            const __m128i b = FoldCase(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inB + i)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xffff)
+            {
+                return false;
+            }
+        }
+        return EqualNoCaseScalar(inA + i, inB + i, size - i);
+    }
+
+    /// Finds needle by comparing its first and last characters at 16 positions at once and verifying the candidates.
+    /// needle is at least 2 characters and not longer than size.
+    static size_t FindSubstringSse2(const char* data, size_t size, const char* needle, size_t needleSize, bool bCaseSensitive)
+    {
+        const uint8_t first = static_cast<uint8_t>(needle[0]);
+        const uint8_t last = static_cast<uint8_t>(needle[needleSize - 1]);
+        const __m128i firstBlock = _mm_set1_epi8(static_cast<char>(bCaseSensitive ? first : FoldCase(first)));
+        const __m128i lastBlock = _mm_set1_epi8(static_cast<char>(bCaseSensitive ? last : FoldCase(last)));
+        const size_t numCandidates = size - needleSize + 1;
+
+        size_t i = 0;
+        for (; i + 16 <= numCandidates; i += 16)
+        {
+            __m128i firstChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i lastChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needleSize - 1));
+            if (!bCaseSensitive)
+            {
+                firstChars = FoldCase(firstChars);
+                lastChars = FoldCase(lastChars);
+            }
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(firstChars, firstBlock), _mm_cmpeq_epi8(lastChars, lastBlock))));
+            while (mask)
+            {
+                const size_t candidate = i + v_ctz_u32(mask);
+                const bool isMatch = bCaseSensitive
+                    ? memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0
+                    : EqualNoCaseSse2(data + candidate + 1, needle + 1, needleSize - 2);
+                if (isMatch)
+                {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        for (; i < numCandidates; ++i)
+        {
+            const bool isMatch = bCaseSensitive
+                ? memcmp(data + i, needle, needleSize) == 0
+                : EqualNoCaseScalar(data + i, needle, needleSize);
+            if (isMatch)
+            {
+                return i;
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    //=========================================================================
+    // AVX2 kernels
+    //=========================================================================
+    V_STRING_FUNC_TARGET("avx2") V_FORCE_INLINE __m256i FoldCaseAvx2(__m256i value)
+    {
+        const __m256i shifted = _mm256_add_epi8(value, _mm256_set1_epi8(static_cast<char>(0x80 - 'A')));
+        const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + 26)), shifted);
+        return _mm256_or_si256(value, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+    }
+
+    V_STRING_FUNC_TARGET("avx2") V_FORCE_INLINE uint32_t MatchMaskAvx2(const char* address, const __m256i* needles, size_t numCharacters)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address));
+        __m256i matches = _mm256_cmpeq_epi8(block, needles[0]);
+        for (size_t i = 1; i < numCharacters; ++i)
+        {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+        return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+    }
+
+    /// size must be at least 32.
+    V_STRING_FUNC_TARGET("avx2") static size_t FindFirstOfAvx2(const char* data, size_t size, const char* characters, size_t numCharacters)
+    {
+        __m256i needles[CharacterSet::MaxVectorCharacters];
+        for (size_t i = 0; i < numCharacters; ++i)
+        {
+            needles[i] = _mm256_set1_epi8(characters[i]);
+        }
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            if (const uint32_t mask = MatchMaskAvx2(data + i, needles, numCharacters); mask)
+            {
+                return i + v_ctz_u32(mask);
+            }
+        }
+        if (i < size)
+        {
+            const size_t last = size - 32;
+            if (const uint32_t mask = MatchMaskAvx2(data + last, needles, numCharacters) >> (i - last); mask)
+            {
+                return i + v_ctz_u32(mask);
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    V_STRING_FUNC_TARGET("avx2") static bool EqualNoCaseAvx2(const char* inA, const char* inB, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i a = FoldCaseAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(inA + i)));
+            const __m256i b = FoldCaseAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(inB + i)));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != 0xffffffffu)
+            {
+                return false;
+            }
+        }
+        return EqualNoCaseSse2(inA + i, inB + i, size - i);
+    }
+#endif // V_TRAIT_USE_PLATFORM_SIMD_SSE
+
+    //=========================================================================
+    // Dispatch
+    //=========================================================================
+    /// characters holds 1 to CharacterSet::MaxVectorCharacters characters.
+    static size_t FindFirstOf(const char* data, size_t size, const char* characters, size_t numCharacters)
+    {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 32 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            return FindFirstOfAvx2(data, size, characters, numCharacters);
+        }
+        if (size >= 16)
+        {
+            return FindFirstOfSse2(data, size, characters, numCharacters);
+        }
+#endif
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t j = 0; j < numCharacters; ++j)
+            {
+                if (data[i] == characters[j])
+                {
+                    return i;
+                }
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    static size_t FindLastOf(const char* data, size_t size, const char* characters, size_t numCharacters)
+    {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 16)
+        {
+            return FindLastOfSse2(data, size, characters, numCharacters);
+        }
+#endif
+        for (size_t i = size; i > 0; --i)
+        {
+            for (size_t j = 0; j < numCharacters; ++j)
+            {
+                if (data[i - 1] == characters[j])
+                {
+                    return i - 1;
+                }
+            }
+        }
+        return VStd::string_view::npos;
+    }
+
+    static bool EqualNoCase(const char* inA, const char* inB, size_t size)
+    {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 32 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            return EqualNoCaseAvx2(inA, inB, size);
+        }
+        return EqualNoCaseSse2(inA, inB, size);
+#else
+        return EqualNoCaseScalar(inA, inB, size);
+#endif
+    }
+
+    /// needle is at least 2 characters and not longer than size.
+    static size_t FindSubstring(const char* data, size_t size, const char* needle, size_t needleSize, bool bCaseSensitive)
+    {
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        return FindSubstringSse2(data, size, needle, needleSize, bCaseSensitive);
+#else
+        const size_t numCandidates = size - needleSize + 1;
+        for (size_t i = 0; i < numCandidates; ++i)
+        {
+            const bool isMatch = bCaseSensitive
+                ? memcmp(data + i, needle, needleSize) == 0
+                : EqualNoCaseScalar(data + i, needle, needleSize);
+            if (isMatch)
+            {
+                return i;
+            }
+        }
+        return VStd::string_view::npos;
+#endif
+    }
+
+    /// Returns true if the token is made only of spaces, the tokenizers skip those unless asked to keep them.
+    static bool IsSpaceToken(VStd::string_view token)
+    {
+        return token.find_first_not_of(' ') == VStd::string_view::npos;
+    }
+
+    //=========================================================================
+    // Base64 and hex codecs
+    //=========================================================================
+    static const char Base64Alphabet[] =
+    {
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz"
+        "0123456789+/"
+    };
+
+    static const char Base64Pad = '=';
+
+    /// Value of each base64 character, 0xff for the characters that are not in the alphabet.
+    static const V::u8 Base64Values[] =
+    {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    };
+
+    static V::u8 Base64Value(char c)
+    {
+        return Base64Values[static_cast<unsigned char>(c)];
+    }
+
+    /// Value of a hex digit of either case, -1 if c isn't one.
+    static int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        c |= 0x20;
+        return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+    }
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+    // The base64 kernels follow Muła and Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+    // A block of 3 bytes is shuffled into a 32-bit lane, the multiplies move its four 6-bit fields to the four bytes of
+    // the lane and a pshufb picks the offset that turns each value into its character. Decoding validates the
+    // characters with two pshufb lookups (one bit per high nibble in a mask per low nibble) and packs the values back
+    // with two multiply-adds.
+
+    V_STRING_FUNC_TARGET("ssse3") static __m128i Base64EncodeBlockSsse3(__m128i block)
+    {
+        block = _mm_shuffle_epi8(block, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m128i fields0 = _mm_mulhi_epu16(_mm_and_si128(block, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i fields1 = _mm_mullo_epi16(_mm_and_si128(block, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        const __m128i values = _mm_or_si128(fields0, fields1);
+
+        // 0-25 -> 13, 26-51 -> 0, 52-61 -> 1-10, 62 -> 11, 63 -> 12
+        __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+    }
+
+    /// Encodes 12 bytes per iteration, reading 16. Returns the number of bytes consumed.
+    V_STRING_FUNC_TARGET("ssse3") static size_t Base64EncodeSsse3(char* out, const V::u8* in, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 12, out += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), Base64EncodeBlockSsse3(block));
+        }
+        return i;
+    }
+
+    /// Returns false if a character isn't in the alphabet, otherwise the 16 characters packed into the low 12 bytes.
+    V_STRING_FUNC_TARGET("ssse3") static bool Base64DecodeBlockSsse3(__m128i block, __m128i& decoded)
+    {
+        const __m128i validBits = _mm_setr_epi8(
+            static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+            static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+            static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54, 0x50, 0x50, 0x50, 0x54);
+        const __m128i highNibbleBits = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80),
+            0, 0, 0, 0, 0, 0, 0, 0);
+        // Indexed by the high nibble, '/' uses index 1
+        const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        const __m128i high = _mm_and_si128(_mm_srli_epi32(block, 4), _mm_set1_epi8(0x0f));
+        const __m128i low = _mm_and_si128(block, _mm_set1_epi8(0x0f));
+        const __m128i valid = _mm_and_si128(_mm_shuffle_epi8(validBits, low), _mm_shuffle_epi8(highNibbleBits, high));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128())) != 0)
+        {
+            return false;
+        }
+
+        const __m128i isSlash = _mm_cmpeq_epi8(block, _mm_set1_epi8('/'));
+        const __m128i values = _mm_add_epi8(block, _mm_shuffle_epi8(offsets, _mm_add_epi8(high, isSlash)));
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        decoded = _mm_shuffle_epi8(triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        return true;
+    }
+
+    /// Decodes 16 characters per iteration and stores 16 bytes, so it stops 8 characters before the end to stay within
+    /// size / 4 * 3 bytes of output. Returns the number of characters consumed, which stops at the first invalid block.
+    V_STRING_FUNC_TARGET("ssse3") static size_t Base64DecodeSsse3(V::u8* out, const char* in, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 24 <= size; i += 16, out += 12)
+        {
+            __m128i decoded;
+            if (!Base64DecodeBlockSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), decoded))
+            {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), decoded);
+        }
+        return i;
+    }
+
+    V_STRING_FUNC_TARGET("avx2") static size_t Base64EncodeAvx2(char* out, const V::u8* in, size_t size)
+    {
+        const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+
+        size_t i = 0;
+        for (; i + 28 <= size; i += 24, out += 32)
+        {
+            // 12 bytes in each lane
+            __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+            block = _mm256_shuffle_epi8(block, shuffle);
+            const __m256i fields0 = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+            const __m256i fields1 = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+            const __m256i values = _mm256_or_si256(fields0, fields1);
+
+            __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+            range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values), _mm256_set1_epi8(13)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range)));
+        }
+        return i;
+    }
+
+    /// Decodes 32 characters per iteration and stores 32 bytes, so it stops 16 characters before the end.
+    V_STRING_FUNC_TARGET("avx2") static size_t Base64DecodeAvx2(V::u8* out, const char* in, size_t size)
+    {
+        const __m256i validBits = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+            static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+            static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+            static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54, 0x50, 0x50, 0x50, 0x54));
+        const __m256i highNibbleBits = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40,
+            static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0));
+        const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+        const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        size_t i = 0;
+        for (; i + 48 <= size; i += 32, out += 24)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi32(block, 4), _mm256_set1_epi8(0x0f));
+            const __m256i low = _mm256_and_si256(block, _mm256_set1_epi8(0x0f));
+            const __m256i valid = _mm256_and_si256(_mm256_shuffle_epi8(validBits, low), _mm256_shuffle_epi8(highNibbleBits, high));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256())) != 0)
+            {
+                break;
+            }
+
+            const __m256i isSlash = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('/'));
+            const __m256i values = _mm256_add_epi8(block, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(high, isSlash)));
+            const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+            // 12 bytes at the start of each lane, moved next to each other
+            const __m256i decoded = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), decoded);
+        }
+        return i;
+    }
+
+    /// Converts nibbles (0-15 per byte) to hex digits.
+    V_FORCE_INLINE __m128i HexDigitsSse2(__m128i nibbles, __m128i letterOffset)
+    {
+        const __m128i isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(isLetter, letterOffset));
+    }
+
+    /// Converts hex digits of either case to nibbles, returns false if a character isn't a hex digit.
+    V_FORCE_INLINE bool HexNibblesSse2(__m128i digits, __m128i& nibbles)
+    {
+        // Unsigned range checks with signed compares, the ranges are moved to start at -128
+        const __m128i digit = _mm_sub_epi8(digits, _mm_set1_epi8('0'));
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(digits, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i isDigit = _mm_cmplt_epi8(_mm_add_epi8(digit, _mm_set1_epi8(-128)), _mm_set1_epi8(-128 + 10));
+        const __m128i isLetter = _mm_cmplt_epi8(_mm_add_epi8(letter, _mm_set1_epi8(-128)), _mm_set1_epi8(-128 + 6));
+        nibbles = _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+        return _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) == 0xffff;
+    }
+
+    /// Joins the nibble pairs of each 16-bit lane (high nibble first) into the low byte of the lane.
+    V_FORCE_INLINE __m128i HexJoinSse2(__m128i nibbles)
+    {
+        return _mm_and_si128(_mm_or_si128(_mm_slli_epi16(nibbles, 4), _mm_srli_epi16(nibbles, 8)), _mm_set1_epi16(0x00ff));
+    }
+
+    /// Encodes 16 bytes per iteration, returns the number of bytes consumed.
+    static size_t HexEncodeSse2(char* out, const V::u8* in, size_t size, char letterOffset)
+    {
+        const __m128i offset = _mm_set1_epi8(letterOffset);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16, out += 32)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i high = HexDigitsSse2(_mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0f)), offset);
+            const __m128i low = HexDigitsSse2(_mm_and_si128(block, _mm_set1_epi8(0x0f)), offset);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(high, low));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(high, low));
+        }
+        return i;
+    }
+
+    /// Decodes 32 characters per iteration, returns the number of characters consumed, which stops at the first
+    /// block with a character that isn't a hex digit.
+    static size_t HexDecodeSse2(V::u8* out, const char* in, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32, out += 16)
+        {
+            __m128i nibbles0, nibbles1;
+            const bool valid0 = HexNibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), nibbles0);
+            const bool valid1 = HexNibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), nibbles1);
+            if (!valid0 || !valid1)
+            {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(HexJoinSse2(nibbles0), HexJoinSse2(nibbles1)));
+        }
+        return i;
+    }
+
+    V_STRING_FUNC_TARGET("avx2") static size_t HexEncodeAvx2(char* out, const V::u8* in, size_t size, char letterOffset)
+    {
+        const __m256i offset = _mm256_set1_epi8(letterOffset);
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i zero = _mm256_set1_epi8('0');
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32, out += 64)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0f));
+            const __m256i lowNibbles = _mm256_and_si256(block, _mm256_set1_epi8(0x0f));
+            const __m256i high = _mm256_add_epi8(_mm256_add_epi8(highNibbles, zero), _mm256_and_si256(_mm256_cmpgt_epi8(highNibbles, nine), offset));
+            const __m256i low = _mm256_add_epi8(_mm256_add_epi8(lowNibbles, zero), _mm256_and_si256(_mm256_cmpgt_epi8(lowNibbles, nine), offset));
+            // The unpacks work within each lane, bytes 0-7 and 16-23 end up in the first one
+            const __m256i first = _mm256_unpacklo_epi8(high, low);
+            const __m256i second = _mm256_unpackhi_epi8(high, low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+        return i;
+    }
+
+    V_STRING_FUNC_TARGET("avx2") static size_t HexDecodeAvx2(V::u8* out, const char* in, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64, out += 32)
+        {
+            __m256i nibbles[2];
+            int invalid = 0;
+            for (int half = 0; half < 2; ++half)
+            {
+                const __m256i digits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + half * 32));
+                const __m256i digit = _mm256_sub_epi8(digits, _mm256_set1_epi8('0'));
+                const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(digits, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+                const __m256i isDigit = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 10), _mm256_add_epi8(digit, _mm256_set1_epi8(-128)));
+                const __m256i isLetter = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 6), _mm256_add_epi8(letter, _mm256_set1_epi8(-128)));
+                invalid |= ~_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+                const __m256i values = _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                    _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+                nibbles[half] = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(values, 4), _mm256_srli_epi16(values, 8)), _mm256_set1_epi16(0x00ff));
+            }
+            if (invalid)
+            {
+                break;
+            }
+            // packus works within each lane, put the 64-bit halves back in order
+            const __m256i packed = _mm256_packus_epi16(nibbles[0], nibbles[1]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute4x64_epi64(packed, 0xd8));
+        }
+        return i;
+    }
+#endif // V_TRAIT_USE_PLATFORM_SIMD_SSE
+
+    /// Encodes the complete groups of 3 bytes of in, returns the number of bytes consumed.
+    static size_t Base64EncodeGroups(char* out, const V::u8* in, size_t size)
+    {
+        size_t i = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 28 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            i = Base64EncodeAvx2(out, in, size);
+        }
+        if (size - i >= 16 && V::Platform::GetCpuFeatures().HasSsse3)
+        {
+            i += Base64EncodeSsse3(out + i / 3 * 4, in + i, size - i);
+        }
+#endif
+        /*
+        figure retrieved from the Base encoding rfc https://tools.ietf.org/html/rfc4648
+        +--first octet--+-second octet--+--third octet--+
+        |7 6 5 4 3 2 1 0|7 6 5 4 3 2 1 0|7 6 5 4 3 2 1 0|
+        +-----------+---+-------+-------+---+-----------+
+        |5 4 3 2 1 0|5 4 3 2 1 0|5 4 3 2 1 0|5 4 3 2 1 0|
+        +--1.index--+--2.index--+--3.index--+--4.index--+
+        */
+        for (char* encodeBuf = out + i / 3 * 4; i + 3 <= size; i += 3, encodeBuf += 4)
+        {
+            encodeBuf[0] = Base64Alphabet[(in[i] & 0xfc) >> 2];
+            encodeBuf[1] = Base64Alphabet[((in[i] & 0x03) << 4) | ((in[i + 1] & 0xf0) >> 4)];
+            encodeBuf[2] = Base64Alphabet[((in[i + 1] & 0x0f) << 2) | ((in[i + 2] & 0xc0) >> 6)];
+            encodeBuf[3] = Base64Alphabet[in[i + 2] & 0x3f];
+        }
+        return i;
+    }
+
+    /// Encodes the last 1 or 2 bytes of a stream to 4 characters with padding.
+    static void Base64EncodeLast(char* out, const V::u8* in, size_t size)
+    {
+        out[0] = Base64Alphabet[(in[0] & 0xfc) >> 2];
+        if (size == 2)
+        {
+            out[1] = Base64Alphabet[((in[0] & 0x03) << 4) | ((in[1] & 0xf0) >> 4)];
+            out[2] = Base64Alphabet[(in[1] & 0x0f) << 2];
+        }
+        else
+        {
+            out[1] = Base64Alphabet[(in[0] & 0x03) << 4];
+            out[2] = Base64Pad;
+        }
+        out[3] = Base64Pad;
+    }
+
+    /// Decodes groups of 4 characters up to the first one that has padding or a character that isn't in the alphabet.
+    /// out must hold size / 4 * 3 bytes. Returns the number of characters consumed.
+    static size_t Base64DecodeGroups(V::u8* out, const char* in, size_t size)
+    {
+        size_t i = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 48 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            i = Base64DecodeAvx2(out, in, size);
+        }
+        if (size - i >= 24 && V::Platform::GetCpuFeatures().HasSsse3)
+        {
+            i += Base64DecodeSsse3(out + i / 4 * 3, in + i, size - i);
+        }
+#endif
+        for (V::u8* decodeBuf = out + i / 4 * 3; i + 4 <= size; i += 4, decodeBuf += 3)
+        {
+            const V::u8 a = Base64Value(in[i]);
+            const V::u8 b = Base64Value(in[i + 1]);
+            const V::u8 c = Base64Value(in[i + 2]);
+            const V::u8 d = Base64Value(in[i + 3]);
+            if ((a | b | c | d) == 0xff)
+            {
+                break;
+            }
+            decodeBuf[0] = static_cast<V::u8>((a << 2) | (b >> 4));
+            decodeBuf[1] = static_cast<V::u8>((b << 4) | (c >> 2));
+            decodeBuf[2] = static_cast<V::u8>((c << 6) | d);
+        }
+        return i;
+    }
+
+    /// Decodes a group of 4 characters that may end with padding. Returns the number of bytes written (1 to 3), or 0
+    /// with the index of the first invalid character in errorIndex.
+    static size_t Base64DecodeLast(V::u8* out, const char* in, size_t& errorIndex)
+    {
+        V::u8 values[4];
+        size_t count = 4;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            values[i] = Base64Value(in[i]);
+            if (values[i] != 0xff)
+            {
+                continue;
+            }
+            // Padding is only valid as the last 1 or 2 characters
+            const bool isPadding = in[i] == Base64Pad && i >= 2 && (i == 3 || in[3] == Base64Pad);
+            if (!isPadding)
+            {
+                errorIndex = i;
+                return 0;
+            }
+            count = VStd::min(count, i);
+            values[i] = 0;
+        }
+
+        out[0] = static_cast<V::u8>((values[0] << 2) | (values[1] >> 4));
+        if (count > 2)
+        {
+            out[1] = static_cast<V::u8>((values[1] << 4) | (values[2] >> 2));
+        }
+        if (count > 3)
+        {
+            out[2] = static_cast<V::u8>((values[2] << 6) | values[3]);
+        }
+        return count - 1;
+    }
+
+    /// Decodes base64 text whose size is a multiple of 4, out must hold size / 4 * 3 bytes. Returns the number of bytes
+    /// written, or npos with the offset of the first invalid character in errorOffset.
+    static size_t Base64Decode(V::u8* out, const char* in, size_t size, size_t& errorOffset)
+    {
+        const size_t consumed = Base64DecodeGroups(out, in, size);
+        const size_t written = consumed / 4 * 3;
+        if (consumed == size)
+        {
+            return written;
+        }
+
+        size_t errorIndex = 0;
+        const size_t lastSize = Base64DecodeLast(out + written, in + consumed, errorIndex);
+        if (lastSize == 0)
+        {
+            errorOffset = consumed + errorIndex;
+            return VStd::string_view::npos;
+        }
+        if (consumed + 4 != size)
+        {
+            // Padding before the end of the text
+            errorOffset = consumed + lastSize + 1;
+            return VStd::string_view::npos;
+        }
+        return written + lastSize;
+    }
+
+    static void HexEncode(char* out, const V::u8* in, size_t size, bool upperCase)
+    {
+        const char letterOffset = static_cast<char>((upperCase ? 'A' : 'a') - '0' - 10);
+        size_t i = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 32 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            i = HexEncodeAvx2(out, in, size, letterOffset);
+        }
+        i += HexEncodeSse2(out + i * 2, in + i, size - i, letterOffset);
+#endif
+        const char* digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+        for (; i < size; ++i)
+        {
+            out[i * 2] = digits[in[i] >> 4];
+            out[i * 2 + 1] = digits[in[i] & 0x0f];
+        }
+    }
+
+    /// Decodes pairs of hex digits of either case up to the first character that isn't a hex digit.
+    /// Returns the number of characters consumed, which is even.
+    static size_t HexDecode(V::u8* out, const char* in, size_t size)
+    {
+        size_t i = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (size >= 64 && V::Platform::GetCpuFeatures().HasAvx2)
+        {
+            i = HexDecodeAvx2(out, in, size);
+        }
+        i += HexDecodeSse2(out + i / 2, in + i, size - i);
+#endif
+        for (; i + 2 <= size; i += 2)
+        {
+            const int high = HexValue(in[i]);
+            const int low = HexValue(in[i + 1]);
+            if (high < 0 || low < 0)
+            {
+                break;
+            }
+            out[i / 2] = static_cast<V::u8>((high << 4) | low);
+        }
+        return i;
+    }
 }
 
 namespace V {
@@ -473,23 +1293,25 @@ namespace V {
         }
         bool Equal(VStd::string_view inA, VStd::string_view inB, bool bCaseSensitive)
         {
-            const size_t maxCharsToCompare = inA.size();
-
-            return inA.size() == inB.size() && (bCaseSensitive
-                ? strncmp(inA.data(), inB.data(), maxCharsToCompare) == 0
-                : v_strnicmp(inA.data(), inB.data(), maxCharsToCompare) == 0);
+            if (inA.size() != inB.size())
+            {
+                return false;
+            }
+            return bCaseSensitive
+                ? memcmp(inA.data(), inB.data(), inA.size()) == 0
+                : Internal::EqualNoCase(inA.data(), inB.data(), inA.size());
         }
 
         bool StartsWith(VStd::string_view sourceValue, VStd::string_view prefixValue, bool bCaseSensitive)
         {
             return sourceValue.size() >= prefixValue.size()
-                && Equal(sourceValue.data(), prefixValue.data(), bCaseSensitive, prefixValue.size());
+                && Equal(sourceValue.substr(0, prefixValue.size()), prefixValue, bCaseSensitive);
         }
 
         bool EndsWith(VStd::string_view sourceValue, VStd::string_view suffixValue, bool bCaseSensitive)
         {
             return sourceValue.size() >= suffixValue.size()
-                && Equal(sourceValue.substr(sourceValue.size() - suffixValue.size(), VStd::string_view::npos).data(), suffixValue.data(), bCaseSensitive, suffixValue.size());
+                && Equal(sourceValue.substr(sourceValue.size() - suffixValue.size()), suffixValue, bCaseSensitive);
         }
 
         bool Contains(VStd::string_view in, char ch, bool bCaseSensitive)
@@ -503,61 +1325,39 @@ namespace V {
 
         size_t Find(VStd::string_view in, char c, size_t pos /*= 0*/, bool bReverse /*= false*/, bool bCaseSensitive /*= false*/)
         {
-            if (in.empty())
-            {
-                return VStd::string::npos;
-            }
-
             if (pos == VStd::string::npos)
             {
                 pos = 0;
             }
 
-            size_t inLen = in.size();
-            if (inLen < pos)
+            const size_t inLen = in.size();
+            if (pos >= inLen)
             {
                 return VStd::string::npos;
             }
 
+            // Case insensitive searches look for both cases of a letter at once
+            char characters[2] = { c, c };
             if (!bCaseSensitive)
             {
-                c = (char)tolower(c);
+                characters[0] = static_cast<char>(tolower(c));
+                characters[1] = static_cast<char>(toupper(c));
             }
+            const size_t numCharacters = characters[0] == characters[1] ? 1 : 2;
 
             if (bReverse)
             {
-                pos = inLen - pos - 1;
+                // pos counts from the end of the string
+                return Internal::FindLastOf(in.data(), inLen - pos, characters, numCharacters);
             }
 
-            char character;
-
-            do
+            if (numCharacters == 1)
             {
-                if (!bCaseSensitive)
-                {
-                    character = (char)tolower(in[pos]);
-                }
-                else
-                {
-                    character = in[pos];
-                }
-
-                if (character == c)
-                {
-                    return pos;
-                }
-
-                if (bReverse)
-                {
-                    pos = pos > 0 ? pos-1 : pos;
-                }
-                else
-                {
-                    pos++;
-                }
-            } while (bReverse ? pos : character != '\0');
-
-            return VStd::string::npos;
+                const void* found = memchr(in.data() + pos, characters[0], inLen - pos);
+                return found ? static_cast<size_t>(reinterpret_cast<const char*>(found) - in.data()) : VStd::string::npos;
+            }
+            const size_t found = Internal::FindFirstOf(in.data() + pos, inLen - pos, characters, numCharacters);
+            return found != VStd::string::npos ? found + pos : found;
         }
 
         size_t Find(VStd::string_view in, VStd::string_view s, size_t offset /*= 0*/, bool bReverse /*= false*/, bool bCaseSensitive /*= false*/)
@@ -586,45 +1386,40 @@ namespace V {
                 return VStd::string::npos;
             }
 
-            const char* pCur;
-
-            if (bReverse)
+            if (slen == 1)
             {
-                // Start at the end (- pos)
-                pCur = in.data() + inlen - slen - offset;
+                return Find(in, s[0], offset, bReverse, bCaseSensitive);
             }
-            else
+
+            if (!bReverse)
             {
-                // Start at the beginning (+ pos)
-                pCur = in.data() + offset;
+                const size_t found = Internal::FindSubstring(in.data() + offset, inlen - offset, s.data(), slen, bCaseSensitive);
+                return found != VStd::string::npos ? found + offset : found;
             }
 
-            do
+            // Reverse searches jump between occurrences of the first character (offset counts from the end)
+            char firstCharacters[2] = { s[0], s[0] };
+            if (!bCaseSensitive)
             {
-                if (bCaseSensitive)
-                {
-                    if (!strncmp(pCur, s.data(), slen))
-                    {
-                        return static_cast<size_t>(pCur - in.data());
-                    }
-                }
-                else
-                {
-                    if (!v_strnicmp(pCur, s.data(), slen))
-                    {
-                        return static_cast<size_t>(pCur - in.data());
-                    }
-                }
+                firstCharacters[0] = static_cast<char>(tolower(s[0]));
+                firstCharacters[1] = static_cast<char>(toupper(s[0]));
+            }
+            const size_t numFirstCharacters = firstCharacters[0] == firstCharacters[1] ? 1 : 2;
 
-                if (bReverse)
+            size_t searchSize = inlen - slen - offset + 1;
+            while (searchSize)
+            {
+                const size_t candidate = Internal::FindLastOf(in.data(), searchSize, firstCharacters, numFirstCharacters);
+                if (candidate == VStd::string::npos)
                 {
-                    pCur--;
+                    break;
                 }
-                else
+                if (Equal(in.substr(candidate + 1, slen - 1), s.substr(1), bCaseSensitive))
                 {
-                    pCur++;
+                    return candidate;
                 }
-            } while (bReverse ? pCur >= in.data() : pCur - in.data() <= static_cast<ptrdiff_t>(inlen));
+                searchSize = candidate;
+            }
 
             return VStd::string::npos;
         }
@@ -704,51 +1499,170 @@ namespace V {
             return Internal::RChop(in, num);
         }
 
-        VStd::string& LKeep(VStd::string& inout, size_t pos, bool bKeepPosCharacter)
+        VStd::string& LKeep(VStd::string& inout, size_t pos, bool bKeepPosCharacter)
+        {
+            return Internal::LKeep(inout, pos, bKeepPosCharacter);
+        }
+
+        VStd::string& RKeep(VStd::string& inout, size_t pos, bool bKeepPosCharacter)
+        {
+            return Internal::RKeep(inout, pos, bKeepPosCharacter);
+        }
+
+        bool Replace(VStd::string& inout, const char replaceA, const char withB, bool bCaseSensitive, bool bReplaceFirst, bool bReplaceLast)
+        {
+            return Internal::Replace(inout, replaceA, withB, bCaseSensitive, bReplaceFirst, bReplaceLast);
+        }
+
+        bool Replace(VStd::string& inout, const char* replaceA, const char* withB, bool bCaseSensitive, bool bReplaceFirst, bool bReplaceLast)
+        {
+            return Internal::Replace(inout, replaceA, withB, bCaseSensitive, bReplaceFirst, bReplaceLast);
+        }
+
+        bool Strip(VStd::string& inout, const char stripCharacter, bool bCaseSensitive, bool bStripBeginning, bool bStripEnding)
+        {
+            return Internal::Strip(inout, stripCharacter, bCaseSensitive, bStripBeginning, bStripEnding);
+        }
+
+        bool Strip(VStd::string& inout, const char* stripCharacters, bool bCaseSensitive, bool bStripBeginning, bool bStripEnding)
+        {
+            return Internal::Strip(inout, stripCharacters, bCaseSensitive, bStripBeginning, bStripEnding);
+        }
+
+        VStd::string& TrimWhiteSpace(VStd::string& value, bool leading, bool trailing)
+        {
+            static const char* trimmable = " \t\r\n";
+            if (value.length() > 0)
+            {
+                if (leading)
+                {
+                    value.erase(0, value.find_first_not_of(trimmable));
+                }
+                if (trailing)
+                {
+                    value.erase(value.find_last_not_of(trimmable) + 1);
+                }
+            }
+            return value;
+        }
+
+        //=========================================================================
+        // CharacterSet
+        //=========================================================================
+        CharacterSet::CharacterSet(VStd::string_view characters)
+        {
+            for (char c : characters)
+            {
+                if (Contains(c))
+                {
+                    continue;
+                }
+                const V::u8 byte = static_cast<V::u8>(c);
+                m_bits[byte >> 6] |= V::u64(1) << (byte & 63);
+                if (m_numCharacters < MaxVectorCharacters)
+                {
+                    m_characters[m_numCharacters] = c;
+                }
+                ++m_numCharacters;
+            }
+        }
+
+        size_t CharacterSet::FindFirstOf(VStd::string_view in, size_t pos) const
+        {
+            if (pos >= in.size() || IsEmpty())
+            {
+                return VStd::string_view::npos;
+            }
+
+            if (m_numCharacters <= MaxVectorCharacters)
+            {
+                const size_t found = Internal::FindFirstOf(in.data() + pos, in.size() - pos, m_characters, m_numCharacters);
+                return found != VStd::string_view::npos ? found + pos : found;
+            }
+
+            for (; pos < in.size(); ++pos)
+            {
+                if (Contains(in[pos]))
+                {
+                    return pos;
+                }
+            }
+            return VStd::string_view::npos;
+        }
+
+        size_t CharacterSet::FindLastOf(VStd::string_view in, size_t pos) const
         {
-            return Internal::LKeep(inout, pos, bKeepPosCharacter);
-        }
+            if (in.empty() || IsEmpty())
+            {
+                return VStd::string_view::npos;
+            }
 
-        VStd::string& RKeep(VStd::string& inout, size_t pos, bool bKeepPosCharacter)
-        {
-            return Internal::RKeep(inout, pos, bKeepPosCharacter);
-        }
+            const size_t size = pos < in.size() ? pos + 1 : in.size();
+            if (m_numCharacters <= MaxVectorCharacters)
+            {
+                return Internal::FindLastOf(in.data(), size, m_characters, m_numCharacters);
+            }
 
-        bool Replace(VStd::string& inout, const char replaceA, const char withB, bool bCaseSensitive, bool bReplaceFirst, bool bReplaceLast)
-        {
-            return Internal::Replace(inout, replaceA, withB, bCaseSensitive, bReplaceFirst, bReplaceLast);
+            for (size_t i = size; i > 0; --i)
+            {
+                if (Contains(in[i - 1]))
+                {
+                    return i - 1;
+                }
+            }
+            return VStd::string_view::npos;
         }
 
-        bool Replace(VStd::string& inout, const char* replaceA, const char* withB, bool bCaseSensitive, bool bReplaceFirst, bool bReplaceLast)
+        //=========================================================================
+        // TokenRange
+        //=========================================================================
+        TokenRange::TokenRange(VStd::string_view in, const char delimiter, bool keepEmptyStrings, bool keepSpaceStrings)
+            : TokenRange(in, { &delimiter, 1 }, keepEmptyStrings, keepSpaceStrings)
         {
-            return Internal::Replace(inout, replaceA, withB, bCaseSensitive, bReplaceFirst, bReplaceLast);
         }
 
-        bool Strip(VStd::string& inout, const char stripCharacter, bool bCaseSensitive, bool bStripBeginning, bool bStripEnding)
+        TokenRange::TokenRange(VStd::string_view in, VStd::string_view delimiters, bool keepEmptyStrings, bool keepSpaceStrings)
+            : m_input(delimiters.empty() ? VStd::string_view() : in)
+            , m_delimiters(delimiters)
+            , m_keepEmptyStrings(keepEmptyStrings)
+            , m_keepSpaceStrings(keepSpaceStrings)
         {
-            return Internal::Strip(inout, stripCharacter, bCaseSensitive, bStripBeginning, bStripEnding);
         }
 
-        bool Strip(VStd::string& inout, const char* stripCharacters, bool bCaseSensitive, bool bStripBeginning, bool bStripEnding)
+        TokenRange::iterator TokenRange::begin() const
         {
-            return Internal::Strip(inout, stripCharacters, bCaseSensitive, bStripBeginning, bStripEnding);
+            iterator result;
+            result.m_range = this;
+            result.m_remaining = m_input;
+            result.m_isEnd = !Next(result.m_remaining, result.m_token);
+            return result;
         }
 
-        VStd::string& TrimWhiteSpace(VStd::string& value, bool leading, bool trailing)
+        bool TokenRange::Next(VStd::string_view& remaining, VStd::string_view& token) const
         {
-            static const char* trimmable = " \t\r\n";
-            if (value.length() > 0)
+            while (!remaining.empty())
             {
-                if (leading)
+                if (size_t pos = m_delimiters.FindFirstOf(remaining); pos == VStd::string_view::npos)
                 {
-                    value.erase(0, value.find_first_not_of(trimmable));
+                    token = remaining;
+                    remaining = {};
                 }
-                if (trailing)
+                else
                 {
-                    value.erase(value.find_last_not_of(trimmable) + 1);
+                    token = { remaining.data(), pos };
+                    remaining.remove_prefix(pos + 1);
+                }
+
+                const bool bIsEmpty = token.empty();
+                const bool bIsSpaces = !bIsEmpty && Internal::IsSpaceToken(token);
+                if ((bIsEmpty && m_keepEmptyStrings) ||
+                    (bIsSpaces && m_keepSpaceStrings) ||
+                    (!bIsSpaces && !bIsEmpty))
+                {
+                    return true;
                 }
             }
-            return value;
+            return false;
         }
 
         void Tokenize(VStd::string_view in, VStd::vector<VStd::string>& tokens, const char delimiter, bool keepEmptyStrings, bool keepSpaceStrings)
@@ -758,11 +1672,23 @@ namespace V {
 
         void Tokenize(VStd::string_view in, VStd::vector<VStd::string>& tokens, VStd::string_view delimiters, bool keepEmptyStrings, bool keepSpaceStrings)
         {
-            auto insertVisitor = [&tokens](VStd::string_view token)
+            for (VStd::string_view token : TokenRange(in, delimiters, keepEmptyStrings, keepSpaceStrings))
+            {
+                tokens.emplace_back(token);
+            }
+        }
+
+        void Tokenize(VStd::string_view in, VStd::vector<VStd::string_view>& tokens, const char delimiter, bool keepEmptyStrings, bool keepSpaceStrings)
+        {
+            return Tokenize(in, tokens, { &delimiter, 1 }, keepEmptyStrings, keepSpaceStrings);
+        }
+
+        void Tokenize(VStd::string_view in, VStd::vector<VStd::string_view>& tokens, VStd::string_view delimiters, bool keepEmptyStrings, bool keepSpaceStrings)
+        {
+            for (VStd::string_view token : TokenRange(in, delimiters, keepEmptyStrings, keepSpaceStrings))
             {
                 tokens.push_back(token);
-            };
-            return TokenizeVisitor(in, insertVisitor, delimiters, keepEmptyStrings, keepSpaceStrings);
+            }
         }
 
         void TokenizeVisitor(VStd::string_view in, const TokenVisitor& tokenVisitor, const char delimiter, bool keepEmptyStrings, bool keepSpaceStrings)
@@ -773,27 +1699,9 @@ namespace V {
         void TokenizeVisitor(VStd::string_view in, const TokenVisitor& tokenVisitor, VStd::string_view delimiters,
             bool keepEmptyStrings, bool keepSpaceStrings)
         {
-            if (delimiters.empty() || in.empty())
-            {
-                return;
-            }
-
-            while (VStd::optional<VStd::string_view> nextToken = TokenizeNext(in, delimiters))
+            for (VStd::string_view token : TokenRange(in, delimiters, keepEmptyStrings, keepSpaceStrings))
             {
-                bool bIsEmpty = nextToken->empty();
-                bool bIsSpaces = false;
-                if (!bIsEmpty)
-                {
-                    VStd::string_view strippedNextToken = StripEnds(*nextToken, " ");
-                    bIsSpaces = strippedNextToken.empty();
-                }
-
-                if ((bIsEmpty && keepEmptyStrings) ||
-                    (bIsSpaces && keepSpaceStrings) ||
-                    (!bIsSpaces && !bIsEmpty))
-                {
-                    tokenVisitor(*nextToken);
-                }
+                tokenVisitor(token);
             }
         }
 
@@ -810,21 +1718,27 @@ namespace V {
                 return;
             }
 
-            while (VStd::optional<VStd::string_view> nextToken = TokenizeLast(in, delimiters))
+            const CharacterSet delimiterSet(delimiters);
+            while (!in.empty())
             {
-                bool bIsEmpty = nextToken->empty();
-                bool bIsSpaces = false;
-                if (!bIsEmpty)
+                VStd::string_view nextToken;
+                if (size_t pos = delimiterSet.FindLastOf(in); pos == VStd::string_view::npos)
                 {
-                    VStd::string_view strippedNextToken = StripEnds(*nextToken, " ");
-                    bIsSpaces = strippedNextToken.empty();
+                    nextToken.swap(in);
+                }
+                else
+                {
+                    nextToken = in.substr(pos + 1);
+                    in = in.substr(0, pos);
                 }
 
+                const bool bIsEmpty = nextToken.empty();
+                const bool bIsSpaces = !bIsEmpty && Internal::IsSpaceToken(nextToken);
                 if ((bIsEmpty && keepEmptyStrings) ||
                     (bIsSpaces && keepSpaceStrings) ||
                     (!bIsSpaces && !bIsEmpty))
                 {
-                    tokenVisitor(*nextToken);
+                    tokenVisitor(nextToken);
                 }
             }
         }
@@ -841,7 +1755,7 @@ namespace V {
             }
 
             VStd::string_view resultToken;
-            if (size_t pos = inout.find_first_of(delimiters); pos == VStd::string_view::npos)
+            if (size_t pos = CharacterSet(delimiters).FindFirstOf(inout); pos == VStd::string_view::npos)
             {
                 // The delimiter has not been found, a new view containing the entire
                 // string will be returned and the input parameter will be set to empty
@@ -870,7 +1784,7 @@ namespace V {
             }
 
             VStd::string_view resultToken;
-            if (size_t pos = inout.find_last_of(delimiters); pos == VStd::string_view::npos)
+            if (size_t pos = CharacterSet(delimiters).FindLastOf(inout); pos == VStd::string_view::npos)
             {
                 // The delimiter has not been found, a new view containing the entire
                 // string will be returned and the input parameter will be set to empty
@@ -948,6 +1862,11 @@ namespace V {
             {
                 return 0;
             }
+            int result;
+            if (VStd::Internal::sto_from_chars(in, strlen(in), nullptr, 10, result))
+            {
+                return result;
+            }
             return atoi(in);
         }
 
@@ -958,38 +1877,19 @@ namespace V {
                 return false;
             }
 
-            //if pos is past then end of the string false
-            size_t len = strlen(in);
-            if (!len)//must at least 1 characters to work with "1"
+            // an optional '-' and digits only, the whole string must be the number
+            const char* end = in + strlen(in);
+            int result;
+            const VStd::from_chars_result parsed = VStd::from_chars(in, end, result);
+            if (parsed.ec != VStd::errc{} || parsed.ptr != end)
             {
                 return false;
             }
-
-            const char* pStr = in;
-
-            size_t countNeg = 0;
-            while (*pStr != '\0' &&
-                   (isdigit(*pStr) ||
-                    *pStr == '-'))
-            {
-                if (*pStr == '-')
-                {
-                    countNeg++;
-                }
-                pStr++;
-            }
-
-            if (*pStr == '\0' &&
-                countNeg < 2)
+            if (pInt)
             {
-                if (pInt)
-                {
-                    *pInt = ToInt(in);
-                }
-
-                return true;
+                *pInt = result;
             }
-            return false;
+            return true;
         }
 
         double ToDouble(const char* in)
@@ -998,6 +1898,11 @@ namespace V {
             {
                 return 0.;
             }
+            double result;
+            if (VStd::Internal::sto_from_chars(in, strlen(in), nullptr, result))
+            {
+                return result;
+            }
             return atof(in);
         }
 
@@ -1014,39 +1919,24 @@ namespace V {
                 return false;
             }
 
-            const char* pStr = in;
-
-            size_t countDot = 0;
-            size_t countNeg = 0;
-            while (*pStr != '\0' &&
-                (isdigit(*pStr) ||
-                (*pStr == '-' ||
-                    *pStr == '.')))
+            // digits with exactly one '.' and an optional leading '-', no exponent
+            const char* dot = strchr(in, '.');
+            if (!dot || strchr(dot + 1, '.'))
             {
-                if (*pStr == '.')
-                {
-                    countDot++;
-                }
-                if (*pStr == '-')
-                {
-                    countNeg++;
-                }
-                pStr++;
+                return false;
             }
-
-            if (*pStr == '\0' &&
-                countDot == 1 &&
-                countNeg < 2)
+            const char* end = in + len;
+            double result;
+            const VStd::from_chars_result parsed = VStd::from_chars(in, end, result, VStd::chars_format::fixed);
+            if (parsed.ec != VStd::errc{} || parsed.ptr != end)
             {
-                if (pDouble)
-                {
-                    *pDouble = ToDouble(in);
-                }
-
-                return true;
+                return false;
             }
-
-            return false;
+            if (pDouble)
+            {
+                *pDouble = result;
+            }
+            return true;
         }
 
         float ToFloat(const char* in)
@@ -1055,6 +1945,11 @@ namespace V {
             {
                 return 0.f;
             }
+            float result;
+            if (VStd::Internal::sto_from_chars(in, strlen(in), nullptr, result))
+            {
+                return result;
+            }
             return (float)atof(in);
         }
 
@@ -1118,109 +2013,39 @@ namespace V {
 
         bool ToHexDump(const char* in, VStd::string& out)
         {
-            struct TInline
-            {
-                static void ByteToHex(char* pszHex, unsigned char bValue)
-                {
-                    pszHex[0] = bValue / 16;
-
-                    if (pszHex[0] < 10)
-                    {
-                        pszHex[0] += '0';
-                    }
-                    else
-                    {
-                        pszHex[0] -= 10;
-                        pszHex[0] += 'A';
-                    }
-
-                    pszHex[1] = bValue % 16;
-
-                    if (pszHex[1] < 10)
-                    {
-                        pszHex[1] += '0';
-                    }
-                    else
-                    {
-                        pszHex[1] -= 10;
-                        pszHex[1] += 'A';
-                    }
-                }
-            };
-
             size_t len = strlen(in);
             if (len < 1) //must be at least 1 character to work with
             {
                 return false;
             }
 
-            size_t nBytes = len;
-
-            char* pszData = reinterpret_cast<char*>(vmalloc((nBytes * 2) + 1));
-
-            for (size_t ii = 0; ii < nBytes; ++ii)
-            {
-                TInline::ByteToHex(&pszData[ii * 2], in[ii]);
-            }
-
-            pszData[nBytes * 2] = 0x00;
-            out = pszData;
-            vfree(pszData);
-
+            out.resize_no_construct(Hex::EncodedSize(len));
+            Internal::HexEncode(out.data(), reinterpret_cast<const V::u8*>(in), len, true);
             return true;
         }
 
         bool FromHexDump(const char* in, VStd::string& out)
         {
-            struct TInline
-            {
-                static unsigned char HexToByte(const char* pszHex)
-                {
-                    unsigned char bHigh = 0;
-                    unsigned char bLow = 0;
-
-                    if ((pszHex[0] >= '0') && (pszHex[0] <= '9'))
-                    {
-                        bHigh = pszHex[0] - '0';
-                    }
-                    else if ((pszHex[0] >= 'A') && (pszHex[0] <= 'F'))
-                    {
-                        bHigh = (pszHex[0] - 'A') + 10;
-                    }
-
-                    bHigh = bHigh << 4;
-
-                    if ((pszHex[1] >= '0') && (pszHex[1] <= '9'))
-                    {
-                        bLow = pszHex[1] - '0';
-                    }
-                    else if ((pszHex[1] >= 'A') && (pszHex[1] <= 'F'))
-                    {
-                        bLow = (pszHex[1] - 'A') + 10;
-                    }
-
-                    return bHigh | bLow;
-                }
-            };
-
             size_t len = strlen(in);
             if (len < 2) //must be at least 2 characters to work with
             {
                 return false;
             }
 
+            // A trailing odd character is ignored
             size_t nBytes = len / 2;
-            char* pszData = reinterpret_cast<char*>(vmalloc(nBytes + 1));
-
-            for (size_t ii = 0; ii < nBytes; ++ii)
+            out.resize_no_construct(nBytes);
+            V::u8* data = reinterpret_cast<V::u8*>(out.data());
+            for (size_t ii = Internal::HexDecode(data, in, nBytes * 2) / 2; ii < nBytes; ++ii)
             {
-                pszData[ii] = TInline::HexToByte(&in[ii * 2]);
+                // Characters that are not hex digits count as 0
+                const int high = Internal::HexValue(in[ii * 2]);
+                const int low = Internal::HexValue(in[ii * 2 + 1]);
+                data[ii] = static_cast<V::u8>(((high < 0 ? 0 : high) << 4) | (low < 0 ? 0 : low));
             }
 
-            pszData[nBytes] = 0x00;
-            out = pszData;
-            vfree(pszData);
-
+            // The result is a c-string, it ends at the first null byte
+            out.resize(strnlen(out.data(), nBytes));
             return true;
         }
 
@@ -2320,168 +3145,208 @@ namespace V {
 
         namespace Base64
         {
-            static const char base64pad = '=';
+            VStd::string Encode(const V::u8* in, const size_t size)
+            {
+                VStd::string result;
+                result.resize_no_construct(EncodedSize(size));
+                Encode(result.data(), in, size);
+                return result;
+            }
 
-            static const char c_base64Table[] =
+            size_t Encode(char* out, const V::u8* in, const size_t size)
             {
-                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-                "abcdefghijklmnopqrstuvwxyz"
-                "0123456789+/"
-            };
+                const size_t consumed = Internal::Base64EncodeGroups(out, in, size);
+                size_t written = consumed / 3 * 4;
+                if (consumed < size)
+                {
+                    Internal::Base64EncodeLast(out + written, in + consumed, size - consumed);
+                    written += 4;
+                }
+                return written;
+            }
 
-            static const V::u8 c_inverseBase64Table[] =
+            bool Decode(VStd::vector<V::u8>& out, const char* in, const size_t size)
             {
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
-                0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
-                0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
-                0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-            };
+                if (size % 4 != 0)
+                {
+                    V_Warning("StringFunc", size % 4 == 0, "Base 64 encoded data length must be multiple of 4");
+                    return false;
+                }
+
+                VStd::vector<V::u8> result;
+                result.resize_no_construct(MaxDecodedSize(size));
+                size_t errorOffset = 0;
+                const size_t written = Internal::Base64Decode(result.data(), in, size, errorOffset);
+                if (written == VStd::string_view::npos)
+                {
+                    V_Warning("StringFunc", false, "Invalid Base64 encoded text at offset %zu", errorOffset);
+                    return false;
+                }
+
+                result.resize(written);
+                out = VStd::move(result);
+                return true;
+            }
 
-            bool IsValidEncodedChar(const char encodedChar)
+            VStd::optional<size_t> Decode(V::u8* out, const char* in, const size_t size)
             {
-                return c_inverseBase64Table[static_cast<size_t>(encodedChar)] != 0xff;
+                size_t errorOffset = 0;
+                const size_t written = size % 4 == 0 ? Internal::Base64Decode(out, in, size, errorOffset) : VStd::string_view::npos;
+                if (written == VStd::string_view::npos)
+                {
+                    return VStd::nullopt;
+                }
+                return written;
             }
 
-            VStd::string Encode(const V::u8* in, const size_t size)
+            size_t Encoder::Update(char* out, const V::u8* in, size_t size)
             {
-                /*
-                figure retrieved from the Base encoding rfc https://tools.ietf.org/html/rfc4648
-                +--first octet--+-second octet--+--third octet--+
-                |7 6 5 4 3 2 1 0|7 6 5 4 3 2 1 0|7 6 5 4 3 2 1 0|
-                +-----------+---+-------+-------+---+-----------+
-                |5 4 3 2 1 0|5 4 3 2 1 0|5 4 3 2 1 0|5 4 3 2 1 0|
-                +--1.index--+--2.index--+--3.index--+--4.index--+
-                */
-                VStd::string result;
+                size_t written = 0;
+                if (m_pendingSize > 0)
+                {
+                    while (m_pendingSize < 3 && size > 0)
+                    {
+                        m_pending[m_pendingSize++] = *in++;
+                        --size;
+                    }
+                    if (m_pendingSize < 3)
+                    {
+                        return 0;
+                    }
+                    Internal::Base64EncodeGroups(out, m_pending, 3);
+                    m_pendingSize = 0;
+                    written = 4;
+                }
+
+                const size_t consumed = Internal::Base64EncodeGroups(out + written, in, size);
+                written += consumed / 3 * 4;
+                m_pendingSize = size - consumed;
+                memcpy(m_pending, in + consumed, m_pendingSize);
+                return written;
+            }
 
-                const size_t remainder = size % 3;
-                const size_t alignEndSize = size - remainder;
-                const V::u8* encodeBuf = in;
-                size_t encodeIndex = 0;
-                for (; encodeIndex < alignEndSize; encodeIndex += 3)
+            size_t Encoder::Finish(char* out)
+            {
+                if (m_pendingSize == 0)
                 {
-                    encodeBuf = &in[encodeIndex];
+                    return 0;
+                }
+                Internal::Base64EncodeLast(out, m_pending, m_pendingSize);
+                m_pendingSize = 0;
+                return 4;
+            }
 
-                    result.push_back(c_base64Table[(encodeBuf[0] & 0xfc) >> 2]);
-                    result.push_back(c_base64Table[((encodeBuf[0] & 0x03) << 4) | ((encodeBuf[1] & 0xf0) >> 4)]);
-                    result.push_back(c_base64Table[((encodeBuf[1] & 0x0f) << 2) | ((encodeBuf[2] & 0xc0) >> 6)]);
-                    result.push_back(c_base64Table[encodeBuf[2] & 0x3f]);
+            VStd::optional<size_t> Decoder::Update(V::u8* out, const char* in, size_t size)
+            {
+                if (m_failed)
+                {
+                    return VStd::nullopt;
                 }
 
-                encodeBuf = &in[encodeIndex];
-                if (remainder == 2)
+                size_t written = 0;
+                if (m_pendingSize > 0)
                 {
-                    result.push_back(c_base64Table[(encodeBuf[0] & 0xfc) >> 2]);
-                    result.push_back(c_base64Table[((encodeBuf[0] & 0x03) << 4) | ((encodeBuf[1] & 0xf0) >> 4)]);
-                    result.push_back(c_base64Table[((encodeBuf[1] & 0x0f) << 2)]);
-                    result.push_back(base64pad);
+                    const size_t count = VStd::min(4 - m_pendingSize, size);
+                    memcpy(m_pending + m_pendingSize, in, count);
+                    m_pendingSize += count;
+                    in += count;
+                    size -= count;
+                    if (m_pendingSize < 4)
+                    {
+                        return size_t(0);
+                    }
+                    m_pendingSize = 0;
+                    if (!DecodeGroups(out, m_pending, 4, written))
+                    {
+                        return VStd::nullopt;
+                    }
                 }
-                else if (remainder == 1)
+
+                const size_t groupsSize = size - size % 4;
+                size_t groupsWritten = 0;
+                if (!DecodeGroups(out + written, in, groupsSize, groupsWritten))
                 {
-                    result.push_back(c_base64Table[(encodeBuf[0] & 0xfc) >> 2]);
-                    result.push_back(c_base64Table[(encodeBuf[0] & 0x03) << 4]);
-                    result.push_back(base64pad);
-                    result.push_back(base64pad);
+                    return VStd::nullopt;
                 }
+                m_pendingSize = size - groupsSize;
+                memcpy(m_pending, in + groupsSize, m_pendingSize);
+                return written + groupsWritten;
+            }
 
+            bool Decoder::Finish()
+            {
+                const bool result = !m_failed && m_pendingSize == 0;
+                m_pendingSize = 0;
+                m_ended = false;
+                m_failed = false;
                 return result;
             }
 
-            bool Decode(VStd::vector<V::u8>& out, const char* in, const size_t size)
+            bool Decoder::DecodeGroups(V::u8* out, const char* in, size_t size, size_t& written)
             {
-                if (size % 4 != 0)
+                written = 0;
+                if (size == 0)
                 {
-                    V_Warning("StringFunc", size % 4 == 0, "Base 64 encoded data length must be multiple of 4");
-                    return false;
+                    return true;
                 }
 
-                VStd::vector<V::u8> result;
-                result.reserve(size * 3 / 4);
-                const char* decodeBuf = in;
-                size_t decodeIndex = 0;
-                for (; decodeIndex < size; decodeIndex += 4)
+                size_t errorOffset = 0;
+                const size_t decoded = m_ended ? VStd::string_view::npos : Internal::Base64Decode(out, in, size, errorOffset);
+                if (decoded == VStd::string_view::npos)
                 {
-                    decodeBuf = &in[decodeIndex];
-                    //Check if each character is a valid Base64 encoded character 
-                    {
-                        // First Octet
-                        if (!IsValidEncodedChar(decodeBuf[0]))
-                        {
-                            V_Warning("StringFunc", false, "Invalid Base64 encoded text at offset %tu", VStd::distance(in, &decodeBuf[0]));
-                            return false;
-                        }
-                        if (!IsValidEncodedChar(decodeBuf[1]))
-                        {
-                            V_Warning("StringFunc", false, "Invalid Base64 encoded text at offset %tu", VStd::distance(in, &decodeBuf[1]));
-                            return false;
-                        }
-
-                        result.push_back((c_inverseBase64Table[static_cast<size_t>(decodeBuf[0])] << 2) | ((c_inverseBase64Table[static_cast<size_t>(decodeBuf[1])] & 0x30) >> 4));
-                    }
-
-                    {
-                        // Second Octet
-                        if (decodeBuf[2] == base64pad)
-                        {
-                            break;
-                        }
-
-                        if (!IsValidEncodedChar(decodeBuf[2]))
-                        {
-                            V_Warning("StringFunc", false, "Invalid Base64 encoded text at offset %tu", VStd::distance(in, &decodeBuf[2]));
-                            return false;
-                        }
+                    m_failed = true;
+                    return false;
+                }
+                // A group with padding ends the stream
+                m_ended = decoded != MaxDecodedSize(size);
+                written = decoded;
+                return true;
+            }
+        } // namespace Base64
 
-                        result.push_back(((c_inverseBase64Table[static_cast<size_t>(decodeBuf[1])] & 0x0f) << 4) | ((c_inverseBase64Table[static_cast<size_t>(decodeBuf[2])] & 0x3c) >> 2));
-                    }
+        namespace Hex
+        {
+            void Encode(char* out, const V::u8* in, const size_t size, bool upperCase)
+            {
+                Internal::HexEncode(out, in, size, upperCase);
+            }
 
-                    {
-                        // Third Octet
-                        if (decodeBuf[3] == base64pad)
-                        {
-                            break;
-                        }
+            VStd::string Encode(const V::u8* in, const size_t size, bool upperCase)
+            {
+                VStd::string result;
+                result.resize_no_construct(EncodedSize(size));
+                Internal::HexEncode(result.data(), in, size, upperCase);
+                return result;
+            }
 
-                        if (!IsValidEncodedChar(decodeBuf[3]))
-                        {
-                            V_Warning("StringFunc", false, "Invalid Base64 encoded text at offset %tu", VStd::distance(in, &decodeBuf[3]));
-                            return false;
-                        }
+            bool Decode(V::u8* out, const char* in, const size_t size)
+            {
+                return size % 2 == 0 && Internal::HexDecode(out, in, size) == size;
+            }
 
-                        result.push_back(((c_inverseBase64Table[static_cast<size_t>(decodeBuf[2])] & 0x03) << 6) | (c_inverseBase64Table[static_cast<size_t>(decodeBuf[3])] & 0x3f));
-                    }
+            bool Decode(VStd::vector<V::u8>& out, const char* in, const size_t size)
+            {
+                VStd::vector<V::u8> result;
+                result.resize_no_construct(size / 2);
+                if (!Decode(result.data(), in, size))
+                {
+                    return false;
                 }
-
                 out = VStd::move(result);
                 return true;
             }
-        }
+        } // namespace Hex
 
         namespace Utf8
         {
             bool CheckNonAsciiChar(const VStd::string& in)
             {
-                for (int i = 0; i < (int)in.length(); ++i)
-                {
-                    char byte = in[i];
-                    if (byte & 0x80)
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                return ::Utf8::ascii_length(in.data(), in.size()) != in.size();
+            }
+
+            bool IsValid(VStd::string_view in)
+            {
+                return ::Utf8::is_valid_utf8(in.data(), in.size());
             }
         }
     } // namespace StringFunc
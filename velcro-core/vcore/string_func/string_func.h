@@ -253,6 +253,41 @@ namespace V {
         bool Strip(VStd::string& inout, const char stripCharacter = ' ', bool bCaseSensitive = false, bool bStripBeginning = false, bool bStripEnding = false);
         bool Strip(VStd::string& inout, const char* stripCharacters = " ", bool bCaseSensitive = false, bool bStripBeginning = false, bool bStripEnding = false);
 
+        //! CharacterSet
+        /*! A set of single byte characters, built once and used to scan many strings.
+         *! Scans 16 or 32 bytes at a time with SSE2 or AVX2 (picked at runtime) for sets of up to
+         *! MaxVectorCharacters characters, larger sets use a bitmap lookup per byte.
+         Example: Find the first separator of a key value list
+         StringFunc::CharacterSet separators("=;");
+         separators.FindFirstOf("key=value;other") == 3
+         separators.FindLastOf("key=value;other") == 9
+         */
+        class CharacterSet
+        {
+        public:
+            static constexpr size_t MaxVectorCharacters = 8;
+
+            CharacterSet() = default;
+            explicit CharacterSet(VStd::string_view characters);
+
+            bool Contains(char c) const
+            {
+                const V::u8 byte = static_cast<V::u8>(c);
+                return (m_bits[byte >> 6] >> (byte & 63)) & 1;
+            }
+            bool IsEmpty() const { return m_numCharacters == 0; }
+
+            //! Returns the position of the first character of in at or after pos that is in the set, or npos.
+            size_t FindFirstOf(VStd::string_view in, size_t pos = 0) const;
+            //! Returns the position of the last character of in at or before pos that is in the set, or npos.
+            size_t FindLastOf(VStd::string_view in, size_t pos = VStd::string_view::npos) const;
+
+        private:
+            V::u64 m_bits[4] = {};
+            char m_characters[MaxVectorCharacters] = {};
+            size_t m_numCharacters = 0;     ///< Number of distinct characters, the first MaxVectorCharacters are in m_characters.
+        };
+
         //! Tokenize
         /*! Tokenize a c-string, into a vector of VStd::string(s) optionally keeping empty string
          *! and optionally keeping space only strings
@@ -266,6 +301,79 @@ namespace V {
         void Tokenize(VStd::string_view in, VStd::vector<VStd::string>& tokens, VStd::string_view delimiters = "\\//, \t\n", bool keepEmptyStrings = false, bool keepSpaceStrings = false);
         void Tokenize(VStd::string_view in, VStd::vector<VStd::string>& tokens, const VStd::vector<VStd::string_view>& delimiters, bool keepEmptyStrings = false, bool keepSpaceStrings = false);
 
+        //! Same as above, the tokens are views into the input string so only the vector allocates.
+        //! Reuse the vector across calls to tokenize without allocating at all.
+        void Tokenize(VStd::string_view in, VStd::vector<VStd::string_view>& tokens, const char delimiter, bool keepEmptyStrings = false, bool keepSpaceStrings = false);
+        void Tokenize(VStd::string_view in, VStd::vector<VStd::string_view>& tokens, VStd::string_view delimiters = "\\//, \t\n", bool keepEmptyStrings = false, bool keepSpaceStrings = false);
+
+        //! TokenRange
+        /*! Iterates over the tokens of a string_view without allocating, giving the same tokens TokenizeVisitor visits.
+         *! The tokens are views into the input string, which has to outlive the range.
+         Example: Tokenize a comma delimited string
+         for (VStd::string_view token : StringFunc::TokenRange("Hello,World,,More", ','))
+         Yields "Hello", "World" and "More"
+         Example: Tokenize a space delimited string while keeping empty strings
+         for (VStd::string_view token : StringFunc::TokenRange("Hello  World", " ", true))
+         Yields "Hello", "" and "World"
+         */
+        class TokenRange
+        {
+        public:
+            class iterator
+            {
+            public:
+                using iterator_category = VStd::forward_iterator_tag;
+                using value_type = VStd::string_view;
+                using difference_type = ptrdiff_t;
+                using pointer = const VStd::string_view*;
+                using reference = const VStd::string_view&;
+
+                iterator() = default;
+
+                reference operator*() const { return m_token; }
+                pointer operator->() const { return &m_token; }
+                iterator& operator++()
+                {
+                    m_isEnd = !m_range->Next(m_remaining, m_token);
+                    return *this;
+                }
+                iterator operator++(int)
+                {
+                    iterator result = *this;
+                    ++*this;
+                    return result;
+                }
+                bool operator==(const iterator& rhs) const
+                {
+                    return m_isEnd == rhs.m_isEnd && (m_isEnd || (m_token.data() == rhs.m_token.data() && m_token.size() == rhs.m_token.size()));
+                }
+                bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+            private:
+                friend class TokenRange;
+
+                const TokenRange* m_range = nullptr;
+                VStd::string_view m_remaining;
+                VStd::string_view m_token;
+                bool m_isEnd = true;
+            };
+
+            TokenRange(VStd::string_view in, const char delimiter, bool keepEmptyStrings = false, bool keepSpaceStrings = false);
+            TokenRange(VStd::string_view in, VStd::string_view delimiters, bool keepEmptyStrings = false, bool keepSpaceStrings = false);
+
+            iterator begin() const;
+            iterator end() const { return iterator(); }
+
+        private:
+            //! Moves the next kept token of remaining into token, returns false when there are no more tokens.
+            bool Next(VStd::string_view& remaining, VStd::string_view& token) const;
+
+            VStd::string_view m_input;
+            CharacterSet m_delimiters;
+            bool m_keepEmptyStrings;
+            bool m_keepSpaceStrings;
+        };
+
         //! TokenizeVisitor
         /*! Tokenize a string_view and invoke a handler for each token found.
          *! The keep empty string option will invoke the handler with empty strings
@@ -946,8 +1054,106 @@ namespace V {
             */
             bool Decode(VStd::vector<V::u8>& out, const char* in, const size_t size);
 
+            //! Number of characters that Encode writes for size bytes, including the padding.
+            constexpr size_t EncodedSize(size_t size)
+            {
+                return (size + 2) / 3 * 4;
+            }
+
+            //! Number of bytes that Decode needs in its output buffer for size characters.
+            //! The decoded data is up to 2 bytes shorter when the text ends with padding.
+            constexpr size_t MaxDecodedSize(size_t size)
+            {
+                return size / 4 * 3;
+            }
+
+            //! Encodes size bytes into out, which must hold EncodedSize(size) characters. No null terminator is written.
+            //! Large inputs are encoded 24 bytes at a time with AVX2, or 12 with SSSE3, when the CPU supports them.
+            //! Returns the number of characters written.
+            size_t Encode(char* out, const V::u8* in, const size_t size);
+
+            //! Decodes size characters into out, which must hold MaxDecodedSize(size) bytes.
+            //! Returns the number of bytes written, or an empty optional if the text is not valid Base64, in which case
+            //! out may have been partly written. Padding is only accepted at the end of the text.
+            VStd::optional<size_t> Decode(V::u8* out, const char* in, const size_t size);
+
+            //! Encodes a stream of bytes that arrives in pieces, the characters are the same as Encode of the whole stream.
+            /*! EX: Base64::Encoder encoder;
+            *! for (each piece) { buffer.resize(encoder.GetUpdateSize(pieceSize)); send(buffer.data(), encoder.Update(buffer.data(), piece, pieceSize)); }
+            *! send(tail, encoder.Finish(tail));
+            */
+            class Encoder
+            {
+            public:
+                //! Number of characters that Update(out, in, size) writes.
+                size_t GetUpdateSize(size_t size) const
+                {
+                    return (m_pendingSize + size) / 3 * 4;
+                }
+
+                //! Encodes the complete groups of 3 bytes of the bytes kept from the previous update followed by in,
+                //! out must hold GetUpdateSize(size) characters. Returns the number of characters written.
+                size_t Update(char* out, const V::u8* in, size_t size);
+
+                //! Encodes the last 1 or 2 bytes of the stream with padding into out, which must hold 4 characters.
+                //! Returns the number of characters written, 0 or 4. The encoder can be used for a new stream afterwards.
+                size_t Finish(char* out);
+
+            private:
+                V::u8 m_pending[3];
+                size_t m_pendingSize = 0;
+            };
+
+            //! Decodes Base64 text that arrives in pieces, which can be split anywhere.
+            class Decoder
+            {
+            public:
+                //! Number of bytes that Update(out, in, size) needs in its output buffer.
+                size_t GetMaxUpdateSize(size_t size) const
+                {
+                    return (m_pendingSize + size) / 4 * 3;
+                }
+
+                //! Decodes the complete groups of 4 characters of the characters kept from the previous update followed
+                //! by in, out must hold GetMaxUpdateSize(size) bytes. Returns the number of bytes written, or an empty
+                //! optional if the text is not valid Base64 so far. Once an update fails the following ones fail as well.
+                VStd::optional<size_t> Update(V::u8* out, const char* in, size_t size);
+
+                //! Returns true if the whole stream was valid and ended on a complete group of 4 characters.
+                //! The decoder can be used for a new stream afterwards.
+                bool Finish();
+
+            private:
+                // Decodes whole groups, the one with padding must be the last of the stream.
+                bool DecodeGroups(V::u8* out, const char* in, size_t size, size_t& written);
+
+                char m_pending[4];
+                size_t m_pendingSize = 0;
+                bool m_ended = false;
+                bool m_failed = false;
+            };
         };
 
+        namespace Hex
+        {
+            //! Number of characters that Encode writes for size bytes.
+            constexpr size_t EncodedSize(size_t size)
+            {
+                return size * 2;
+            }
+
+            //! Encodes each byte as 2 hex digits into out, which must hold EncodedSize(size) characters.
+            //! No null terminator is written. Large inputs are encoded 32 bytes at a time with AVX2, or 16 with SSE2.
+            void Encode(char* out, const V::u8* in, const size_t size, bool upperCase = true);
+            VStd::string Encode(const V::u8* in, const size_t size, bool upperCase = true);
+
+            //! Decodes size hex digits of either case into out, which must hold size / 2 bytes.
+            //! Returns false if size is odd or a character is not a hex digit, in which case out may have been partly written.
+            bool Decode(V::u8* out, const char* in, const size_t size);
+            //! Decodes into out, which is left unmodified if the text is not valid hex.
+            bool Decode(VStd::vector<V::u8>& out, const char* in, const size_t size);
+        } // namespace Hex
+
         namespace Utf8
         {
             /**
@@ -956,6 +1162,13 @@ namespace V {
              * @return true if the string passed in contains any byte that cannot be encoded in 7-bit ASCII, otherwise false.
              */
             bool CheckNonAsciiChar(const VStd::string& in);
+
+            /**
+             * Check to see if a string is well formed UTF-8.
+             * @param in A string to validate.
+             * @return true if the string has no invalid, truncated or overlong sequences, surrogates or code points past U+10FFFF.
+             */
+            bool IsValid(VStd::string_view in);
         }
     } // namespace StringFunc
 } // namespace VelcroFramework
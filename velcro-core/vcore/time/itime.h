@@ -13,6 +13,7 @@
 namespace V {
     V_TYPE_SAFE_INTEGRAL(TimeMs, int64_t);
     V_TYPE_SAFE_INTEGRAL(TimeUs, int64_t);
+    V_TYPE_SAFE_INTEGRAL(TimeNs, int64_t);
 
     class ITime {
         public:
@@ -27,6 +28,9 @@ namespace V {
             /// @brief 返回应用程序从开始到现在的时间间隔,单位微妙
             /// @return 应用程序从开始到现在的时间间隔
             virtual TimeUs GetElapsedTimeUs() const = 0;
+            /// @brief 返回应用程序从开始到现在的时间间隔,单位纳秒
+            /// @return 应用程序从开始到现在的时间间隔
+            virtual TimeNs GetElapsedTimeNs() const = 0;
 
             V_DISABLE_COPY_MOVE(ITime);
     };
@@ -41,6 +45,12 @@ namespace V {
         return V::Interface<ITime>::Get()->GetElapsedTimeUs();
     }
 
+    //! This is a simple convenience wrapper
+    inline TimeNs GetElapsedTimeNs()
+    {
+        return V::Interface<ITime>::Get()->GetElapsedTimeNs();
+    }
+
     //! Converts from milliseconds to microseconds
     inline TimeUs TimeMsToUs(TimeMs value)
     {
@@ -53,6 +63,24 @@ namespace V {
         return static_cast<TimeMs>(value / static_cast<TimeUs>(1000));
     }
 
+    //! Converts from microseconds to nanoseconds
+    inline TimeNs TimeUsToNs(TimeUs value)
+    {
+        return static_cast<TimeNs>(value * static_cast<TimeUs>(1000));
+    }
+
+    //! Converts from nanoseconds to microseconds
+    inline TimeUs TimeNsToUs(TimeNs value)
+    {
+        return static_cast<TimeUs>(value / static_cast<TimeNs>(1000));
+    }
+
+    //! Converts from nanoseconds to milliseconds
+    inline TimeMs TimeNsToMs(TimeNs value)
+    {
+        return static_cast<TimeMs>(value / static_cast<TimeNs>(1000000));
+    }
+
     //! Converts from milliseconds to seconds
     inline float TimeMsToSeconds(TimeMs value)
     {
@@ -84,5 +112,6 @@ namespace V {
 
 V_TYPE_SAFE_INTEGRAL_SERIALIZEBINDING(V::TimeMs);
 V_TYPE_SAFE_INTEGRAL_SERIALIZEBINDING(V::TimeUs);
+V_TYPE_SAFE_INTEGRAL_SERIALIZEBINDING(V::TimeNs);
 
 #endif // V_FRAMEWORK_CORE_TIME_ITIME_H
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <vcore/time/time_system.h>
+#include <vcore/interface/interface.h>
+#include <vcore/std/parallel/lock.h>
+#include <vcore/std/parallel/mutex.h>
+#include <vcore/std/parallel/thread.h>
+
+namespace V {
+    namespace TimeSystemInternal {
+        // serializes the re-basing and publishing of concurrent calibrations,
+        // defined before s_stateOwner which locks it when it is destroyed
+        VStd::mutex s_calibrateMutex;
+    }
+
+    const MonotonicClock::State MonotonicClock::s_uncalibratedState;
+    MonotonicClock::State MonotonicClock::s_exitState;
+    VStd::atomic<const MonotonicClock::State*> MonotonicClock::s_state{ &MonotonicClock::s_uncalibratedState };
+    MonotonicClock::StateOwner MonotonicClock::s_stateOwner;
+
+    void MonotonicClock::Calibrate(V::u32 calibrationMs)
+    {
+        State* state = new State();
+        state->m_ticksPerSecond = VStd::GetTimeTicksPerSecond();
+
+        if (V::Platform::HasInvariantTimeStampCounter() && calibrationMs > 0) {
+            // Bracket both counters as tightly as possible at the start and the end of the window,
+            // the error of the measured rate is then bounded by the two tick reads rather than the sleep.
+            const VStd::sys_time_t ticksStart = VStd::GetTimeNowTicks();
+            const V::u64 tscStart = V::Platform::ReadTimeStampCounter();
+            VStd::this_thread::sleep_for(VStd::chrono::milliseconds(calibrationMs));
+            const VStd::sys_time_t ticksEnd = VStd::GetTimeNowTicks();
+            const V::u64 tscEnd = V::Platform::ReadTimeStampCounter();
+
+            const double elapsedNs = static_cast<double>(ticksEnd - ticksStart) * 1e9 / static_cast<double>(state->m_ticksPerSecond);
+            const double tscDelta = static_cast<double>(tscEnd - tscStart);
+            if (elapsedNs > 0.0 && tscDelta > 0.0) {
+                const double nsPerTsc = elapsedNs / tscDelta;
+                // NowNs() relies on the multiplier fitting in 32 bits, i.e. a TSC faster than 1 GHz.
+                if (nsPerTsc < 1.0) {
+                    state->m_tscToNsMul = static_cast<V::u64>(nsPerTsc * 4294967296.0);
+                    state->m_useTsc = state->m_tscToNsMul != 0;
+                }
+            }
+        }
+
+        Publish(state, false);
+    }
+
+    void MonotonicClock::Publish(State* state, bool onlyIfUncalibrated)
+    {
+        VStd::lock_guard<VStd::mutex> lock(TimeSystemInternal::s_calibrateMutex);
+        const State* previous = s_state.load(VStd::memory_order_acquire);
+        if (onlyIfUncalibrated && previous != &s_uncalibratedState) {
+            delete state;
+            return;
+        }
+
+        state->m_ticksBase = VStd::GetTimeNowTicks();
+        state->m_tscBase = V::Platform::ReadTimeStampCounter();
+
+        // Re-base on the value the current state gives at the new bases, so the clock doesn't jump back to zero.
+        if (previous != &s_uncalibratedState) {
+            state->m_nsBase = previous->m_useTsc
+                ? previous->m_nsBase + TscToNs(*previous, state->m_tscBase)
+                : TicksToNs(*previous, state->m_ticksBase);
+            state->m_previous = previous;
+        }
+        s_state.store(state, VStd::memory_order_release);
+    }
+
+    V::s64 MonotonicClock::TicksToNs(const State& state, VStd::sys_time_t ticks)
+    {
+        ticks -= state.m_ticksBase;
+        const VStd::sys_time_t frequency = state.m_ticksPerSecond;
+        // Split the conversion so that ticks * 1e9 can not overflow for long running processes.
+        return state.m_nsBase + (ticks / frequency) * 1000000000ll + ((ticks % frequency) * 1000000000ll) / frequency;
+    }
+
+    V::s64 MonotonicClock::FallbackNowNs(const State& state)
+    {
+        if (&state == &s_uncalibratedState) {
+            // Read before the first Calibrate(), the uncalibrated state has no tick rate to convert with.
+            State* fallbackState = new State();
+            fallbackState->m_ticksPerSecond = VStd::GetTimeTicksPerSecond();
+            Publish(fallbackState, true);
+            return NowNs();
+        }
+        return TicksToNs(state, VStd::GetTimeNowTicks());
+    }
+
+    MonotonicClock::StateOwner::~StateOwner()
+    {
+        VStd::lock_guard<VStd::mutex> lock(TimeSystemInternal::s_calibrateMutex);
+        const State* state = s_state.load(VStd::memory_order_acquire);
+        if (state == &s_uncalibratedState) {
+            return;
+        }
+
+        // Objects destroyed later may still read the clock, leave them a copy that is never freed.
+        s_exitState = *state;
+        s_exitState.m_previous = nullptr;
+        s_state.store(&s_exitState, VStd::memory_order_release);
+        while (state) {
+            const State* previous = state->m_previous;
+            delete state;
+            state = previous;
+        }
+    }
+
+    TimeSystem::TimeSystem()
+    {
+        MonotonicClock::Calibrate();
+        V::Interface<ITime>::Register(this);
+    }
+
+    TimeSystem::~TimeSystem()
+    {
+        V::Interface<ITime>::Unregister(this);
+    }
+
+    TimeMs TimeSystem::GetElapsedTimeMs() const
+    {
+        return static_cast<TimeMs>(MonotonicClock::NowMs());
+    }
+
+    TimeUs TimeSystem::GetElapsedTimeUs() const
+    {
+        return static_cast<TimeUs>(MonotonicClock::NowUs());
+    }
+
+    TimeNs TimeSystem::GetElapsedTimeNs() const
+    {
+        return static_cast<TimeNs>(MonotonicClock::NowNs());
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef V_FRAMEWORK_CORE_TIME_TIME_SYSTEM_H
+#define V_FRAMEWORK_CORE_TIME_TIME_SYSTEM_H
+
+#include <vcore/time/itime.h>
+#include <vcore/time/time_platform.h>
+#include <vcore/std/parallel/atomic.h>
+#include <vcore/std/time.h>
+
+namespace V {
+    //! @class MonotonicClock
+    //! Process wide monotonic clock with nanosecond resolution.
+    //! When the processor exposes an invariant time stamp counter the clock is read with a single rdtsc and converted
+    //! to nanoseconds with a 32.32 fixed point multiplier calibrated against VStd::GetTimeNowTicks(). Otherwise every
+    //! read falls back to the platform's monotonic tick counter (QueryPerformanceCounter / clock_gettime(CLOCK_MONOTONIC)).
+    //! NowNs() is non-virtual and inlined, use it on hot paths instead of going through V::Interface<ITime>.
+    //! The calibration is published as an immutable state through an atomic pointer, so Calibrate() can run while
+    //! other threads read the clock.
+    class MonotonicClock {
+    public:
+        //! Establishes the clock origin on the first call and (re)calibrates the TSC rate.
+        //! Recalibrating continues from the current time instead of restarting at zero.
+        //! Called by TimeSystem on construction, blocks the calling thread for roughly calibrationMs.
+        //! Reading the clock before the first call starts it on the platform's tick counter.
+        static void Calibrate(V::u32 calibrationMs = 20);
+
+        //! Returns true when reads are served by the time stamp counter.
+        static bool IsUsingTsc() { return s_state.load(VStd::memory_order_acquire)->m_useTsc; }
+
+        //! Returns the nanoseconds elapsed since the first Calibrate() or the first read, whichever came first.
+        static V_FORCE_INLINE V::s64 NowNs()
+        {
+            const State* state = s_state.load(VStd::memory_order_acquire);
+            if (state->m_useTsc) {
+                return state->m_nsBase + TscToNs(*state, V::Platform::ReadTimeStampCounter());
+            }
+            return FallbackNowNs(*state);
+        }
+
+        static V_FORCE_INLINE V::s64 NowUs() { return NowNs() / 1000; }
+        static V_FORCE_INLINE V::s64 NowMs() { return NowNs() / 1000000; }
+
+    private:
+        struct State {
+            bool m_useTsc = false;
+            V::u64 m_tscBase = 0;
+            V::u64 m_tscToNsMul = 0;
+            VStd::sys_time_t m_ticksBase = 0;
+            VStd::sys_time_t m_ticksPerSecond = 1;
+            //! Clock value at the bases, keeps the clock continuous across calibrations.
+            V::s64 m_nsBase = 0;
+            //! Replaced states are kept alive until the process exits, a reader may still be using one.
+            const State* m_previous = nullptr;
+        };
+
+        //! Frees the calibrated states when the process exits.
+        struct StateOwner {
+            ~StateOwner();
+        };
+
+        //! Nanoseconds from the state's TSC base to tsc.
+        static V_FORCE_INLINE V::s64 TscToNs(const State& state, V::u64 tsc)
+        {
+            const V::u64 delta = tsc - state.m_tscBase;
+            // delta * mul / 2^32 without a 128 bit product, m_tscToNsMul is kept below 2^32 by Calibrate().
+            return static_cast<V::s64>((delta >> 32) * state.m_tscToNsMul + (((delta & 0xffffffffull) * state.m_tscToNsMul) >> 32));
+        }
+        //! Clock value at ticks, read from the platform's tick counter.
+        static V::s64 TicksToNs(const State& state, VStd::sys_time_t ticks);
+        static V::s64 FallbackNowNs(const State& state);
+        //! Sets the bases of state and makes it the current state. With onlyIfUncalibrated state is dropped
+        //! if another thread published first.
+        static void Publish(State* state, bool onlyIfUncalibrated);
+
+        static const State s_uncalibratedState;
+        //! Copy of the last state, read by the clocks used during static destruction.
+        static State s_exitState;
+        static VStd::atomic<const State*> s_state;
+        static StateOwner s_stateOwner;
+    };
+
+    //! @class TimeSystem
+    //! Default ITime implementation, registers itself with V::Interface<ITime> for its lifetime.
+    class TimeSystem
+        : public ITime {
+    public:
+        VOBJECT_RTTI(TimeSystem, "{5b0d8c1a-3f9e-4c7d-a2b6-91e4f07d6c35}", ITime);
+
+        TimeSystem();
+        ~TimeSystem() override;
+
+        //////////////////////////////////////////////////////////////////////////
+        // ITime
+        TimeMs GetElapsedTimeMs() const override;
+        TimeUs GetElapsedTimeUs() const override;
+        TimeNs GetElapsedTimeNs() const override;
+        //////////////////////////////////////////////////////////////////////////
+    };
+
+    //! Non-virtual counterparts of V::GetElapsedTime*(), calibrated against the TSC once a TimeSystem has been created.
+    V_FORCE_INLINE TimeNs GetElapsedTimeNsFast()
+    {
+        return static_cast<TimeNs>(MonotonicClock::NowNs());
+    }
+
+    V_FORCE_INLINE TimeUs GetElapsedTimeUsFast()
+    {
+        return static_cast<TimeUs>(MonotonicClock::NowUs());
+    }
+
+    V_FORCE_INLINE TimeMs GetElapsedTimeMsFast()
+    {
+        return static_cast<TimeMs>(MonotonicClock::NowMs());
+    }
+}
+
+#endif // V_FRAMEWORK_CORE_TIME_TIME_SYSTEM_H
@@ -21,6 +21,8 @@ SET(FILES
     vcore/io/generic_streams.cc
     vcore/io/io_utils.h
     vcore/io/io_utils.cc
+    vcore/io/mapped_file.h
+    vcore/io/mapped_file.cc
     vcore/io/system_file.h
     vcore/io/system_file.cc
     vcore/io/istreamer.h
@@ -97,6 +99,8 @@ SET(FILES
     vcore/name/name_dictionary.cc
     vcore/name/name.h
     vcore/name/name.cc
+    vcore/name/interned_string.h
+    vcore/name/interned_string.cc
     vcore/native_ui/native_ui_requests.h
     vcore/native_ui/native_ui_system.h
     vcore/native_ui/native_ui_system.cc
@@ -159,6 +163,39 @@ SET(FILES
     vcore/vobject/vobject.h
     vcore/vobject/reflect_context.h
     vcore/vobject/reflect_context.cc
+    vcore/vobject/attribute_lookup.h
+    vcore/vobject/attribute_lookup.cc
+    vcore/serialization/serialization_context.h
+    vcore/serialization/serialization_context.cc
+    vcore/serialization/vstd_containers.inl
+    vcore/serialization/vstd_any_data_container.inl
+    vcore/serialization/dynamic_serializable_field.h
+    vcore/serialization/dynamic_serializable_field.cc
+    vcore/serialization/root_object_arena.h
+    vcore/serialization/root_object_arena.cc
+    vcore/serialization/class_data_index.h
+    vcore/serialization/class_data_index.cc
+    vcore/serialization/serialize_plan.h
+    vcore/serialization/serialize_plan.cc
+    vcore/serialization/parallel_clone.h
+    vcore/serialization/parallel_clone.cc
+    vcore/serialization/object_stream.h
+    vcore/serialization/object_stream.cc
+    vcore/serialization/object_delta.h
+    vcore/serialization/object_delta.cc
+    vcore/serialization/json_reader.h
+    vcore/serialization/json_reader.cc
+    vcore/serialization/json_writer.h
+    vcore/serialization/json_writer.cc
+    vcore/serialization/json_serialization.h
+    vcore/serialization/json_serialization.cc
+    vcore/serialization/snapshot_format.h
+    vcore/serialization/snapshot_reader.h
+    vcore/serialization/snapshot_reader.cc
+    vcore/serialization/snapshot_writer.h
+    vcore/serialization/snapshot_writer.cc
+    vcore/math/math_reflection.h
+    vcore/math/math_reflection.cc
     vcore/debug/budget_tracker.h
     vcore/debug/budget_tracker.cc
     vcore/debug/budget.h
@@ -172,6 +209,9 @@ SET(FILES
     vcore/debug/profiler_bus.h
     vcore/debug/profiler.h
     vcore/debug/profiler.cc
+    vcore/debug/profiler.inl
+    vcore/debug/trace_profiler.h
+    vcore/debug/trace_profiler.cc
     vcore/debug/time.h
     vcore/debug/trace_message_bus.h
     vcore/debug/trace_message_detector_bus.h
@@ -180,6 +220,8 @@ SET(FILES
     vcore/debug/trace.cc
     vcore/debug/local_file_event_logger.h
     vcore/debug/local_file_event_logger.cc
+    vcore/debug/mapped_event_log_reader.h
+    vcore/debug/mapped_event_log_reader.cc
     vcore/compression/compression.h
     vcore/compression/compression.cc
     vcore/compression/zstd_compression.h
@@ -192,6 +234,8 @@ SET(FILES
     vcore/detector/stream.h
     vcore/detector/stream.cc
     vcore/time/itime.h
+    vcore/time/time_system.h
+    vcore/time/time_system.cc
     vcore/socket/vsocket_fwd.h
     vcore/socket/vsocket.h
     vcore/socket/vsocket.cc
@@ -203,6 +247,8 @@ SET(FILES
     vcore/std/allocator_traits.h
     vcore/std/allocator.h
     vcore/std/allocator.cc
+    vcore/std/charconv.h
+    vcore/std/charconv.cc
     vcore/std/createdestroy.h
     vcore/std/exceptions.h
     vcore/std/functional_basic.h
@@ -297,6 +343,12 @@ SET(FILES
     vcore/std/smart_ptr/sp_convertible.h
     vcore/std/smart_ptr/unique_ptr.h
     vcore/std/smart_ptr/weak_ptr.h
+    vcore/std/string/cord.h
+    vcore/std/string/cord.cc
+    vcore/std/string/regex_automaton.h
+    vcore/std/string/regex_automaton.cc
+    vcore/std/string/utf8/transcode.h
+    vcore/std/string/utf8/transcode.cc
     vcore/std/typetraits/internal/is_template_copy_constructible.h
     vcore/std/typetraits/internal/type_sequence_traits.h
     vcore/std/typetraits/add_const.h
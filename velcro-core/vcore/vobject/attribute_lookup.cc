@@ -0,0 +1,119 @@
+#include <vcore/vobject/attribute_lookup.h>
+#include <vcore/math/math_intrinsics.h>
+#include <vcore/std/algorithm.h>
+
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace V
+{
+    namespace AttributeLookupInternal
+    {
+        /// Up to this many ids a linear SIMD scan beats the branches of a binary search.
+        static constexpr size_t MaxLinearScanSize = 16;
+    } // namespace AttributeLookupInternal
+
+    //=========================================================================
+    // Clear
+    //=========================================================================
+    void AttributeLookup::Clear()
+    {
+        m_ids.clear();
+        m_entries.clear();
+        m_isBuilt = false;
+    }
+
+    //=========================================================================
+    // Insert
+    //=========================================================================
+    void AttributeLookup::Insert(AttributeId id, Attribute* attribute)
+    {
+        // attribute arrays are short, an insertion sort keeps the first attribute of duplicated ids
+        auto idIt = VStd::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if (idIt != m_ids.end() && *idIt == id)
+        {
+            return;
+        }
+
+        Entry entry;
+        entry.AttributePtr = attribute;
+        entry.Kind = ScalarKind::None;
+        entry.UnsignedValue = 0;
+        if (attribute)
+        {
+            static_cast<void>(StoreScalar<bool>(attribute, entry) ||
+                StoreScalar<char>(attribute, entry) ||
+                StoreScalar<signed char>(attribute, entry) ||
+                StoreScalar<unsigned char>(attribute, entry) ||
+                StoreScalar<short>(attribute, entry) ||
+                StoreScalar<unsigned short>(attribute, entry) ||
+                StoreScalar<int>(attribute, entry) ||
+                StoreScalar<unsigned int>(attribute, entry) ||
+                StoreScalar<s64>(attribute, entry) ||
+                StoreScalar<u64>(attribute, entry) ||
+                StoreScalar<float>(attribute, entry) ||
+                StoreScalar<double>(attribute, entry) ||
+                StoreScalar<Crc32>(attribute, entry));
+        }
+
+        const size_t index = idIt - m_ids.begin();
+        m_ids.insert(idIt, id);
+        m_entries.insert(m_entries.begin() + index, entry);
+    }
+
+    //=========================================================================
+    // Finalize
+    //=========================================================================
+    void AttributeLookup::Finalize()
+    {
+        m_ids.shrink_to_fit();
+        m_entries.shrink_to_fit();
+        m_isBuilt = true;
+    }
+
+    //=========================================================================
+    // Find
+    //=========================================================================
+    Attribute* AttributeLookup::Find(AttributeId id) const
+    {
+        const Entry* entry = FindEntry(id);
+        return entry ? entry->AttributePtr : nullptr;
+    }
+
+    //=========================================================================
+    // FindEntry
+    //=========================================================================
+    const AttributeLookup::Entry* AttributeLookup::FindEntry(AttributeId id) const
+    {
+        const size_t numIds = m_ids.size();
+        const AttributeId* ids = m_ids.data();
+        if (numIds > AttributeLookupInternal::MaxLinearScanSize)
+        {
+            const AttributeId* idIt = VStd::lower_bound(ids, ids + numIds, id);
+            return (idIt != ids + numIds && *idIt == id) ? &m_entries[idIt - ids] : nullptr;
+        }
+
+        size_t index = 0;
+#if V_TRAIT_USE_PLATFORM_SIMD_SSE
+        const __m128i key = _mm_set1_epi32(static_cast<int>(id));
+        for (; index + 4 <= numIds; index += 4)
+        {
+            const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + index));
+            const u32 matches = static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(group, key))));
+            if (matches)
+            {
+                return &m_entries[index + v_ctz_u32(matches)];
+            }
+        }
+#endif
+        for (; index < numIds; ++index)
+        {
+            if (ids[index] == id)
+            {
+                return &m_entries[index];
+            }
+        }
+        return nullptr;
+    }
+} // namespace V
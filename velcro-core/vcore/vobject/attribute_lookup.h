@@ -0,0 +1,170 @@
+#ifndef V_FRAMEWORK_CORE_VOBJECT_ATTRIBUTE_LOOKUP_H
+#define V_FRAMEWORK_CORE_VOBJECT_ATTRIBUTE_LOOKUP_H
+
+#include <vcore/vobject/reflect_context.h>
+#include <vcore/vobject/attribute_reader.h>
+#include <vcore/math/crc.h>
+
+namespace V
+{
+    /**
+     * Read only copy of an attribute array, built once reflection is done.
+     *
+     * Ids are kept sorted in their own array. Small sets are scanned four ids at a time with SIMD compares,
+     * larger ones are binary searched. Value attributes of scalar types (AttributeData<T> with an integral, floating
+     * point or Crc32 T) are also copied inline, so ReadValue doesn't have to go through the Attribute object.
+     * If an id is present more than once the first attribute wins, like FindAttribute on the array.
+     */
+    class AttributeLookup
+    {
+    public:
+        AttributeLookup() = default;
+
+        template<class ContainerType>
+        void Build(const ContainerType& attrArray);
+        void Clear();
+        bool IsBuilt() const { return m_isBuilt; }
+
+        Attribute* Find(AttributeId id) const;
+
+        /// Reads a value attribute without an instance. Scalars use the inline copy with the conversion rules of
+        /// Internal::AttributeReader, anything else goes through the reader.
+        template<class T>
+        bool ReadValue(AttributeId id, T& value) const;
+
+    private:
+        enum class ScalarKind : u8
+        {
+            None,
+            Bool,
+            Signed,
+            Unsigned,
+            Floating,
+        };
+
+        struct Entry
+        {
+            Attribute* AttributePtr;
+            ScalarKind Kind;
+            union
+            {
+                s64 SignedValue;
+                u64 UnsignedValue;
+                double FloatingValue;
+            };
+        };
+
+        void Insert(AttributeId id, Attribute* attribute);
+        void Finalize();
+        const Entry* FindEntry(AttributeId id) const;
+
+        template<class T>
+        static bool StoreScalar(Attribute* attribute, Entry& entry);
+
+        VStd::vector<AttributeId> m_ids;
+        VStd::vector<Entry> m_entries;
+        bool m_isBuilt = false;
+    };
+
+    inline Attribute* FindAttribute(AttributeId id, const AttributeLookup& lookup)
+    {
+        return lookup.Find(id);
+    }
+
+    template<class ContainerType>
+    void AttributeLookup::Build(const ContainerType& attrArray)
+    {
+        Clear();
+        m_ids.reserve(attrArray.size());
+        m_entries.reserve(attrArray.size());
+        for (const auto& attrPair : attrArray)
+        {
+            Insert(attrPair.first, attrPair.second ? &*attrPair.second : nullptr);
+        }
+        Finalize();
+    }
+
+    template<class T>
+    bool AttributeLookup::StoreScalar(Attribute* attribute, Entry& entry)
+    {
+        // only the exact type, AttributeMemberData<T> derives from AttributeData<T> but reads from the instance
+        if (attribute->RTTI_GetType() != AttributeData<T>::RTTI_Type())
+        {
+            return false;
+        }
+
+        const T& value = static_cast<AttributeData<T>*>(attribute)->Get(nullptr);
+        if constexpr (VStd::is_same_v<T, bool>)
+        {
+            entry.Kind = ScalarKind::Bool;
+            entry.UnsignedValue = value ? 1 : 0;
+        }
+        else if constexpr (VStd::is_floating_point_v<T>)
+        {
+            entry.Kind = ScalarKind::Floating;
+            entry.FloatingValue = value;
+        }
+        else if constexpr (VStd::is_same_v<T, Crc32>)
+        {
+            entry.Kind = ScalarKind::Unsigned;
+            entry.UnsignedValue = static_cast<u32>(value);
+        }
+        else if constexpr (VStd::is_signed_v<T>)
+        {
+            entry.Kind = ScalarKind::Signed;
+            entry.SignedValue = value;
+        }
+        else
+        {
+            entry.Kind = ScalarKind::Unsigned;
+            entry.UnsignedValue = value;
+        }
+        return true;
+    }
+
+    template<class T>
+    bool AttributeLookup::ReadValue(AttributeId id, T& value) const
+    {
+        const Entry* entry = FindEntry(id);
+        if (!entry || !entry->AttributePtr)
+        {
+            return false;
+        }
+
+        if constexpr (VStd::is_same_v<T, bool>)
+        {
+            // bool requires an exact match
+            if (entry->Kind == ScalarKind::Bool)
+            {
+                value = entry->UnsignedValue != 0;
+                return true;
+            }
+        }
+        else if constexpr (VStd::is_integral_v<T>)
+        {
+            switch (entry->Kind)
+            {
+            case ScalarKind::Bool:
+            case ScalarKind::Unsigned:
+                value = static_cast<T>(entry->UnsignedValue);
+                return true;
+            case ScalarKind::Signed:
+                value = static_cast<T>(entry->SignedValue);
+                return true;
+            default:
+                break;
+            }
+        }
+        else if constexpr (VStd::is_floating_point_v<T>)
+        {
+            if (entry->Kind == ScalarKind::Floating)
+            {
+                value = static_cast<T>(entry->FloatingValue);
+                return true;
+            }
+        }
+        return Internal::AttributeReader<T, T>::Read(value, entry->AttributePtr, static_cast<void*>(nullptr));
+    }
+} // namespace V
+
+#endif // V_FRAMEWORK_CORE_VOBJECT_ATTRIBUTE_LOOKUP_H
@@ -493,7 +493,7 @@ namespace V {
         }
         template<typename TypeIdResolverTag = CanonicalTypeIdTag>
         static const V::TypeId& Id() {
-            static V::Internal::TypeIdHolder _uuid(V::Internal::AggregateTypes<R, Args...>::template Uuid<>(TypeIdResolverTag));
+            static V::Internal::TypeIdHolder _uuid(V::Internal::AggregateTypes<R, Args...>::template Uuid<TypeIdResolverTag>());
             return _uuid;
         }
         static constexpr TypeTraits GetTypeTraits()
@@ -526,7 +526,7 @@ namespace V {
             }
             return typeName;
         }
-        template<typename TypeIdResolverTag = CannonicalTypeIdTag>
+        template<typename TypeIdResolverTag = CanonicalTypeIdTag>
         static const V::TypeId& Id() {
             static V::Internal::TypeIdHolder _uuid(V::Internal::AggregateTypes<R, C, Args...>::template Uuid<TypeIdResolverTag>());
             return _uuid;
@@ -929,6 +929,7 @@ namespace V {
     VOBJECT_INFO_INTERNAL_SPECIALIZE(void, "{6c20c236-3bbe-4c44-84c5-20acdcd69531}");
     VOBJECT_INFO_INTERNAL_SPECIALIZE(Crc32, "{bbc4eff2-2079-41cd-ac56-ecf1f89a029c}");
     VOBJECT_INFO_INTERNAL_SPECIALIZE(PlatformID, "{4feafc8b-b03d-47c2-86f7-a318cb7d9c09}");
+    VOBJECT_INFO_INTERNAL_SPECIALIZE(VStd::monostate, "{b1e9136b-d77a-4643-be8e-2abda246ae0e}");
 
     VOBJECT_INTERNAL_SPECIALIZE_CV(T, T*, "", "*");
     VOBJECT_INTERNAL_SPECIALIZE_CV(T, T &, "", "&");